@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "captureGroup.h"
+#include "gstPipeline.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+// checks that a set of frames from captureGroup stays valid while newer sets are captured
+int main( int argc, char** argv )
+{
+	const uint32_t numSources = 2;
+	const uint32_t width  = 320;
+	const uint32_t height = 240;
+
+	// the ball pattern moves every frame, so a slot that gets overwritten is noticed
+	const char* launchStr = "videotestsrc pattern=ball is-live=true ! video/x-raw,format=RGB,width=320,height=240,framerate=30/1 ! appsink name=mysink";
+
+	gstPipeline* sources[numSources];
+	captureGroup* group = captureGroup::Create(captureGroup::DefaultSkew * 5);
+
+	for( uint32_t n=0; n < numSources; n++ )
+	{
+		sources[n] = gstPipeline::Create(launchStr, width, height, 24);
+
+		if( !sources[n] || !group->AddSource(sources[n]) )
+		{
+			printf("capture-group-test:  failed to create source %u\n", n);
+			return 1;
+		}
+	}
+
+	if( !group->Open() )
+	{
+		printf("capture-group-test:  failed to open the sources\n");
+		return 1;
+	}
+
+	// capture a set and keep a copy of it
+	const size_t size = width * height * 3;
+
+	captureGroupFrame held[numSources];
+	captureGroupFrame next[numSources];
+
+	void* copies[numSources];
+
+	if( !group->Capture(held, 5000) )
+	{
+		printf("capture-group-test:  failed to capture the first set\n");
+		return 1;
+	}
+
+	for( uint32_t n=0; n < numSources; n++ )
+	{
+		copies[n] = malloc(size);
+		memcpy(copies[n], held[n].cpu, size);
+	}
+
+	// capture more sets while the first one is still held
+	bool passed = true;
+
+	for( uint32_t i=0; i < 8 && passed; i++ )
+	{
+		if( !group->Capture(next, 5000) )
+		{
+			printf("capture-group-test:  failed to capture set %u\n", i + 1);
+			passed = false;
+			break;
+		}
+
+		for( uint32_t n=0; n < numSources; n++ )
+		{
+			if( next[n].cpu == held[n].cpu )
+			{
+				printf("capture-group-test:  set %u reused the held frame from source %u\n", i + 1, n);
+				passed = false;
+			}
+
+			if( memcmp(copies[n], held[n].cpu, size) != 0 )
+			{
+				printf("capture-group-test:  the held frame from source %u was overwritten\n", n);
+				passed = false;
+			}
+		}
+
+		group->Release(next);
+	}
+
+	group->Release(held);
+	group->Close();
+
+	printf("capture-group-test:  %s\n", passed ? "PASSED" : "FAILED");
+
+	// the group is deleted first, because it detaches itself from the sources
+	delete group;
+
+	for( uint32_t n=0; n < numSources; n++ )
+	{
+		free(copies[n]);
+		delete sources[n];
+	}
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "captureGroup.h"
+
+#include "gstCamera.h"
+#include "gstPipeline.h"
+#include "gstUtility.h"
+
+#include <string.h>
+
+
+// captureGroupPolicyToString
+const char* captureGroupPolicyToString( captureGroupPolicy policy )
+{
+	if( policy == CAPTURE_GROUP_DROP_INCOMPLETE )		return "CAPTURE_GROUP_DROP_INCOMPLETE";
+	else if( policy == CAPTURE_GROUP_ALLOW_PARTIAL )	return "CAPTURE_GROUP_ALLOW_PARTIAL";
+
+	return "UNKNOWN";
+}
+
+
+// constructor
+captureGroup::captureGroup( uint64_t skew, captureGroupPolicy policy )
+{
+	mSkew   = skew;
+	mPolicy = policy;
+
+	mSetsCaptured    = 0;
+	mSetsIncomplete  = 0;
+	mFramesDiscarded = 0;
+}
+
+
+// destructor
+captureGroup::~captureGroup()
+{
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( mSources[n].held )
+			releaseSource(mSources[n]);
+
+		if( mSources[n].type == SOURCE_CAMERA )
+			((gstCamera*)mSources[n].ptr)->SetNotifyEvent(NULL);
+		else
+			((gstPipeline*)mSources[n].ptr)->SetNotifyEvent(NULL);
+	}
+}
+
+
+// Create
+captureGroup* captureGroup::Create( uint64_t skew, captureGroupPolicy policy )
+{
+	return new captureGroup(skew, policy);
+}
+
+
+// AddSource
+bool captureGroup::AddSource( gstCamera* camera )
+{
+	return addSource(SOURCE_CAMERA, camera);
+}
+
+
+// AddSource
+bool captureGroup::AddSource( gstPipeline* pipeline )
+{
+	return addSource(SOURCE_PIPELINE, pipeline);
+}
+
+
+// addSource
+bool captureGroup::addSource( sourceType type, void* ptr )
+{
+	if( !ptr )
+		return false;
+
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( mSources[n].ptr == ptr )
+		{
+			printf(LOG_GSTREAMER "captureGroup -- source was already added to the group\n");
+			return false;
+		}
+	}
+
+	source src;
+	memset(&src, 0, sizeof(source));
+
+	src.type = type;
+	src.ptr  = ptr;
+	src.held = false;
+
+	if( type == SOURCE_CAMERA )
+		((gstCamera*)ptr)->SetNotifyEvent(&mEvent);
+	else
+		((gstPipeline*)ptr)->SetNotifyEvent(&mEvent);
+
+	mSources.push_back(src);
+	return true;
+}
+
+
+// Open
+bool captureGroup::Open()
+{
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		const bool result = (mSources[n].type == SOURCE_CAMERA) ? ((gstCamera*)mSources[n].ptr)->Open()
+													 : ((gstPipeline*)mSources[n].ptr)->Open();
+
+		if( !result )
+		{
+			printf(LOG_GSTREAMER "captureGroup -- failed to open source %zu\n", n);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Close
+void captureGroup::Close()
+{
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( mSources[n].held )
+			releaseSource(mSources[n]);
+
+		if( mSources[n].type == SOURCE_CAMERA )
+			((gstCamera*)mSources[n].ptr)->Close();
+		else
+			((gstPipeline*)mSources[n].ptr)->Close();
+	}
+}
+
+
+// captureSource
+bool captureGroup::captureSource( source& src )
+{
+	captureGroupFrame& frame = src.frame;
+
+	// Capture() would release the frame from the previous set in copy mode, which the caller may still hold
+	const bool result = (src.type == SOURCE_CAMERA) ? ((gstCamera*)src.ptr)->Acquire(&frame.cpu, &frame.cuda, 0, &frame.metadata)
+										   : ((gstPipeline*)src.ptr)->Acquire(&frame.cpu, &frame.cuda, 0, &frame.metadata);
+
+	src.held    = result;
+	frame.valid = result;
+
+	return result;
+}
+
+
+// releaseSource
+void captureGroup::releaseSource( source& src )
+{
+	void* image = (src.frame.cpu != NULL) ? src.frame.cpu : src.frame.cuda;
+
+	if( src.type == SOURCE_CAMERA )
+		((gstCamera*)src.ptr)->Release(image);
+	else
+		((gstPipeline*)src.ptr)->Release(image);
+
+	memset(&src.frame, 0, sizeof(captureGroupFrame));
+	src.held = false;
+}
+
+
+// discardStale
+int captureGroup::discardStale()
+{
+	// find the newest frame that's held
+	const timespec* newest = NULL;
+
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( !mSources[n].held )
+			continue;
+
+		if( !newest || timeCmp(mSources[n].frame.metadata.enqueued, *newest) > 0 )
+			newest = &mSources[n].frame.metadata.enqueued;
+	}
+
+	if( !newest )
+		return 0;
+
+	const timespec latest = *newest;
+
+	// release the frames that are too far behind it to be in the same set
+	int discarded = 0;
+
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( !mSources[n].held )
+			continue;
+
+		const timespec diff = timeDiff(mSources[n].frame.metadata.enqueued, latest);
+		const uint64_t skew = (uint64_t)diff.tv_sec * 1000000ULL + diff.tv_nsec / 1000;
+
+		if( skew <= mSkew )
+			continue;
+
+		releaseSource(mSources[n]);
+		discarded++;
+	}
+
+	mFramesDiscarded += discarded;
+	return discarded;
+}
+
+
+// Capture
+bool captureGroup::Capture( captureGroupFrame* frames, uint64_t timeout )
+{
+	if( !frames || mSources.size() == 0 )
+		return false;
+
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		// poll each source that doesn't have a frame yet, and drop frames
+		// that fell behind (the sources they came from may have newer ones)
+		bool complete = true;
+
+		do
+		{
+			complete = true;
+
+			for( size_t n=0; n < mSources.size(); n++ )
+			{
+				if( !mSources[n].held && !captureSource(mSources[n]) )
+					complete = false;
+			}
+
+		} while( discardStale() > 0 );
+
+		if( complete )
+		{
+			for( size_t n=0; n < mSources.size(); n++ )
+			{
+				frames[n] = mSources[n].frame;
+				memset(&mSources[n].frame, 0, sizeof(captureGroupFrame));
+				mSources[n].held = false;
+			}
+
+			mSetsCaptured++;
+			return true;
+		}
+
+		// wait for the remaining sources to queue a frame
+		bool timedOut = (timeout == 0);
+
+		if( !timedOut && timeout != UINT64_MAX )
+		{
+			const timespec elapsed = timeDiff(start, timestampMonotonic());
+			const uint64_t elapsedNs = (uint64_t)elapsed.tv_sec * 1000000000ULL + elapsed.tv_nsec;
+			const uint64_t timeoutNs = timeout * 1000000ULL;
+
+			timedOut = (elapsedNs >= timeoutNs) || !mEvent.WaitNs(timeoutNs - elapsedNs);
+		}
+		else if( !timedOut )
+		{
+			mEvent.Wait();
+		}
+
+		if( !timedOut )
+			continue;
+
+		// some sources were late or missing
+		mSetsIncomplete++;
+
+		if( mPolicy != CAPTURE_GROUP_ALLOW_PARTIAL )
+			return false;	// keep the frames that are held, they may still be matched on the next call
+
+		bool any = false;
+
+		for( size_t n=0; n < mSources.size(); n++ )
+		{
+			frames[n] = mSources[n].frame;
+			frames[n].valid = mSources[n].held;
+
+			memset(&mSources[n].frame, 0, sizeof(captureGroupFrame));
+
+			any |= mSources[n].held;
+			mSources[n].held = false;
+		}
+
+		return any;
+	}
+}
+
+
+// Release
+void captureGroup::Release( captureGroupFrame* frames )
+{
+	if( !frames )
+		return;
+
+	for( size_t n=0; n < mSources.size(); n++ )
+	{
+		if( !frames[n].valid )
+			continue;
+
+		void* image = (frames[n].cpu != NULL) ? frames[n].cpu : frames[n].cuda;
+
+		if( mSources[n].type == SOURCE_CAMERA )
+			((gstCamera*)mSources[n].ptr)->Release(image);
+		else
+			((gstPipeline*)mSources[n].ptr)->Release(image);
+
+		frames[n].valid = false;
+	}
+}
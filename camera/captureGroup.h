@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CAPTURE_GROUP_H__
+#define __CAPTURE_GROUP_H__
+
+#include "captureQueue.h"
+
+#include <vector>
+
+
+// Forward declarations
+class gstCamera;
+class gstPipeline;
+
+
+/**
+ * Enumeration of policies for handling sources that are late or missing
+ * when a captureGroup assembles a frame set.
+ * @see captureGroup
+ * @ingroup camera
+ */
+enum captureGroupPolicy
+{
+	CAPTURE_GROUP_DROP_INCOMPLETE,	/**< Only return complete frame sets, Capture() fails if a source doesn't deliver in time (default) */
+	CAPTURE_GROUP_ALLOW_PARTIAL		/**< On timeout, return the frames that are aligned and mark the late sources as invalid */
+};
+
+/**
+ * Stringize function to convert captureGroupPolicy enum to text
+ * @ingroup camera
+ */
+const char* captureGroupPolicyToString( captureGroupPolicy policy );
+
+
+/**
+ * One frame of a set returned by captureGroup::Capture().
+ * @ingroup camera
+ */
+struct captureGroupFrame
+{
+	void* cpu;					/**< Pointer to the image in CPU address space (NULL if not valid) */
+	void* cuda;					/**< Pointer to the image in GPU address space (NULL if not valid) */
+	bool  valid;				/**< False if the source was late or missing (CAPTURE_GROUP_ALLOW_PARTIAL) */
+	captureMetadata metadata;	/**< Sequence number and timestamps of the frame */
+};
+
+
+/**
+ * Captures timestamp-aligned sets of frames from several gstCamera or gstPipeline sources.
+ *
+ * Frames from different sources are matched by the time that they arrived from
+ * their pipelines (captureMetadata::enqueued), and a set is returned once every
+ * source has a frame within the skew tolerance of the others.  When sources drift
+ * apart, the oldest frames are discarded until they line up again.
+ *
+ * All of the sources are serviced from the thread that calls Capture(), which
+ * waits on a single event that every source signals when it queues a frame.
+ *
+ * The sources aren't owned by the captureGroup, and they should outlive it.
+ * @ingroup camera
+ */
+class captureGroup
+{
+public:
+	/**
+	 * Create an empty capture group.
+	 * @param skew maximum difference between the timestamps of frames in a set, in microseconds
+	 * @param policy how to handle sources that are late or missing
+	 */
+	static captureGroup* Create( uint64_t skew=DefaultSkew, captureGroupPolicy policy=CAPTURE_GROUP_DROP_INCOMPLETE );
+
+	/**
+	 * Destructor
+	 */
+	~captureGroup();
+
+	/**
+	 * Add a camera to the group.  Sources are indexed in the order they were added.
+	 */
+	bool AddSource( gstCamera* camera );
+
+	/**
+	 * Add a pipeline to the group.  Sources are indexed in the order they were added.
+	 */
+	bool AddSource( gstPipeline* pipeline );
+
+	/**
+	 * Return the number of sources in the group.
+	 */
+	inline uint32_t GetNumSources() const					{ return mSources.size(); }
+
+	/**
+	 * Begin streaming all of the sources.
+	 */
+	bool Open();
+
+	/**
+	 * Stop streaming all of the sources.
+	 */
+	void Close();
+
+	/**
+	 * Capture the next timestamp-aligned set of frames.
+	 *
+	 * @param[out] frames array of GetNumSources() elements that receives the frame from each source
+	 * @param[in] timeout The time in milliseconds to wait for a complete set.
+	 *                    If timeout is 0, return immediately if a set isn't ready.
+	 *                    If timeout is UINT64_MAX, wait indefinitely (the default).
+	 *
+	 * @returns `true` if a set was captured, or `false` on timeout or error.
+	 *          With CAPTURE_GROUP_ALLOW_PARTIAL, a set is returned after the timeout
+	 *          as long as at least one source has a frame.  The frames remain valid
+	 *          until they're passed to Release(), even while newer sets are captured.
+	 */
+	bool Capture( captureGroupFrame* frames, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Release a set of frames that was returned by Capture().
+	 */
+	void Release( captureGroupFrame* frames );
+
+	/**
+	 * Set the maximum difference between the timestamps of frames in a set, in microseconds.
+	 */
+	inline void SetSkewTolerance( uint64_t skew )			{ mSkew = skew; }
+
+	/**
+	 * Get the maximum difference between the timestamps of frames in a set, in microseconds.
+	 */
+	inline uint64_t GetSkewTolerance() const				{ return mSkew; }
+
+	/**
+	 * Set the policy for handling sources that are late or missing.
+	 */
+	inline void SetPolicy( captureGroupPolicy policy )		{ mPolicy = policy; }
+
+	/**
+	 * Get the policy for handling sources that are late or missing.
+	 */
+	inline captureGroupPolicy GetPolicy() const				{ return mPolicy; }
+
+	/**
+	 * Return the number of complete sets that were captured.
+	 */
+	inline uint64_t GetSetsCaptured() const					{ return mSetsCaptured; }
+
+	/**
+	 * Return the number of times that a set couldn't be completed before the timeout
+	 * (this includes the partial sets returned with CAPTURE_GROUP_ALLOW_PARTIAL).
+	 */
+	inline uint64_t GetSetsIncomplete() const				{ return mSetsIncomplete; }
+
+	/**
+	 * Return the number of frames that were discarded because they
+	 * couldn't be aligned with the frames from the other sources.
+	 */
+	inline uint64_t GetFramesDiscarded() const				{ return mFramesDiscarded; }
+
+	/**
+	 * Default skew tolerance, in microseconds (10ms)
+	 */
+	static const uint64_t DefaultSkew = 10000;
+
+protected:
+	captureGroup( uint64_t skew, captureGroupPolicy policy );
+
+	enum sourceType
+	{
+		SOURCE_CAMERA,
+		SOURCE_PIPELINE
+	};
+
+	struct source
+	{
+		sourceType type;
+		void*      ptr;
+		bool       held;		// is a frame currently held from this source?
+		captureGroupFrame frame;
+	};
+
+	bool addSource( sourceType type, void* ptr );
+	bool captureSource( source& src );
+	void releaseSource( source& src );
+	int  discardStale();
+
+	std::vector<source> mSources;
+
+	uint64_t mSkew;
+	captureGroupPolicy mPolicy;
+
+	uint64_t mSetsCaptured;
+	uint64_t mSetsIncomplete;
+	uint64_t mFramesDiscarded;
+
+	Event mEvent;	// signalled by the sources when they queue a frame
+};
+
+
+#endif
+
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "captureQueue.h"
+#include "timespec.h"
+
+#include <string.h>
+
+
+// captureQueuePolicyToString
+const char* captureQueuePolicyToString( captureQueuePolicy policy )
+{
+	switch(policy)
+	{
+		case CAPTURE_QUEUE_LATEST:		return "latest";
+		case CAPTURE_QUEUE_FIFO:		return "fifo";
+		case CAPTURE_QUEUE_DROP_OLDEST:	return "drop-oldest";
+	}
+
+	return "unknown";
+}
+
+
+// constructor
+captureQueue::captureQueue( uint32_t numSlots, captureQueuePolicy policy ) : mFree(MaxSlots), mReady(MaxSlots)
+{
+	if( numSlots < 2 )
+		numSlots = 2;
+	else if( numSlots > MaxSlots )
+		numSlots = MaxSlots;
+
+	mNumSlots     = numSlots;
+	mProduced     = 0;
+	mConsumed     = 0;
+	mDropped      = 0;
+	mPolicy       = policy;
+	mDropCallback = NULL;
+	mDropUserData = NULL;
+	mFlushing     = false;
+	mEOS          = false;
+	mNotifyEvent  = NULL;
+
+	for( uint32_t n=0; n < MaxSlots; n++ )
+	{
+		mState[n] = SLOT_FREE;
+		memset(&mMetadata[n], 0, sizeof(captureMetadata));
+	}
+
+	for( uint32_t n=0; n < mNumSlots; n++ )
+		mFree.TryPush(n);
+}
+
+
+// destructor
+captureQueue::~captureQueue()
+{
+
+}
+
+
+// SetPolicy
+void captureQueue::SetPolicy( captureQueuePolicy policy )
+{
+	mPolicy = policy;
+
+	if( policy == CAPTURE_QUEUE_LATEST )
+	{
+		while( mReady.GetSize() > 1 && dropFront() )
+			;
+	}
+
+	// a producer that's waiting in FIFO mode may not need to anymore
+	mFreeEvent.Notify();
+}
+
+
+// SetDropCallback
+void captureQueue::SetDropCallback( captureQueueDropCallback callback, void* user_data )
+{
+	mDropCallback = callback;
+	mDropUserData = user_data;
+}
+
+
+// SetNotifyEvent
+void captureQueue::SetNotifyEvent( Event* event )
+{
+	mNotifyEvent = event;
+}
+
+
+// dropFront
+bool captureQueue::dropFront()
+{
+	uint32_t slot = 0;
+
+	if( !mReady.TryPop(&slot) )
+		return false;
+
+	if( mDropCallback != NULL )
+		mDropCallback(slot, mDropUserData);
+
+	mState[slot] = SLOT_FREE;
+	mDropped++;
+
+	mFree.TryPush(slot);
+	mFreeEvent.Notify();
+
+	return true;
+}
+
+
+// BeginWrite
+int captureQueue::BeginWrite()
+{
+	while(true)
+	{
+		// take the snapshot before checking the conditions, so a change can't be missed
+		const uint32_t snapshot = mFreeEvent.Prepare();
+
+		if( mFlushing )
+			return -1;
+
+		uint32_t slot = 0;
+
+		if( mFree.TryPop(&slot) )
+		{
+			mState[slot] = SLOT_WRITING;
+			return slot;
+		}
+
+		// every slot is either queued or held by a consumer
+		if( mPolicy != CAPTURE_QUEUE_FIFO )
+		{
+			if( dropFront() )
+				continue;	// reuse the slot of the oldest queued frame
+
+			// a consumer may have released a slot since the checks above,
+			// so only drop the frame if nothing has changed in the meantime
+			if( mFreeEvent.Prepare() != snapshot || mReady.GetSize() > 0 )
+				continue;
+
+			if( mFree.TryPop(&slot) )
+			{
+				mState[slot] = SLOT_WRITING;
+				return slot;
+			}
+
+			// all slots are held by consumers, so drop this frame
+			mProduced++;
+			mDropped++;
+			return -1;
+		}
+
+		// in FIFO mode, wait for a consumer to release a slot
+		mFreeEvent.Wait(snapshot);
+	}
+}
+
+
+// Commit
+uint64_t captureQueue::Commit( uint32_t slot, uint64_t pts, uint64_t dts )
+{
+	if( slot >= mNumSlots )
+		return 0;
+
+	if( mFlushing )
+	{
+		Cancel(slot);
+		return 0;
+	}
+
+	// in latest mode, the previous unconsumed frame is superseded by this one
+	if( mPolicy == CAPTURE_QUEUE_LATEST )
+	{
+		while( dropFront() )
+			;
+	}
+
+	const uint64_t sequence = mProduced++;
+
+	mMetadata[slot].sequence = sequence;
+	mMetadata[slot].pts      = pts;
+	mMetadata[slot].dts      = dts;
+	mMetadata[slot].enqueued = timestamp();
+
+	mState[slot] = SLOT_QUEUED;
+	mReady.TryPush(slot);
+
+	// if flushing started while the frame was being queued, it may have missed it
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if( mFlushing )
+	{
+		while( dropFront() )
+			;
+
+		return sequence;
+	}
+
+	mReadyEvent.Notify();
+
+	Event* notify = mNotifyEvent;
+
+	if( notify != NULL )
+		notify->Wake();
+
+	return sequence;
+}
+
+
+// Cancel
+void captureQueue::Cancel( uint32_t slot )
+{
+	if( slot >= mNumSlots )
+		return;
+
+	uint32_t state = SLOT_WRITING;
+
+	if( !mState[slot].compare_exchange_strong(state, SLOT_FREE) )
+		return;
+
+	mFree.TryPush(slot);
+	mFreeEvent.Notify();
+}
+
+
+// Drop
+void captureQueue::Drop( uint32_t slot )
+{
+	if( slot >= mNumSlots )
+		return;
+
+	uint32_t state = SLOT_WRITING;
+
+	if( !mState[slot].compare_exchange_strong(state, SLOT_FREE) )
+		return;
+
+	mProduced++;
+	mDropped++;
+
+	mFree.TryPush(slot);
+	mFreeEvent.Notify();
+}
+
+
+// Dequeue
+int captureQueue::Dequeue( uint64_t timeout, captureMetadata* metadata )
+{
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mReadyEvent.Prepare();
+		uint32_t slot = 0;
+
+		if( mReady.TryPop(&slot) )
+		{
+			mConsumed++;
+
+			mMetadata[slot].dequeued = timestamp();
+			mQueueLatency.Add(mMetadata[slot].enqueued, mMetadata[slot].dequeued);
+
+			if( metadata != NULL )
+				*metadata = mMetadata[slot];
+
+			mState[slot] = SLOT_ACQUIRED;
+			return slot;
+		}
+
+		if( mEOS || timeout == 0 )
+			return -1;
+
+		// wait for the time that's remaining of the timeout
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return -1;
+
+		mReadyEvent.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// Release
+void captureQueue::Release( uint32_t slot )
+{
+	if( slot >= mNumSlots )
+		return;
+
+	const timespec dequeued = mMetadata[slot].dequeued;
+	uint32_t state = SLOT_ACQUIRED;
+
+	// only the first release of the slot returns it to the producer
+	if( !mState[slot].compare_exchange_strong(state, SLOT_FREE) )
+		return;
+
+	mHoldLatency.Add(dequeued, timestamp());
+
+	mFree.TryPush(slot);
+	mFreeEvent.Notify();
+}
+
+
+// IsAcquired
+bool captureQueue::IsAcquired( uint32_t slot )
+{
+	if( slot >= mNumSlots )
+		return false;
+
+	return (mState[slot] == SLOT_ACQUIRED);
+}
+
+
+// SetFlushing
+void captureQueue::SetFlushing( bool flushing )
+{
+	mFlushing = flushing;
+
+	if( flushing )
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		while( dropFront() )
+			;
+	}
+
+	mFreeEvent.Notify();
+}
+
+
+// SetEOS
+void captureQueue::SetEOS( bool eos )
+{
+	mEOS = eos;
+
+	if( eos )
+		mReadyEvent.Notify();
+}
+
+
+// IsEOS
+bool captureQueue::IsEOS()
+{
+	return mEOS && (mReady.GetSize() == 0);
+}
+
+
+// Reset
+void captureQueue::Reset()
+{
+	while( dropFront() )
+		;
+
+	// return every slot to the free list in order, including the ones held by consumers
+	uint32_t slot = 0;
+
+	while( mFree.TryPop(&slot) )
+		;
+
+	for( uint32_t n=0; n < mNumSlots; n++ )
+	{
+		mState[n] = SLOT_FREE;
+		mFree.TryPush(n);
+	}
+
+	mFreeEvent.Notify();
+}
+
+
+// GetProduced
+uint64_t captureQueue::GetProduced()
+{
+	return mProduced;
+}
+
+
+// GetConsumed
+uint64_t captureQueue::GetConsumed()
+{
+	return mConsumed;
+}
+
+
+// GetDropped
+uint64_t captureQueue::GetDropped()
+{
+	return mDropped;
+}
+
+
+// GetDepth
+uint32_t captureQueue::GetDepth()
+{
+	return mReady.GetSize();
+}
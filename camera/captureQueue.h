@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CAPTURE_QUEUE_H__
+#define __CAPTURE_QUEUE_H__
+
+#include <stdint.h>
+
+#include "Event.h"
+#include "EventCount.h"
+#include "MPMCQueue.h"
+
+#include "latencyHistogram.h"
+
+
+/**
+ * Enumeration of policies for handing captured frames from the
+ * streaming thread to the consumer.
+ * @see captureQueue
+ * @ingroup camera
+ */
+enum captureQueuePolicy
+{
+	CAPTURE_QUEUE_LATEST,		/**< Only the most recent frame is kept, older unconsumed frames are dropped (default) */
+	CAPTURE_QUEUE_FIFO,			/**< Bounded FIFO that never drops frames, the producer blocks while the queue is full */
+	CAPTURE_QUEUE_DROP_OLDEST	/**< Bounded FIFO that drops the oldest queued frame while the queue is full */
+};
+
+/**
+ * Convert a captureQueuePolicy enum to a string.
+ * @ingroup camera
+ */
+const char* captureQueuePolicyToString( captureQueuePolicy policy );
+
+
+/**
+ * Metadata that travels with each frame through a captureQueue.
+ * The times are from timestamp() in timespec.h.
+ * @ingroup camera
+ */
+struct captureMetadata
+{
+	uint64_t sequence;	/**< Monotonic sequence number, assigned when the frame was queued (gaps mean frames were dropped before being written) */
+	uint64_t pts;		/**< Presentation timestamp from the driver or source in nanoseconds, or UINT64_MAX if unknown */
+	uint64_t dts;		/**< Decode timestamp from the source in nanoseconds, or UINT64_MAX if unknown */
+	timespec enqueued;	/**< Time that the frame was queued by the producer */
+	timespec dequeued;	/**< Time that the frame was retrieved by the consumer */
+};
+
+
+/**
+ * Function pointer typedef that captureQueue calls when a frame that was queued
+ * but never consumed gets dropped, so that the owner can release any resources
+ * attached to that slot.  It's called from the thread that dropped the frame
+ * (usually the producer), and the slot isn't reused until it returns.
+ * @ingroup camera
+ */
+typedef void (*captureQueueDropCallback)( uint32_t slot, void* user_data );
+
+
+/**
+ * Bookkeeping for a ringbuffer of captured frames that gets shared between
+ * a producer (typically the GStreamer streaming thread) and one or more consumers.
+ *
+ * captureQueue doesn't own any memory for the frames itself, it only tracks the
+ * state of each slot in the ringbuffer (free, being written, queued, or held by
+ * a consumer), the order that frames were queued in, their sequence numbers,
+ * and the number of frames that were produced, consumed, and dropped.
+ *
+ * The producer calls BeginWrite() to get a slot to fill, then Commit() to queue it.
+ * The consumer calls Dequeue() to get the next frame, then Release() when done with it.
+ * How frames get dropped when the consumer falls behind depends on the captureQueuePolicy.
+ *
+ * The free and queued slots are kept in lock-free MPMCQueue rings and the waits use
+ * EventCount, so handing off a frame doesn't take a lock, and the producer can't be
+ * held up by a consumer that was preempted in the middle of Dequeue() or Release().
+ *
+ * @ingroup camera
+ */
+class captureQueue
+{
+public:
+	/**
+	 * Constructor
+	 * @param numSlots the number of slots in the ringbuffer (at least 2, and at most MaxSlots)
+	 * @param policy the initial policy to use
+	 */
+	captureQueue( uint32_t numSlots, captureQueuePolicy policy=CAPTURE_QUEUE_LATEST );
+
+	/**
+	 * Destructor
+	 */
+	~captureQueue();
+
+	/**
+	 * Set the policy used for dropping frames.
+	 * If the new policy is CAPTURE_QUEUE_LATEST, all but the most recent queued frame are dropped.
+	 */
+	void SetPolicy( captureQueuePolicy policy );
+
+	/**
+	 * Get the policy used for dropping frames.
+	 */
+	inline captureQueuePolicy GetPolicy() const			{ return mPolicy; }
+
+	/**
+	 * Set a function that gets called when a queued frame is dropped.
+	 * This should be set before the producer is started.
+	 */
+	void SetDropCallback( captureQueueDropCallback callback, void* user_data=NULL );
+
+	/**
+	 * Set an additional event that gets signalled whenever a frame is queued,
+	 * so that one thread can wait on several queues at once (or NULL to disable).
+	 * The event should outlive the captureQueue, or be unset before it's deleted.
+	 */
+	void SetNotifyEvent( Event* event );
+
+	/**
+	 * Acquire a free slot for the producer to write the next frame into.
+	 *
+	 * If no slot is free, then with CAPTURE_QUEUE_FIFO this blocks until the consumer releases one,
+	 * with CAPTURE_QUEUE_DROP_OLDEST the oldest queued frame gets dropped and its slot is reused,
+	 * and with CAPTURE_QUEUE_LATEST the frame is dropped if all of the slots are held by consumers.
+	 *
+	 * @returns the index of the slot to write to, or -1 if the frame should be dropped.
+	 */
+	int BeginWrite();
+
+	/**
+	 * Queue a slot that was filled by the producer, and wake up any waiting consumers.
+	 * @param pts presentation timestamp of the frame in nanoseconds (UINT64_MAX if unknown)
+	 * @param dts decode timestamp of the frame in nanoseconds (UINT64_MAX if unknown)
+	 * @returns the sequence number that was assigned to the frame.
+	 */
+	uint64_t Commit( uint32_t slot, uint64_t pts=UINT64_MAX, uint64_t dts=UINT64_MAX );
+
+	/**
+	 * Hand back a slot from BeginWrite() without queueing it (i.e. if an error occurred).
+	 */
+	void Cancel( uint32_t slot );
+
+	/**
+	 * Hand back a slot from BeginWrite() without queueing it, and count the frame
+	 * as produced and dropped (i.e. if the producer couldn't fill the slot).
+	 */
+	void Drop( uint32_t slot );
+
+	/**
+	 * Retrieve the oldest queued frame, waiting for one to arrive if the queue is empty.
+	 *
+	 * @param timeout The time in milliseconds to wait for a frame to be queued.
+	 *                If timeout is 0, Dequeue() returns immediately if no frame is queued.
+	 *                If timeout is UINT64_MAX, Dequeue() waits indefinitely.
+	 * @param metadata optional pointer that gets filled with the frame's sequence number and timestamps.
+	 *
+	 * @returns the index of the slot that the frame resides in, or -1 on timeout
+	 *          (or right away if the queue is empty after SetEOS() was called).
+	 *          The slot is held by the caller until it's given back with Release().
+	 */
+	int Dequeue( uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+	/**
+	 * Give a slot from Dequeue() back to the producer.
+	 */
+	void Release( uint32_t slot );
+
+	/**
+	 * Check if a slot is currently held by a consumer.
+	 */
+	bool IsAcquired( uint32_t slot );
+
+	/**
+	 * Enable or disable flushing.  While flushing, queued frames are dropped,
+	 * BeginWrite() returns -1 immediately, and a producer that's blocked in
+	 * BeginWrite() is woken up.  This should be enabled before stopping the
+	 * streaming thread, so that it can't get stuck waiting for a free slot.
+	 */
+	void SetFlushing( bool flushing );
+
+	/**
+	 * Mark that the producer has reached the end of the stream and won't queue
+	 * any more frames.  Frames that are already queued can still be dequeued,
+	 * after which Dequeue() returns -1 immediately instead of waiting.
+	 * Consumers that are blocked in Dequeue() are woken up.
+	 */
+	void SetEOS( bool eos=true );
+
+	/**
+	 * Check if the end of the stream was reached and every queued frame was consumed.
+	 */
+	bool IsEOS();
+
+	/**
+	 * Drop any queued frames and return every slot to the producer,
+	 * including slots that are being held by consumers.  This should
+	 * only be called while the producer is stopped.
+	 */
+	void Reset();
+
+	/**
+	 * Get the number of frames that have been received by the producer.  This includes
+	 * the frames that were dropped in BeginWrite() because there was no free slot,
+	 * so that it always equals the number of consumed frames plus dropped frames
+	 * (apart from the frames that are still queued or being written).
+	 */
+	uint64_t GetProduced();
+
+	/**
+	 * Get the number of frames that have been retrieved by consumers.
+	 */
+	uint64_t GetConsumed();
+
+	/**
+	 * Get the number of frames that were dropped, either because they were
+	 * never consumed, or because there was no free slot to store them in.
+	 */
+	uint64_t GetDropped();
+
+	/**
+	 * Get the number of frames that are currently queued.
+	 */
+	uint32_t GetDepth();
+
+	/**
+	 * Get the histogram of the time that frames spent queued (from Commit() to Dequeue()).
+	 */
+	inline latencyHistogram* GetQueueLatency()			{ return &mQueueLatency; }
+
+	/**
+	 * Get the histogram of the time that consumers held frames (from Dequeue() to Release()).
+	 */
+	inline latencyHistogram* GetHoldLatency()			{ return &mHoldLatency; }
+
+	/**
+	 * Get the number of slots in the ringbuffer.
+	 */
+	inline uint32_t GetNumSlots() const					{ return mNumSlots; }
+
+	/**
+	 * The maximum number of slots that a captureQueue can have.
+	 */
+	static const uint32_t MaxSlots = 64;
+
+protected:
+	enum slotState
+	{
+		SLOT_FREE = 0,
+		SLOT_WRITING,
+		SLOT_QUEUED,
+		SLOT_ACQUIRED
+	};
+
+	bool dropFront();	// drop the oldest queued frame, returns false if none were queued
+
+	uint32_t mNumSlots;
+
+	std::atomic<uint32_t> mState[MaxSlots];	// slotState of each slot
+	captureMetadata mMetadata[MaxSlots];
+
+	MPMCQueue<uint32_t> mFree;		// slots the producer can write to, least recently freed first
+	MPMCQueue<uint32_t> mReady;		// queued slots, oldest first
+
+	std::atomic<uint64_t> mProduced;
+	std::atomic<uint64_t> mConsumed;
+	std::atomic<uint64_t> mDropped;
+
+	std::atomic<captureQueuePolicy> mPolicy;
+	captureQueueDropCallback mDropCallback;
+	void* mDropUserData;
+	std::atomic<bool>   mFlushing;
+	std::atomic<bool>   mEOS;
+	std::atomic<Event*> mNotifyEvent;
+
+	latencyHistogram mQueueLatency;
+	latencyHistogram mHoldLatency;
+
+	EventCount mReadyEvent;	// notified when a frame is queued
+	EventCount mFreeEvent;	// notified when a slot becomes free
+};
+
+
+#endif
+
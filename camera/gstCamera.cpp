@@ -48,8 +48,18 @@ const char* gstCameraSrcToString( gstCameraSrc src )
 }
 
 
+// gstCaptureModeToString
+const char* gstCaptureModeToString( gstCaptureMode mode )
+{
+	if( mode == GST_CAPTURE_COPY )			return "GST_CAPTURE_COPY";
+	else if( mode == GST_CAPTURE_SAMPLE )	return "GST_CAPTURE_SAMPLE";
+
+	return "UNKNOWN";
+}
+
+
 // constructor
-gstCamera::gstCamera()
+gstCamera::gstCamera() : mQueue(NUM_RINGBUFFERS), mLayoutMutex("gstCamera::mLayoutMutex")
 {	
 	mAppSink    = NULL;
 	mBus        = NULL;
@@ -63,18 +73,40 @@ gstCamera::gstCamera()
 	mSize   = 0;
 	mSource = GST_SOURCE_NVCAMERA;
 
-	mLatestRGBA       = 0;
-	mLatestRingbuffer = 0;
-	mLatestRetrieved  = false;
+	mCopyAcquired = -1;
+
+	memset(&mLayout, 0, sizeof(cudaVideoLayout));
 	
 	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
 	{
 		mRingbufferCPU[n] = NULL;
 		mRingbufferGPU[n] = NULL;
-		mRGBA[n]          = NULL;
+		mSamples[n]       = NULL;
+
+		mRingbufferSize[n] = 0;
+
+		memset(&mSampleMaps[n], 0, sizeof(GstMapInfo));
+		memset(&mRingLayout[n], 0, sizeof(cudaVideoLayout));
+	}
+
+	for( uint32_t f=0; f < CUDA_OUTPUT_FORMATS; f++ )
+	{
+		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+			mRGBA[f][n] = NULL;
+
+		mLatestRGBA[f]   = 0;
+		mRGBAZeroCopy[f] = false;
 	}
 
-	mRGBAZeroCopy = false;
+	mCaptureMode  = GST_CAPTURE_COPY;
+	mSlotRGBA     = -1;
+	mSampleDeviceAccess = false;
+
+	mStagingCPU  = NULL;
+	mStagingGPU  = NULL;
+	mStagingSize = 0;
+
+	mQueue.SetDropCallback(onDropped, this);
 }
 
 
@@ -82,29 +114,39 @@ gstCamera::gstCamera()
 gstCamera::~gstCamera()
 {
 	Close();
+	gstBusWatchRemove(mPipeline);
+
+	// drop any samples that are still being held
+	mQueue.Reset();
+	mSlotRGBA = -1;
+
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+		releaseSample(n);
+
+	// free staging buffer
+	if( mStagingCPU != NULL )
+	{
+		cudaFreeMapped(mStagingCPU);
+
+		mStagingCPU = NULL;
+		mStagingGPU = NULL;
+	}
 
 	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
 	{
 		// free capture buffer
 		if( mRingbufferCPU[n] != NULL )
 		{
-			CUDA(cudaFreeHost(mRingbufferCPU[n]));
+			cudaFreeMapped(mRingbufferCPU[n]);
 
 			mRingbufferCPU[n] = NULL;
 			mRingbufferGPU[n] = NULL;
 		}
-
-		// free convert buffer
-		if( mRGBA[n] != NULL )
-		{
-			if( mRGBAZeroCopy )
-				CUDA(cudaFreeHost(mRGBA[n]));
-			else
-				CUDA(cudaFree(mRGBA[n]));
-
-			mRGBA[n] = NULL; 
-		}
 	}
+
+	// free convert buffers
+	for( uint32_t f=0; f < CUDA_OUTPUT_FORMATS; f++ )
+		freeRGBA((cudaOutputFormat)f);
 }
 
 
@@ -134,60 +176,236 @@ GstFlowReturn gstCamera::onBuffer(_GstAppSink* sink, void* user_data)
 	gstCamera* dec = (gstCamera*)user_data;
 	
 	dec->checkBuffer();
-	dec->checkMsgBus();
 	return GST_FLOW_OK;
 }
 	
 
 // Capture
-bool gstCamera::Capture( void** cpu, void** cuda, uint64_t timeout )
+bool gstCamera::Capture( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
+{
+	// in copy mode, the previous frame is implicitly released
+	if( mCaptureMode == GST_CAPTURE_COPY )
+	{
+		const int previous = mCopyAcquired.exchange(-1);
+
+		if( previous >= 0 )
+			mQueue.Release(previous);
+	}
+
+	const int slot = acquire(cpu, cuda, timeout, metadata);
+
+	if( slot < 0 )
+		return false;
+
+	if( mCaptureMode == GST_CAPTURE_COPY )
+		mCopyAcquired = slot;
+
+	return true;
+}
+
+
+// Acquire
+bool gstCamera::Acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
+{
+	return (acquire(cpu, cuda, timeout, metadata) >= 0);
+}
+
+
+// acquire
+int gstCamera::acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
 {
 	// confirm the camera is streaming
 	if( !mStreaming )
 	{
 		if( !Open() )
-			return false;
+			return -1;
 	}
 
-	// wait until a new frame is recieved
-	if( !mWaitEvent.Wait(timeout) )
-		return false;
-	
-	// get the latest ringbuffer
-	mRingMutex.Lock();
-	const uint32_t latest = mLatestRingbuffer;
-	const bool retrieved = mLatestRetrieved;
-	mLatestRetrieved = true;
-	mRingMutex.Unlock();
-	
-	// skip if it was already retrieved
-	if( retrieved )
-		return false;
+	// wait until a frame is queued
+	const int slot = mQueue.Dequeue(timeout, metadata);
+
+	if( slot < 0 )
+		return -1;
 	
+	// in sample mode, hand out views of the mapped GstBuffer
+	if( mCaptureMode == GST_CAPTURE_SAMPLE )
+	{
+		void* data = mSampleMaps[slot].data;
+
+		if( cpu != NULL )
+			*cpu = data;
+
+		if( cuda != NULL )
+			*cuda = mSampleDeviceAccess ? data : NULL;
+
+		return slot;
+	}
+
 	// set output pointers
 	if( cpu != NULL )
-		*cpu = mRingbufferCPU[latest];
+		*cpu = mRingbufferCPU[slot];
 	
 	if( cuda != NULL )
-		*cuda = mRingbufferGPU[latest];
+		*cuda = mRingbufferGPU[slot];
 	
+	return slot;
+}
+
+
+// Release
+void gstCamera::Release( void* image )
+{
+	if( !image )
+		return;
+
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		if( !mQueue.IsAcquired(n) )
+			continue;
+
+		if( mCaptureMode == GST_CAPTURE_SAMPLE )
+		{
+			if( mSampleMaps[n].data != image )
+				continue;
+		}
+		else if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+		{
+			continue;
+		}
+
+		release(n);
+		break;
+	}
+}
+
+
+// release
+void gstCamera::release( uint32_t slot )
+{
+	if( mCaptureMode == GST_CAPTURE_SAMPLE )
+	{
+		releaseSample(slot);
+	}
+	else
+	{
+		int acquired = slot;
+		mCopyAcquired.compare_exchange_strong(acquired, -1);
+	}
+
+	mQueue.Release(slot);
+}
+
+
+// SetCaptureMode
+bool gstCamera::SetCaptureMode( gstCaptureMode mode )
+{
+	if( mode == mCaptureMode )
+		return true;
+
+	if( mStreaming )
+	{
+		printf(LOG_GSTREAMER "gstCamera -- the capture mode can't be changed while the camera is streaming\n");
+		return false;
+	}
+
+	mQueue.Reset();
+
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+		releaseSample(n);
+
+	mCopyAcquired = -1;
+	mSlotRGBA     = -1;
+	mCaptureMode  = mode;
+
+	printf(LOG_GSTREAMER "gstCamera -- capture mode set to %s\n", gstCaptureModeToString(mode));
 	return true;
 }
 
 
+// SetQueuePolicy
+void gstCamera::SetQueuePolicy( captureQueuePolicy policy )
+{
+	mQueue.SetPolicy(policy);
+	printf(LOG_GSTREAMER "gstCamera -- queue policy set to %s\n", captureQueuePolicyToString(policy));
+}
+
+
 // CaptureRGBA
 bool gstCamera::CaptureRGBA( float** output, unsigned long timeout, bool zeroCopy )
+{
+	return CaptureRGBA((void**)output, CUDA_OUTPUT_RGBA32, timeout, zeroCopy);
+}
+
+
+// CaptureRGBA
+bool gstCamera::CaptureRGBA( void** output, cudaOutputFormat format, unsigned long timeout, bool zeroCopy )
 {
 	void* cpu = NULL;
 	void* gpu = NULL;
 
-	if( !Capture(&cpu, &gpu, timeout) )
+	// in sample mode, keep the slot so the frame can be released without searching for it
+	int slot = -1;
+
+	if( mCaptureMode == GST_CAPTURE_SAMPLE )
+		slot = acquire(&cpu, &gpu, timeout, NULL);
+	else if( Capture(&cpu, &gpu, timeout) )
+		slot = mCopyAcquired;
+
+	if( slot < 0 )
 	{
 		printf(LOG_GSTREAMER "gstCamera failed to capture frame\n");
 		return false;
 	}
 
-	if( !ConvertRGBA(gpu, output, zeroCopy) )
+	// in sample mode, the GPU might not be able to read the buffer directly,
+	// in which case it gets copied to a staging buffer in mapped memory first
+	if( mCaptureMode == GST_CAPTURE_SAMPLE )
+	{
+		if( !gpu )
+		{
+			if( mStagingSize < mSize )
+			{
+				if( mStagingCPU != NULL )
+					cudaFreeMapped(mStagingCPU);
+
+				mStagingCPU  = NULL;
+				mStagingGPU  = NULL;
+				mStagingSize = 0;
+
+				if( !cudaAllocMapped(&mStagingCPU, &mStagingGPU, mSize, CUDA_MEMORY_CAMERA, false) )
+				{
+					printf(LOG_GSTREAMER "gstCamera -- failed to allocate %u bytes for sample staging buffer\n", mSize);
+					release(slot);
+					return false;
+				}
+
+				mStagingSize = mSize;
+			}
+
+			// the conversion of the previous frame may still be reading from the staging buffer
+			CUDA(cudaStreamSynchronize(NULL));
+
+			memcpy(mStagingCPU, cpu, mSize);
+			gpu = mStagingGPU;
+			release(slot);
+		}
+		else
+		{
+			// the GPU reads the sample asynchronously, so the slot (and the mapping of its buffer)
+			// is held until the next call, which waits for that conversion before releasing it
+			const int previous = mSlotRGBA.exchange(slot);
+
+			if( previous >= 0 )
+			{
+				CUDA(cudaStreamSynchronize(NULL));
+				release(previous);
+			}
+		}
+	}
+
+	const bool result = ConvertRGBA(gpu, output, format, zeroCopy);
+
+	if( !result )
 	{
 		printf(LOG_GSTREAMER "gstCamera failed to convert frame to RGBA\n");
 		return false;
@@ -199,86 +417,177 @@ bool gstCamera::CaptureRGBA( float** output, unsigned long timeout, bool zeroCop
 
 // ConvertRGBA
 bool gstCamera::ConvertRGBA( void* input, float** output, bool zeroCopy )
+{
+	return ConvertRGBA(input, (void**)output, CUDA_OUTPUT_RGBA32, zeroCopy);
+}
+
+
+// ConvertRGBA
+bool gstCamera::ConvertRGBA( void* input, void** output, cudaOutputFormat format, bool zeroCopy )
 {
 	if( !input || !output )
 		return false;
-	
+
+	if( format < 0 || format >= CUDA_OUTPUT_FORMATS )
+	{
+		printf(LOG_GSTREAMER "gstCamera -- invalid output format (%i)\n", (int)format);
+		return false;
+	}
+
 	// check if the buffers were previously allocated with a different zeroCopy option
 	// if necessary, free them so they can be re-allocated with the correct option
-	if( mRGBA[0] != NULL && zeroCopy != mRGBAZeroCopy )
-	{
-		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
-		{
-			if( mRGBA[n] != NULL )
-			{
-				if( mRGBAZeroCopy )
-					CUDA(cudaFreeHost(mRGBA[n]));
-				else
-					CUDA(cudaFree(mRGBA[n]));
+	if( mRGBA[format][0] != NULL && zeroCopy != mRGBAZeroCopy[format] )
+		freeRGBA(format);
 
-				mRGBA[n] = NULL; 
-			}
-		}
+	// check if the buffers need allocated
+	if( !mRGBA[format][0] && !allocRGBA(format, zeroCopy) )
+		return false;
+	
+	void* rgba = mRGBA[format][mLatestRGBA[format]];
+
+	// use the layout that the frame was captured with, or the latest one
+	// if the frame came from elsewhere (i.e. the sample staging buffer)
+	cudaVideoLayout layout;
+
+	if( !findLayout(input, &layout) )
+		layout = GetLayout();
 
-		mRGBAZeroCopy = false;	// reset for sanity
+	if( layout.format != CUDA_VIDEO_UNKNOWN )
+	{
+		if( CUDA_FAILED(cudaVideoConvert(input, layout, rgba, format)) )
+			return false;
 	}
+	else if( format != CUDA_OUTPUT_RGBA32 )
+	{
+		// MIPI CSI camera is NV12, V4L2 webcam is RGB
+		cudaVideoLayoutPacked(&layout, csiCamera() ? CUDA_VIDEO_NV12 : CUDA_VIDEO_RGB, mWidth, mHeight);
 
-	// check if the buffers need allocated
-	if( !mRGBA[0] )
+		if( CUDA_FAILED(cudaVideoConvert(input, layout, rgba, format)) )
+			return false;
+	}
+	else if( csiCamera() )
 	{
-		const size_t size = mWidth * mHeight * sizeof(float4);
+		// MIPI CSI camera is NV12
+		if( CUDA_FAILED(cudaNV12ToRGBA32((uint8_t*)input, (float4*)rgba, mWidth, mHeight)) )
+			return false;
+	}
+	else
+	{
+		// V4L2 webcam is RGB
+		if( CUDA_FAILED(cudaRGB8ToRGBA32((uchar3*)input, (float4*)rgba, mWidth, mHeight)) )
+			return false;
+	}
+	
+	*output = rgba;
+	mLatestRGBA[format] = (mLatestRGBA[format] + 1) % NUM_RINGBUFFERS;
+	return true;
+}
 
-		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
-		{
-			if( zeroCopy )
-			{
-				void* cpuPtr = NULL;
-				void* gpuPtr = NULL;
 
-				if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size) )
-				{
-					printf(LOG_GSTREAMER "gstCamera -- failed to allocate zeroCopy memory for %ux%xu RGBA texture\n", mWidth, mHeight);
-					return false;
-				}
+// allocRGBA
+bool gstCamera::allocRGBA( cudaOutputFormat format, bool zeroCopy )
+{
+	const size_t size = mWidth * mHeight * cudaOutputFormatSize(format);
 
-				if( cpuPtr != gpuPtr )
-				{
-					printf(LOG_GSTREAMER "gstCamera -- zeroCopy memory has different pointers, please use a UVA-compatible GPU\n");
-					return false;
-				}
+	mRGBAZeroCopy[format] = zeroCopy;	// so freeRGBA() can clean up after a failure
 
-				mRGBA[n] = gpuPtr;
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		if( zeroCopy )
+		{
+			void* cpuPtr = NULL;
+			void* gpuPtr = NULL;
+
+			if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, CUDA_MEMORY_CAMERA, false) )
+			{
+				printf(LOG_GSTREAMER "gstCamera -- failed to allocate zeroCopy memory for %ux%u %s texture\n", mWidth, mHeight, cudaOutputFormatToString(format));
+				freeRGBA(format);
+				return false;
 			}
-			else
+
+			if( cpuPtr != gpuPtr )
 			{
-				if( CUDA_FAILED(cudaMalloc(&mRGBA[n], size)) )
-				{
-					printf(LOG_GSTREAMER "gstCamera -- failed to allocate memory for %ux%u RGBA texture\n", mWidth, mHeight);
-					return false;
-				}
+				printf(LOG_GSTREAMER "gstCamera -- zeroCopy memory has different pointers, please use a UVA-compatible GPU\n");
+				cudaFreeMapped(cpuPtr);
+				freeRGBA(format);
+				return false;
+			}
+
+			mRGBA[format][n] = gpuPtr;
+		}
+		else
+		{
+			if( CUDA_FAILED(cudaMalloc(&mRGBA[format][n], size)) )
+			{
+				printf(LOG_GSTREAMER "gstCamera -- failed to allocate memory for %ux%u %s texture\n", mWidth, mHeight, cudaOutputFormatToString(format));
+				mRGBA[format][n] = NULL;
+				freeRGBA(format);
+				return false;
 			}
 		}
-		
-		printf(LOG_GSTREAMER "gstCamera -- allocated %u RGBA ringbuffers\n", NUM_RINGBUFFERS);
-		mRGBAZeroCopy = zeroCopy;
 	}
 	
-	if( csiCamera() )
+	printf(LOG_GSTREAMER "gstCamera -- allocated %u %s ringbuffers (%zu bytes each)\n", NUM_RINGBUFFERS, cudaOutputFormatToString(format), size);
+
+	mLatestRGBA[format] = 0;
+	return true;
+}
+
+
+// freeRGBA
+void gstCamera::freeRGBA( cudaOutputFormat format )
+{
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
 	{
-		// MIPI CSI camera is NV12
-		if( CUDA_FAILED(cudaNV12ToRGBA32((uint8_t*)input, (float4*)mRGBA[mLatestRGBA], mWidth, mHeight)) )
-			return false;
+		if( mRGBA[format][n] != NULL )
+		{
+			if( mRGBAZeroCopy[format] )
+				cudaFreeMapped(mRGBA[format][n]);
+			else
+				CUDA(cudaFree(mRGBA[format][n]));
+
+			mRGBA[format][n] = NULL; 
+		}
 	}
-	else
+
+	mRGBAZeroCopy[format] = false;	// reset for sanity
+}
+
+
+// GetLayout
+cudaVideoLayout gstCamera::GetLayout()
+{
+	mLayoutMutex.Lock();
+	const cudaVideoLayout layout = mLayout;
+	mLayoutMutex.Unlock();
+	return layout;
+}
+
+
+// findLayout
+bool gstCamera::findLayout( void* image, cudaVideoLayout* layout )
+{
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
 	{
-		// V4L2 webcam is RGB
-		if( CUDA_FAILED(cudaRGB8ToRGBA32((uchar3*)input, (float4*)mRGBA[mLatestRGBA], mWidth, mHeight)) )
-			return false;
+		if( !mQueue.IsAcquired(n) )
+			continue;
+
+		if( mCaptureMode == GST_CAPTURE_SAMPLE )
+		{
+			if( mSampleMaps[n].data != image )
+				continue;
+		}
+		else if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+		{
+			continue;
+		}
+
+		// the slot is only written while it's free, so this is stable while it's held
+		*layout = mRingLayout[n];
+		return true;
 	}
-	
-	*output     = (float*)mRGBA[mLatestRGBA];
-	mLatestRGBA = (mLatestRGBA + 1) % NUM_RINGBUFFERS;
-	return true;
+
+	return false;
 }
 
 
@@ -337,63 +646,158 @@ void gstCamera::checkBuffer()
 		release_return;
 	}
 	
-	GstStructure* gstCapsStruct = gst_caps_get_structure(gstCaps, 0);
-	
-	if( !gstCapsStruct )
+	// get the format, dimensions and plane layout of the buffer
+	// (the depth comes from the format, because the size includes any row padding)
+	cudaVideoLayout layout;
+
+	if( !gst_video_layout(gstCaps, gstBuffer, &layout) )
 	{
-		printf(LOG_GSTREAMER "gstCamera -- gst_caps had NULL structure...\n");
+		printf(LOG_GSTREAMER "gstCamera -- gst_caps aren't raw video...\n");
+		gst_buffer_unmap(gstBuffer, &map);
 		release_return;
 	}
 	
-	// get width & height of the buffer
-	int width  = 0;
-	int height = 0;
-	
-	if( !gst_structure_get_int(gstCapsStruct, "width", &width) ||
-		!gst_structure_get_int(gstCapsStruct, "height", &height) )
+	if( layout.width < 1 || layout.height < 1 )
 	{
-		printf(LOG_GSTREAMER "gstCamera -- gst_caps missing width/height...\n");
+		gst_buffer_unmap(gstBuffer, &map);
 		release_return;
 	}
 	
-	if( width < 1 || height < 1 )
-		release_return;
-	
-	mWidth  = width;
-	mHeight = height;
-	mDepth  = (gstSize * 8) / (width * height);
+	mWidth  = layout.width;
+	mHeight = layout.height;
+	mDepth  = cudaVideoFormatDepth(layout.format);
 	mSize   = gstSize;
+
+	if( mDepth == 0 )
+		mDepth = (gstSize * 8) / (mWidth * mHeight);
+
+	// this is the only thread that writes mLayout, so it can be compared without the lock
+	if( memcmp(&layout, &mLayout, sizeof(cudaVideoLayout)) != 0 )
+	{
+		mLayoutMutex.Lock();
+		mLayout = layout;
+		mLayoutMutex.Unlock();
+	}
 	
 	//printf(LOG_GSTREAMER "gstCamera recieved %ix%i frame (%u bytes, %u bpp)\n", width, height, gstSize, mDepth);
 	
-	// make sure ringbuffer is allocated
-	if( !mRingbufferCPU[0] )
+	// measure the latency since the frame was timestamped
+	const uint64_t latency = gst_buffer_latency(mPipeline, gstBuffer);
+
+	if( latency != UINT64_MAX )
+		mPipelineLatency.Add(latency);
+	
+	// in sample mode, the ringbuffer holds the sample itself instead of a copy
+	if( mCaptureMode == GST_CAPTURE_SAMPLE )
 	{
-		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+		checkSample(gstSample, gstBuffer, map, layout);
+		return;
+	}
+
+	// get the next free ringbuffer (this may block in CAPTURE_QUEUE_FIFO mode)
+	const int nextRingbuffer = mQueue.BeginWrite();
+
+	if( nextRingbuffer < 0 )
+	{
+		gst_buffer_unmap(gstBuffer, &map);
+		release_return;
+	}
+	
+	// the slot isn't held by a consumer while it's being written, so it can be (re)allocated
+	// here for the first frame, or for a larger frame after the caps were renegotiated
+	if( gstSize > mRingbufferSize[nextRingbuffer] )
+	{
+		if( mRingbufferCPU[nextRingbuffer] != NULL )
+			cudaFreeMapped(mRingbufferCPU[nextRingbuffer]);
+
+		mRingbufferCPU[nextRingbuffer]  = NULL;
+		mRingbufferGPU[nextRingbuffer]  = NULL;
+		mRingbufferSize[nextRingbuffer] = 0;
+
+		if( !cudaAllocMapped(&mRingbufferCPU[nextRingbuffer], &mRingbufferGPU[nextRingbuffer], gstSize, CUDA_MEMORY_CAMERA, false) )
 		{
-			if( !cudaAllocMapped(&mRingbufferCPU[n], &mRingbufferGPU[n], gstSize) )
-				printf(LOG_GSTREAMER "gstCamera -- failed to allocate ringbuffer %u  (size=%u)\n", n, gstSize);
+			printf(LOG_GSTREAMER "gstCamera -- failed to allocate ringbuffer %i  (size=%u)\n", nextRingbuffer, gstSize);
+			gst_buffer_unmap(gstBuffer, &map);
+			mQueue.Drop(nextRingbuffer);
+			release_return;
 		}
-		
-		printf(LOG_GSTREAMER "gstCamera -- allocated %u ringbuffers, %u bytes each\n", NUM_RINGBUFFERS, gstSize);
+
+		mRingbufferSize[nextRingbuffer] = gstSize;
 	}
-	
-	// copy to next ringbuffer
-	const uint32_t nextRingbuffer = (mLatestRingbuffer + 1) % NUM_RINGBUFFERS;		
-	
+
 	//printf(LOG_GSTREAMER "gstCamera -- using ringbuffer #%u for next frame\n", nextRingbuffer);
 	memcpy(mRingbufferCPU[nextRingbuffer], gstData, gstSize);
+	mRingLayout[nextRingbuffer] = layout;
+
+	const uint64_t pts = GST_BUFFER_PTS_IS_VALID(gstBuffer) ? GST_BUFFER_PTS(gstBuffer) : UINT64_MAX;
+	const uint64_t dts = GST_BUFFER_DTS_IS_VALID(gstBuffer) ? GST_BUFFER_DTS(gstBuffer) : UINT64_MAX;
+
 	gst_buffer_unmap(gstBuffer, &map); 
 	//gst_buffer_unref(gstBuffer);
 	gst_sample_unref(gstSample);
 	
-	
-	// update and signal sleeping threads
-	mRingMutex.Lock();
-	mLatestRingbuffer = nextRingbuffer;
-	mLatestRetrieved  = false;
-	mRingMutex.Unlock();
-	mWaitEvent.Wake();
+	// queue the frame and signal sleeping threads
+	mQueue.Commit(nextRingbuffer, pts, dts);
+}
+
+
+// checkSample
+void gstCamera::checkSample( GstSample* gstSample, GstBuffer* gstBuffer, const GstMapInfo& map, const cudaVideoLayout& layout )
+{
+	// get the next free slot (this may block in CAPTURE_QUEUE_FIFO mode)
+	const int nextRingbuffer = mQueue.BeginWrite();
+
+	if( nextRingbuffer < 0 )
+	{
+		GstMapInfo unmap = map;
+		gst_buffer_unmap(gstBuffer, &unmap);
+		gst_sample_unref(gstSample);
+		return;
+	}
+
+	// take ownership of the mapping and the sample reference
+	releaseSample(nextRingbuffer);
+
+	mSamples[nextRingbuffer]    = gstSample;
+	mSampleMaps[nextRingbuffer] = map;
+	mRingLayout[nextRingbuffer] = layout;
+
+	// queue the frame and signal sleeping threads
+	mQueue.Commit(nextRingbuffer, GST_BUFFER_PTS_IS_VALID(gstBuffer) ? GST_BUFFER_PTS(gstBuffer) : UINT64_MAX,
+							GST_BUFFER_DTS_IS_VALID(gstBuffer) ? GST_BUFFER_DTS(gstBuffer) : UINT64_MAX);
+}
+
+
+// releaseSample
+void gstCamera::releaseSample( uint32_t slot )
+{
+	if( slot >= NUM_RINGBUFFERS || !mSamples[slot] )
+		return;
+
+	GstBuffer* gstBuffer = gst_sample_get_buffer(mSamples[slot]);
+
+	if( gstBuffer != NULL )
+		gst_buffer_unmap(gstBuffer, &mSampleMaps[slot]);
+
+	gst_sample_unref(mSamples[slot]);
+
+	mSamples[slot] = NULL;
+	memset(&mSampleMaps[slot], 0, sizeof(GstMapInfo));
+}
+
+
+// onDropped
+void gstCamera::onDropped( uint32_t slot, void* user_data )
+{
+	if( !user_data )
+		return;
+
+	// frames that were never captured get dropped by the queue, so
+	// release their samples right away to keep upstream pools from starving
+	gstCamera* cam = (gstCamera*)user_data;
+
+	if( cam->mCaptureMode == GST_CAPTURE_SAMPLE )
+		cam->releaseSample(slot);
 }
 
 
@@ -523,6 +927,14 @@ gstCamera* gstCamera::Create( uint32_t width, uint32_t height, const char* camer
 		}
 	}
 	
+	// check if the GPU can read pageable memory, which GST_CAPTURE_SAMPLE mode needs
+	// in order to return CUDA pointers to the sample memory without staging it first
+	int device = 0;
+	int pageableAccess = 0;
+
+	if( cudaGetDevice(&device) == cudaSuccess && cudaDeviceGetAttribute(&pageableAccess, cudaDevAttrPageableMemoryAccess, device) == cudaSuccess )
+		cam->mSampleDeviceAccess = (pageableAccess != 0);
+
 	printf(LOG_GSTREAMER "gstCamera successfully initialized with %s, camera %s\n", gstCameraSrcToString(cam->mSource), cam->mCameraStr.c_str()); 
 	return cam;
 }
@@ -576,8 +988,14 @@ bool gstCamera::init( gstCameraSrc src )
 		return false;
 	}
 
-	// add watch for messages (disabled when we poll the bus ourselves, instead of gmainloop)
-	//gst_bus_add_watch(mBus, (GstBusFunc)gst_message_print, NULL);
+	// handle messages from the bus thread, instead of polling from the streaming thread
+	gstBusCallbacks busCallbacks;
+	memset(&busCallbacks, 0, sizeof(gstBusCallbacks));
+
+	busCallbacks.error = onBusError;
+
+	if( !gstBusWatchAdd(mPipeline, &busCallbacks, this) )
+		return false;
 
 	// get the appsrc
 	GstElement* appsinkElement = gst_bin_get_by_name(GST_BIN(pipeline), "mysink");
@@ -614,6 +1032,9 @@ bool gstCamera::Open()
 	// transition pipline to STATE_PLAYING
 	printf(LOG_GSTREAMER "opening gstCamera for streaming, transitioning pipeline to GST_STATE_PLAYING\n");
 	
+	mQueue.SetEOS(false);
+	mQueue.SetFlushing(false);
+	
 	const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_PLAYING);
 
 	if( result == GST_STATE_CHANGE_ASYNC )
@@ -637,9 +1058,7 @@ bool gstCamera::Open()
 		return false;
 	}
 
-	checkMsgBus();
 	usleep(100*1000);
-	checkMsgBus();
 
 	mStreaming = true;
 	return true;
@@ -655,6 +1074,9 @@ void gstCamera::Close()
 	// stop pipeline
 	printf(LOG_GSTREAMER "closing gstCamera for streaming, transitioning pipeline to GST_STATE_NULL\n");
 
+	// unblock the streaming thread if it's waiting for a free slot
+	mQueue.SetFlushing(true);
+
 	const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_NULL);
 
 	if( result != GST_STATE_CHANGE_SUCCESS )
@@ -665,18 +1087,14 @@ void gstCamera::Close()
 }
 
 
-// checkMsgBus
-void gstCamera::checkMsgBus()
+// onBusError
+void gstCamera::onBusError( const char* source, const char* message, void* user_data )
 {
-	while(true)
-	{
-		GstMessage* msg = gst_bus_pop(mBus);
-
-		if( !msg )
-			break;
+	if( !user_data )
+		return;
 
-		gst_message_print(mBus, msg, this);
-		gst_message_unref(msg);
-	}
+	// the pipeline has stopped, so wake up consumers instead of letting them wait for frames
+	gstCamera* cam = (gstCamera*)user_data;
+	cam->mQueue.SetEOS(true);
 }
 
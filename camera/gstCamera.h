@@ -29,6 +29,9 @@
 #include "Mutex.h"
 #include "Event.h"
 
+#include "captureQueue.h"
+#include "cudaVideoFormat.h"
+
 
 // Forward declarations
 struct _GstAppSink;
@@ -52,6 +55,24 @@ enum gstCameraSrc
 const char* gstCameraSrcToString( gstCameraSrc src );	
 
 
+/**
+ * Enumeration of the memory modes that gstCamera can capture frames with.
+ * @see gstCamera::SetCaptureMode()
+ * @ingroup gstCamera
+ */
+enum gstCaptureMode
+{
+	GST_CAPTURE_COPY,		/* copy each frame into a CUDA mapped ringbuffer (default) */
+	GST_CAPTURE_SAMPLE		/* hold a reference to the GstSample and return views into its mapped memory */
+};
+
+/**
+ * Stringize function to convert gstCaptureMode enum to text
+ * @ingroup gstCamera
+ */
+const char* gstCaptureModeToString( gstCaptureMode mode );
+
+
 /**
  * MIPI CSI and V4L2 camera capture using GStreamer and `nvarguscamerasrc` or `v4l2src` elements.
  * gstCamera supports both MIPI CSI cameras and V4L2-compliant devices like USB webcams.
@@ -155,6 +176,9 @@ public:
 	 * mapped memory or zero-copy memory.  Hence it is unnessary to copy them to GPU.
 	 * This memory is managed internally by gstCamera, so don't attempt to free it.
 	 *
+	 * Which frame gets returned depends on the queue policy (see SetQueuePolicy()).
+	 * By default only the most recent frame is kept, and each frame is returned once.
+	 *
 	 * @param[out] cpu Pointer that gets returned to the image in CPU address space.
 	 * @param[out] cuda Pointer that gets returned to the image in GPU address space.
 	 *
@@ -165,10 +189,131 @@ public:
 	 *                    If timeout is UINT64_MAX, the calling thread will wait
 	 *                    indefinetly for a new frame to arrive (this is the default behavior).
 	 *
+	 * @param[out] metadata Optional pointer that gets filled with the frame's sequence number,
+	 *                      buffer PTS/DTS, and the times that it was queued and captured.
+	 *                      Sequence numbers start at 0 and increase by one for each frame that
+	 *                      the camera produced, so a gap between them indicates dropped frames.
+	 *
 	 * @returns `true` if a frame was successfully captured, otherwise `false` if a timeout
 	 *               or error occurred, or if timeout was 0 and a frame wasn't ready.
+	 *
+	 * @note when the camera is using GST_CAPTURE_SAMPLE mode, the returned pointers are
+	 *       views into the memory of the GStreamer buffer itself, and they remain valid
+	 *       until the frame is handed back with Release().  In this mode the `cuda` pointer
+	 *       is only set if the GPU can access pageable host memory, otherwise it's NULL.
+	 *       In GST_CAPTURE_COPY mode, the frame is released automatically by the next call
+	 *       to Capture() if it wasn't already released.
+	 */
+	bool Capture( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+	/**
+	 * Capture a frame like Capture() does, except that the previous frame is never released
+	 * implicitly, even in GST_CAPTURE_COPY mode.  Each frame stays valid until it's passed to
+	 * Release(), so several of them can be held at once (i.e. by a captureGroup).
+	 */
+	bool Acquire( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+	/**
+	 * Release a frame that was previously returned by Capture() or Acquire().
+	 *
+	 * In GST_CAPTURE_SAMPLE mode, this drops the reference to the underlying GstSample
+	 * so that GStreamer can recycle the buffer.  Each frame returned by Capture() should
+	 * be released once, after the caller has finished reading from it.  Frames that 
+	 * aren't released will keep occupying ringbuffer slots, and once all slots are
+	 * held new frames from the camera will be dropped.
+	 *
+	 * In GST_CAPTURE_COPY mode, this hands the ringbuffer slot back so that it can be
+	 * reused for new frames.  Calling it is optional in this mode, because the next
+	 * call to Capture() releases the previous frame anyway.
+	 *
+	 * @param image Either the CPU or CUDA pointer that was returned by Capture().
+	 */
+	void Release( void* image );
+
+	/**
+	 * Set the memory mode that frames are captured with (the default is GST_CAPTURE_COPY).
+	 *
+	 * With GST_CAPTURE_COPY, each frame is copied into a CUDA mapped ringbuffer that is
+	 * accessible from both CPU and GPU.  With GST_CAPTURE_SAMPLE, the memcpy is skipped
+	 * entirely and Capture() returns views into the GStreamer buffers, which is cheaper
+	 * for consumers that only read the frames on the CPU.
+	 *
+	 * The capture mode can only be changed while the camera isn't streaming.
+	 *
+	 * @returns `true` on success, or `false` if the camera is currently streaming.
+	 */
+	bool SetCaptureMode( gstCaptureMode mode );
+
+	/**
+	 * Retrieve the memory mode that frames are being captured with.
+	 */
+	inline gstCaptureMode GetCaptureMode() const	{ return mCaptureMode; }
+
+	/**
+	 * Set the policy for queueing frames when the consumer falls behind the camera.
+	 *
+	 * With CAPTURE_QUEUE_LATEST (the default), only the most recent frame is kept.
+	 * With CAPTURE_QUEUE_FIFO, frames are never dropped while they're unconsumed,
+	 * and instead the GStreamer pipeline is stalled until the consumer catches up.
+	 * With CAPTURE_QUEUE_DROP_OLDEST, up to NUM_RINGBUFFERS frames are queued, and
+	 * the oldest one gets dropped when a new frame arrives while the queue is full.
+	 *
+	 * The policy can be changed at any time.
+	 */
+	void SetQueuePolicy( captureQueuePolicy policy );
+
+	/**
+	 * Retrieve the policy for queueing frames.
+	 */
+	inline captureQueuePolicy GetQueuePolicy() const	{ return mQueue.GetPolicy(); }
+
+	/**
+	 * Return the number of frames that have been received from the camera.
 	 */
-	bool Capture( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX );
+	inline uint64_t GetFramesProduced()			{ return mQueue.GetProduced(); }
+
+	/**
+	 * Return the number of frames that have been retrieved with Capture().
+	 */
+	inline uint64_t GetFramesConsumed()			{ return mQueue.GetConsumed(); }
+
+	/**
+	 * Return the number of frames that were dropped, either because they were
+	 * superseded by newer frames before being captured, or because there wasn't
+	 * a free ringbuffer slot to store them in.
+	 */
+	inline uint64_t GetFramesDropped()			{ return mQueue.GetDropped(); }
+
+	/**
+	 * Return the number of frames that are waiting to be captured.
+	 */
+	inline uint32_t GetQueueDepth()				{ return mQueue.GetDepth(); }
+
+	/**
+	 * Set an event that gets signalled whenever a new frame is queued, in addition
+	 * to waking threads blocked in Capture().  This lets one thread wait on several
+	 * cameras at once, and then poll them with Capture() using a timeout of 0.
+	 * @see captureGroup
+	 */
+	inline void SetNotifyEvent( Event* event )		{ mQueue.SetNotifyEvent(event); }
+
+	/**
+	 * Return the histogram of the latency from when the sensor/driver timestamped
+	 * each frame to when it arrived at the appsink (measured from the buffer PTS).
+	 */
+	inline latencyHistogram* GetPipelineLatency()	{ return &mPipelineLatency; }
+
+	/**
+	 * Return the histogram of the time that frames waited in the queue
+	 * between arriving at the appsink and being retrieved by Capture().
+	 */
+	inline latencyHistogram* GetQueueLatency()		{ return mQueue.GetQueueLatency(); }
+
+	/**
+	 * Return the histogram of the time that the consumer held frames,
+	 * from Capture() until Release() (or the next Capture() in GST_CAPTURE_COPY mode).
+	 */
+	inline latencyHistogram* GetHoldLatency()		{ return mQueue.GetHoldLatency(); }
 
 	/**
 	 * Capture the next image frame from the camera and convert it to float4 RGBA format,
@@ -178,6 +323,9 @@ public:
 	 * The ConvertRGBA() function uses CUDA, so if you want to capture from a different 
 	 * thread than your CUDA device, use the Capture() and ConvertRGBA() functions.
 	 *
+	 * In GST_CAPTURE_SAMPLE mode, the GPU may still be reading the sample after this returns,
+	 * so it stays acquired (and mapped) until the next call to CaptureRGBA().
+	 *
 	 * @param[out] image Pointer that gets returned to the image in GPU address space,
 	 *                   or if the zeroCopy parameter is true, then the pointer is valid
 	 *                   in both CPU and GPU address spaces.  Do not manually free the image memory, 
@@ -201,6 +349,20 @@ public:
 	 *               or error occurred, or if timeout was 0 and a frame wasn't ready.
 	 */
 	bool CaptureRGBA( float** image, uint64_t timeout=UINT64_MAX, bool zeroCopy=false );
+
+	/**
+	 * Capture the next image frame from the camera and convert it to the specified format.
+	 * This is the same as CaptureRGBA() above, except that the frame can be converted directly
+	 * to an 8-bit format like CUDA_OUTPUT_RGBA8 or CUDA_OUTPUT_GRAY8 (see cudaOutputFormat).
+	 *
+	 * Each output format has its own ringbuffer, which gets allocated the first time that
+	 * the format is requested.  The size of the image is:
+	 *   `GetWidth() * GetHeight() * cudaOutputFormatSize(format)`
+	 *
+	 * @returns `true` if a frame was successfully captured, otherwise `false` if a timeout
+	 *               or error occurred, or if timeout was 0 and a frame wasn't ready.
+	 */
+	bool CaptureRGBA( void** image, cudaOutputFormat format, uint64_t timeout=UINT64_MAX, bool zeroCopy=false );
 	
 	/**
 	 * Convert an image to float4 RGBA that was previously aquired with Capture().
@@ -211,6 +373,8 @@ public:
 	 *                  If this is a MIPI CSI camera, it's expected to be in YUV (NV12) format.
 	 *                  If this is a V4L2 device, it's expected to be in RGB (24-bit) format.
 	 *                  In both cases, these are the formats that Capture() provides the image in.
+	 *                  The conversion reads the planes with the offsets and strides that were
+	 *                  negotiated for the frame (see GetLayout()), so padded rows are supported.
 	 *
 	 * @param[out] output Pointer that gets returned to the image in GPU address space,
 	 *                    or if the zeroCopy parameter is true, then the pointer is valid
@@ -227,6 +391,20 @@ public:
 	 * @returns `true` on success, `false` if an error occurred.
 	 */
 	bool ConvertRGBA( void* input, float** output, bool zeroCopy=false );
+
+	/**
+	 * Convert an image that was previously aquired with Capture() to the specified format.
+	 * This is the same as ConvertRGBA() above, except that the frame can be converted directly
+	 * to an 8-bit format like CUDA_OUTPUT_RGBA8 or CUDA_OUTPUT_GRAY8 (see cudaOutputFormat),
+	 * which uses a quarter of the memory and bandwidth (or less) of float4 RGBA.
+	 *
+	 * Each output format has its own ringbuffer, which gets allocated the first time that
+	 * the format is requested.  The size of the image is:
+	 *   `GetWidth() * GetHeight() * cudaOutputFormatSize(format)`
+	 *
+	 * @returns `true` on success, `false` if an error occurred.
+	 */
+	bool ConvertRGBA( void* input, void** output, cudaOutputFormat format, bool zeroCopy=false );
 	
 	/**
 	 * Return the width of the camera.
@@ -253,8 +431,15 @@ public:
 	 *       image that gets aquired by the Capture() function.
 	 *       To calculate the size of the converted float4 RGBA image,
 	 *       take:  `GetWidth() * GetHeight() * sizeof(float) * 4`
+	 *       (or `cudaOutputFormatSize(format)` for the other output formats)
 	 */
 	inline uint32_t GetSize() const	   { return mSize; }
+
+	/**
+	 * Return the format, plane offsets and strides of the most recent frame,
+	 * as they were negotiated with the appsink.
+	 */
+	cudaVideoLayout GetLayout();
 	
 	/**
 	 * Default camera width, unless otherwise specified during Create()
@@ -277,8 +462,17 @@ private:
 	bool buildLaunchStr( gstCameraSrc src );
 	bool parseCameraStr( const char* camera );
 
-	void checkMsgBus();
+	static void onBusError( const char* source, const char* message, void* user_data );
 	void checkBuffer();
+	void checkSample( GstSample* sample, GstBuffer* buffer, const GstMapInfo& map, const cudaVideoLayout& layout );
+	void releaseSample( uint32_t slot );
+	void release( uint32_t slot );
+	int  acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata );
+	bool findLayout( void* image, cudaVideoLayout* layout );
+	bool allocRGBA( cudaOutputFormat format, bool zeroCopy );
+	void freeRGBA( cudaOutputFormat format );
+
+	static void onDropped( uint32_t slot, void* user_data );
 	
 	_GstBus*     mBus;
 	_GstAppSink* mAppSink;
@@ -297,20 +491,35 @@ private:
 	
 	void* mRingbufferCPU[NUM_RINGBUFFERS];
 	void* mRingbufferGPU[NUM_RINGBUFFERS];
+	size_t mRingbufferSize[NUM_RINGBUFFERS];	// allocated size of each slot
+
+	cudaVideoLayout mRingLayout[NUM_RINGBUFFERS];	// layout of the frame in each slot
+	cudaVideoLayout mLayout;						// layout of the most recent frame
 	
-	Event mWaitEvent;
-	Mutex mWaitMutex;
-	Mutex mRingMutex;
+	GstSample* mSamples[NUM_RINGBUFFERS];		// GST_CAPTURE_SAMPLE mode
+	GstMapInfo mSampleMaps[NUM_RINGBUFFERS];
+	std::atomic<int> mSlotRGBA;			// sample slot last converted by CaptureRGBA()
+	bool       mSampleDeviceAccess;			// can the GPU read the sample memory directly?
+
+	void* mStagingCPU;	// used by CaptureRGBA() when the GPU can't access sample memory
+	void* mStagingGPU;
+	size_t mStagingSize;
+
+	captureQueue mQueue;
+	Mutex mLayoutMutex;	// protects mLayout, which is only written when the layout changes
+
+	latencyHistogram mPipelineLatency;
 	
-	uint32_t mLatestRGBA;
-	uint32_t mLatestRingbuffer;
-	bool     mLatestRetrieved;
+	uint32_t mLatestRGBA[CUDA_OUTPUT_FORMATS];
+	std::atomic<int> mCopyAcquired;	// slot last returned by Capture() in GST_CAPTURE_COPY mode
 	
-	void*  mRGBA[NUM_RINGBUFFERS];
-	bool   mRGBAZeroCopy; // were the RGBA buffers allocated with zeroCopy?
+	void*  mRGBA[CUDA_OUTPUT_FORMATS][NUM_RINGBUFFERS];	// ringbuffer of each output format
+	bool   mRGBAZeroCopy[CUDA_OUTPUT_FORMATS]; // were the RGBA buffers allocated with zeroCopy?
 	bool   mStreaming;	  // true if the device is currently open
 	int    mSensorCSI;	  // -1 for V4L2, >=0 for MIPI CSI
 
+	gstCaptureMode mCaptureMode;
+
 	inline bool csiCamera() const		{ return (mSensorCSI >= 0); }
 };
 
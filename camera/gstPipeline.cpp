@@ -19,7 +19,7 @@
 
 
 // constructor
-gstPipeline::gstPipeline()
+gstPipeline::gstPipeline() : mQueue(NUM_RINGBUFFERS), mLayoutMutex("gstPipeline::mLayoutMutex")
 {
     mAppSink    = NULL;
     mBus        = NULL;
@@ -31,18 +31,27 @@ gstPipeline::gstPipeline()
     mDepth  = 0;
     mSize   = 0;
 
-    mLatestRGBA       = 0;
-    mLatestRingbuffer = 0;
-    mLatestRetrieved  = false;
+    mLastAcquired = -1;
+
+    memset(&mLayout, 0, sizeof(cudaVideoLayout));
 
     for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
     {
         mRingbufferCPU[n] = NULL;
         mRingbufferGPU[n] = NULL;
-        mRGBA[n]          = NULL;
+
+        mRingbufferSize[n] = 0;
+        memset(&mRingLayout[n], 0, sizeof(cudaVideoLayout));
     }
 
-    mRGBAZeroCopy = false;
+    for( uint32_t f=0; f < CUDA_OUTPUT_FORMATS; f++ )
+    {
+        for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+            mRGBA[f][n] = NULL;
+
+        mLatestRGBA[f]   = 0;
+        mRGBAZeroCopy[f] = false;
+    }
 }
 
 
@@ -50,34 +59,35 @@ gstPipeline::gstPipeline()
 gstPipeline::~gstPipeline()
 {
     Close();
+    gstBusWatchRemove(mPipeline);
 
     for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
     {
         // free capture buffer
         if( mRingbufferCPU[n] != NULL )
         {
-            CUDA(cudaFreeHost(mRingbufferCPU[n]));
+            cudaFreeMapped(mRingbufferCPU[n]);
 
             mRingbufferCPU[n] = NULL;
             mRingbufferGPU[n] = NULL;
         }
-
-        // free convert buffer
-        if( mRGBA[n] != NULL )
-        {
-            if( mRGBAZeroCopy )
-                CUDA(cudaFreeHost(mRGBA[n]));
-            else
-                CUDA(cudaFree(mRGBA[n]));
-
-            mRGBA[n] = NULL;
-        }
     }
+
+    // free convert buffers
+    for( uint32_t f=0; f < CUDA_OUTPUT_FORMATS; f++ )
+        freeRGBA((cudaOutputFormat)f);
 }
 
 
 // CaptureRGBA
 bool gstPipeline::CaptureRGBA( float** output, unsigned long timeout, bool zeroCopy )
+{
+    return CaptureRGBA((void**)output, CUDA_OUTPUT_RGBA32, timeout, zeroCopy);
+}
+
+
+// CaptureRGBA
+bool gstPipeline::CaptureRGBA( void** output, cudaOutputFormat format, unsigned long timeout, bool zeroCopy )
 {
     void* cpu = NULL;
     void* gpu = NULL;
@@ -88,7 +98,7 @@ bool gstPipeline::CaptureRGBA( float** output, unsigned long timeout, bool zeroC
         return false;
     }
 
-    if( !ConvertRGBA(gpu, output, zeroCopy) )
+    if( !ConvertRGBA(gpu, output, format, zeroCopy) )
     {
         printf(LOG_GSTREAMER "gstPipeline failed to convert frame to RGBA\n");
         return false;
@@ -99,87 +109,171 @@ bool gstPipeline::CaptureRGBA( float** output, unsigned long timeout, bool zeroC
 
 
 // ConvertRGBA
-bool gstPipeline::ConvertRGBA( void* input, float** output, bool zeroCopy)
+bool gstPipeline::ConvertRGBA( void* input, float** output, bool zeroCopy )
+{
+    return ConvertRGBA(input, (void**)output, CUDA_OUTPUT_RGBA32, zeroCopy);
+}
+
+
+// ConvertRGBA
+bool gstPipeline::ConvertRGBA( void* input, void** output, cudaOutputFormat format, bool zeroCopy )
 {
     if( !input || !output )
         return false;
 
+    if( format < 0 || format >= CUDA_OUTPUT_FORMATS )
+    {
+        printf(LOG_GSTREAMER "gstPipeline -- invalid output format (%i)\n", (int)format);
+        return false;
+    }
+
     // check if the buffers were previously allocated with a different zeroCopy option
     // if necessary, free them so they can be re-allocated with the correct option
-    if( mRGBA[0] != NULL && zeroCopy != mRGBAZeroCopy )
-    {
-        for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
-        {
-            if( mRGBA[n] != NULL )
-            {
-                if( mRGBAZeroCopy )
-                    CUDA(cudaFreeHost(mRGBA[n]));
-                else
-                    CUDA(cudaFree(mRGBA[n]));
+    if( mRGBA[format][0] != NULL && zeroCopy != mRGBAZeroCopy[format] )
+        freeRGBA(format);
 
-                mRGBA[n] = NULL;
-            }
-        }
+    // check if the buffers need allocated
+    if( !mRGBA[format][0] && !allocRGBA(format, zeroCopy) )
+        return false;
+
+    void* rgba = mRGBA[format][mLatestRGBA[format]];
+
+    // use the layout that the frame was captured with, or the latest one
+    // if the frame came from elsewhere (i.e. it was copied by the user)
+    cudaVideoLayout layout;
+
+    if( !findLayout(input, &layout) )
+        layout = GetLayout();
 
-        mRGBAZeroCopy = false;	// reset for sanity
+    if( layout.format != CUDA_VIDEO_UNKNOWN )
+    {
+        if( CUDA_FAILED(cudaVideoConvert(input, layout, rgba, format)) )
+            return false;
     }
+    else if( format != CUDA_OUTPUT_RGBA32 )
+    {
+        // NV12 or RGB, depending on the depth
+        cudaVideoLayoutPacked(&layout, (mDepth == 12) ? CUDA_VIDEO_NV12 : CUDA_VIDEO_RGB, mWidth, mHeight);
 
-    // check if the buffers need allocated
-    if( !mRGBA[0] )
+        if( CUDA_FAILED(cudaVideoConvert(input, layout, rgba, format)) )
+            return false;
+    }
+    else if( mDepth == 12 )
+    {
+        // NV12
+        if( CUDA_FAILED(cudaNV12ToRGBA32((uint8_t*)input, (float4*)rgba, mWidth, mHeight)) )
+            return false;
+    }
+    else
     {
-        const size_t size = mWidth * mHeight * sizeof(float4);
+        // RGB
+        if( CUDA_FAILED(cudaRGB8ToRGBA32((uchar3*)input, (float4*)rgba, mWidth, mHeight)) )
+            return false;
+    }
 
-        for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+    *output = rgba;
+    mLatestRGBA[format] = (mLatestRGBA[format] + 1) % NUM_RINGBUFFERS;
+    return true;
+}
+
+
+// allocRGBA
+bool gstPipeline::allocRGBA( cudaOutputFormat format, bool zeroCopy )
+{
+    const size_t size = mWidth * mHeight * cudaOutputFormatSize(format);
+
+    mRGBAZeroCopy[format] = zeroCopy;	// so freeRGBA() can clean up after a failure
+
+    for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+    {
+        if( zeroCopy )
         {
-            if( zeroCopy )
+            void* cpuPtr = NULL;
+            void* gpuPtr = NULL;
+
+            if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, CUDA_MEMORY_CAMERA, false) )
             {
-                void* cpuPtr = NULL;
-                void* gpuPtr = NULL;
-
-                if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size) )
-                {
-                    printf(LOG_GSTREAMER "gstPipeline -- failed to allocate zeroCopy memory for %ux%xu RGBA texture\n", mWidth, mHeight);
-                    return false;
-                }
-
-                if( cpuPtr != gpuPtr )
-                {
-                    printf(LOG_GSTREAMER "gstPipeline -- zeroCopy memory has different pointers, please use a UVA-compatible GPU\n");
-                    return false;
-                }
-
-                mRGBA[n] = gpuPtr;
+                printf(LOG_GSTREAMER "gstPipeline -- failed to allocate zeroCopy memory for %ux%u %s texture\n", mWidth, mHeight, cudaOutputFormatToString(format));
+                freeRGBA(format);
+                return false;
             }
-            else
+
+            if( cpuPtr != gpuPtr )
             {
-                if( CUDA_FAILED(cudaMalloc(&mRGBA[n], size)) )
-                {
-                    printf(LOG_GSTREAMER "gstPipeline -- failed to allocate memory for %ux%u RGBA texture\n", mWidth, mHeight);
-                    return false;
-                }
+                printf(LOG_GSTREAMER "gstPipeline -- zeroCopy memory has different pointers, please use a UVA-compatible GPU\n");
+                cudaFreeMapped(cpuPtr);
+                freeRGBA(format);
+                return false;
             }
-        }
 
-        printf(LOG_GSTREAMER "gstPipeline -- allocated %u RGBA ringbuffers\n", NUM_RINGBUFFERS);
-        mRGBAZeroCopy = zeroCopy;
+            mRGBA[format][n] = gpuPtr;
+        }
+        else
+        {
+            if( CUDA_FAILED(cudaMalloc(&mRGBA[format][n], size)) )
+            {
+                printf(LOG_GSTREAMER "gstPipeline -- failed to allocate memory for %ux%u %s texture\n", mWidth, mHeight, cudaOutputFormatToString(format));
+                mRGBA[format][n] = NULL;
+                freeRGBA(format);
+                return false;
+            }
+        }
     }
 
-    if( mDepth == 12 )
+    printf(LOG_GSTREAMER "gstPipeline -- allocated %u %s ringbuffers (%zu bytes each)\n", NUM_RINGBUFFERS, cudaOutputFormatToString(format), size);
+
+    mLatestRGBA[format] = 0;
+    return true;
+}
+
+
+// freeRGBA
+void gstPipeline::freeRGBA( cudaOutputFormat format )
+{
+    for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
     {
-        // NV12
-        if( CUDA_FAILED(cudaNV12ToRGBA32((uint8_t*)input, (float4*)mRGBA[mLatestRGBA], mWidth, mHeight)) )
-            return false;
+        if( mRGBA[format][n] != NULL )
+        {
+            if( mRGBAZeroCopy[format] )
+                cudaFreeMapped(mRGBA[format][n]);
+            else
+                CUDA(cudaFree(mRGBA[format][n]));
+
+            mRGBA[format][n] = NULL;
+        }
     }
-    else
+
+    mRGBAZeroCopy[format] = false;	// reset for sanity
+}
+
+
+// GetLayout
+cudaVideoLayout gstPipeline::GetLayout()
+{
+    mLayoutMutex.Lock();
+    const cudaVideoLayout layout = mLayout;
+    mLayoutMutex.Unlock();
+    return layout;
+}
+
+
+// findLayout
+bool gstPipeline::findLayout( void* image, cudaVideoLayout* layout )
+{
+    for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
     {
-        // RGB
-        if( CUDA_FAILED(cudaRGB8ToRGBA32((uchar3*)input, (float4*)mRGBA[mLatestRGBA], mWidth, mHeight)) )
-            return false;
+        if( !mQueue.IsAcquired(n) )
+            continue;
+
+        if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+            continue;
+
+        // the slot is only written while it's free, so this is stable while it's held
+        *layout = mRingLayout[n];
+        return true;
     }
 
-    *output     = (float*)mRGBA[mLatestRGBA];
-    mLatestRGBA = (mLatestRGBA + 1) % NUM_RINGBUFFERS;
-    return true;
+    return false;
 }
 
 
@@ -209,43 +303,90 @@ GstFlowReturn gstPipeline::onBuffer(_GstAppSink* sink, void* user_data)
     gstPipeline* dec = (gstPipeline*)user_data;
 
     dec->checkBuffer();
-    dec->checkMsgBus();
     return GST_FLOW_OK;
 }
 
 
 // Capture
-bool gstPipeline::Capture( void** cpu, void** cuda, uint64_t timeout )
+bool gstPipeline::Capture( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
+{
+    // release the previous frame
+    const int previous = mLastAcquired.exchange(-1);
+
+    if( previous >= 0 )
+        mQueue.Release(previous);
+
+    const int slot = acquire(cpu, cuda, timeout, metadata);
+
+    if( slot < 0 )
+        return false;
+
+    mLastAcquired = slot;
+    return true;
+}
+
+
+// Acquire
+bool gstPipeline::Acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
+{
+    return (acquire(cpu, cuda, timeout, metadata) >= 0);
+}
+
+
+// acquire
+int gstPipeline::acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
 {
     // confirm the pipeline is streaming
     if( !mStreaming )
     {
         if( !Open() )
-            return false;
+            return -1;
     }
 
-    // wait until a new frame is received
-    if( !mWaitEvent.Wait(timeout) )
-        return false;
+    // wait until a frame is queued
+    const int slot = mQueue.Dequeue(timeout, metadata);
 
-    // get the latest ringbuffer
-    mRingMutex.Lock();
-    const uint32_t latest = mLatestRingbuffer;
-    const bool retrieved = mLatestRetrieved;
-    mLatestRetrieved = true;
-    mRingMutex.Unlock();
-
-    // skip if it was already retrieved
-    if( retrieved )
-        return false;
+    if( slot < 0 )
+        return -1;
 
     if( cpu != NULL )
-        *cpu = mRingbufferCPU[latest];
+        *cpu = mRingbufferCPU[slot];
 
     if( cuda != NULL )
-        *cuda = mRingbufferGPU[latest];
+        *cuda = mRingbufferGPU[slot];
 
-    return true;
+    return slot;
+}
+
+
+// Release
+void gstPipeline::Release( void* image )
+{
+    if( !image )
+        return;
+
+    for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+    {
+        if( !mQueue.IsAcquired(n) )
+            continue;
+
+        if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+            continue;
+
+        int acquired = n;
+        mLastAcquired.compare_exchange_strong(acquired, -1);
+
+        mQueue.Release(n);
+        break;
+    }
+}
+
+
+// SetQueuePolicy
+void gstPipeline::SetQueuePolicy( captureQueuePolicy policy )
+{
+    mQueue.SetPolicy(policy);
+    printf(LOG_GSTREAMER "gstreamer pipeline -- queue policy set to %s\n", captureQueuePolicyToString(policy));
 }
 
 
@@ -304,63 +445,93 @@ void gstPipeline::checkBuffer()
         release_return;
     }
 
-    GstStructure* gstCapsStruct = gst_caps_get_structure(gstCaps, 0);
+    // get the format, dimensions and plane layout of the buffer
+    cudaVideoLayout layout;
 
-    if( !gstCapsStruct )
+    if( !gst_video_layout(gstCaps, gstBuffer, &layout) )
     {
-        printf(LOG_GSTREAMER "gstreamer pipeline -- gst_caps had NULL structure...\n");
+        printf(LOG_GSTREAMER "gstreamer pipeline -- gst_caps aren't raw video...\n");
+        gst_buffer_unmap(gstBuffer, &map);
         release_return;
     }
 
-    // get width & height of the buffer
-    int width  = 0;
-    int height = 0;
-
-    if( !gst_structure_get_int(gstCapsStruct, "width", &width) ||
-        !gst_structure_get_int(gstCapsStruct, "height", &height) )
+    if( layout.width < 1 || layout.height < 1 )
     {
-        printf(LOG_GSTREAMER "gstreamer pipeline -- gst_caps missing width/height...\n");
+        gst_buffer_unmap(gstBuffer, &map);
         release_return;
     }
 
-    if( width < 1 || height < 1 )
-    release_return;
+    if( layout.format != mLayout.format || layout.width != mWidth || layout.height != mHeight )
+        printf(LOG_GSTREAMER "gstreamer pipeline -- negotiated %ux%u %s frames (%u planes, %u bytes)\n", layout.width, layout.height, cudaVideoFormatToString(layout.format), layout.planes, gstSize);
 
-    mWidth  = width;
-    mHeight = height;
-    mDepth  = (gstSize * 8) / (width * height);
+    mWidth  = layout.width;
+    mHeight = layout.height;
+    mDepth  = cudaVideoFormatDepth(layout.format);
     mSize   = gstSize;
 
+    if( mDepth == 0 )
+        mDepth = (gstSize * 8) / (mWidth * mHeight);
+
+    // this is the only thread that writes mLayout, so it can be compared without the lock
+    if( memcmp(&layout, &mLayout, sizeof(cudaVideoLayout)) != 0 )
+    {
+        mLayoutMutex.Lock();
+        mLayout = layout;
+        mLayoutMutex.Unlock();
+    }
+
     //printf(LOG_GSTREAMER "gstreamer pipeline recieved %ix%i frame (%u bytes, %u bpp)\n", width, height, gstSize, mDepth);
 
-    // make sure ringbuffer is allocated
-    if( !mRingbufferCPU[0] )
+    // measure the latency since the frame was timestamped
+    const uint64_t latency = gst_buffer_latency(mPipeline, gstBuffer);
+
+    if( latency != UINT64_MAX )
+        mPipelineLatency.Add(latency);
+
+    // get the next free ringbuffer (this may block in CAPTURE_QUEUE_FIFO mode)
+    const int nextRingbuffer = mQueue.BeginWrite();
+
+    if( nextRingbuffer < 0 )
     {
-        for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+        gst_buffer_unmap(gstBuffer, &map);
+        release_return;
+    }
+
+    // the slot isn't held by a consumer while it's being written, so it can be (re)allocated
+    // here for the first frame, or for a larger frame after the caps were renegotiated
+    if( gstSize > mRingbufferSize[nextRingbuffer] )
+    {
+        if( mRingbufferCPU[nextRingbuffer] != NULL )
+            cudaFreeMapped(mRingbufferCPU[nextRingbuffer]);
+
+        mRingbufferCPU[nextRingbuffer]  = NULL;
+        mRingbufferGPU[nextRingbuffer]  = NULL;
+        mRingbufferSize[nextRingbuffer] = 0;
+
+        if( !cudaAllocMapped(&mRingbufferCPU[nextRingbuffer], &mRingbufferGPU[nextRingbuffer], gstSize, CUDA_MEMORY_CAMERA, false) )
         {
-            if( !cudaAllocMapped(&mRingbufferCPU[n], &mRingbufferGPU[n], gstSize) )
-                printf(LOG_CUDA "gstreamer pipeline -- failed to allocate ringbuffer %u  (size=%u)\n", n, gstSize);
+            printf(LOG_CUDA "gstreamer pipeline -- failed to allocate ringbuffer %i  (size=%u)\n", nextRingbuffer, gstSize);
+            gst_buffer_unmap(gstBuffer, &map);
+            mQueue.Drop(nextRingbuffer);
+            release_return;
         }
 
-        printf(LOG_CUDA "gstreamer pipeline -- allocated %u ringbuffers, %u bytes each\n", NUM_RINGBUFFERS, gstSize);
+        mRingbufferSize[nextRingbuffer] = gstSize;
     }
 
-    // copy to next ringbuffer
-    const uint32_t nextRingbuffer = (mLatestRingbuffer + 1) % NUM_RINGBUFFERS;
-
     //printf(LOG_GSTREAMER "gstreamer pipeline -- using ringbuffer #%u for next frame\n", nextRingbuffer);
     memcpy(mRingbufferCPU[nextRingbuffer], gstData, gstSize);
+    mRingLayout[nextRingbuffer] = layout;
+
+    const uint64_t pts = GST_BUFFER_PTS_IS_VALID(gstBuffer) ? GST_BUFFER_PTS(gstBuffer) : UINT64_MAX;
+    const uint64_t dts = GST_BUFFER_DTS_IS_VALID(gstBuffer) ? GST_BUFFER_DTS(gstBuffer) : UINT64_MAX;
+
     gst_buffer_unmap(gstBuffer, &map);
     //gst_buffer_unref(gstBuffer);
     gst_sample_unref(gstSample);
 
-
-    // update and signal sleeping threads
-    mRingMutex.Lock();
-    mLatestRingbuffer = nextRingbuffer;
-    mLatestRetrieved  = false;
-    mRingMutex.Unlock();
-    mWaitEvent.Wake();
+    // queue the frame and signal sleeping threads
+    mQueue.Commit(nextRingbuffer, pts, dts);
 }
 
 // Create
@@ -425,8 +596,14 @@ bool gstPipeline::init()
         return false;
     }
 
-    // add watch for messages (disabled when we poll the bus ourselves, instead of gmainloop)
-    //gst_bus_add_watch(mBus, (GstBusFunc)gst_message_print, NULL);
+    // handle messages from the bus thread, instead of polling from the streaming thread
+    gstBusCallbacks busCallbacks;
+    memset(&busCallbacks, 0, sizeof(gstBusCallbacks));
+
+    busCallbacks.error = onBusError;
+
+    if( !gstBusWatchAdd(mPipeline, &busCallbacks, this) )
+        return false;
 
     // get the appsrc
     GstElement* appsinkElement = gst_bin_get_by_name(GST_BIN(pipeline), "mysink");
@@ -463,6 +640,9 @@ bool gstPipeline::Open()
     // transition pipline to STATE_PLAYING
     printf(LOG_GSTREAMER "gstreamer transitioning pipeline to GST_STATE_PLAYING\n");
 
+    mQueue.SetEOS(false);
+    mQueue.SetFlushing(false);
+
     const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_PLAYING);
 
     if( result == GST_STATE_CHANGE_ASYNC )
@@ -486,9 +666,7 @@ bool gstPipeline::Open()
         return false;
     }
 
-    checkMsgBus();
     usleep(100*1000);
-    checkMsgBus();
 
     mStreaming = true;
     return true;
@@ -504,6 +682,9 @@ void gstPipeline::Close()
     // stop pipeline
     printf(LOG_GSTREAMER "gstreamer transitioning pipeline to GST_STATE_NULL\n");
 
+    // unblock the streaming thread if it's waiting for a free slot
+    mQueue.SetFlushing(true);
+
     const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_NULL);
 
     if( result != GST_STATE_CHANGE_SUCCESS )
@@ -514,17 +695,13 @@ void gstPipeline::Close()
 }
 
 
-// checkMsgBus
-void gstPipeline::checkMsgBus()
+// onBusError
+void gstPipeline::onBusError( const char* source, const char* message, void* user_data )
 {
-    while(true)
-    {
-        GstMessage* msg = gst_bus_pop(mBus);
-
-        if( !msg )
-            break;
+    if( !user_data )
+        return;
 
-        gst_message_print(mBus, msg, this);
-        gst_message_unref(msg);
-    }
+    // the pipeline has stopped, so wake up consumers instead of letting them wait for frames
+    gstPipeline* dec = (gstPipeline*)user_data;
+    dec->mQueue.SetEOS(true);
 }
\ No newline at end of file
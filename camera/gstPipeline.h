@@ -11,6 +11,9 @@
 #include "Mutex.h"
 #include "Event.h"
 
+#include "captureQueue.h"
+#include "cudaVideoFormat.h"
+
 struct _GstAppSink;
 
 
@@ -31,22 +34,61 @@ public:
     bool Open();
     void Close();
 
-    // Capture YUV (NV12)
-    bool Capture( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX );
+    // Capture a frame in the format that was negotiated with the appsink (see GetLayout()),
+    // optionally returning the frame's sequence number and timestamps
+    // the frame stays valid until Release() or the next call to Capture()
+    bool Capture( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+    // Capture a frame without implicitly releasing the previous one,
+    // so the frame stays valid until it's passed to Release()
+    bool Acquire( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+    // Hand a frame from Capture() or Acquire() back to the ringbuffer
+    void Release( void* image );
 
     // Capture the next image frame from the camera and convert it to float4 RGBA format,
     //	 * with pixel intensities ranging between 0.0 and 255.0.
     bool CaptureRGBA( float** image, uint64_t timeout=UINT64_MAX, bool zeroCopy=false );
 
-    // Takes in captured YUV-NV12 CUDA image, converts to float4 RGBA (with pixel intensity 0-255)
+    // Capture the next image frame and convert it to the specified format (see ConvertRGBA() below)
+    bool CaptureRGBA( void** image, cudaOutputFormat format, uint64_t timeout=UINT64_MAX, bool zeroCopy=false );
+
+    // Takes in a captured CUDA image, converts to float4 RGBA (with pixel intensity 0-255)
+    // the conversion is picked from the format and plane strides that the frame was captured with
     bool ConvertRGBA( void* input, float** output, bool zeroCopy=false );
 
+    // Takes in a captured CUDA image and converts it directly to one of the cudaOutputFormat's,
+    // i.e. CUDA_OUTPUT_RGBA8 for 8-bit consumers instead of converting to float4 and back
+    // each format has its own ringbuffer, allocated the first time the format is requested
+    bool ConvertRGBA( void* input, void** output, cudaOutputFormat format, bool zeroCopy=false );
+
+    // Queue policy for when the consumer falls behind (latest-only by default)
+    void SetQueuePolicy( captureQueuePolicy policy );
+    inline captureQueuePolicy GetQueuePolicy() const { return mQueue.GetPolicy(); }
+
+    // Frame counters
+    inline uint64_t GetFramesProduced()  { return mQueue.GetProduced(); }
+    inline uint64_t GetFramesConsumed()  { return mQueue.GetConsumed(); }
+    inline uint64_t GetFramesDropped()   { return mQueue.GetDropped(); }
+    inline uint32_t GetQueueDepth()      { return mQueue.GetDepth(); }
+
+    // Event that gets signalled whenever a frame is queued (for waiting on several sources)
+    inline void SetNotifyEvent( Event* event ) { mQueue.SetNotifyEvent(event); }
+
+    // Latency histograms (buffer PTS to appsink, appsink to Capture(), Capture() to Release())
+    inline latencyHistogram* GetPipelineLatency() { return &mPipelineLatency; }
+    inline latencyHistogram* GetQueueLatency()    { return mQueue.GetQueueLatency(); }
+    inline latencyHistogram* GetHoldLatency()     { return mQueue.GetHoldLatency(); }
+
     // Image dimensions
     inline uint32_t GetWidth() const	  { return mWidth; }
     inline uint32_t GetHeight() const	  { return mHeight; }
     inline uint32_t GetPixelDepth() const { return mDepth; }
     inline uint32_t GetSize() const		  { return mSize; }
 
+    // Format, plane offsets and strides of the most recent frame
+    cudaVideoLayout GetLayout();
+
     // Default resolution, unless otherwise specified during Create()
     static const uint32_t DefaultWidth  = 1280;
     static const uint32_t DefaultHeight = 720;
@@ -60,8 +102,12 @@ private:
     gstPipeline();
 
     bool init();
-    void checkMsgBus();
+    static void onBusError( const char* source, const char* message, void* user_data );
     void checkBuffer();
+    int  acquire( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata );
+    bool findLayout( void* image, cudaVideoLayout* layout );
+    bool allocRGBA( cudaOutputFormat format, bool zeroCopy );
+    void freeRGBA( cudaOutputFormat format );
 
     _GstBus*     mBus;
     _GstAppSink* mAppSink;
@@ -78,17 +124,21 @@ private:
 
     void* mRingbufferCPU[NUM_RINGBUFFERS];
     void* mRingbufferGPU[NUM_RINGBUFFERS];
+    size_t mRingbufferSize[NUM_RINGBUFFERS];  // allocated size of each slot
+
+    cudaVideoLayout mRingLayout[NUM_RINGBUFFERS];  // layout of the frame in each slot
+    cudaVideoLayout mLayout;                       // layout of the most recent frame
+
+    captureQueue mQueue;
+    Mutex mLayoutMutex;  // protects mLayout, which is only written when the layout changes
 
-    Event mWaitEvent;
-    Mutex mWaitMutex;
-    Mutex mRingMutex;
+    latencyHistogram mPipelineLatency;
 
-    uint32_t mLatestRGBA;
-    uint32_t mLatestRingbuffer;
-    bool     mLatestRetrieved;
+    uint32_t mLatestRGBA[CUDA_OUTPUT_FORMATS];
+    std::atomic<int> mLastAcquired;  // slot last returned by Capture(), released on the next call
 
-    void* mRGBA[NUM_RINGBUFFERS];
-    bool   mRGBAZeroCopy; // were the RGBA buffers allocated with zeroCopy?
+    void* mRGBA[CUDA_OUTPUT_FORMATS][NUM_RINGBUFFERS];  // ringbuffer of each output format
+    bool   mRGBAZeroCopy[CUDA_OUTPUT_FORMATS]; // were the RGBA buffers allocated with zeroCopy?
     bool   mStreaming;	  // true if the device is currently open
 
 };
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "v4l2Camera.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/mman.h>
+
+
+//-----------------------------------------------------------------------------------
+// fake V4L2 device, which fills each buffer with its sequence number when it's dequeued
+//-----------------------------------------------------------------------------------
+#define FAKE_WIDTH   64
+#define FAKE_HEIGHT  48
+#define FAKE_PITCH   (FAKE_WIDTH * 2)
+#define FAKE_SIZE    (FAKE_PITCH * FAKE_HEIGHT)
+#define FAKE_BUFFERS 4
+#define FAKE_FD      42
+
+static bool     fakeQueued[FAKE_BUFFERS];	// is the buffer queued to the "driver"?
+static uint32_t fakeOrder[FAKE_BUFFERS];	// the order that buffers were queued in
+static uint32_t fakeNumQueued = 0;
+static uint32_t fakeSequence  = 0;
+static uint32_t fakeErrors    = 0;		// buffers that were queued twice, or weren't queued when dequeued
+
+static int fakeOpen( const char* path, int flags )	{ return FAKE_FD; }
+static int fakeClose( int fd )						{ return 0; }
+
+static void* fakeBuffers[FAKE_BUFFERS];
+
+static void* fakeMMap( void* addr, size_t length, int prot, int flags, int fd, off_t offset )
+{
+	void* ptr = malloc(length);
+	fakeBuffers[offset / FAKE_SIZE] = ptr;
+	return ptr;
+}
+
+static int fakeMUnmap( void* addr, size_t length )
+{
+	free(addr);
+	return 0;
+}
+
+static int fakePoll( struct pollfd* fds, nfds_t nfds, int timeout )
+{
+	fds[0].revents = (fakeNumQueued > 0) ? POLLIN : 0;
+	return (fakeNumQueued > 0) ? 1 : 0;
+}
+
+static int fakeIoctl( int fd, unsigned long request, void* arg )
+{
+	switch(request)
+	{
+		case VIDIOC_QUERYCAP:
+		{
+			v4l2_capability* caps = (v4l2_capability*)arg;
+			memset(caps, 0, sizeof(v4l2_capability));
+			caps->capabilities = V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_STREAMING;
+			return 0;
+		}
+		case VIDIOC_ENUM_FMT:
+		{
+			v4l2_fmtdesc* desc = (v4l2_fmtdesc*)arg;
+
+			if( desc->index > 0 )
+			{
+				errno = EINVAL;
+				return -1;
+			}
+
+			desc->pixelformat = V4L2_PIX_FMT_YUYV;
+			strcpy((char*)desc->description, "YUYV");
+			return 0;
+		}
+		case VIDIOC_G_FMT:
+		case VIDIOC_S_FMT:
+		{
+			v4l2_format* fmt = (v4l2_format*)arg;
+
+			fmt->fmt.pix.width        = FAKE_WIDTH;
+			fmt->fmt.pix.height       = FAKE_HEIGHT;
+			fmt->fmt.pix.bytesperline = FAKE_PITCH;
+			fmt->fmt.pix.sizeimage    = FAKE_SIZE;
+			fmt->fmt.pix.pixelformat  = V4L2_PIX_FMT_YUYV;
+			return 0;
+		}
+		case VIDIOC_REQBUFS:
+		{
+			((v4l2_requestbuffers*)arg)->count = FAKE_BUFFERS;
+			return 0;
+		}
+		case VIDIOC_QUERYBUF:
+		{
+			v4l2_buffer* buf = (v4l2_buffer*)arg;
+			buf->length   = FAKE_SIZE;
+			buf->m.offset = buf->index * FAKE_SIZE;
+			return 0;
+		}
+		case VIDIOC_QBUF:
+		{
+			const uint32_t index = ((v4l2_buffer*)arg)->index;
+
+			if( index >= FAKE_BUFFERS || fakeQueued[index] )
+			{
+				fakeErrors++;
+				errno = EINVAL;
+				return -1;
+			}
+
+			fakeQueued[index] = true;
+			fakeOrder[fakeNumQueued++] = index;
+			return 0;
+		}
+		case VIDIOC_DQBUF:
+		{
+			if( fakeNumQueued == 0 )
+			{
+				errno = EAGAIN;
+				return -1;
+			}
+
+			v4l2_buffer* buf = (v4l2_buffer*)arg;
+			const uint32_t index = fakeOrder[0];
+
+			memmove(fakeOrder, fakeOrder + 1, (--fakeNumQueued) * sizeof(uint32_t));
+
+			if( !fakeQueued[index] )
+				fakeErrors++;
+
+			fakeQueued[index] = false;
+
+			buf->index     = index;
+			buf->bytesused = FAKE_SIZE;
+			buf->sequence  = fakeSequence++;
+
+			memset(fakeBuffers[index], buf->sequence & 0xFF, FAKE_SIZE);
+			return 0;
+		}
+		case VIDIOC_STREAMON:
+		{
+			return 0;
+		}
+		case VIDIOC_STREAMOFF:
+		{
+			// the driver gives back all of the buffers that were queued
+			memset(fakeQueued, 0, sizeof(fakeQueued));
+			fakeNumQueued = 0;
+			return 0;
+		}
+	}
+
+	errno = EINVAL;
+	return -1;
+}
+
+// the frame still holds the value it was filled with when it was dequeued
+static bool frameIntact( const v4l2Frame& frame )
+{
+	const uint8_t* data = (const uint8_t*)frame.data;
+
+	for( uint32_t n=0; n < frame.size; n++ )
+	{
+		if( data[n] != (frame.sequence & 0xFF) )
+			return false;
+	}
+
+	return true;
+}
+
+
+#define CHECK(x)	if( !(x) ) { printf("v4l2-fake-test:  check failed, line %i:  %s\n", __LINE__, #x); passed = false; }
+
+
+// checks the DQBUF/hold/QBUF cycle of v4l2Camera against the fake device
+int main( int argc, char** argv )
+{
+	const v4l2DeviceOps ops = { fakeOpen, fakeClose, fakeIoctl, fakePoll, fakeMMap, fakeMUnmap };
+
+	v4l2Camera* camera = v4l2Camera::Create("/dev/fake0", FAKE_BUFFERS, &ops);
+
+	if( !camera || !camera->Open() )
+	{
+		printf("v4l2-fake-test:  failed to open the fake device\n");
+		return 1;
+	}
+
+	bool passed = true;
+
+	CHECK(camera->GetBufferCount() == FAKE_BUFFERS);
+	CHECK(fakeNumQueued == FAKE_BUFFERS);
+
+	// hold every buffer, and check that none of them are queued to the driver anymore
+	v4l2Frame frames[FAKE_BUFFERS];
+
+	for( uint32_t n=0; n < FAKE_BUFFERS; n++ )
+		CHECK(camera->Acquire(&frames[n], 0));
+
+	CHECK(fakeNumQueued == 0);
+
+	v4l2Frame extra;
+	CHECK(!camera->Poll(&extra));
+	CHECK(!camera->Acquire(&extra, 10));
+
+	// releasing a frame hands its buffer back, and the held frames aren't touched
+	CHECK(camera->Release(frames[0]));
+	CHECK(!camera->Release(frames[0]));
+	CHECK(fakeNumQueued == 1);
+
+	CHECK(camera->Acquire(&extra, 0));
+	CHECK(extra.index == frames[0].index);
+	CHECK(extra.sequence == FAKE_BUFFERS);
+
+	for( uint32_t n=1; n < FAKE_BUFFERS; n++ )
+		CHECK(frameIntact(frames[n]));
+
+	CHECK(camera->Release(extra));
+
+	// buffers that are released while stopped get queued again when the camera is opened
+	CHECK(camera->Close());
+	CHECK(camera->Release(frames[1]));
+	CHECK(fakeNumQueued == 0);
+
+	CHECK(camera->Open());
+	CHECK(fakeNumQueued == 2);
+
+	for( uint32_t n=2; n < FAKE_BUFFERS; n++ )
+		CHECK(camera->Release(frames[n]));
+
+	// Capture(timeout) re-queues the previous frame on the next call
+	CHECK(camera->Capture(0) != NULL);
+	CHECK(camera->Capture(0) != NULL);
+	CHECK(fakeNumQueued == FAKE_BUFFERS - 1);
+
+	CHECK(fakeErrors == 0);
+
+	delete camera;
+
+	printf("v4l2-fake-test:  %s\n", passed ? "PASSED" : "FAILED");
+	return passed ? 0 : 1;
+}
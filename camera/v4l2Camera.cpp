@@ -37,27 +37,23 @@
 
 
 
-#define REQUESTED_RINGBUFFERS 	4
+// default system calls
+static int v4l2_open( const char* path, int flags )				{ return open(path, flags, 0); }
+static int v4l2_ioctl( int fd, unsigned long request, void* arg )	{ return ioctl(fd, request, arg); }
 
-
-
-// ioctl
-static int xioctl(int fd, int request, void* arg)
-{
-    int status;
-    do { status = ioctl (fd, request, arg); } while (-1==status && EINTR==errno);
-    return status;
-}
+static const v4l2DeviceOps v4l2_default_ops = { v4l2_open, close, v4l2_ioctl, poll, mmap, munmap };
 
 
 
 // constructor
-v4l2Camera::v4l2Camera( const char* device_path ) : mDevicePath(device_path)
+v4l2Camera::v4l2Camera( const char* device_path, uint32_t numBuffers, const v4l2DeviceOps* ops ) : mDevicePath(device_path)
 {	
 	mFD = -1;
 
 	mBuffersMMap     = NULL;
 	mBufferCountMMap = 0;
+	mLastCaptured    = -1;
+	mRequestBuffers  = numBuffers;
 	mRequestWidth    = 0;
 	mRequestHeight   = 0;
 	mRequestFormat   = 1;
@@ -67,58 +63,154 @@ v4l2Camera::v4l2Camera( const char* device_path ) : mDevicePath(device_path)
 	mHeight     = 0;
 	mPitch      = 0;
 	mPixelDepth = 0;
+	mStreaming  = false;
+
+	mOps = (ops != NULL) ? *ops : v4l2_default_ops;
 }
 
 
 // destructor	
 v4l2Camera::~v4l2Camera()
 {
+	if( mStreaming )
+		Close();
+
+	// unmap buffers
+	if( mBuffersMMap != NULL )
+	{
+		for( size_t n=0; n < mBufferCountMMap; n++ )
+		{
+			if( mBuffersMMap[n].ptr != NULL && mBuffersMMap[n].ptr != MAP_FAILED )
+				mOps.munmap(mBuffersMMap[n].ptr, mBuffersMMap[n].buf.length);
+		}
+
+		free(mBuffersMMap);
+		mBuffersMMap = NULL;
+	}
+
 	// close file
 	if( mFD >= 0 )
 	{
-		close(mFD);
+		mOps.close(mFD);
 		mFD = -1;
 	}
 }
 
 
-// ProcessEmit
-void* v4l2Camera::Capture( size_t timeout )
+// xioctl
+int v4l2Camera::xioctl( unsigned long request, void* arg )
 {
-	fd_set fds;
-	FD_ZERO(&fds);
-	FD_SET(mFD, &fds);
-
-	struct timeval tv;
- 
-	tv.tv_sec  = 0;
-	tv.tv_usec = 0;
+    int status;
+    do { status = mOps.ioctl(mFD, request, arg); } while (-1==status && EINTR==errno);
+    return status;
+}
 
-	const bool threaded = true; //false;
 
-	if( timeout > 0 )
+// Capture
+void* v4l2Camera::Capture( size_t timeout )
+{
+	// the previous frame is no longer in use, so give it back to the driver
+	if( mLastCaptured >= 0 )
 	{
-		tv.tv_sec  = timeout / 1000;
-		tv.tv_usec = (timeout - (tv.tv_sec * 1000)) * 1000;
+		v4l2Frame previous;
+		memset(&previous, 0, sizeof(v4l2Frame));
+
+		previous.index = mLastCaptured;
+		mLastCaptured  = -1;
+
+		Release(previous);
 	}
-	
-	//
-	const int result = select(mFD + 1, &fds, NULL, NULL, &tv);
 
+	v4l2Frame frame;
+
+	if( !Acquire(&frame, timeout) )
+		return NULL;
+
+	mLastCaptured = frame.index;
+	return frame.data;
+}
+
+
+// Acquire
+bool v4l2Camera::Acquire( v4l2Frame* frame, uint64_t timeout )
+{
+	if( !frame )
+		return false;
+
+	// check if a frame is already waiting
+	const int ready = dequeue(frame);
+
+	if( ready != 0 )
+		return (ready > 0);
+
+	if( timeout == 0 )
+		return false;
+
+	// wait for the device to become readable
+	struct pollfd fds;
+
+	fds.fd      = mFD;
+	fds.events  = POLLIN;
+	fds.revents = 0;
+
+	const int result = mOps.poll(&fds, 1, (timeout >= INT32_MAX) ? -1 : (int)timeout);
 
 	if( result == -1 ) 
 	{
-		//if (EINTR == errno)
-		printf("v4l2 -- select() failed (errno=%i) (%s)\n", errno, strerror(errno));
-		return NULL;
+		if( errno != EINTR )
+			printf("v4l2 -- poll() failed (errno=%i) (%s)\n", errno, strerror(errno));
+
+		return false;
 	}
 	else if( result == 0 )
 	{
-		if( timeout > 0 )
-			printf("v4l2 -- select() timed out...\n");
-		return NULL;	// timeout, not necessarily an error (TRY_AGAIN)
+		printf("v4l2 -- poll() timed out...\n");
+		return false;	// timeout, not necessarily an error (TRY_AGAIN)
+	}
+
+	return (dequeue(frame) > 0);
+}
+
+
+// Poll
+bool v4l2Camera::Poll( v4l2Frame* frame )
+{
+	if( !frame )
+		return false;
+
+	return (dequeue(frame) > 0);
+}
+
+
+// Release
+bool v4l2Camera::Release( const v4l2Frame& frame )
+{
+	if( frame.index >= mBufferCountMMap || mBuffersMMap[frame.index].state != BUFFER_HELD )
+	{
+		printf("v4l2 -- Release() called on buffer %u, which isn't held\n", frame.index);
+		return false;
 	}
 
+	if( mLastCaptured == (int)frame.index )
+		mLastCaptured = -1;
+
+	mBuffersMMap[frame.index].state = BUFFER_IDLE;
+	mHoldLatency.Add(mBuffersMMap[frame.index].dequeued, timestamp());
+
+	// while stopped, buffers get queued again when the stream is opened
+	if( !mStreaming )
+		return true;
+
+	return enqueue(frame.index);
+}
+
+
+// dequeue (returns 1 if a frame was dequeued, 0 if none was ready, or -1 on error)
+int v4l2Camera::dequeue( v4l2Frame* frame )
+{
+	if( !mStreaming )
+		return -1;
+
 	// dequeue input buffer from V4L2
 	struct v4l2_buffer buf;
 	memset(&buf, 0, sizeof(v4l2_buffer));
@@ -126,43 +218,80 @@ void* v4l2Camera::Capture( size_t timeout )
 	buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 	buf.memory = V4L2_MEMORY_MMAP;	//V4L2_MEMORY_USERPTR;
 
-	if( xioctl(mFD, VIDIOC_DQBUF, &buf) < 0 )
+	if( xioctl(VIDIOC_DQBUF, &buf) < 0 )
 	{
+		if( errno == EAGAIN )
+			return 0;	// the device is non-blocking, so no frame is ready yet
+
 		printf("v4l2 -- ioctl(VIDIOC_DQBUF) failed (errno=%i) (%s)\n", errno, strerror(errno));
-		return NULL;
+		return -1;
 	}
 	
 	if( buf.index >= mBufferCountMMap )
 	{
 		printf("v4l2 -- invalid mmap buffer index (%u)\n", buf.index);
-		return NULL;
+		return -1;
 	}
 	
-	// emit ringbuffer entry
 	//printf("v4l2 -- recieved %ux%u video frame (index=%u)\n", mWidth, mHeight, (uint32_t)buf.index);
 
-	void* image_ptr = mBuffersMMap[buf.index].ptr;
+	mBuffersMMap[buf.index].state    = BUFFER_HELD;
+	mBuffersMMap[buf.index].dequeued = timestamp();
+
+	frame->data     = mBuffersMMap[buf.index].ptr;
+	frame->size     = buf.bytesused;
+	frame->index    = buf.index;
+	frame->sequence = buf.sequence;
+	frame->dequeued = mBuffersMMap[buf.index].dequeued;
+
+	frame->timestamp.tv_sec  = buf.timestamp.tv_sec;
+	frame->timestamp.tv_nsec = buf.timestamp.tv_usec * 1000;
+
+	// driver timestamps can only be compared against the monotonic clock
+	if( (buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC )
+	{
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		mDriverLatency.Add(frame->timestamp, now);
+	}
+
+	return 1;
+}
+
+
+// enqueue
+bool v4l2Camera::enqueue( uint32_t index )
+{
+	struct v4l2_buffer buf;
+	memset(&buf, 0, sizeof(v4l2_buffer));
+
+	buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+	buf.memory = V4L2_MEMORY_MMAP;
+	buf.index  = index;
 
-	// re-queue buffer to V4L2
-	if( xioctl(mFD, VIDIOC_QBUF, &buf) < 0 )
+	if( xioctl(VIDIOC_QBUF, &buf) < 0 )
+	{
 		printf("v4l2 -- ioctl(VIDIOC_QBUF) failed (errno=%i) (%s)\n", errno, strerror(errno));
+		return false;
+	}
 
-	return image_ptr;
+	mBuffersMMap[index].state = BUFFER_QUEUED;
+	return true;
 }
 
 
 
 // initMMap
-bool v4l2Camera::initMMap()
+bool v4l2Camera::initMMap( uint32_t numBuffers )
 {
 	struct v4l2_requestbuffers req;
 	memset(&req, 0, sizeof(v4l2_requestbuffers));
 
-	req.count  = REQUESTED_RINGBUFFERS;
+	req.count  = numBuffers;
 	req.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 	req.memory = V4L2_MEMORY_MMAP;
 
-	if( xioctl(mFD, VIDIOC_REQBUFS, &req) < 0 )
+	if( xioctl(VIDIOC_REQBUFS, &req) < 0 )
 	{
 		printf("v4l2 -- does not support mmap (errno=%i) (%s)\n", errno, strerror(errno));
 		return false;
@@ -187,27 +316,25 @@ bool v4l2Camera::initMMap()
 		mBuffersMMap[n].buf.memory = V4L2_MEMORY_MMAP;
 		mBuffersMMap[n].buf.index  = n;
 		
-		if( xioctl(mFD, VIDIOC_QUERYBUF, &mBuffersMMap[n].buf) < 0 )
+		if( xioctl(VIDIOC_QUERYBUF, &mBuffersMMap[n].buf) < 0 )
 		{
 			printf( "v4l2 -- failed retrieve mmap buffer info (errno=%i) (%s)\n", errno, strerror(errno));
 			return false;
 		}
 
-		mBuffersMMap[n].ptr = mmap(NULL, mBuffersMMap[n].buf.length,
+		mBuffersMMap[n].ptr = mOps.mmap(NULL, mBuffersMMap[n].buf.length,
 							  PROT_READ|PROT_WRITE, MAP_SHARED,
 							  mFD, mBuffersMMap[n].buf.m.offset);
 
 		if( mBuffersMMap[n].ptr == MAP_FAILED )
 		{
 			printf( "v4l2 -- failed to mmap buffer (errno=%i) (%s)\n", errno, strerror(errno));
+			mBuffersMMap[n].ptr = NULL;
 			return false;
 		}
 
-		if( xioctl(mFD, VIDIOC_QBUF, &mBuffersMMap[n].buf) < 0 )
-		{
-			printf( "v4l2 -- failed to queue mmap buffer (errno=%i) (%s)\n", errno, strerror(errno));
-			return false;
-		}
+		mBufferCountMMap = n + 1;	// so the destructor unmaps it
+		mBuffersMMap[n].state = BUFFER_IDLE;	// buffers are queued by Open()
 	}
 
 	mBufferCountMMap = req.count;	
@@ -260,7 +387,7 @@ bool v4l2Camera::initFormats()
 	desc.index = 0;
 	desc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
-	while( ioctl(mFD, VIDIOC_ENUM_FMT, &desc) == 0 )
+	while( xioctl(VIDIOC_ENUM_FMT, &desc) == 0 )
 	{
 		mFormats.push_back(desc);
 		v4l2_print_formatdesc( desc );
@@ -279,7 +406,7 @@ bool v4l2Camera::initStream()
 	fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
 	// retrieve existing video format
-	if( xioctl(mFD, VIDIOC_G_FMT, &fmt) < 0 )
+	if( xioctl(VIDIOC_G_FMT, &fmt) < 0 )
 	{
 		const int err = errno;
 		printf( "v4l2 -- failed to get video format of device (errno=%i) (%s)\n", errno, strerror(errno));
@@ -311,7 +438,7 @@ bool v4l2Camera::initStream()
 
 	v4l2_print_format(new_fmt, "setting new format...");
 
-	if( xioctl(mFD, VIDIOC_S_FMT, &new_fmt) < 0 )
+	if( xioctl(VIDIOC_S_FMT, &new_fmt) < 0 )
 	{
 		const int err = errno;
 		printf( "v4l2 -- failed to set video format of device (errno=%i) (%s)\n", errno, strerror(errno));
@@ -323,7 +450,7 @@ bool v4l2Camera::initStream()
 	memset(&fmt, 0, sizeof(v4l2_format));
 	fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
-	if( xioctl(mFD, VIDIOC_G_FMT, &fmt) < 0 )
+	if( xioctl(VIDIOC_G_FMT, &fmt) < 0 )
 	{
 		const int err = errno;
 		printf( "v4l2 -- failed to get video format of device (errno=%i) (%s)\n", errno, strerror(errno));
@@ -339,7 +466,7 @@ bool v4l2Camera::initStream()
 	mPixelDepth = (mPitch * 8) / mWidth;
 
 	// initMMap
-	if( !initMMap() )		// initUserPtr()
+	if( !initMMap(mRequestBuffers) )		// initUserPtr()
 		return false;
 
 	return true;
@@ -347,9 +474,9 @@ bool v4l2Camera::initStream()
 
 
 // Create
-v4l2Camera* v4l2Camera::Create( const char* device_path )
+v4l2Camera* v4l2Camera::Create( const char* device_path, uint32_t numBuffers, const v4l2DeviceOps* ops )
 {
-	v4l2Camera* cam = new v4l2Camera(device_path);
+	v4l2Camera* cam = new v4l2Camera(device_path, numBuffers, ops);
 
 	if( !cam->init() )
 	{
@@ -366,7 +493,7 @@ v4l2Camera* v4l2Camera::Create( const char* device_path )
 bool v4l2Camera::init()
 {
 	// locate the /dev/event* path for this device
-	mFD = open(mDevicePath.c_str(), O_RDWR | O_NONBLOCK, 0 );
+	mFD = mOps.open(mDevicePath.c_str(), O_RDWR | O_NONBLOCK);
 
 	if( mFD < 0 )
 	{
@@ -393,17 +520,28 @@ bool v4l2Camera::Open()
 {
 	printf( "v4l2Camera::Open(%s)\n", mDevicePath.c_str());
 
+	if( mStreaming )
+		return true;
+
+	// queue the buffers that aren't held by the user
+	for( size_t n=0; n < mBufferCountMMap; n++ )
+	{
+		if( mBuffersMMap[n].state == BUFFER_IDLE && !enqueue(n) )
+			return false;
+	}
+
 	// begin streaming
 	enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
 	printf( "v4l2 -- starting streaming %s with ioctl(VIDIOC_STREAMON)...\n", mDevicePath.c_str());
 
-	if( xioctl(mFD, VIDIOC_STREAMON, &type) < 0 )
+	if( xioctl(VIDIOC_STREAMON, &type) < 0 )
 	{
 		printf( "v4l2 -- failed to start streaming (errno=%i) (%s)\n", errno, strerror(errno));
 		return false;
 	}
 
+	mStreaming = true;
 	return true;
 }
 
@@ -416,12 +554,20 @@ bool v4l2Camera::Close()
 
 	printf( "v4l2 -- stopping streaming %s with ioctl(VIDIOC_STREAMOFF)...\n", mDevicePath.c_str());
 
-	if( xioctl(mFD, VIDIOC_STREAMOFF, &type) < 0 )
+	if( xioctl(VIDIOC_STREAMOFF, &type) < 0 )
 	{
 		printf( "v4l2 -- failed to stop streaming (errno=%i) (%s)\n", errno, strerror(errno));
 		//return false;
 	}
 
+	// STREAMOFF returns all of the queued buffers from the driver
+	for( size_t n=0; n < mBufferCountMMap; n++ )
+	{
+		if( mBuffersMMap[n].state == BUFFER_QUEUED )
+			mBuffersMMap[n].state = BUFFER_IDLE;
+	}
+
+	mStreaming = false;
 	return true;
 }
 
@@ -432,7 +578,7 @@ bool v4l2Camera::initCaps()
 {
 	struct v4l2_capability caps;
 
-	if( xioctl(mFD, VIDIOC_QUERYCAP, &caps) < 0 )
+	if( xioctl(VIDIOC_QUERYCAP, &caps) < 0 )
 	{
 		printf( "v4l2 -- failed to query caps (xioctl VIDIOC_QUERYCAP) for %s\n", mDevicePath.c_str());
 		return false;
@@ -462,11 +608,11 @@ bool v4l2Camera::initUserPtr()
 	struct v4l2_requestbuffers req;
 	memset(&req, 0, sizeof(v4l2_requestbuffers));
 
-	req.count  = REQUESTED_RINGBUFFERS;
+	req.count  = mRequestBuffers;
 	req.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 	req.memory = V4L2_MEMORY_USERPTR;
 
-	if ( xioctl(mFD, VIDIOC_REQBUFS, &req) < 0 ) 
+	if ( xioctl(VIDIOC_REQBUFS, &req) < 0 ) 
 	{
 		const int err = errno;
 		printf( "v4l2 -- failed to request buffers (errno=%i) (%s)\n", errno, strerror(errno));
@@ -487,7 +633,7 @@ bool v4l2Camera::initUserPtr()
 
 		buf.m.userptr = (unsigned long)mRingbuffer[n]->GetCPU();
 
-		if( xioctl(mFD, VIDIOC_QBUF, &buf) < 0 )
+		if( xioctl(VIDIOC_QBUF, &buf) < 0 )
 		{
 			printf( "v4l2 -- failed to queue buffer %zu (errno=%i) (%s)\n", n, errno, strerror(errno));
 			return false;
@@ -29,6 +29,46 @@
 #include <string>
 #include <vector>
 
+#include <poll.h>
+#include <sys/types.h>
+
+#include "latencyHistogram.h"
+
+
+/**
+ * Table of the system calls that v4l2Camera uses to access the device.
+ * By default these map directly to open(), ioctl(), mmap(), ect., but they
+ * can be replaced to run v4l2Camera against a fake device (i.e. for testing).
+ * Each function follows the conventions of the system call it replaces,
+ * including returning -1 (or MAP_FAILED) and setting errno on failure.
+ * @ingroup camera
+ */
+struct v4l2DeviceOps
+{
+	int   (*open)( const char* path, int flags );
+	int   (*close)( int fd );
+	int   (*ioctl)( int fd, unsigned long request, void* arg );
+	int   (*poll)( struct pollfd* fds, nfds_t nfds, int timeout );
+	void* (*mmap)( void* addr, size_t length, int prot, int flags, int fd, off_t offset );
+	int   (*munmap)( void* addr, size_t length );
+};
+
+
+/**
+ * Handle to a frame that was captured with v4l2Camera::Acquire() or v4l2Camera::Poll().
+ * The frame resides in one of the driver's mmap'd buffers, and the driver won't
+ * overwrite it until the handle is given back with v4l2Camera::Release().
+ * @ingroup camera
+ */
+struct v4l2Frame
+{
+	void*    data;		/**< Pointer to the image inside the mmap'd buffer */
+	uint32_t size;		/**< Number of bytes of image data in the buffer */
+	uint32_t index;		/**< Index of the mmap'd buffer that holds the frame */
+	uint32_t sequence;	/**< Sequence number that the driver assigned to the frame */
+	timespec timestamp;	/**< Timestamp that the driver assigned to the frame (usually from CLOCK_MONOTONIC) */
+	timespec dequeued;	/**< Time that the frame was dequeued from the driver, from timestamp() */
+};
 
 
 /**
@@ -44,8 +84,13 @@ public:
 	/**
 	 * Create V4L2 interface
 	 * @param path Filename of the video device (e.g. /dev/video0)
+	 * @param numBuffers Number of mmap'd buffers to request from the driver.
+	 *                   The driver may allocate more or less than requested.
+	 * @param ops Optional table of system calls to use to access the device,
+	 *            or NULL to use the real system calls (the default).
 	 */
-	static v4l2Camera* Create( const char* device_path );
+	static v4l2Camera* Create( const char* device_path, uint32_t numBuffers=DefaultBufferCount, 
+						  const v4l2DeviceOps* ops=NULL );
 
 	/**
 	 * Destructor
@@ -64,9 +109,71 @@ public:
 
 	/**
 	 * Return the next image.
+	 *
+	 * The image stays valid until the next call to Capture(), at which
+	 * point its buffer is handed back to the driver.  To hold on to
+	 * more than one frame at a time, use Acquire() instead.
+	 *
+	 * @param timeout time in milliseconds to wait for a frame (0 doesn't wait)
 	 */
 	void* Capture( size_t timeout=0 );
 
+	/**
+	 * Wait for the next frame, and take ownership of the buffer it resides in.
+	 * The buffer won't be re-queued to the driver until the frame is passed to Release(),
+	 * so the frame can be processed in place without it being overwritten.
+	 *
+	 * @param[out] frame handle to the captured frame
+	 * @param[in] timeout time in milliseconds to wait for a frame.  If 0, return immediately
+	 *                    if no frame is ready.  If UINT64_MAX, wait indefinitely (the default).
+	 *
+	 * @returns `true` if a frame was captured, or `false` on timeout or error.
+	 */
+	bool Acquire( v4l2Frame* frame, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Retrieve the next frame if one is ready, without waiting.
+	 * This is the same as Acquire() with a timeout of 0.
+	 * @returns `true` if a frame was captured, or `false` if none was ready.
+	 */
+	bool Poll( v4l2Frame* frame );
+
+	/**
+	 * Hand the buffer of a frame from Acquire() or Poll() back to the driver.
+	 * If the camera isn't streaming, the buffer is re-queued the next time it's opened.
+	 * @returns `true` on success, or `false` if the frame wasn't held or the re-queue failed.
+	 */
+	bool Release( const v4l2Frame& frame );
+
+	/**
+	 * Return the number of mmap'd buffers that the driver allocated.
+	 */
+	inline uint32_t GetBufferCount() const				{ return mBufferCountMMap; }
+
+	/**
+	 * Return the file descriptor of the device, which becomes readable
+	 * when a frame is ready.  It can be used to wait on several devices at once.
+	 */
+	inline int GetFD() const							{ return mFD; }
+
+	/**
+	 * Check if the camera is streaming or not.
+	 */
+	inline bool IsStreaming() const					{ return mStreaming; }
+
+	/**
+	 * Return the histogram of the latency from when the driver timestamped
+	 * each frame to when it was dequeued.  This is only measured if the
+	 * driver uses monotonic timestamps.
+	 */
+	inline latencyHistogram* GetDriverLatency()			{ return &mDriverLatency; }
+
+	/**
+	 * Return the histogram of the time that frames were held by the user,
+	 * from Capture() or Acquire() until they were released.
+	 */
+	inline latencyHistogram* GetHoldLatency()			{ return &mHoldLatency; }
+
 	/**
 	 * Get width, in pixels, of camera image.
 	 */
@@ -87,9 +194,14 @@ public:
 	 */
 	inline uint32_t GetPixelDepth() const				{ return mPixelDepth; }
 
+	/**
+	 * Default number of mmap'd buffers to request from the driver.
+	 */
+	static const uint32_t DefaultBufferCount = 4;
+
 private:
 
-	v4l2Camera( const char* device_path );
+	v4l2Camera( const char* device_path, uint32_t numBuffers, const v4l2DeviceOps* ops );
 
 	bool init();
 	bool initCaps();
@@ -97,7 +209,11 @@ private:
 	bool initStream();
 
 	bool initUserPtr();
-	bool initMMap();
+	bool initMMap( uint32_t numBuffers );
+
+	int  dequeue( v4l2Frame* frame );
+	bool enqueue( uint32_t index );
+	int  xioctl( unsigned long request, void* arg );
 
 	int 	    mFD;
 	int	    mRequestFormat;
@@ -107,15 +223,32 @@ private:
 	uint32_t mHeight;
 	uint32_t mPitch;
 	uint32_t mPixelDepth;
+	uint32_t mRequestBuffers;
+	bool     mStreaming;
+
+	enum bufferState
+	{
+		BUFFER_IDLE = 0,	// owned by v4l2Camera, waiting to be queued
+		BUFFER_QUEUED,		// queued to the driver
+		BUFFER_HELD		// dequeued and held by the user
+	};
 
 	struct v4l2_mmap
 	{
 		struct v4l2_buffer buf;
 		void*  ptr;
+		bufferState state;
+		timespec dequeued;
 	};
 
 	v4l2_mmap* mBuffersMMap;
 	size_t mBufferCountMMap;
+	int    mLastCaptured;	// buffer returned by Capture(timeout), re-queued on the next call
+
+	v4l2DeviceOps mOps;
+
+	latencyHistogram mDriverLatency;
+	latencyHistogram mHoldLatency;
 
 	std::vector<v4l2_fmtdesc> mFormats;
 	std::string mDevicePath;
@@ -32,16 +32,41 @@
 #include <string.h>
 #include <strings.h>
 
+#include "cudaMappedMemory.h"
+
 
 
 // constructor
-gstDecoder::gstDecoder()
+gstDecoder::gstDecoder() : mQueue(NUM_RINGBUFFERS), mRingMutex("gstDecoder::mRingMutex")
 {	
 	mAppSink    = NULL;
 	mBus        = NULL;
 	mPipeline   = NULL;
 	mPort       = 0;
 	mCodec      = GST_CODEC_H264;
+	mSync       = true;
+	mStreaming  = false;
+
+	mWidth  = 0;
+	mHeight = 0;
+	mDepth  = 0;
+	mSize   = 0;
+
+	mLatestRGBA     = 0;
+	mLastAcquired   = -1;
+	mRGBAZeroCopy   = false;
+
+	memset(&mLayout, 0, sizeof(cudaVideoLayout));
+
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		mRingbufferCPU[n] = NULL;
+		mRingbufferGPU[n] = NULL;
+		mRGBA[n]          = NULL;
+
+		mRingbufferSize[n] = 0;
+		memset(&mRingLayout[n], 0, sizeof(cudaVideoLayout));
+	}
 }
 
 
@@ -50,30 +75,73 @@ gstDecoder::~gstDecoder()
 {
 	// stop pipeline
 	printf(LOG_GSTREAMER "gstDecoder - shutting down pipeline\n");
-	printf(LOG_GSTREAMER "gstDecoder - transitioning pipeline to GST_STATE_NULL\n");
+	Close();
+	gstBusWatchRemove(mPipeline);
+	printf(LOG_GSTREAMER "gstDecoder - pipeline shutdown complete\n");
 
-	const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_NULL);
+	if( mPipeline != NULL )
+	{
+		gst_object_unref(mPipeline);
+		mPipeline = NULL;
+	}
 
-	if( result != GST_STATE_CHANGE_SUCCESS )
-		printf(LOG_GSTREAMER "gstDecoder - failed to stop pipeline (error %u)\n", result);
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		// free decode buffer
+		if( mRingbufferCPU[n] != NULL )
+		{
+			cudaFreeMapped(mRingbufferCPU[n]);
 
-	sleepMs(250);
-	
-	printf(LOG_GSTREAMER "gstDecoder - pipeline shutdown complete\n");
+			mRingbufferCPU[n] = NULL;
+			mRingbufferGPU[n] = NULL;
+		}
+
+		// free convert buffer
+		if( mRGBA[n] != NULL )
+		{
+			if( mRGBAZeroCopy )
+				cudaFreeMapped(mRGBA[n]);
+			else
+				CUDA(cudaFree(mRGBA[n]));
+
+			mRGBA[n] = NULL;
+		}
+	}
 }
 
 
 // Create
 gstDecoder* gstDecoder::Create( gstCodec codec, const char* filename )
 {
+	return create(codec, filename, true);
+}
+
+
+// CreateOffline
+gstDecoder* gstDecoder::CreateOffline( gstCodec codec, const char* filename )
+{
+	return create(codec, filename, false);
+}
+
+
+// create
+gstDecoder* gstDecoder::create( gstCodec codec, const char* filename, bool sync )
+{
+	if( !gstreamerInit() )
+	{
+		printf(LOG_GSTREAMER "failed to initialize gstreamer API\n");
+		return NULL;
+	}
+
 	gstDecoder* dec = new gstDecoder();
 	
 	if( !dec )
 		return NULL;
 	
-	if( !dec->init(codec, filename, NULL, 0) )
+	if( !dec->init(codec, filename, NULL, 0, sync) )
 	{
 		printf(LOG_GSTREAMER "gstDecoder::Create() failed\n");
+		delete dec;
 		return NULL;
 	}
 	
@@ -91,14 +159,21 @@ gstDecoder* gstDecoder::Create( gstCodec codec, uint16_t port )
 // Create
 gstDecoder* gstDecoder::Create( gstCodec codec, const char* multicastIP, uint16_t port )
 {
+	if( !gstreamerInit() )
+	{
+		printf(LOG_GSTREAMER "failed to initialize gstreamer API\n");
+		return NULL;
+	}
+
 	gstDecoder* dec = new gstDecoder();
 	
 	if( !dec )
 		return NULL;
 	
-	if( !dec->init(codec, NULL, multicastIP, port) )
+	if( !dec->init(codec, NULL, multicastIP, port, true) )
 	{
 		printf(LOG_GSTREAMER "gstDecoder::Create() failed\n");
+		delete dec;
 		return NULL;
 	}
 	
@@ -107,16 +182,21 @@ gstDecoder* gstDecoder::Create( gstCodec codec, const char* multicastIP, uint16_
 
 
 // init
-bool gstDecoder::init( gstCodec codec, const char* filename, const char* multicastIP, uint16_t port )
+bool gstDecoder::init( gstCodec codec, const char* filename, const char* multicastIP, uint16_t port, bool sync )
 {
+	if( !filename && port == 0 )
+		return false;
+
 	mCodec 		 = codec;
-	mInputPath 	 = filename;
-	mMulticastIP = multicastIP;
+	mInputPath 	 = (filename != NULL) ? filename : "";
+	mMulticastIP = (multicastIP != NULL) ? multicastIP : "";
 	mPort 		 = port;
+	mSync        = sync;
 	GError* err  = NULL;
-	
-	if( !filename && !multicastIP )
-		return false;
+
+	// when decoding offline as fast as possible, throttle the decoder instead of dropping frames
+	if( !sync )
+		mQueue.SetPolicy(CAPTURE_QUEUE_FIFO);
 
 	// build pipeline string
 	if( !buildLaunchStr() )
@@ -153,8 +233,14 @@ bool gstDecoder::init( gstCodec codec, const char* filename, const char* multica
 		return false;
 	}
 
-	// add watch for messages (disabled when we poll the bus ourselves, instead of gmainloop)
-	//gst_bus_add_watch(mBus, (GstBusFunc)gst_message_print, NULL);
+	// handle messages from the bus thread, instead of polling from the streaming thread
+	gstBusCallbacks busCallbacks;
+	memset(&busCallbacks, 0, sizeof(gstBusCallbacks));
+
+	busCallbacks.error = onBusError;
+
+	if( !gstBusWatchAdd(mPipeline, &busCallbacks, this) )
+		return false;
 
 	// get the appsrc
 	GstElement* appsinkElement = gst_bin_get_by_name(GST_BIN(pipeline), "mysink");
@@ -181,10 +267,22 @@ bool gstDecoder::init( gstCodec codec, const char* filename, const char* multica
 #endif
 	
 	gst_app_sink_set_callbacks(mAppSink, &cb, (void*)this, NULL);
+	
+	return true;
+}
+
 
+// Open
+bool gstDecoder::Open()
+{
+	if( mStreaming )
+		return true;
 
 	// transition pipline to STATE_PLAYING
 	printf(LOG_GSTREAMER "gstDecoder - transitioning pipeline to GST_STATE_PLAYING\n");
+
+	mQueue.SetEOS(false);
+	mQueue.SetFlushing(false);
 	
 	const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_PLAYING);
 
@@ -209,14 +307,34 @@ bool gstDecoder::init( gstCodec codec, const char* filename, const char* multica
 		return false;
 	}
 
-	checkMsgBus();
 	sleepMs(100);
-	checkMsgBus();
 	
+	mStreaming = true;
 	return true;
 }
 
 
+// Close
+void gstDecoder::Close()
+{
+	if( !mStreaming )
+		return;
+
+	printf(LOG_GSTREAMER "gstDecoder - transitioning pipeline to GST_STATE_NULL\n");
+
+	// unblock the streaming thread if it's waiting for a free slot
+	mQueue.SetFlushing(true);
+
+	const GstStateChangeReturn result = gst_element_set_state(mPipeline, GST_STATE_NULL);
+
+	if( result != GST_STATE_CHANGE_SUCCESS )
+		printf(LOG_GSTREAMER "gstDecoder - failed to stop pipeline (error %u)\n", result);
+
+	sleepMs(250);
+	mStreaming = false;
+}
+
+
 // buildLaunchStr
 bool gstDecoder::buildLaunchStr()
 {
@@ -256,23 +374,30 @@ bool gstDecoder::buildLaunchStr()
 	else
 		return false;
 	
-#if GST_CHECK_VERSION(1,0,0)
-	if( mCodec == GST_CODEC_H264 )
-		ss << "omxh264dec ! ";
-	else if( mCodec == GST_CODEC_H265 )
-		ss << "omxh265dec ! ";
-#else
-	if( mCodec == GST_CODEC_H264 )
-		ss << "nv_omx_h264dec ! ";
-	else if( mCodec == GST_CODEC_H265 )
-		ss << "nv_omx_h265dec ! ";
-#endif
+	// use the hardware decoder if it's available, otherwise decode in software
+	const char* hwDecoder = (mCodec == GST_CODEC_H264) ? "omxh264dec" : "omxh265dec";
+	GstElementFactory* factory = gst_element_factory_find(hwDecoder);
 
-#define CAPS_STR "video/x-raw,format=(string)RGBA"
-//#define CAPS_STR "video/x-raw-yuv,format=(fourcc)NV12"
+	if( factory != NULL )
+	{
+		gst_object_unref(factory);
+
+		// the decoded frames are copied out of NVMM memory as NV12
+		ss << hwDecoder << " ! nvvidconv ! video/x-raw,format=(string)NV12 ! ";
+	}
+	else
+	{
+		printf(LOG_GSTREAMER "gstDecoder - %s not found, falling back to software decoding\n", hwDecoder);
+
+		// videoconvert is passthrough when the decoder already outputs one of these formats,
+		// which ConvertRGBA() can consume directly (avdec_h264 outputs I420)
+		ss << "decodebin ! videoconvert ! video/x-raw,format=(string){I420,NV12,YV12} ! ";
+	}
 
-	ss << "nvvidconv ! \"" << CAPS_STR << "\" ! ";
-	ss << "appsink name=mysink caps=\"" << CAPS_STR << "\"";
+	ss << "appsink name=mysink";
+
+	if( !mSync )
+		ss << " sync=false";
 	
 	mLaunchStr = ss.str();
 
@@ -286,6 +411,13 @@ bool gstDecoder::buildLaunchStr()
 void gstDecoder::onEOS( _GstAppSink* sink, void* user_data )
 {
 	printf(LOG_GSTREAMER "gstDecoder - onEOS()\n");
+
+	if( !user_data )
+		return;
+
+	// wake up the consumer once the queued frames run out
+	gstDecoder* dec = (gstDecoder*)user_data;
+	dec->mQueue.SetEOS(true);
 }
 
 
@@ -300,7 +432,7 @@ GstFlowReturn gstDecoder::onPreroll( _GstAppSink* sink, void* user_data )
 // onBuffer
 GstFlowReturn gstDecoder::onBuffer(_GstAppSink* sink, void* user_data)
 {
-	printf(LOG_GSTREAMER "gstDecoder - onBuffer()\n");
+	//printf(LOG_GSTREAMER "gstDecoder - onBuffer()\n");
 	
 	if( !user_data )
 		return GST_FLOW_OK;
@@ -308,15 +440,221 @@ GstFlowReturn gstDecoder::onBuffer(_GstAppSink* sink, void* user_data)
 	gstDecoder* dec = (gstDecoder*)user_data;
 	
 	dec->checkBuffer();
-	dec->checkMsgBus();
 	return GST_FLOW_OK;
 }
 
-#if GST_CHECK_VERSION(1,0,0)
+
+// Capture
+bool gstDecoder::Capture( void** cpu, void** cuda, uint64_t timeout, captureMetadata* metadata )
+{
+	// confirm the pipeline is streaming
+	if( !mStreaming )
+	{
+		if( !Open() )
+			return false;
+	}
+
+	// release the previous frame
+	mRingMutex.Lock();
+	const int previous = mLastAcquired;
+	mLastAcquired = -1;
+	mRingMutex.Unlock();
+
+	if( previous >= 0 )
+		mQueue.Release(previous);
+
+	// wait until a frame is queued
+	const int slot = mQueue.Dequeue(timeout, metadata);
+
+	if( slot < 0 )
+		return false;
+
+	mRingMutex.Lock();
+	mLastAcquired = slot;
+	mRingMutex.Unlock();
+
+	if( cpu != NULL )
+		*cpu = mRingbufferCPU[slot];
+
+	if( cuda != NULL )
+		*cuda = mRingbufferGPU[slot];
+
+	return true;
+}
+
+
+// Release
+void gstDecoder::Release( void* image )
+{
+	if( !image )
+		return;
+
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		if( !mQueue.IsAcquired(n) )
+			continue;
+
+		if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+			continue;
+
+		mRingMutex.Lock();
+
+		if( mLastAcquired == (int)n )
+			mLastAcquired = -1;
+
+		mRingMutex.Unlock();
+
+		mQueue.Release(n);
+		break;
+	}
+}
+
+
+// CaptureRGBA
+bool gstDecoder::CaptureRGBA( float** output, uint64_t timeout, bool zeroCopy )
+{
+	void* cpu = NULL;
+	void* gpu = NULL;
+
+	if( !Capture(&cpu, &gpu, timeout) )
+	{
+		if( !mQueue.IsEOS() )
+			printf(LOG_GSTREAMER "gstDecoder - failed to capture frame\n");
+
+		return false;
+	}
+
+	if( !ConvertRGBA(gpu, output, zeroCopy) )
+	{
+		printf(LOG_GSTREAMER "gstDecoder - failed to convert frame to RGBA\n");
+		return false;
+	}
+
+	return true;
+}
+
+
+// ConvertRGBA
+bool gstDecoder::ConvertRGBA( void* input, float** output, bool zeroCopy )
+{
+	if( !input || !output )
+		return false;
+
+	// check if the buffers were previously allocated with a different zeroCopy option
+	// if necessary, free them so they can be re-allocated with the correct option
+	if( mRGBA[0] != NULL && zeroCopy != mRGBAZeroCopy )
+	{
+		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+		{
+			if( mRGBA[n] != NULL )
+			{
+				if( mRGBAZeroCopy )
+					cudaFreeMapped(mRGBA[n]);
+				else
+					CUDA(cudaFree(mRGBA[n]));
+
+				mRGBA[n] = NULL;
+			}
+		}
+
+		mRGBAZeroCopy = false;	// reset for sanity
+	}
+
+	// check if the buffers need allocated
+	if( !mRGBA[0] )
+	{
+		const size_t size = mWidth * mHeight * sizeof(float4);
+
+		for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+		{
+			if( zeroCopy )
+			{
+				void* cpuPtr = NULL;
+				void* gpuPtr = NULL;
+
+				if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, CUDA_MEMORY_CODEC, false) )
+				{
+					printf(LOG_GSTREAMER "gstDecoder - failed to allocate zeroCopy memory for %ux%u RGBA texture\n", mWidth, mHeight);
+					return false;
+				}
+
+				if( cpuPtr != gpuPtr )
+				{
+					printf(LOG_GSTREAMER "gstDecoder - zeroCopy memory has different pointers, please use a UVA-compatible GPU\n");
+					return false;
+				}
+
+				mRGBA[n] = gpuPtr;
+			}
+			else
+			{
+				if( CUDA_FAILED(cudaMalloc(&mRGBA[n], size)) )
+				{
+					printf(LOG_GSTREAMER "gstDecoder - failed to allocate memory for %ux%u RGBA texture\n", mWidth, mHeight);
+					return false;
+				}
+			}
+		}
+
+		printf(LOG_GSTREAMER "gstDecoder - allocated %u RGBA ringbuffers\n", NUM_RINGBUFFERS);
+		mRGBAZeroCopy = zeroCopy;
+	}
+
+	// use the layout that the frame was decoded with
+	cudaVideoLayout layout;
+
+	if( !findLayout(input, &layout) )
+		layout = GetLayout();
+
+	if( CUDA_FAILED(cudaVideoToRGBA32(input, layout, (float4*)mRGBA[mLatestRGBA])) )
+		return false;
+
+	*output     = (float*)mRGBA[mLatestRGBA];
+	mLatestRGBA = (mLatestRGBA + 1) % NUM_RINGBUFFERS;
+	return true;
+}
+
+
+// SetQueuePolicy
+void gstDecoder::SetQueuePolicy( captureQueuePolicy policy )
+{
+	mQueue.SetPolicy(policy);
+	printf(LOG_GSTREAMER "gstDecoder - queue policy set to %s\n", captureQueuePolicyToString(policy));
+}
+
+
+// GetLayout
+cudaVideoLayout gstDecoder::GetLayout()
+{
+	mRingMutex.Lock();
+	const cudaVideoLayout layout = mLayout;
+	mRingMutex.Unlock();
+	return layout;
+}
+
+
+// findLayout
+bool gstDecoder::findLayout( void* image, cudaVideoLayout* layout )
+{
+	for( uint32_t n=0; n < NUM_RINGBUFFERS; n++ )
+	{
+		if( !mQueue.IsAcquired(n) )
+			continue;
+
+		if( mRingbufferCPU[n] != image && mRingbufferGPU[n] != image )
+			continue;
+
+		// the slot is only written while it's free, so this is stable while it's held
+		*layout = mRingLayout[n];
+		return true;
+	}
+
+	return false;
+}
+
+
 #define release_return { gst_sample_unref(gstSample); return; }
-#else
-#define release_return { gst_buffer_unref(gstBuffer); return; }
-#endif
+
 
 // checkBuffer
 void gstDecoder::checkBuffer()
@@ -324,8 +662,6 @@ void gstDecoder::checkBuffer()
 	if( !mAppSink )
 		return;
 
-	
-#if GST_CHECK_VERSION(1,0,0)
 	// block waiting for the sample
 	GstSample* gstSample = gst_app_sink_pull_sample(mAppSink);
 	
@@ -364,89 +700,81 @@ void gstDecoder::checkBuffer()
 	
 	const void* gstData = map.data;
 	const guint gstSize = map.size;
-#else
-	// block waiting for the buffer
-	GstBuffer* gstBuffer = gst_app_sink_pull_buffer(mAppSink);
-	
-	if( !gstBuffer )
-	{
-		printf(LOG_GSTREAMER "gstDecoder - app_sink_pull_buffer() returned NULL...\n");
-		return;
-	}
-	
-	// retrieve data pointer
-	void* gstData = GST_BUFFER_DATA(gstBuffer);
-	const guint gstSize = GST_BUFFER_SIZE(gstBuffer);
-	
-	if( !gstData )
-	{
-		printf(LOG_GSTREAMER "gstDecoder - gst_buffer had NULL data pointer...\n");
-		release_return;
-	}
-	
-	// retrieve caps
-	GstCaps* gstCaps = gst_buffer_get_caps(gstBuffer);
-	
-	if( !gstCaps )
+
+	// retrieve the format, dimensions and plane layout of the frame
+	cudaVideoLayout layout;
+
+	if( !gst_video_layout(gstCaps, gstBuffer, &layout) || layout.width < 1 || layout.height < 1 )
 	{
-		printf(LOG_GSTREAMER "gstDecoder - gst_buffer had NULL caps...\n");
+		printf(LOG_GSTREAMER "gstDecoder - gst_caps aren't raw video...\n");
+		gst_buffer_unmap(gstBuffer, &map);
 		release_return;
 	}
-#endif
-	// retrieve caps structure
-	GstStructure* gstCapsStruct = gst_caps_get_structure(gstCaps, 0);
-	
-	if( !gstCapsStruct )
+
+	if( layout.format != mLayout.format || layout.width != mWidth || layout.height != mHeight )
+		printf(LOG_GSTREAMER "gstDecoder - recieved %ux%u %s frame (%u bytes)\n", layout.width, layout.height, cudaVideoFormatToString(layout.format), gstSize);
+
+	mWidth  = layout.width;
+	mHeight = layout.height;
+	mDepth  = cudaVideoFormatDepth(layout.format);
+	mSize   = gstSize;
+
+	mRingMutex.Lock();
+	mLayout = layout;
+	mRingMutex.Unlock();
+
+	// get the next free ringbuffer (this blocks in CAPTURE_QUEUE_FIFO mode)
+	const int nextRingbuffer = mQueue.BeginWrite();
+
+	if( nextRingbuffer < 0 )
 	{
-		printf(LOG_GSTREAMER "gstDecoder - gst_caps had NULL structure...\n");
+		gst_buffer_unmap(gstBuffer, &map);
 		release_return;
 	}
-	
-	// retrieve the width and height of the buffer
-	int width  = 0;
-	int height = 0;
-	
-	if( !gst_structure_get_int(gstCapsStruct, "width", &width) ||
-		!gst_structure_get_int(gstCapsStruct, "height", &height) )
+
+	// the slot isn't held by a consumer while it's being written, so it can be (re)allocated
+	// here for the first frame, or for a larger frame after the caps were renegotiated
+	if( gstSize > mRingbufferSize[nextRingbuffer] )
 	{
-		printf(LOG_GSTREAMER "gstDecoder - gst_caps missing width/height...\n");
-		release_return;
+		if( mRingbufferCPU[nextRingbuffer] != NULL )
+			cudaFreeMapped(mRingbufferCPU[nextRingbuffer]);
+
+		mRingbufferCPU[nextRingbuffer]  = NULL;
+		mRingbufferGPU[nextRingbuffer]  = NULL;
+		mRingbufferSize[nextRingbuffer] = 0;
+
+		if( !cudaAllocMapped(&mRingbufferCPU[nextRingbuffer], &mRingbufferGPU[nextRingbuffer], gstSize, CUDA_MEMORY_CODEC, false) )
+		{
+			printf(LOG_GSTREAMER "gstDecoder - failed to allocate ringbuffer %i  (size=%u)\n", nextRingbuffer, gstSize);
+			gst_buffer_unmap(gstBuffer, &map);
+			mQueue.Drop(nextRingbuffer);
+			release_return;
+		}
+
+		mRingbufferSize[nextRingbuffer] = gstSize;
 	}
-	
-	printf(LOG_GSTREAMER "gstDecoder - recieved %ix%i frame\n", width, height);
-		
-	if( width < 1 || height < 1 )
-		release_return;
-	
-	/*// alloc ringbuffer
-	const DataType type(12, 1, false, false);	// NV12
-	
-	if( !AllocRingbuffer2D(width, height, type) )
-	{
-		printf(LOG_GASKET "gstreamer decoder -- failed to alloc %ix%i ringbuffer\n", width, height);
-		release_return;
-	}*/
-	
-#if GST_CHECK_VERSION(1,0,0)
+
+	memcpy(mRingbufferCPU[nextRingbuffer], gstData, gstSize);
+	mRingLayout[nextRingbuffer] = layout;
+
+	const uint64_t pts = GST_BUFFER_PTS_IS_VALID(gstBuffer) ? GST_BUFFER_PTS(gstBuffer) : UINT64_MAX;
+	const uint64_t dts = GST_BUFFER_DTS_IS_VALID(gstBuffer) ? GST_BUFFER_DTS(gstBuffer) : UINT64_MAX;
+
 	gst_buffer_unmap(gstBuffer, &map);
-#endif
-	
-	release_return;
+	gst_sample_unref(gstSample);
+
+	// queue the frame and signal sleeping threads
+	mQueue.Commit(nextRingbuffer, pts, dts);
 }
 
 
-// checkMsgBus
-void gstDecoder::checkMsgBus()
+// onBusError
+void gstDecoder::onBusError( const char* source, const char* message, void* user_data )
 {
-	while(true)
-	{
-		GstMessage* msg = gst_bus_pop(mBus);
-
-		if( !msg )
-			break;
+	if( !user_data )
+		return;
 
-		gst_message_print(mBus, msg, this);
-		gst_message_unref(msg);
-	}
+	// the pipeline has stopped, so wake up consumers instead of letting them wait for frames
+	gstDecoder* dec = (gstDecoder*)user_data;
+	dec->mQueue.SetEOS(true);
 }
-
@@ -24,47 +24,179 @@
 #define __GSTREAMER_DECODER_H__
 
 #include "gstUtility.h"
+#include "captureQueue.h"
+#include "cudaVideoFormat.h"
 
 
 struct _GstAppSink;
 
 
 /**
- * Hardware-accelerated H.264/H.265 video decoder for Jetson using GStreamer.
+ * H.264/H.265 video decoder using GStreamer, that delivers the decoded frames
+ * through a ringbuffer in CUDA mapped memory with the same Capture() API as gstCamera.
+ *
+ * The hardware decoders (`omxh264dec`/`omxh265dec`) are used on Jetson, and if
+ * they aren't installed the stream is decoded in software with `decodebin`
+ * (i.e. `avdec_h264`/`avdec_h265` from gst-libav).
+ *
  * @ingroup codec
  */
 class gstDecoder
 {
 public:
 	/**
-	 * Create an decoder instance that reads from a video file on disk.
+	 * Create an decoder instance that reads from a video file on disk (MKV container).
+	 * Frames are delivered at the framerate of the file.
+	 */
+	static gstDecoder* Create( gstCodec codec, const char* filename );
+
+	/**
+	 * Create an decoder instance that reads from a video file on disk (MKV container),
+	 * and decodes it as fast as possible instead of at the framerate of the file.
+	 * The queue policy is set to CAPTURE_QUEUE_FIFO so that no frames are dropped
+	 * (the decoder is throttled by the consumer instead).  This is useful for
+	 * replaying recordings offline.
 	 */
-	gstDecoder* Create( gstCodec codec, const char* filename );
+	static gstDecoder* CreateOffline( gstCodec codec, const char* filename );
 	
 	/**
-	 * Create an decoder instance that streams over the network.
+	 * Create an decoder instance that streams RTP over the network.
 	 */
-	gstDecoder* Create( gstCodec codec, uint16_t port );
+	static gstDecoder* Create( gstCodec codec, uint16_t port );
 	
 	/**
-	 * Create an decoder instance that streams over the network using multicast.
+	 * Create an decoder instance that streams RTP over the network using multicast.
 	 */
-	gstDecoder* Create( gstCodec codec, const char* multicastIP, uint16_t port );
+	static gstDecoder* Create( gstCodec codec, const char* multicastIP, uint16_t port );
 	
 	/**
 	 * Destructor
 	 */
 	~gstDecoder();
 	
+	/**
+	 * Begin decoding the stream.  If it wasn't called already,
+	 * Open() is called automatically by Capture().
+	 */
+	bool Open();
+
+	/**
+	 * Stop decoding the stream.
+	 */
+	void Close();
+
+	/**
+	 * Check if the decoder is streaming or not.
+	 */
+	inline bool IsStreaming() const		{ return mStreaming; }
+
+	/**
+	 * Check if the end of the stream was reached, and every decoded frame was captured.
+	 */
+	inline bool IsEOS()					{ return mQueue.IsEOS(); }
+
+	/**
+	 * Capture the next decoded frame.
+	 *
+	 * The frame is in the format that was negotiated with the decoder (see GetLayout()),
+	 * which is NV12 for the hardware decoders and typically I420 for software decoding.
+	 * It resides in CUDA mapped memory, and stays valid until Release() or the next Capture().
+	 *
+	 * @param[out] cpu Pointer that gets returned to the image in CPU address space.
+	 * @param[out] cuda Pointer that gets returned to the image in GPU address space.
+	 * @param[in] timeout The time in milliseconds to wait for a frame (UINT64_MAX waits indefinitely).
+	 * @param[out] metadata Optional pointer that gets filled with the frame's sequence number and timestamps.
+	 *
+	 * @returns `true` if a frame was captured, or `false` on timeout, error, or end of stream.
+	 */
+	bool Capture( void** cpu, void** cuda, uint64_t timeout=UINT64_MAX, captureMetadata* metadata=NULL );
+
+	/**
+	 * Release a frame that was previously returned by Capture().
+	 * @param image Either the CPU or CUDA pointer that was returned by Capture().
+	 */
+	void Release( void* image );
+
+	/**
+	 * Capture the next decoded frame and convert it to float4 RGBA format,
+	 * with pixel intensities ranging between 0.0 and 255.0.
+	 * @see gstCamera::CaptureRGBA()
+	 */
+	bool CaptureRGBA( float** image, uint64_t timeout=UINT64_MAX, bool zeroCopy=false );
+
+	/**
+	 * Convert a frame that was previously returned by Capture() to float4 RGBA.
+	 * @see gstCamera::ConvertRGBA()
+	 */
+	bool ConvertRGBA( void* input, float** output, bool zeroCopy=false );
+
+	/**
+	 * Set the policy for queueing frames when the consumer falls behind.
+	 * @see gstCamera::SetQueuePolicy()
+	 */
+	void SetQueuePolicy( captureQueuePolicy policy );
+
+	/**
+	 * Retrieve the policy for queueing frames.
+	 */
+	inline captureQueuePolicy GetQueuePolicy() const	{ return mQueue.GetPolicy(); }
+
+	/**
+	 * Return the number of frames that have been decoded.
+	 */
+	inline uint64_t GetFramesProduced()			{ return mQueue.GetProduced(); }
+
+	/**
+	 * Return the number of frames that have been retrieved with Capture().
+	 */
+	inline uint64_t GetFramesConsumed()			{ return mQueue.GetConsumed(); }
+
+	/**
+	 * Return the number of decoded frames that were dropped.
+	 */
+	inline uint64_t GetFramesDropped()			{ return mQueue.GetDropped(); }
+
+	/**
+	 * Return the number of frames that are waiting to be captured.
+	 */
+	inline uint32_t GetQueueDepth()				{ return mQueue.GetDepth(); }
+
+	/**
+	 * Return the width of the decoded frames.
+	 */
+	inline uint32_t GetWidth() const			{ return mWidth; }
+
+	/**
+	 * Return the height of the decoded frames.
+	 */
+	inline uint32_t GetHeight() const			{ return mHeight; }
+
+	/**
+	 * Return the pixel bit depth of the decoded frames (i.e. 12 for NV12/I420).
+	 */
+	inline uint32_t GetPixelDepth() const		{ return mDepth; }
+
+	/**
+	 * Return the size (in bytes) of a decoded frame from Capture().
+	 */
+	inline uint32_t GetSize() const				{ return mSize; }
+
+	/**
+	 * Return the format, plane offsets and strides of the most recent frame.
+	 */
+	cudaVideoLayout GetLayout();
 
 protected:
 	gstDecoder();
 	
-	void checkMsgBus();
+	static void onBusError( const char* source, const char* message, void* user_data );
 	void checkBuffer();
 	bool buildLaunchStr();
+	bool findLayout( void* image, cudaVideoLayout* layout );
 	
-	bool init( gstCodec codec, const char* filename, const char* multicastIP, uint16_t port );
+	static gstDecoder* create( gstCodec codec, const char* filename, bool sync );
+
+	bool init( gstCodec codec, const char* filename, const char* multicastIP, uint16_t port, bool sync );
 	
 	static void onEOS(_GstAppSink* sink, void* user_data);
 	static GstFlowReturn onPreroll(_GstAppSink* sink, void* user_data);
@@ -79,6 +211,31 @@ protected:
 	std::string  mInputPath;
 	std::string  mMulticastIP;
 	uint16_t     mPort;
+	bool         mSync;
+	bool         mStreaming;
+
+	uint32_t mWidth;
+	uint32_t mHeight;
+	uint32_t mDepth;
+	uint32_t mSize;
+
+	static const uint32_t NUM_RINGBUFFERS = 16;
+
+	void*  mRingbufferCPU[NUM_RINGBUFFERS];
+	void*  mRingbufferGPU[NUM_RINGBUFFERS];
+	size_t mRingbufferSize[NUM_RINGBUFFERS];	// allocated size of each slot
+
+	cudaVideoLayout mRingLayout[NUM_RINGBUFFERS];
+	cudaVideoLayout mLayout;
+
+	captureQueue mQueue;
+	Mutex mRingMutex;
+
+	uint32_t mLatestRGBA;
+	int      mLastAcquired;	// slot last returned by Capture(), released on the next call
+
+	void* mRGBA[NUM_RINGBUFFERS];
+	bool  mRGBAZeroCopy;
 };
   
 #endif
@@ -36,14 +36,50 @@
 #include <string.h>
 #include <strings.h>
 #include <unistd.h>
+#include <errno.h>
+
+
+// minimum number of buffers that the pool preallocates (it grows as needed)
+#define BUFFER_POOL_MIN 4
+
+
+// memory that was wrapped by EncodeI420() without copying
+struct wrappedBuffer
+{
+	void* buffer;
+	void* user_data;
+	gstEncoderReleaseCallback callback;
+};
+
+
+// gstEncoderQueuePolicyToString
+const char* gstEncoderQueuePolicyToString( gstEncoderQueuePolicy policy )
+{
+	if( policy == GST_ENCODER_QUEUE_BLOCK )				return "GST_ENCODER_QUEUE_BLOCK";
+	else if( policy == GST_ENCODER_QUEUE_DROP_NEWEST )	return "GST_ENCODER_QUEUE_DROP_NEWEST";
+	else if( policy == GST_ENCODER_QUEUE_DROP_OLDEST )	return "GST_ENCODER_QUEUE_DROP_OLDEST";
+
+	return "UNKNOWN";
+}
+
+
+// gstEncoderRateControlToString
+const char* gstEncoderRateControlToString( gstEncoderRateControl mode )
+{
+	if( mode == GST_ENCODER_RATE_VBR )		return "GST_ENCODER_RATE_VBR";
+	else if( mode == GST_ENCODER_RATE_CBR )	return "GST_ENCODER_RATE_CBR";
+
+	return "UNKNOWN";
+}
 
 
 // constructor
-gstEncoder::gstEncoder()
+gstEncoder::gstEncoder() : mQueueMutex("gstEncoder::mQueueMutex"), mAsyncMutex("gstEncoder::mAsyncMutex")
 {	
 	mAppSrc     = NULL;
 	mBus        = NULL;
 	mBufferCaps = NULL;
+	mBufferPool = NULL;
 	mPipeline   = NULL;
 	mNeedData   = false;
 	mOutputPort = 0;
@@ -55,14 +91,63 @@ gstEncoder::gstEncoder()
 	mGpuRGBA    = NULL;
 	mCpuI420    = NULL;
 	mGpuI420    = NULL;
+
+	mBufferPoolSize = 0;
+
+	mQueueHead   = 0;
+	mQueueCount  = 0;
+	mQueueSize   = DefaultQueueSize;
+	mQueuePolicy = GST_ENCODER_QUEUE_DROP_NEWEST;
+	mDraining    = false;
+
+	mFramesEnqueued = 0;
+	mFramesEncoded  = 0;
+	mFramesDropped  = 0;
+
+	for( uint32_t n=0; n < MaxQueueSize; n++ )
+		mQueue[n] = NULL;
+
+	mAsyncHead     = 0;
+	mAsyncCount    = 0;
+	mAsyncBusy     = false;
+	mWorkerStarted = false;
+	mWorkerStop    = false;
+
+	memset(mAsyncQueue, 0, sizeof(mAsyncQueue));
+
+	// blocked producers and Flush() can wait at the same time, so this gets broadcast
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&mAsyncDone, &attr);
+	pthread_condattr_destroy(&attr);
 }
 
 
 // destructor	
 gstEncoder::~gstEncoder()
 {
-	// send EOS
+	// finish the asynchronous frames first, they get added to the queue below
+	stopWorker();
+
+	// send the frames that are still queued, so they get encoded before EOS
+	mQueueMutex.Lock();
+
+	while( mQueueCount > 0 )
+	{
+		GstBuffer* gstBuffer = mQueue[mQueueHead];
+
+		mQueueHead = (mQueueHead + 1) % MaxQueueSize;
+		mQueueCount--;
+
+		mQueueMutex.Unlock();
+		pushBuffer(gstBuffer);
+		mQueueMutex.Lock();
+	}
+
 	mNeedData = false;
+	mQueueMutex.Unlock();
+	mQueueEvent.Wake();
 	
 	printf(LOG_GSTREAMER "gstEncoder - shutting down pipeline, sending EOS\n");
 	GstFlowReturn eos_result = gst_app_src_end_of_stream(GST_APP_SRC(mAppSrc));
@@ -70,7 +155,11 @@ gstEncoder::~gstEncoder()
 	if( eos_result != 0 )
 		printf(LOG_GSTREAMER "gstEncoder - failed sending appsrc EOS (result %u)\n", eos_result);
 
-	sleep(1);
+	// wait for the encoder to flush the stream to the sink
+	if( !mEOSEvent.Wait((uint64_t)EOSTimeout) )
+		printf(LOG_GSTREAMER "gstEncoder - timed out waiting for EOS to reach the sink\n");
+
+	gstBusWatchRemove(mPipeline);
 
 	// stop pipeline
 	printf(LOG_GSTREAMER "gstEncoder - transitioning pipeline to GST_STATE_NULL\n");
@@ -81,34 +170,51 @@ gstEncoder::~gstEncoder()
 		printf(LOG_GSTREAMER "gstEncoder - failed to set pipeline state to NULL (error %u)\n", result);
 
 	sleep(1);
+
+	// free the buffer pool (any buffers still in flight were released with the pipeline)
+	if( mBufferPool != NULL )
+	{
+		gst_buffer_pool_set_active(mBufferPool, FALSE);
+		gst_object_unref(mBufferPool);
+		mBufferPool = NULL;
+	}
+
+	// free the conversion buffers
+	cudaFreeMapped(mCpuI420);
+	cudaFreeMapped(mCpuRGBA);
+
+	mCpuI420 = NULL;
+	mCpuRGBA = NULL;
+
+	pthread_cond_destroy(&mAsyncDone);
 	
 	printf(LOG_GSTREAMER "gstEncoder - pipeline shutdown complete\n");	
 }
 
 
 // Create
-gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename )
+gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const gstEncoderOptions& options )
 {
-	return Create(codec, width, height, filename, NULL, 0);
+	return Create(codec, width, height, filename, NULL, 0, options);
 }
 
 
 // Create
-gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* ipAddress, uint16_t port )
+gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* ipAddress, uint16_t port, const gstEncoderOptions& options )
 {
-	return Create(codec, width, height, NULL, ipAddress, port);
+	return Create(codec, width, height, NULL, ipAddress, port, options);
 }
 
 
 // Create
-gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port )
+gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port, const gstEncoderOptions& options )
 {
 	gstEncoder* enc = new gstEncoder();
 	
 	if( !enc )
 		return NULL;
 	
-	if( !enc->init(codec, width, height, filename, ipAddress, port) )
+	if( !enc->init(codec, width, height, filename, ipAddress, port, options) )
 	{
 		printf(LOG_GSTREAMER "gstEncoder::Create() failed\n");
 		return NULL;
@@ -119,11 +225,15 @@ gstEncoder* gstEncoder::Create( gstCodec codec, uint32_t width, uint32_t height,
 
 	
 // init
-bool gstEncoder::init( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port )
+bool gstEncoder::init( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port, const gstEncoderOptions& options )
 {
-	mCodec  = codec;
-	mWidth  = width;
-	mHeight = height;
+	mCodec   = codec;
+	mWidth   = width;
+	mHeight  = height;
+	mOptions = options;
+
+	if( mOptions.framerate == 0 )
+		mOptions.framerate = 30;
 	
 	if( mWidth == 0 || mHeight == 0 )
 		return false;
@@ -197,8 +307,14 @@ bool gstEncoder::init( gstCodec codec, uint32_t width, uint32_t height, const ch
 		return false;
 	}
 	
-	// add watch for messages (disabled when we poll the bus ourselves, instead of gmainloop)
-	//gst_bus_add_watch(mBus, (GstBusFunc)gst_message_print, NULL);
+	// handle messages from the bus thread, instead of polling from the producer thread
+	gstBusCallbacks busCallbacks;
+	memset(&busCallbacks, 0, sizeof(gstBusCallbacks));
+
+	busCallbacks.eos = onBusEOS;
+
+	if( !gstBusWatchAdd(mPipeline, &busCallbacks, this) )
+		return false;
 
 	// get the appsrc element
 	GstElement* appsrcElement = gst_bin_get_by_name(GST_BIN(pipeline), "mysource");
@@ -265,13 +381,13 @@ bool gstEncoder::buildCapsStr()
 	ss << ",width=" << mWidth;
 	ss << ",height=" << mHeight;
 	ss << ",format=(string)I420";
-	ss << ",framerate=30/1";
+	ss << ",framerate=" << mOptions.framerate << "/1";
 #else
 	ss << "video/x-raw-yuv";
 	ss << ",width=" << mWidth;
 	ss << ",height=" << mHeight;
 	ss << ",format=(fourcc)I420";
-	ss << ",framerate=30/1";
+	ss << ",framerate=" << mOptions.framerate << "/1";
 #endif
 	
 	mCapsStr = ss.str();
@@ -282,6 +398,37 @@ bool gstEncoder::buildCapsStr()
 }
 	
 	
+// selectEncoder
+bool gstEncoder::selectEncoder()
+{
+	// in order of preference, the hardware encoder first
+	const char* h264[] = { "omxh264enc", "x264enc", "openh264enc", NULL };
+	const char* h265[] = { "omxh265enc", "x265enc", NULL };
+
+	const char** candidates = (mCodec == GST_CODEC_H264) ? h264 : h265;
+
+	for( uint32_t n=0; candidates[n] != NULL; n++ )
+	{
+		GstElementFactory* factory = gst_element_factory_find(candidates[n]);
+
+		if( !factory )
+		{
+			printf(LOG_GSTREAMER "gstEncoder - %s not found\n", candidates[n]);
+			continue;
+		}
+
+		gst_object_unref(factory);
+		mEncoderName = candidates[n];
+
+		printf(LOG_GSTREAMER "gstEncoder - using %s\n", candidates[n]);
+		return true;
+	}
+
+	printf(LOG_GSTREAMER "gstEncoder - couldn't find an encoder for %s\n", (mCodec == GST_CODEC_H264) ? "H.264" : "H.265");
+	return false;
+}
+
+
 // buildLaunchStr
 bool gstEncoder::buildLaunchStr()
 {
@@ -294,10 +441,75 @@ bool gstEncoder::buildLaunchStr()
 #if GST_CHECK_VERSION(1,0,0)
 	ss << mCapsStr << " ! ";
 
+	if( !selectEncoder() )
+		return false;
+
+	const gstEncoderOptions& opt = mOptions;
+	ss << mEncoderName << " name=encoder";
+
+	if( mEncoderName == "omxh264enc" || mEncoderName == "omxh265enc" )
+	{
+		if( opt.bitrate != 0 )
+			ss << " bitrate=" << opt.bitrate;
+
+		ss << " control-rate=" << ((opt.rateControl == GST_ENCODER_RATE_CBR) ? 2 : 1);
+
+		if( opt.keyframeInterval != 0 )
+			ss << " iframeinterval=" << opt.keyframeInterval;
+
+		if( mCodec == GST_CODEC_H264 )
+			ss << " num-B-frames=" << opt.bFrames;
+
+		if( opt.lowLatency )
+			ss << " preset-level=0 insert-sps-pps=true";
+	}
+	else if( mEncoderName == "x264enc" || mEncoderName == "x265enc" )
+	{
+		// the x264/x265 bitrates are in kbit/sec
+		if( opt.bitrate != 0 )
+			ss << " bitrate=" << (opt.bitrate / 1000);
+
+		if( opt.keyframeInterval != 0 )
+			ss << " key-int-max=" << opt.keyframeInterval;
+
+		if( mEncoderName == "x264enc" )
+		{
+			// VBR uses the default average bitrate mode, CBR also limits it with the VBV buffer
+			if( opt.rateControl == GST_ENCODER_RATE_CBR )
+			{
+				const uint32_t bufferMs = (opt.lowLatency && opt.framerate != 0) ? (1000 + opt.framerate - 1) / opt.framerate : 500;
+				ss << " pass=cbr vbv-buf-capacity=" << bufferMs;
+			}
+
+			ss << " bframes=" << opt.bFrames;
+		}
+		else
+		{
+			ss << " option-string=\"bframes=" << opt.bFrames << "\"";
+		}
+
+		if( opt.lowLatency )
+			ss << " tune=zerolatency speed-preset=ultrafast";
+	}
+	else if( mEncoderName == "openh264enc" )
+	{
+		// openh264 doesn't support B-frames
+		if( opt.bitrate != 0 )
+			ss << " bitrate=" << opt.bitrate;
+
+		ss << " rate-control=" << ((opt.rateControl == GST_ENCODER_RATE_CBR) ? "bitrate" : "quality");
+
+		if( opt.keyframeInterval != 0 )
+			ss << " gop-size=" << opt.keyframeInterval;
+
+		if( opt.lowLatency )
+			ss << " complexity=low";
+	}
+
 	if( mCodec == GST_CODEC_H264 )
-		ss << "omxh264enc ! video/x-h264 ! ";	// TODO:  investigate quality-level replacement
+		ss << " ! video/x-h264 ! ";
 	else if( mCodec == GST_CODEC_H265 )
-		ss << "omxh265enc ! video/x-h265 ! ";
+		ss << " ! video/x-h265 ! ";
 #else
 	if( mCodec == GST_CODEC_H264 )
 		ss << "nv_omx_h264enc quality-level=2 ! video/x-h264 ! ";
@@ -355,6 +567,34 @@ bool gstEncoder::buildLaunchStr()
 }
 
 
+// SetBitrate
+bool gstEncoder::SetBitrate( uint32_t bitrate )
+{
+	if( !mPipeline || bitrate == 0 )
+		return false;
+
+	GstElement* encoder = gst_bin_get_by_name(GST_BIN(mPipeline), "encoder");
+
+	if( !encoder )
+	{
+		printf(LOG_GSTREAMER "gstEncoder - failed to find the encoder element to set the bitrate\n");
+		return false;
+	}
+
+	// the x264/x265 bitrates are in kbit/sec, the others in bits/sec
+	if( mEncoderName == "x264enc" || mEncoderName == "x265enc" )
+		g_object_set(G_OBJECT(encoder), "bitrate", (guint)(bitrate / 1000), NULL);
+	else
+		g_object_set(G_OBJECT(encoder), "bitrate", (guint)bitrate, NULL);
+
+	gst_object_unref(encoder);
+	mOptions.bitrate = bitrate;
+
+	printf(LOG_GSTREAMER "gstEncoder - bitrate set to %u bits/sec\n", bitrate);
+	return true;
+}
+
+
 // onNeedData
 void gstEncoder::onNeedData( GstElement* pipeline, guint size, gpointer user_data )
 {
@@ -364,7 +604,13 @@ void gstEncoder::onNeedData( GstElement* pipeline, guint size, gpointer user_dat
 		return;
 
 	gstEncoder* enc = (gstEncoder*)user_data;
-	enc->mNeedData  = true;
+
+	enc->mQueueMutex.Lock();
+	enc->mNeedData = true;
+	enc->mQueueMutex.Unlock();
+
+	// send the frames that queued up while the pipeline was full
+	enc->drainQueue();
 }
  
 
@@ -377,7 +623,10 @@ void gstEncoder::onEnoughData( GstElement* pipeline, gpointer user_data )
 		return;
 
 	gstEncoder* enc = (gstEncoder*)user_data;
-	enc->mNeedData  = false;
+
+	enc->mQueueMutex.Lock();
+	enc->mNeedData = false;
+	enc->mQueueMutex.Unlock();
 }
 
 
@@ -387,16 +636,12 @@ bool gstEncoder::EncodeI420( void* buffer, size_t size )
 	if( !buffer || size == 0 )
 		return false;
 	
-	if( !mNeedData )
-	{
-		printf(LOG_GSTREAMER "gstEncoder - pipeline full, skipping frame (%zu bytes)\n", size);
-		return true;
-	}
-
-	
 #if GST_CHECK_VERSION(1,0,0)
-	// allocate gstreamer buffer memory
-	GstBuffer* gstBuffer = gst_buffer_new_allocate(NULL, size, NULL);
+	// get a recycled buffer from the pool
+	GstBuffer* gstBuffer = acquireBuffer(size);
+
+	if( !gstBuffer )
+		return false;
 	
 	// map the buffer for write access
 	GstMapInfo map; 
@@ -438,6 +683,549 @@ bool gstEncoder::EncodeI420( void* buffer, size_t size )
 	memcpy(GST_BUFFER_DATA(gstBuffer), buffer, size);
 #endif
 
+	return enqueueBuffer(gstBuffer);
+}
+
+
+// EncodeI420
+bool gstEncoder::EncodeI420( void* buffer, size_t size, gstEncoderReleaseCallback callback, void* user_data )
+{
+	if( !callback )
+		return EncodeI420(buffer, size);
+
+	if( !buffer || size == 0 )
+		return false;
+
+#if GST_CHECK_VERSION(1,0,0)
+	// wrap the user's memory, GStreamer calls onBufferReleased() when it's done with it
+	wrappedBuffer* wrapped = new wrappedBuffer;
+
+	wrapped->buffer    = buffer;
+	wrapped->user_data = user_data;
+	wrapped->callback  = callback;
+
+	GstBuffer* gstBuffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, buffer, size, 0, size, wrapped, onBufferReleased);
+
+	if( !gstBuffer )
+	{
+		printf(LOG_GSTREAMER "gstEncoder - failed to wrap %zu bytes of memory in a GstBuffer\n", size);
+		delete wrapped;
+		callback(buffer, user_data);
+		return false;
+	}
+
+	// if the frame gets dropped, unreferencing it invokes the callback
+	return enqueueBuffer(gstBuffer);
+#else
+	// wrapped memory isn't supported before GStreamer 1.0, so copy it instead
+	const bool result = EncodeI420(buffer, size);
+	callback(buffer, user_data);
+	return result;
+#endif
+}
+
+
+// onBufferReleased
+void gstEncoder::onBufferReleased( void* user_data )
+{
+	wrappedBuffer* wrapped = (wrappedBuffer*)user_data;
+
+	if( !wrapped )
+		return;
+
+	wrapped->callback(wrapped->buffer, wrapped->user_data);
+	delete wrapped;
+}
+
+
+// acquireBuffer
+GstBuffer* gstEncoder::acquireBuffer( size_t size )
+{
+	// (re)create the pool if the frame size changed
+	if( mBufferPool != NULL && mBufferPoolSize != size )
+	{
+		gst_buffer_pool_set_active(mBufferPool, FALSE);
+		gst_object_unref(mBufferPool);
+
+		mBufferPool     = NULL;
+		mBufferPoolSize = 0;
+	}
+
+	if( !mBufferPool )
+	{
+		mBufferPool = gst_buffer_pool_new();
+
+		GstStructure* config = gst_buffer_pool_get_config(mBufferPool);
+		gst_buffer_pool_config_set_params(config, mBufferCaps, size, BUFFER_POOL_MIN, 0);
+
+		if( !gst_buffer_pool_set_config(mBufferPool, config) || !gst_buffer_pool_set_active(mBufferPool, TRUE) )
+		{
+			printf(LOG_GSTREAMER "gstEncoder - failed to create buffer pool (%zu bytes), allocating buffers per frame\n", size);
+			gst_object_unref(mBufferPool);
+			mBufferPool = NULL;
+
+			return gst_buffer_new_allocate(NULL, size, NULL);
+		}
+
+		mBufferPoolSize = size;
+		printf(LOG_GSTREAMER "gstEncoder - created buffer pool (%zu bytes per buffer)\n", size);
+	}
+
+	// the pool has no maximum, so this doesn't block
+	GstBuffer* gstBuffer = NULL;
+
+	if( gst_buffer_pool_acquire_buffer(mBufferPool, &gstBuffer, NULL) != GST_FLOW_OK || !gstBuffer )
+	{
+		printf(LOG_GSTREAMER "gstEncoder - failed to acquire buffer from pool (%zu bytes)\n", size);
+		return NULL;
+	}
+
+	return gstBuffer;
+}
+
+
+// EncodeRGBAAsync
+bool gstEncoder::EncodeRGBAAsync( uint8_t* buffer, gstEncoderReleaseCallback callback, void* user_data )
+{
+	if( !buffer )
+		return false;
+
+	asyncFrame frame;
+	memset(&frame, 0, sizeof(asyncFrame));
+
+	frame.format    = ASYNC_RGBA8;
+	frame.buffer    = buffer;
+	frame.callback  = callback;
+	frame.user_data = user_data;
+
+	return enqueueAsync(frame);
+}
+
+
+// EncodeRGBAAsync
+bool gstEncoder::EncodeRGBAAsync( float* buffer, float maxPixelValue, gstEncoderReleaseCallback callback, void* user_data )
+{
+	if( !buffer )
+		return false;
+
+	asyncFrame frame;
+	memset(&frame, 0, sizeof(asyncFrame));
+
+	frame.format        = ASYNC_RGBA32;
+	frame.buffer        = buffer;
+	frame.maxPixelValue = maxPixelValue;
+	frame.callback      = callback;
+	frame.user_data     = user_data;
+
+	return enqueueAsync(frame);
+}
+
+
+// EncodeI420Async
+bool gstEncoder::EncodeI420Async( void* buffer, size_t size, gstEncoderReleaseCallback callback, void* user_data )
+{
+	if( !buffer || size == 0 )
+		return false;
+
+	asyncFrame frame;
+	memset(&frame, 0, sizeof(asyncFrame));
+
+	frame.format    = ASYNC_I420;
+	frame.buffer    = buffer;
+	frame.size      = size;
+	frame.callback  = callback;
+	frame.user_data = user_data;
+
+	return enqueueAsync(frame);
+}
+
+
+// enqueueAsync
+bool gstEncoder::enqueueAsync( const asyncFrame& frame )
+{
+	if( !startWorker() )
+		return false;
+
+	asyncFrame dropped;
+	bool hasDropped = false;
+
+	mAsyncMutex.Lock();
+
+	while(true)
+	{
+		// the queue settings are protected by mQueueMutex, and can change while waiting
+		mQueueMutex.Lock();
+		const uint32_t queueSize = mQueueSize;
+		const gstEncoderQueuePolicy policy = mQueuePolicy;
+		mQueueMutex.Unlock();
+
+		if( mAsyncCount < queueSize )
+			break;
+
+		if( policy == GST_ENCODER_QUEUE_DROP_NEWEST )
+		{
+			mAsyncMutex.Unlock();
+
+			mQueueMutex.Lock();
+			mFramesDropped++;
+			mQueueMutex.Unlock();
+
+			if( frame.callback != NULL )
+				frame.callback(frame.buffer, frame.user_data);
+
+			return false;
+		}
+		else if( policy == GST_ENCODER_QUEUE_DROP_OLDEST )
+		{
+			dropped = mAsyncQueue[mAsyncHead];
+			hasDropped = true;
+
+			mAsyncHead = (mAsyncHead + 1) % MaxQueueSize;
+			mAsyncCount--;
+		}
+		else
+		{
+			// GST_ENCODER_QUEUE_BLOCK waits for the encoder thread to take a frame
+			pthread_cond_wait(&mAsyncDone, mAsyncMutex.GetID());
+		}
+	}
+
+	mAsyncQueue[(mAsyncHead + mAsyncCount) % MaxQueueSize] = frame;
+	mAsyncCount++;
+
+	mAsyncMutex.Unlock();
+	mAsyncReady.Wake();
+
+	// return the dropped frame to its owner outside of the lock
+	if( hasDropped )
+	{
+		mQueueMutex.Lock();
+		mFramesDropped++;
+		mQueueMutex.Unlock();
+
+		if( dropped.callback != NULL )
+			dropped.callback(dropped.buffer, dropped.user_data);
+	}
+
+	return true;
+}
+
+
+// startWorker
+bool gstEncoder::startWorker()
+{
+	mAsyncMutex.Lock();
+
+	if( mWorkerStarted )
+	{
+		mAsyncMutex.Unlock();
+		return true;
+	}
+
+	mWorkerStop = false;
+
+	if( !mWorker.StartThread(&gstEncoder::workerEntry, this) )
+	{
+		mAsyncMutex.Unlock();
+		printf(LOG_GSTREAMER "gstEncoder - failed to start the encoder thread\n");
+		return false;
+	}
+
+	mWorkerStarted = true;
+	mAsyncMutex.Unlock();
+
+	return true;
+}
+
+
+// stopWorker
+void gstEncoder::stopWorker()
+{
+	mAsyncMutex.Lock();
+
+	if( !mWorkerStarted )
+	{
+		mAsyncMutex.Unlock();
+		return;
+	}
+
+	mWorkerStop = true;
+	mAsyncMutex.Unlock();
+	mAsyncReady.Wake();
+
+	// the thread finishes the frames that are still queued before it exits
+	pthread_join(*mWorker.GetThreadID(), NULL);
+	mWorker.StopThread();
+
+	mAsyncMutex.Lock();
+	mWorkerStarted = false;
+	mAsyncMutex.Unlock();
+}
+
+
+// workerEntry
+void* gstEncoder::workerEntry( void* user_data )
+{
+	gstEncoder* enc = (gstEncoder*)user_data;
+
+	while(true)
+	{
+		enc->mAsyncMutex.Lock();
+
+		if( enc->mAsyncCount == 0 )
+		{
+			const bool stop = enc->mWorkerStop;
+			enc->mAsyncMutex.Unlock();
+
+			if( stop )
+				break;
+
+			enc->mAsyncReady.Wait();
+			continue;
+		}
+
+		const asyncFrame frame = enc->mAsyncQueue[enc->mAsyncHead];
+
+		enc->mAsyncHead = (enc->mAsyncHead + 1) % MaxQueueSize;
+		enc->mAsyncCount--;
+		enc->mAsyncBusy = true;
+
+		pthread_cond_broadcast(&enc->mAsyncDone);
+		enc->mAsyncMutex.Unlock();
+
+		enc->processAsync(frame);
+
+		enc->mAsyncMutex.Lock();
+		enc->mAsyncBusy = false;
+		pthread_cond_broadcast(&enc->mAsyncDone);
+		enc->mAsyncMutex.Unlock();
+	}
+
+	return NULL;
+}
+
+
+// processAsync
+void gstEncoder::processAsync( const asyncFrame& frame )
+{
+	// the conversions synchronize with the GPU before they return,
+	// so the input buffer has been read by the time the callback is made
+	if( frame.format == ASYNC_RGBA8 )
+		EncodeRGBA((uint8_t*)frame.buffer);
+	else if( frame.format == ASYNC_RGBA32 )
+		EncodeRGBA((float*)frame.buffer, frame.maxPixelValue);
+	else if( frame.format == ASYNC_I420 )
+		EncodeI420(frame.buffer, frame.size);
+
+	if( frame.callback != NULL )
+		frame.callback(frame.buffer, frame.user_data);
+}
+
+
+// Flush
+bool gstEncoder::Flush( uint64_t timeout )
+{
+	// mAsyncDone waits on the monotonic clock, until an absolute time
+	const timespec deadline = timeAdd(timestampMonotonic(), timeNew(timeout / 1000, (timeout % 1000) * 1000000));
+
+	mAsyncMutex.Lock();
+
+	while( mAsyncCount > 0 || mAsyncBusy )
+	{
+		if( timeout == UINT64_MAX )
+		{
+			pthread_cond_wait(&mAsyncDone, mAsyncMutex.GetID());
+			continue;
+		}
+
+		if( pthread_cond_timedwait(&mAsyncDone, mAsyncMutex.GetID(), &deadline) == ETIMEDOUT )
+		{
+			const bool idle = (mAsyncCount == 0 && !mAsyncBusy);
+			mAsyncMutex.Unlock();
+			return idle;
+		}
+	}
+
+	mAsyncMutex.Unlock();
+	return true;
+}
+
+
+// GetAsyncDepth
+uint32_t gstEncoder::GetAsyncDepth()
+{
+	mAsyncMutex.Lock();
+	const uint32_t depth = mAsyncCount;
+	mAsyncMutex.Unlock();
+	return depth;
+}
+
+
+// enqueueBuffer
+bool gstEncoder::enqueueBuffer( GstBuffer* gstBuffer )
+{
+	GstBuffer* dropped = NULL;
+
+	mQueueMutex.Lock();
+
+	while( mQueueCount >= mQueueSize )
+	{
+		if( mQueuePolicy == GST_ENCODER_QUEUE_DROP_NEWEST )
+		{
+			mFramesDropped++;
+			mQueueMutex.Unlock();
+
+			gst_buffer_unref(gstBuffer);
+			return false;
+		}
+		else if( mQueuePolicy == GST_ENCODER_QUEUE_DROP_OLDEST )
+		{
+			dropped = mQueue[mQueueHead];
+
+			mQueueHead = (mQueueHead + 1) % MaxQueueSize;
+			mQueueCount--;
+			mFramesDropped++;
+		}
+		else
+		{
+			// GST_ENCODER_QUEUE_BLOCK waits for the encoder to take a frame
+			mQueueMutex.Unlock();
+			mQueueEvent.Wait();
+			mQueueMutex.Lock();
+		}
+	}
+
+	mQueue[(mQueueHead + mQueueCount) % MaxQueueSize] = gstBuffer;
+	mQueueCount++;
+	mFramesEnqueued++;
+
+	mQueueMutex.Unlock();
+
+	// unreference outside of the lock, because it can call back into user code
+	if( dropped != NULL )
+		gst_buffer_unref(dropped);
+
+	drainQueue();
+	return true;
+}
+
+
+// drainQueue
+void gstEncoder::drainQueue()
+{
+	mQueueMutex.Lock();
+
+	// only one thread pushes at a time, so the frames stay in order
+	if( mDraining )
+	{
+		mQueueMutex.Unlock();
+		return;
+	}
+
+	mDraining = true;
+
+	while( mNeedData && mQueueCount > 0 )
+	{
+		GstBuffer* gstBuffer = mQueue[mQueueHead];
+
+		mQueueHead = (mQueueHead + 1) % MaxQueueSize;
+		mQueueCount--;
+		mFramesEncoded++;
+
+		// pushing can emit enough-data, which locks the mutex
+		mQueueMutex.Unlock();
+		mQueueEvent.Wake();
+
+		pushBuffer(gstBuffer);
+		mQueueMutex.Lock();
+	}
+
+	mDraining = false;
+	mQueueMutex.Unlock();
+}
+
+
+// SetQueuePolicy
+void gstEncoder::SetQueuePolicy( gstEncoderQueuePolicy policy )
+{
+	mQueueMutex.Lock();
+	mQueuePolicy = policy;
+	mQueueMutex.Unlock();
+
+	// let blocked callers re-evaluate the policy
+	mQueueEvent.Wake();
+
+	mAsyncMutex.Lock();
+	pthread_cond_broadcast(&mAsyncDone);
+	mAsyncMutex.Unlock();
+
+	printf(LOG_GSTREAMER "gstEncoder - queue policy set to %s\n", gstEncoderQueuePolicyToString(policy));
+}
+
+
+// SetQueueSize
+void gstEncoder::SetQueueSize( uint32_t size )
+{
+	if( size < 1 )
+		size = 1;
+	else if( size > MaxQueueSize )
+		size = MaxQueueSize;
+
+	mQueueMutex.Lock();
+	mQueueSize = size;
+	mQueueMutex.Unlock();
+
+	mQueueEvent.Wake();
+
+	mAsyncMutex.Lock();
+	pthread_cond_broadcast(&mAsyncDone);
+	mAsyncMutex.Unlock();
+}
+
+
+// GetFramesEnqueued
+uint64_t gstEncoder::GetFramesEnqueued()
+{
+	mQueueMutex.Lock();
+	const uint64_t count = mFramesEnqueued;
+	mQueueMutex.Unlock();
+	return count;
+}
+
+
+// GetFramesEncoded
+uint64_t gstEncoder::GetFramesEncoded()
+{
+	mQueueMutex.Lock();
+	const uint64_t count = mFramesEncoded;
+	mQueueMutex.Unlock();
+	return count;
+}
+
+
+// GetFramesDropped
+uint64_t gstEncoder::GetFramesDropped()
+{
+	mQueueMutex.Lock();
+	const uint64_t count = mFramesDropped;
+	mQueueMutex.Unlock();
+	return count;
+}
+
+
+// GetQueueDepth
+uint32_t gstEncoder::GetQueueDepth()
+{
+	mQueueMutex.Lock();
+	const uint32_t depth = mQueueCount;
+	mQueueMutex.Unlock();
+	return depth;
+}
+
+
+// pushBuffer
+bool gstEncoder::pushBuffer( GstBuffer* gstBuffer )
+{
 	// queue buffer to gstreamer
 	GstFlowReturn ret;	
 	g_signal_emit_by_name(mAppSrc, "push-buffer", gstBuffer, &ret);
@@ -446,19 +1234,18 @@ bool gstEncoder::EncodeI420( void* buffer, size_t size )
 	if( ret != 0 )
 		printf(LOG_GSTREAMER "gstEncoder - AppSrc pushed buffer abnormally (result %u)\n", ret);
 
-	// check for any messages
-	while(true)
-	{
-		GstMessage* msg = gst_bus_pop(mBus);
+	return true;
+}
 
-		if( !msg )
-			break;
 
-		gst_message_print(mBus, msg, this);
-		gst_message_unref(msg);
-	}
-	
-	return true;
+// onBusEOS
+void gstEncoder::onBusEOS( void* user_data )
+{
+	if( !user_data )
+		return;
+
+	gstEncoder* enc = (gstEncoder*)user_data;
+	enc->mEOSEvent.Wake();
 }
 
 
@@ -472,7 +1259,7 @@ bool gstEncoder::EncodeRGBA( uint8_t* buffer )
 
 	if( !mCpuI420 || !mGpuI420 )
 	{
-		if( !cudaAllocMapped(&mCpuI420, &mGpuI420, i420Size) )
+		if( !cudaAllocMapped(&mCpuI420, &mGpuI420, i420Size, CUDA_MEMORY_CODEC, false) )
 		{
 			printf(LOG_GSTREAMER "gstEncoder - failed to allocate CUDA memory for YUV I420 conversion\n");
 			return false;
@@ -499,7 +1286,7 @@ bool gstEncoder::EncodeRGBA( float* buffer, float maxPixelValue )
 
 	if( !mCpuRGBA || !mGpuRGBA )
 	{
-		if( !cudaAllocMapped(&mCpuRGBA, &mGpuRGBA, mWidth * mHeight * 4 * sizeof(uint8_t)) )
+		if( !cudaAllocMapped(&mCpuRGBA, &mGpuRGBA, mWidth * mHeight * 4 * sizeof(uint8_t), CUDA_MEMORY_CODEC, false) )
 		{
 			printf(LOG_GSTREAMER "gstEncoder - failed to allocate CUDA memory for RGBA8 conversion\n");
 			return false;
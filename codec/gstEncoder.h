@@ -25,11 +25,86 @@
 
 #include "gstUtility.h"
 
+#include "Mutex.h"
+#include "Event.h"
+#include "Thread.h"
+
+
+/**
+ * Enumeration of policies for when frames are submitted faster than the encoder consumes them.
+ * @see gstEncoder::SetQueuePolicy()
+ * @ingroup codec
+ */
+enum gstEncoderQueuePolicy
+{
+	GST_ENCODER_QUEUE_BLOCK,		/**< Block the caller until there's room in the queue */
+	GST_ENCODER_QUEUE_DROP_NEWEST,	/**< Drop the frame being submitted while the queue is full (default) */
+	GST_ENCODER_QUEUE_DROP_OLDEST	/**< Drop the oldest queued frame to make room for the new one */
+};
+
+/**
+ * Stringize function to convert gstEncoderQueuePolicy enum to text
+ * @ingroup codec
+ */
+const char* gstEncoderQueuePolicyToString( gstEncoderQueuePolicy policy );
+
+
+/**
+ * Enumeration of the rate control modes of the encoder.
+ * @see gstEncoderOptions
+ * @ingroup codec
+ */
+enum gstEncoderRateControl
+{
+	GST_ENCODER_RATE_VBR,	/**< Variable bitrate, that averages out to the target bitrate (default) */
+	GST_ENCODER_RATE_CBR	/**< Constant bitrate */
+};
+
+/**
+ * Stringize function to convert gstEncoderRateControl enum to text
+ * @ingroup codec
+ */
+const char* gstEncoderRateControlToString( gstEncoderRateControl mode );
+
+
+/**
+ * Encoding parameters that are passed to gstEncoder::Create().
+ * Values that are 0 leave the setting at the encoder's default.
+ * @ingroup codec
+ */
+struct gstEncoderOptions
+{
+	uint32_t framerate;					/**< Frames per second that are submitted (default 30) */
+	uint32_t bitrate;					/**< Target bitrate in bits per second */
+	gstEncoderRateControl rateControl;	/**< Rate control mode (default GST_ENCODER_RATE_VBR) */
+	uint32_t keyframeInterval;			/**< Number of frames between keyframes (the GOP length) */
+	uint32_t bFrames;					/**< Number of B-frames between reference frames (default 0) */
+	bool     lowLatency;				/**< Tune the encoder for latency over compression (default false) */
+
+	/**
+	 * Constructor, sets the default options.
+	 */
+	gstEncoderOptions() : framerate(30), bitrate(0), rateControl(GST_ENCODER_RATE_VBR), keyframeInterval(0), bFrames(0), lowLatency(false) {}
+};
+
+
+/**
+ * Function pointer typedef for the callback that gets invoked once the encoder
+ * is done reading a buffer that was passed to gstEncoder::EncodeI420() without copying.
+ * @param buffer the pointer that was passed to EncodeI420()
+ * @param user_data the user_data that was passed to EncodeI420()
+ * @ingroup codec
+ */
+typedef void (*gstEncoderReleaseCallback)( void* buffer, void* user_data );
+
 
 /**
  * Hardware-accelerated H.264/H.265 video encoder for Jetson using GStreamer.
  * The encoder can write the encoded video to disk in .mkv or .h264/.h265 formats,
  * or handle streaming network transmission to remote host(s) via RTP/RTSP protocol.
+ *
+ * The hardware encoders (`omxh264enc`/`omxh265enc`) are used when they're available,
+ * otherwise the software encoders `x264enc`/`x265enc` (or `openh264enc`) are used.
  * @ingroup codec
  */
 class gstEncoder
@@ -38,17 +113,17 @@ public:
 	/**
 	 * Create an encoder instance that outputs to a file on disk.
 	 */
-	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename );
+	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const gstEncoderOptions& options=gstEncoderOptions() );
 	
 	/**
 	 * Create an encoder instance that streams over the network.
 	 */
-	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* ipAddress, uint16_t port );
+	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* ipAddress, uint16_t port, const gstEncoderOptions& options=gstEncoderOptions() );
 	
 	/**
 	 * Create an encoder instance that outputs to a file on disk and streams over the network.
 	 */
-	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port );
+	static gstEncoder* Create( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port, const gstEncoderOptions& options=gstEncoderOptions() );
 	
 	/**
 	 * Destructor
@@ -81,9 +156,83 @@ public:
 	 * Encode the next I420 frame provided by the user.
 	 * Expects 12-bpp (bit per pixel) image in YUV I420 format.
 	 * This image is passed to GStreamer, so CPU pointer should be used.
+	 *
+	 * The image is copied into a GstBuffer from a pool that's recycled between
+	 * frames, so the buffer pointer can be reused as soon as this returns.
+	 *
+	 * Frames wait in a bounded queue until the encoder is ready for them,
+	 * and what happens when the queue is full depends on the queue policy.
+	 *
 	 * @param buffer CPU pointer to the I420 image
+	 * @returns `false` on error, or if the frame was dropped (GST_ENCODER_QUEUE_DROP_NEWEST).
 	 */
 	bool EncodeI420( void* buffer, size_t size );
+
+	/**
+	 * Encode the next I420 frame provided by the user, without copying it.
+	 *
+	 * The memory is wrapped in a GstBuffer and passed to GStreamer directly,
+	 * so it must not be modified or freed until the callback is invoked.
+	 * The callback is called exactly once for each call to this function,
+	 * either from the GStreamer streaming thread after the encoder is done
+	 * reading from the buffer, or from whichever thread dropped the frame
+	 * from the queue (before this function returns, for GST_ENCODER_QUEUE_DROP_NEWEST).
+	 *
+	 * @param buffer CPU pointer to the I420 image
+	 * @param callback function that gets called when the buffer can be reused
+	 * @param user_data pointer that gets passed to the callback
+	 */
+	bool EncodeI420( void* buffer, size_t size, gstEncoderReleaseCallback callback, void* user_data=NULL );
+
+	/**
+	 * Encode the next fixed-point RGBA frame asynchronously.
+	 *
+	 * The frame is queued for the encoder thread, which performs the colorspace
+	 * conversion and passes it to GStreamer, so this returns without waiting for
+	 * either.  The buffer must not be modified or freed until the callback is invoked,
+	 * which happens on the encoder thread once the conversion is done reading from it,
+	 * or when the frame is dropped.  The callback is called exactly once per frame.
+	 *
+	 * Up to GetQueueSize() frames can wait for the encoder thread, and the queue policy
+	 * decides what happens when it's full (like it does for the frames waiting on GStreamer).
+	 *
+	 * The conversion buffers are shared with EncodeRGBA(), so the synchronous and
+	 * asynchronous functions shouldn't be used at the same time from different threads.
+	 *
+	 * @param buffer CUDA pointer to the RGBA image.
+	 * @param callback function that gets called when the buffer can be reused (may be NULL)
+	 * @param user_data pointer that gets passed to the callback
+	 * @returns `false` on error, or if the frame was dropped (GST_ENCODER_QUEUE_DROP_NEWEST).
+	 */
+	bool EncodeRGBAAsync( uint8_t* buffer, gstEncoderReleaseCallback callback, void* user_data=NULL );
+
+	/**
+	 * Encode the next floating-point RGBA frame asynchronously.
+	 * @see EncodeRGBAAsync() for the fixed-point version.
+	 * @param buffer CUDA pointer to the RGBA image.
+	 * @param maxPixelValue indicates the maximum pixel intensity (typically 255.0f or 1.0f)
+	 */
+	bool EncodeRGBAAsync( float* buffer, float maxPixelValue, gstEncoderReleaseCallback callback, void* user_data=NULL );
+
+	/**
+	 * Encode the next I420 frame asynchronously.  The encoder thread copies it into
+	 * a pooled GstBuffer, and then invokes the callback.
+	 * @see EncodeRGBAAsync()
+	 * @param buffer CPU pointer to the I420 image
+	 */
+	bool EncodeI420Async( void* buffer, size_t size, gstEncoderReleaseCallback callback, void* user_data=NULL );
+
+	/**
+	 * Wait for the encoder thread to finish the frames that were queued asynchronously.
+	 * @param timeout The time in milliseconds to wait, or UINT64_MAX to wait indefinitely.
+	 * @returns `true` if the frames were finished, or `false` on timeout.
+	 */
+	bool Flush( uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Return the number of asynchronous frames that are waiting for the encoder thread.
+	 */
+	uint32_t GetAsyncDepth();
 	
 	/**
 	 * Retrieve the width that the encoder was created for, in pixels.
@@ -95,23 +244,127 @@ public:
 	 */
 	inline uint32_t GetHeight() const			{ return mHeight; }
 
+	/**
+	 * Retrieve the options that the encoder was created with
+	 * (including any changes from SetBitrate()).
+	 */
+	inline const gstEncoderOptions& GetOptions() const	{ return mOptions; }
+
+	/**
+	 * Retrieve the name of the GStreamer element that's being used for encoding.
+	 */
+	inline const char* GetEncoderName() const	{ return mEncoderName.c_str(); }
+
+	/**
+	 * Change the target bitrate (in bits per second) while the encoder is running.
+	 * @returns `true` on success, or `false` if the encoder element couldn't be found.
+	 */
+	bool SetBitrate( uint32_t bitrate );
+
+	/**
+	 * Set the policy for when the queue of frames waiting to be encoded is full.
+	 * The policy can be changed at any time.
+	 */
+	void SetQueuePolicy( gstEncoderQueuePolicy policy );
+
+	/**
+	 * Retrieve the policy for when the queue is full.
+	 */
+	inline gstEncoderQueuePolicy GetQueuePolicy() const	{ return mQueuePolicy; }
+
+	/**
+	 * Set the maximum number of frames that can wait to be encoded (between 1 and MaxQueueSize).
+	 * Frames that are already queued beyond the new size aren't dropped.
+	 */
+	void SetQueueSize( uint32_t size );
+
+	/**
+	 * Retrieve the maximum number of frames that can wait to be encoded.
+	 */
+	inline uint32_t GetQueueSize() const		{ return mQueueSize; }
+
+	/**
+	 * Return the number of frames that were accepted into the queue.
+	 */
+	uint64_t GetFramesEnqueued();
+
+	/**
+	 * Return the number of frames that were passed from the queue to the encoder.
+	 */
+	uint64_t GetFramesEncoded();
+
+	/**
+	 * Return the number of frames that were dropped because the queue was full.
+	 */
+	uint64_t GetFramesDropped();
+
+	/**
+	 * Return the number of frames that are currently waiting in the queue.
+	 */
+	uint32_t GetQueueDepth();
+
+	/**
+	 * Default number of frames that can wait to be encoded.
+	 */
+	static const uint32_t DefaultQueueSize = 4;
+
+	/**
+	 * Maximum number of frames that can wait to be encoded.
+	 */
+	static const uint32_t MaxQueueSize = 32;
+
 protected:
 	gstEncoder();
 	
 	bool buildCapsStr();
 	bool buildLaunchStr();
 	
-	bool init( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port );
+	bool init( gstCodec codec, uint32_t width, uint32_t height, const char* filename, const char* ipAddress, uint16_t port, const gstEncoderOptions& options );
+	bool selectEncoder();
+
+	_GstBuffer* acquireBuffer( size_t size );
+	bool pushBuffer( _GstBuffer* buffer );
+	bool enqueueBuffer( _GstBuffer* buffer );
+	void drainQueue();
 	
 	static void onNeedData( _GstElement* pipeline, uint32_t size, void* user_data );
 	static void onEnoughData( _GstElement* pipeline, void* user_data );
+	static void onBufferReleased( void* user_data );
+	static void onBusEOS( void* user_data );
+
+	// frames that were queued by the Encode*Async() functions
+	enum asyncFormat
+	{
+		ASYNC_RGBA8,
+		ASYNC_RGBA32,
+		ASYNC_I420
+	};
+
+	struct asyncFrame
+	{
+		asyncFormat format;
+		void*       buffer;
+		size_t      size;
+		float       maxPixelValue;
+		void*       user_data;
+		gstEncoderReleaseCallback callback;
+	};
+
+	bool enqueueAsync( const asyncFrame& frame );
+	bool startWorker();
+	void stopWorker();
+	void processAsync( const asyncFrame& frame );
+
+	static void* workerEntry( void* user_data );
 
 	_GstBus*     mBus;
+	_GstBufferPool* mBufferPool;
+	size_t       mBufferPoolSize;
 	_GstCaps*    mBufferCaps;
 	_GstElement* mAppSrc;
 	_GstElement* mPipeline;
 	gstCodec     mCodec;
-	bool         mNeedData;
+	bool         mNeedData;		// protected by mQueueMutex
 	uint32_t     mWidth;
 	uint32_t     mHeight;
 	
@@ -120,12 +373,49 @@ protected:
 	std::string  mOutputPath;
 	std::string  mOutputIP;
 	uint16_t     mOutputPort;
+	std::string  mEncoderName;	// GStreamer element used for encoding
+
+	gstEncoderOptions mOptions;
 
 	// format conversion buffers
 	void* mCpuRGBA;
 	void* mGpuRGBA;
 	void* mCpuI420;
 	void* mGpuI420;
+
+	// frames waiting for the appsrc to request data
+	_GstBuffer* mQueue[MaxQueueSize];
+	uint32_t    mQueueHead;
+	uint32_t    mQueueCount;
+	uint32_t    mQueueSize;
+	bool        mDraining;		// is a thread currently pushing from the queue?
+
+	gstEncoderQueuePolicy mQueuePolicy;
+
+	uint64_t mFramesEnqueued;
+	uint64_t mFramesEncoded;
+	uint64_t mFramesDropped;
+
+	Mutex mQueueMutex;
+	Event mQueueEvent;		// signalled when a frame leaves the queue
+
+	// encoder thread for the asynchronous frames
+	asyncFrame mAsyncQueue[MaxQueueSize];
+	uint32_t   mAsyncHead;
+	uint32_t   mAsyncCount;
+	bool       mAsyncBusy;		// is the encoder thread working on a frame?
+	bool       mWorkerStarted;
+	bool       mWorkerStop;
+
+	Thread mWorker;
+	Mutex  mAsyncMutex;
+	Event  mAsyncReady;		// signalled when a frame is queued for the encoder thread
+
+	pthread_cond_t mAsyncDone;	// broadcast under mAsyncMutex when the encoder thread takes or finishes a frame
+
+	Event  mEOSEvent;		// signalled by the bus thread when EOS reaches the sink
+
+	static const uint64_t EOSTimeout = 3000;	// milliseconds to wait for EOS on shutdown
 };
  
  
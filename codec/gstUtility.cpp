@@ -21,10 +21,17 @@
  */
 
 #include "gstUtility.h"
+#include "cudaVideoFormat.h"
+
+#include "Mutex.h"
+#include "Thread.h"
 
 #include <gst/gst.h>
+#include <gst/video/video.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <vector>
 
 
 inline const char* gst_debug_level_str( GstDebugLevel level )
@@ -244,3 +251,325 @@ gboolean gst_message_print(GstBus* bus, GstMessage* message, gpointer user_data)
 	return TRUE;
 }
 
+
+// gst_buffer_latency
+uint64_t gst_buffer_latency(_GstElement* pipeline, _GstBuffer* buffer)
+{
+	if( !pipeline || !buffer || !GST_BUFFER_PTS_IS_VALID(buffer) )
+		return UINT64_MAX;
+
+	GstClock* clock = gst_element_get_clock(pipeline);
+
+	if( !clock )
+		return UINT64_MAX;
+
+	const GstClockTime now  = gst_clock_get_time(clock);
+	const GstClockTime base = gst_element_get_base_time(pipeline);
+
+	gst_object_unref(clock);
+
+	if( now < base || now - base < GST_BUFFER_PTS(buffer) )
+		return UINT64_MAX;
+
+	return (now - base) - GST_BUFFER_PTS(buffer);
+}
+
+
+// gst_video_layout
+bool gst_video_layout(_GstCaps* caps, _GstBuffer* buffer, cudaVideoLayout* layout)
+{
+	if( !caps || !layout )
+		return false;
+
+	GstVideoInfo info;
+
+	if( !gst_video_info_from_caps(&info, caps) )
+		return false;
+
+	memset(layout, 0, sizeof(cudaVideoLayout));
+
+	switch(GST_VIDEO_INFO_FORMAT(&info))
+	{
+		case GST_VIDEO_FORMAT_NV12:	layout->format = CUDA_VIDEO_NV12;	break;
+		case GST_VIDEO_FORMAT_NV16:	layout->format = CUDA_VIDEO_NV16;	break;
+		case GST_VIDEO_FORMAT_I420:	layout->format = CUDA_VIDEO_I420;	break;
+		case GST_VIDEO_FORMAT_YV12:	layout->format = CUDA_VIDEO_YV12;	break;
+		case GST_VIDEO_FORMAT_YUY2:	layout->format = CUDA_VIDEO_YUY2;	break;
+		case GST_VIDEO_FORMAT_UYVY:	layout->format = CUDA_VIDEO_UYVY;	break;
+		case GST_VIDEO_FORMAT_GRAY8:	layout->format = CUDA_VIDEO_GRAY8;	break;
+		case GST_VIDEO_FORMAT_RGB:	layout->format = CUDA_VIDEO_RGB;	break;
+		case GST_VIDEO_FORMAT_BGR:	layout->format = CUDA_VIDEO_BGR;	break;
+		case GST_VIDEO_FORMAT_RGBx:
+		case GST_VIDEO_FORMAT_RGBA:	layout->format = CUDA_VIDEO_RGBX;	break;
+		case GST_VIDEO_FORMAT_BGRx:
+		case GST_VIDEO_FORMAT_BGRA:	layout->format = CUDA_VIDEO_BGRX;	break;
+		default:					layout->format = CUDA_VIDEO_UNKNOWN;	break;
+	}
+
+	layout->width  = GST_VIDEO_INFO_WIDTH(&info);
+	layout->height = GST_VIDEO_INFO_HEIGHT(&info);
+	layout->planes = GST_VIDEO_INFO_N_PLANES(&info);
+	layout->size   = GST_VIDEO_INFO_SIZE(&info);
+
+	if( layout->planes > 3 )
+		layout->planes = 3;
+
+	for( uint32_t n=0; n < layout->planes; n++ )
+	{
+		layout->offset[n] = GST_VIDEO_INFO_PLANE_OFFSET(&info, n);
+		layout->stride[n] = GST_VIDEO_INFO_PLANE_STRIDE(&info, n);
+	}
+
+	// upstream elements can attach their own plane layout when it's padded
+	GstVideoMeta* meta = (buffer != NULL) ? gst_buffer_get_video_meta(buffer) : NULL;
+
+	if( meta != NULL )
+	{
+		for( uint32_t n=0; n < layout->planes && n < meta->n_planes; n++ )
+		{
+			layout->offset[n] = meta->offset[n];
+			layout->stride[n] = meta->stride[n];
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------------------------
+
+// pipeline that's registered with the bus watch thread
+struct gstBusWatch
+{
+	GstElement* pipeline;
+	GSource*    source;
+	bool        removed;
+	void*       user_data;
+	gstBusCallbacks callbacks;
+};
+
+static std::vector<gstBusWatch*> gBusWatches;
+
+static GMainContext* gBusContext = NULL;
+static GMainLoop*    gBusLoop    = NULL;
+
+static Thread gBusThread;
+static bool   gBusThreadStarted = false;
+static Mutex  gBusMutex;	// protects gBusWatches, and is held while a message is dispatched
+
+
+// gst_bus_thread_current
+static inline bool gst_bus_thread_current()
+{
+	return gBusThreadStarted && pthread_equal(pthread_self(), *gBusThread.GetThreadID());
+}
+
+
+// gst_bus_thread
+static void* gst_bus_thread( void* user_data )
+{
+	g_main_context_push_thread_default(gBusContext);
+	g_main_loop_run(gBusLoop);
+	g_main_context_pop_thread_default(gBusContext);
+	return NULL;
+}
+
+
+// gst_bus_watch_free
+static void gst_bus_watch_free( gpointer user_data )
+{
+	delete (gstBusWatch*)user_data;
+}
+
+
+// gst_bus_watch_dispatch
+static gboolean gst_bus_watch_dispatch( GstBus* bus, GstMessage* message, gpointer user_data )
+{
+	gstBusWatch* watch = (gstBusWatch*)user_data;
+
+	gBusMutex.Lock();
+
+	if( watch->removed )
+	{
+		gBusMutex.Unlock();
+		return FALSE;
+	}
+
+	const gstBusCallbacks& cb = watch->callbacks;
+
+	switch( GST_MESSAGE_TYPE(message) )
+	{
+		case GST_MESSAGE_EOS:
+		{
+			gst_message_print(bus, message, watch->user_data);
+
+			if( cb.eos != NULL )
+				cb.eos(watch->user_data);
+
+			break;
+		}
+		case GST_MESSAGE_ERROR:
+		{
+			gst_message_print(bus, message, watch->user_data);
+
+			if( cb.error != NULL )
+			{
+				GError* err = NULL;
+				gst_message_parse_error(message, &err, NULL);
+
+				cb.error(GST_OBJECT_NAME(message->src), (err != NULL) ? err->message : "unknown error", watch->user_data);
+
+				if( err != NULL )
+					g_error_free(err);
+			}
+
+			break;
+		}
+		case GST_MESSAGE_LATENCY:
+		{
+			// redistribute the latency, as the application is expected to
+			printf(LOG_GSTREAMER "gstreamer %s changed latency, recalculating\n", GST_OBJECT_NAME(message->src));
+			gst_bin_recalculate_latency(GST_BIN(watch->pipeline));
+
+			if( cb.latency != NULL )
+				cb.latency(watch->user_data);
+
+			break;
+		}
+		case GST_MESSAGE_QOS:
+		{
+			GstFormat format  = GST_FORMAT_UNDEFINED;
+			guint64 processed = UINT64_MAX;
+			guint64 dropped   = UINT64_MAX;
+
+			gst_message_parse_qos_stats(message, &format, &processed, &dropped);
+
+			if( format != GST_FORMAT_BUFFERS && format != GST_FORMAT_DEFAULT )
+			{
+				processed = UINT64_MAX;
+				dropped   = UINT64_MAX;
+			}
+
+			if( cb.qos != NULL )
+				cb.qos(GST_OBJECT_NAME(message->src), processed, dropped, watch->user_data);
+
+			break;
+		}
+		default:
+		{
+			gst_message_print(bus, message, watch->user_data);
+			break;
+		}
+	}
+
+	gBusMutex.Unlock();
+	return TRUE;
+}
+
+
+// gstBusWatchAdd
+bool gstBusWatchAdd( _GstElement* pipeline, const gstBusCallbacks* callbacks, void* user_data )
+{
+	if( !pipeline )
+		return false;
+
+	gBusMutex.Lock();
+
+	for( size_t n=0; n < gBusWatches.size(); n++ )
+	{
+		if( gBusWatches[n]->pipeline == pipeline )
+		{
+			gBusMutex.Unlock();
+			printf(LOG_GSTREAMER "gstBusWatchAdd() -- pipeline was already registered\n");
+			return false;
+		}
+	}
+
+	// start the bus thread on first use
+	if( !gBusThreadStarted )
+	{
+		gBusContext = g_main_context_new();
+		gBusLoop    = g_main_loop_new(gBusContext, FALSE);
+
+		if( !gBusThread.StartThread(gst_bus_thread, NULL) )
+		{
+			g_main_loop_unref(gBusLoop);
+			g_main_context_unref(gBusContext);
+
+			gBusLoop    = NULL;
+			gBusContext = NULL;
+
+			gBusMutex.Unlock();
+			printf(LOG_GSTREAMER "gstBusWatchAdd() -- failed to start the bus watch thread\n");
+			return false;
+		}
+
+		gBusThreadStarted = true;
+	}
+
+	GstBus* bus = gst_element_get_bus(pipeline);
+
+	if( !bus )
+	{
+		gBusMutex.Unlock();
+		printf(LOG_GSTREAMER "gstBusWatchAdd() -- failed to retrieve GstBus from pipeline\n");
+		return false;
+	}
+
+	gstBusWatch* watch = new gstBusWatch();
+
+	watch->pipeline  = pipeline;
+	watch->removed   = false;
+	watch->user_data = user_data;
+	watch->source    = gst_bus_create_watch(bus);
+
+	if( callbacks != NULL )
+		watch->callbacks = *callbacks;
+	else
+		memset(&watch->callbacks, 0, sizeof(gstBusCallbacks));
+
+	gst_object_unref(bus);
+
+	g_source_set_callback(watch->source, (GSourceFunc)gst_bus_watch_dispatch, watch, gst_bus_watch_free);
+	g_source_attach(watch->source, gBusContext);
+
+	gBusWatches.push_back(watch);
+	gBusMutex.Unlock();
+
+	return true;
+}
+
+
+// gstBusWatchRemove
+void gstBusWatchRemove( _GstElement* pipeline )
+{
+	if( !pipeline )
+		return;
+
+	// the mutex is already held if this is called from a callback
+	const bool locked = !gst_bus_thread_current();
+
+	if( locked )
+		gBusMutex.Lock();
+
+	for( size_t n=0; n < gBusWatches.size(); n++ )
+	{
+		gstBusWatch* watch = gBusWatches[n];
+
+		if( watch->pipeline != pipeline )
+			continue;
+
+		// the watch is freed once the source is no longer dispatching
+		GSource* source = watch->source;
+		watch->removed = true;
+
+		g_source_destroy(source);
+		g_source_unref(source);
+
+		gBusWatches.erase(gBusWatches.begin() + n);
+		break;
+	}
+
+	if( locked )
+		gBusMutex.Unlock();
+}
@@ -27,6 +27,10 @@
 #include <string>
 
 
+// Forward declarations
+struct cudaVideoLayout;
+
+
 /**
  * Video codec (H.264/H.265) enumeration.
  * @ingroup codec
@@ -61,5 +65,87 @@ bool gstreamerInit();
 gboolean gst_message_print(_GstBus* bus, _GstMessage* message, void* user_data);
 
 
+/**
+ * Return how long ago (in nanoseconds) a buffer was timestamped, by comparing
+ * its PTS to the current running time of the pipeline.  For live sources this
+ * is the latency from the sensor/driver up to the point where it's called.
+ * @returns the latency, or UINT64_MAX if the buffer or pipeline clock has no timestamp.
+ * @internal
+ * @ingroup codec
+ */
+uint64_t gst_buffer_latency(_GstElement* pipeline, _GstBuffer* buffer);
+
+
+/**
+ * Fill out the format, dimensions and plane offsets/strides of a raw video frame
+ * from its negotiated caps.  If the buffer is provided and carries a GstVideoMeta
+ * (i.e. because upstream pads its rows), the plane layout from the meta is used.
+ * @returns `false` if the caps don't describe raw video.  Formats that CUDA can't
+ *          convert are still described, with their format set to CUDA_VIDEO_UNKNOWN.
+ * @internal
+ * @ingroup codec
+ */
+bool gst_video_layout(_GstCaps* caps, _GstBuffer* buffer, cudaVideoLayout* layout);
+
+
+/**
+ * Callbacks for the pipeline messages that are handled by the bus watch thread.
+ * Any of them can be NULL.  They're called from the bus watch thread (which is
+ * shared by every pipeline), so they shouldn't block.
+ * @see gstBusWatchAdd()
+ * @ingroup codec
+ */
+struct gstBusCallbacks
+{
+	/**
+	 * The pipeline reached the end of the stream.
+	 */
+	void (*eos)( void* user_data );
+
+	/**
+	 * An element of the pipeline posted an error.
+	 */
+	void (*error)( const char* source, const char* message, void* user_data );
+
+	/**
+	 * The latency of the pipeline changed (it's recalculated before this is called).
+	 */
+	void (*latency)( void* user_data );
+
+	/**
+	 * An element dropped buffers for quality-of-service reasons (i.e. because they were late).
+	 * The counts are the totals reported by the element, or UINT64_MAX if they're unknown.
+	 */
+	void (*qos)( const char* source, uint64_t processed, uint64_t dropped, void* user_data );
+};
+
+
+/**
+ * Register a pipeline with the bus watch thread, which logs its messages
+ * and dispatches EOS, errors, latency and QoS messages to the callbacks.
+ *
+ * A single background thread services the buses of every pipeline that's
+ * registered, so messages are handled off of the streaming threads and
+ * even when no buffers are flowing.  The thread is started on first use.
+ *
+ * @param callbacks optional callbacks (these are copied, may be NULL)
+ * @param user_data pointer that gets passed to the callbacks
+ * @returns `false` if the pipeline was already registered or the thread couldn't be started.
+ * @internal
+ * @ingroup codec
+ */
+bool gstBusWatchAdd(_GstElement* pipeline, const gstBusCallbacks* callbacks, void* user_data);
+
+
+/**
+ * Unregister a pipeline from the bus watch thread.  Once this returns, the
+ * callbacks won't be called again, so it should be done before the object that
+ * receives them is destroyed.  It's safe to call from inside of a callback.
+ * @internal
+ * @ingroup codec
+ */
+void gstBusWatchRemove(_GstElement* pipeline);
+
+
 #endif
 
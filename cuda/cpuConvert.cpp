@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cpuConvert.h"
+#include "ThreadPool.h"
+
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#include <immintrin.h>
+#include <cpuid.h>
+#define TARGET_F16C __attribute__((target("avx,f16c")))
+#elif defined(__aarch64__)
+#define CPU_NEON
+#include <arm_neon.h>
+#endif
+
+
+// don't split images into bands smaller than this (the threads cost more than they save)
+#define MIN_ROWS_PER_THREAD 32
+
+// upper limit on the number of threads
+#define MAX_THREADS 64
+
+
+static uint32_t gFeatureMask = UINT32_MAX;
+static uint32_t gNumThreads  = 1;
+
+
+// cpuFeatureToString
+const char* cpuFeatureToString( cpuFeature feature )
+{
+	switch(feature)
+	{
+		case CPU_FEATURE_NONE:	return "CPU_FEATURE_NONE";
+		case CPU_FEATURE_SSE41:	return "CPU_FEATURE_SSE41";
+		case CPU_FEATURE_AVX2:	return "CPU_FEATURE_AVX2";
+		case CPU_FEATURE_NEON:	return "CPU_FEATURE_NEON";
+		case CPU_FEATURE_F16C:	return "CPU_FEATURE_F16C";
+	}
+
+	return "UNKNOWN";
+}
+
+
+// cpuDetectFeatures
+static uint32_t cpuDetectFeatures()
+{
+	uint32_t features = CPU_FEATURE_NONE;
+
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports("sse4.1") )
+		features |= CPU_FEATURE_SSE41;
+
+	if( __builtin_cpu_supports("avx2") )
+		features |= CPU_FEATURE_AVX2;
+
+	// F16C isn't one of the features that __builtin_cpu_supports() knows about on older
+	// compilers, so check CPUID leaf 1 directly (it uses the AVX registers, so needs AVX too)
+	unsigned int eax, ebx, ecx, edx;
+
+	if( __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C) && __builtin_cpu_supports("avx") )
+		features |= CPU_FEATURE_F16C;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	features |= CPU_FEATURE_NEON;
+#endif
+
+	return features;
+}
+
+
+// cpuGetFeatures
+uint32_t cpuGetFeatures()
+{
+	static const uint32_t supported = cpuDetectFeatures();
+	return supported & gFeatureMask;
+}
+
+
+// cpuSetFeatures
+void cpuSetFeatures( uint32_t mask )
+{
+	gFeatureMask = mask;
+}
+
+
+// cpuGetThreads
+uint32_t cpuGetThreads()
+{
+	return gNumThreads;
+}
+
+
+// cpuSetThreads
+void cpuSetThreads( uint32_t threads )
+{
+	if( threads == 0 )
+	{
+		const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = (cpus > 0) ? cpus : 1;
+	}
+
+	if( threads > MAX_THREADS )
+		threads = MAX_THREADS;
+
+	gNumThreads = threads;
+}
+
+
+// cpuParallelRows
+void cpuParallelRows( size_t rows, size_t rowAlign, cpuRowFunction function, void* user_data )
+{
+	if( !function || rows == 0 )
+		return;
+
+	if( rowAlign == 0 )
+		rowAlign = 1;
+
+	size_t numBands = gNumThreads;
+
+	if( numBands > rows / MIN_ROWS_PER_THREAD )
+		numBands = rows / MIN_ROWS_PER_THREAD;
+
+	if( numBands <= 1 )
+	{
+		function(0, rows, user_data);
+		return;
+	}
+
+	// divide the rows evenly, rounded up to the alignment
+	size_t bandRows = (rows + numBands - 1) / numBands;
+	bandRows = ((bandRows + rowAlign - 1) / rowAlign) * rowAlign;
+
+	// the bands run on the shared pool, with the calling thread taking some of them
+	ThreadPool::GetShared()->ParallelFor(rows, bandRows, [function, user_data](size_t rowBegin, size_t rowEnd)
+	{
+		function(rowBegin, rowEnd, user_data);
+	});
+}
+
+
+// cpuFloatToHalf
+uint16_t cpuFloatToHalf( float value )
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(float));
+
+	const uint16_t sign = (bits >> 16) & 0x8000;
+	bits &= 0x7FFFFFFF;
+
+	// infinity and NaN (which is quieted, and keeps the upper bits of its payload like F16C does)
+	if( bits >= 0x7F800000 )
+		return sign | 0x7C00 | ((bits > 0x7F800000) ? (0x200 | ((bits >> 13) & 0x3FF)) : 0);
+
+	// values from 65520 round up to infinity
+	if( bits >= 0x477FF000 )
+		return sign | 0x7C00;
+
+	// subnormal halves, which are rounded by adding to 0.5 (the spacing of floats
+	// around 0.5 is the same as the spacing of the subnormal halves, 2^-24)
+	if( bits < 0x38800000 )
+	{
+		float magnitude;
+		memcpy(&magnitude, &bits, sizeof(float));
+		magnitude += 0.5f;
+		memcpy(&bits, &magnitude, sizeof(float));
+		return sign | (bits - 0x3F000000);
+	}
+
+	// rebias the exponent from 127 to 15, and round the 13 bits that are dropped
+	bits += 0xC8000FFF + ((bits >> 13) & 1);
+	return sign | (bits >> 13);
+}
+
+
+// cpuHalfToFloat
+float cpuHalfToFloat( uint16_t value )
+{
+	const uint32_t sign     = (value & 0x8000) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1F;
+	const uint32_t mantissa = value & 0x3FF;
+
+	uint32_t bits;
+
+	if( exponent == 0x1F )
+		bits = sign | 0x7F800000 | (mantissa << 13) | (mantissa ? 0x400000 : 0);	// quiet NaN
+	else if( exponent != 0 )
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	else
+	{
+		// zero and subnormals, which are exact as floats
+		float magnitude = float(mantissa) * (1.0f / 16777216.0f);
+		memcpy(&bits, &magnitude, sizeof(float));
+		bits |= sign;
+	}
+
+	float result;
+	memcpy(&result, &bits, sizeof(float));
+	return result;
+}
+
+
+#ifdef CPU_X86
+// floatToHalfF16C (8 values per iteration)
+TARGET_F16C static size_t floatToHalfF16C( const float* input, uint16_t* output, size_t count )
+{
+	size_t n = 0;
+
+	for( ; n + 8 <= count; n += 8 )
+		_mm_storeu_si128((__m128i*)(output + n), _mm256_cvtps_ph(_mm256_loadu_ps(input + n), _MM_FROUND_TO_NEAREST_INT));
+
+	return n;
+}
+
+// halfToFloatF16C (8 values per iteration)
+TARGET_F16C static size_t halfToFloatF16C( const uint16_t* input, float* output, size_t count )
+{
+	size_t n = 0;
+
+	for( ; n + 8 <= count; n += 8 )
+		_mm256_storeu_ps(output + n, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(input + n))));
+
+	return n;
+}
+#endif
+
+#ifdef CPU_NEON
+// floatToHalfNEON (8 values per iteration, rounded by the FPCR mode, which is nearest-even)
+static size_t floatToHalfNEON( const float* input, uint16_t* output, size_t count )
+{
+	size_t n = 0;
+
+	for( ; n + 8 <= count; n += 8 )
+	{
+		const float16x8_t h = vcombine_f16(vcvt_f16_f32(vld1q_f32(input + n)), vcvt_f16_f32(vld1q_f32(input + n + 4)));
+		vst1q_u16(output + n, vreinterpretq_u16_f16(h));
+	}
+
+	return n;
+}
+
+// halfToFloatNEON (8 values per iteration)
+static size_t halfToFloatNEON( const uint16_t* input, float* output, size_t count )
+{
+	size_t n = 0;
+
+	for( ; n + 8 <= count; n += 8 )
+	{
+		const float16x8_t h = vreinterpretq_f16_u16(vld1q_u16(input + n));
+
+		vst1q_f32(output + n, vcvt_f32_f16(vget_low_f16(h)));
+		vst1q_f32(output + n + 4, vcvt_high_f32_f16(h));
+	}
+
+	return n;
+}
+#endif
+
+
+// cpuFloatToHalf
+void cpuFloatToHalf( const float* input, uint16_t* output, size_t count )
+{
+	if( !input || !output )
+		return;
+
+	const uint32_t features = cpuGetFeatures();
+	size_t n = 0;
+
+#if defined(CPU_X86)
+	if( features & CPU_FEATURE_F16C )
+		n = floatToHalfF16C(input, output, count);
+#elif defined(CPU_NEON)
+	if( features & CPU_FEATURE_NEON )
+		n = floatToHalfNEON(input, output, count);
+#endif
+
+	for( ; n < count; n++ )
+		output[n] = cpuFloatToHalf(input[n]);
+}
+
+
+// cpuHalfToFloat
+void cpuHalfToFloat( const uint16_t* input, float* output, size_t count )
+{
+	if( !input || !output )
+		return;
+
+	const uint32_t features = cpuGetFeatures();
+	size_t n = 0;
+
+#if defined(CPU_X86)
+	if( features & CPU_FEATURE_F16C )
+		n = halfToFloatF16C(input, output, count);
+#elif defined(CPU_NEON)
+	if( features & CPU_FEATURE_NEON )
+		n = halfToFloatNEON(input, output, count);
+#endif
+
+	for( ; n < count; n++ )
+		output[n] = cpuHalfToFloat(input[n]);
+}
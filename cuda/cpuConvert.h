@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CPU_CONVERT_H__
+#define __CPU_CONVERT_H__
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/**
+ * LOG_CPU logging prefix
+ * @ingroup colorspace
+ */
+#define LOG_CPU "[cpu]    "
+
+
+/**
+ * Instruction set extensions that the host conversions can dispatch to.
+ * The values are bit flags, so they can be combined into a mask.
+ * @see cpuGetFeatures()
+ * @ingroup colorspace
+ */
+enum cpuFeature
+{
+	CPU_FEATURE_NONE   = 0,			/**< Scalar reference implementation */
+	CPU_FEATURE_SSE41  = (1 << 0),	/**< x86 SSE4.1 */
+	CPU_FEATURE_AVX2   = (1 << 1),	/**< x86 AVX2 */
+	CPU_FEATURE_NEON   = (1 << 2),	/**< ARM NEON (always available on aarch64) */
+	CPU_FEATURE_F16C   = (1 << 3)	/**< x86 F16C half-precision conversions */
+};
+
+/**
+ * Stringize function to convert cpuFeature enum to text
+ * @ingroup colorspace
+ */
+const char* cpuFeatureToString( cpuFeature feature );
+
+
+/**
+ * Return the mask of cpuFeature flags that the host conversions are using.
+ * By default, this is every feature that is supported by the processor.
+ * @ingroup colorspace
+ */
+uint32_t cpuGetFeatures();
+
+/**
+ * Limit the host conversions to a subset of the supported cpuFeature flags.
+ * Features that the processor doesn't support are ignored.  Setting the mask to
+ * CPU_FEATURE_NONE selects the scalar reference path (i.e. for verifying the
+ * vectorized paths against it), and setting it to UINT32_MAX restores the default.
+ * @ingroup colorspace
+ */
+void cpuSetFeatures( uint32_t mask );
+
+/**
+ * Return the number of threads that the host conversions split the rows of an image across.
+ * @ingroup colorspace
+ */
+uint32_t cpuGetThreads();
+
+/**
+ * Set the number of threads that the host conversions split the rows of an image across.
+ * The default is 1, which runs the conversions entirely on the calling thread.
+ * If 0 is passed, the number of online processors is used.
+ * @ingroup colorspace
+ */
+void cpuSetThreads( uint32_t threads );
+
+
+/**
+ * Function pointer typedef for processing a band of rows, from `rowBegin` up to (but not including) `rowEnd`.
+ * @ingroup colorspace
+ */
+typedef void (*cpuRowFunction)( size_t rowBegin, size_t rowEnd, void* user_data );
+
+/**
+ * Split the rows of an image into as many as cpuGetThreads() bands, and process them on the
+ * shared ThreadPool (see ThreadPool::GetShared()) along with the calling thread.
+ * The bands are aligned to a multiple of `rowAlign` rows (i.e. 2 for 4:2:0 formats),
+ * and small images are processed on the calling thread.  Returns once every band is done.
+ * @ingroup colorspace
+ */
+void cpuParallelRows( size_t rows, size_t rowAlign, cpuRowFunction function, void* user_data );
+
+
+/**
+ * Convert a 32-bit float to the bits of a 16-bit IEEE half-precision float,
+ * rounding to the nearest even value (like `__float2half_rn()` in CUDA).
+ * @ingroup colorspace
+ */
+uint16_t cpuFloatToHalf( float value );
+
+/**
+ * Convert the bits of a 16-bit IEEE half-precision float to a 32-bit float.
+ * @ingroup colorspace
+ */
+float cpuHalfToFloat( uint16_t value );
+
+/**
+ * Convert an array of 32-bit floats to half-precision, with F16C or NEON when
+ * they're available.  The results are bit-exact with cpuFloatToHalf().
+ * @ingroup colorspace
+ */
+void cpuFloatToHalf( const float* input, uint16_t* output, size_t count );
+
+/**
+ * Convert an array of half-precision floats to 32-bit floats, with F16C or NEON
+ * when they're available.  The results are bit-exact with cpuHalfToFloat().
+ * @ingroup colorspace
+ */
+void cpuHalfToFloat( const uint16_t* input, float* output, size_t count );
+
+
+#endif
+
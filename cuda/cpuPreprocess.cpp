@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cpuPreprocess.h"
+#include "cpuResize.h"
+#include "cpuVector.h"
+
+
+// preprocessing that's shared by the bands of rows
+struct preprocessJob
+{
+	const uint8_t* input;
+	size_t inputWidth;
+	size_t inputHeight;
+
+	void*  output;
+	size_t outputWidth;
+	size_t outputHeight;
+
+	float  pixelScale;
+	float  mean[3];
+	float  invStdDev[3];
+	bool   bgr;
+	bool   chw;
+
+	cpuFilterTaps cols;
+	cpuFilterTaps rows;
+};
+
+
+// preprocessLoad (RGBA8)
+template<typename Ops> static inline typename Ops::vec preprocessLoad( const uchar4* input, int x, int y, const preprocessJob* job )
+{
+	return Ops::load(input + y * job->inputWidth + x);
+}
+
+// preprocessLoad (NV12, returns the Y/U/V samples)
+template<typename Ops> static inline typename Ops::vec preprocessLoad( const uint8_t* input, int x, int y, const preprocessJob* job )
+{
+	const uint8_t* uv = input + job->inputWidth * job->inputHeight + (y >> 1) * job->inputWidth + (x & ~1);
+	return Ops::widen(input[y * job->inputWidth + x] | (uv[0] << 8) | (uv[1] << 16));
+}
+
+// preprocessStore
+static inline void preprocessStore( float* output, size_t index, float value )
+{
+	output[index] = value;
+}
+
+static inline void preprocessStore( __half* output, size_t index, float value )
+{
+	const uint16_t bits = cpuFloatToHalf(value);
+	memcpy(output + index, &bits, sizeof(uint16_t));
+}
+
+static inline float clampf( float value )
+{
+	return fminf(fmaxf(value, 0.0f), 255.0f);
+}
+
+
+// preprocessRows
+template<typename Ops, typename T, typename S> static void preprocessRows( size_t rowBegin, size_t rowEnd, const preprocessJob* job )
+{
+	const T* input = (const T*)job->input;
+	S* output = (S*)job->output;
+
+	const int*   xIndex  = job->cols.index.data();
+	const float* xWeight = job->cols.weight.data();
+	const int*   xOffset = job->cols.offset.data();
+
+	const size_t stride = job->chw ? job->outputWidth * job->outputHeight : 1;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		for( size_t x=0; x < job->outputWidth; x++ )
+		{
+			typename Ops::vec sum = Ops::zero();
+
+			// filter along each row first, then across the rows (like cpuResize)
+			for( int ty=job->rows.offset[y]; ty < job->rows.offset[y+1]; ty++ )
+			{
+				typename Ops::vec acc = Ops::zero();
+
+				for( int tx=xOffset[x]; tx < xOffset[x+1]; tx++ )
+					acc = Ops::accum(acc, preprocessLoad<Ops>(input, xIndex[tx], job->rows.index[ty], job), xWeight[tx]);
+
+				sum = Ops::accum(sum, acc, job->rows.weight[ty]);
+			}
+
+			float px[4];
+			Ops::extract(sum, px);
+
+			// NV12 is filtered as Y/U/V, and converted afterwards
+			if( sizeof(T) == sizeof(uint8_t) )
+			{
+				const float luma = px[0];
+				const float u = px[1] - 128.0f;
+				const float v = px[2] - 128.0f;
+
+				px[0] = clampf(luma + 1.140f * v);
+				px[1] = clampf(luma - 0.395f * u - 0.581f * v);
+				px[2] = clampf(luma + 2.032f * u);
+			}
+
+			const float r = (px[0] * job->pixelScale - job->mean[0]) * job->invStdDev[0];
+			const float g = (px[1] * job->pixelScale - job->mean[1]) * job->invStdDev[1];
+			const float b = (px[2] * job->pixelScale - job->mean[2]) * job->invStdDev[2];
+
+			const size_t pixel = y * job->outputWidth + x;
+			const size_t index = job->chw ? pixel : pixel * 3;
+
+			preprocessStore(output, index, job->bgr ? b : r);
+			preprocessStore(output, index + stride, g);
+			preprocessStore(output, index + stride * 2, job->bgr ? r : b);
+		}
+	}
+}
+
+// preprocessBand
+template<typename T, typename S> static void preprocessBand( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const preprocessJob* job = (const preprocessJob*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+#if defined(CPU_VECTOR_SSE)
+	if( features & (CPU_FEATURE_SSE41|CPU_FEATURE_AVX2) )
+		return preprocessRows<cpuVectorSSE, T, S>(rowBegin, rowEnd, job);
+#elif defined(CPU_VECTOR_NEON)
+	if( features & CPU_FEATURE_NEON )
+		return preprocessRows<cpuVectorNEON, T, S>(rowBegin, rowEnd, job);
+#endif
+
+	preprocessRows<cpuVectorScalar, T, S>(rowBegin, rowEnd, job);
+}
+
+// launchPreprocess
+template<typename T, typename S> static bool launchPreprocess( T* input, size_t inputWidth, size_t inputHeight,
+											   S* output, size_t outputWidth, size_t outputHeight,
+											   const cudaPreprocessOptions& options )
+{
+	if( !input || !output || inputWidth == 0 || inputHeight == 0 || outputWidth == 0 || outputHeight == 0 )
+		return false;
+
+	int4 roi = options.roi;
+
+	if( roi.x == 0 && roi.y == 0 && roi.z == 0 && roi.w == 0 )
+		roi = make_int4(0, 0, inputWidth, inputHeight);
+
+	if( roi.x < 0 || roi.y < 0 || roi.z > (int)inputWidth || roi.w > (int)inputHeight || roi.x >= roi.z || roi.y >= roi.w )
+		return false;
+
+	if( options.stdDev.x == 0.0f || options.stdDev.y == 0.0f || options.stdDev.z == 0.0f )
+		return false;
+
+	preprocessJob job;
+
+	job.input        = (const uint8_t*)input;
+	job.inputWidth   = inputWidth;
+	job.inputHeight  = inputHeight;
+	job.output       = output;
+	job.outputWidth  = outputWidth;
+	job.outputHeight = outputHeight;
+	job.pixelScale   = options.scale;
+	job.bgr          = (options.order == CHANNEL_ORDER_BGR);
+	job.chw          = (options.format == FORMAT_CHW);
+
+	job.mean[0] = options.mean.x;
+	job.mean[1] = options.mean.y;
+	job.mean[2] = options.mean.z;
+
+	job.invStdDev[0] = 1.0f / options.stdDev.x;
+	job.invStdDev[1] = 1.0f / options.stdDev.y;
+	job.invStdDev[2] = 1.0f / options.stdDev.z;
+
+	cpuBuildFilterTaps(job.cols, options.filter, roi.z - roi.x, outputWidth, roi.x);
+	cpuBuildFilterTaps(job.rows, options.filter, roi.w - roi.y, outputHeight, roi.y);
+
+	cpuParallelRows(outputHeight, 1, preprocessBand<T, S>, &job);
+	return true;
+}
+
+
+// cpuPreprocess
+bool cpuPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+				float* output, size_t outputWidth, size_t outputHeight,
+				const cudaPreprocessOptions& options )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options);
+}
+
+// cpuPreprocess
+bool cpuPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+				__half* output, size_t outputWidth, size_t outputHeight,
+				const cudaPreprocessOptions& options )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options);
+}
+
+// cpuPreprocessNV12
+bool cpuPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+				    float* output, size_t outputWidth, size_t outputHeight,
+				    const cudaPreprocessOptions& options )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options);
+}
+
+// cpuPreprocessNV12
+bool cpuPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+				    __half* output, size_t outputWidth, size_t outputHeight,
+				    const cudaPreprocessOptions& options )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options);
+}
+
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __CPU_PREPROCESS_H__
+#define __CPU_PREPROCESS_H__
+
+
+#include "cudaPreprocess.h"
+#include "cpuConvert.h"
+
+
+/**
+ * Host implementations of cudaPreprocess() and cudaPreprocessNV12(), which take CPU pointers.
+ * They follow the same steps as the CUDA kernels (see cudaPreprocessOptions), so they can be
+ * used for verifying the GPU and for running the preprocessing on CPU-only nodes.
+ *
+ * The filtering is vectorized across the channels of each pixel with SSE or NEON
+ * (selected from cpuGetFeatures()), and is bit-exact with the scalar path.  The rows of
+ * the tensor can optionally be split across threads with cpuSetThreads().
+ *
+ * @ingroup cuda
+ */
+bool cpuPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+				float* output, size_t outputWidth, size_t outputHeight,
+				const cudaPreprocessOptions& options=cudaPreprocessOptions() );
+
+/**
+ * Prepare an RGBA8 image as a 3-channel half-precision tensor on the CPU.
+ * @see cpuPreprocess()
+ * @ingroup cuda
+ */
+bool cpuPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+				__half* output, size_t outputWidth, size_t outputHeight,
+				const cudaPreprocessOptions& options=cudaPreprocessOptions() );
+
+/**
+ * Prepare an NV12 image as a 3-channel float tensor on the CPU.
+ * @see cpuPreprocess()
+ * @ingroup cuda
+ */
+bool cpuPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+				    float* output, size_t outputWidth, size_t outputHeight,
+				    const cudaPreprocessOptions& options=cudaPreprocessOptions() );
+
+/**
+ * Prepare an NV12 image as a 3-channel half-precision tensor on the CPU.
+ * @see cpuPreprocess()
+ * @ingroup cuda
+ */
+bool cpuPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+				    __half* output, size_t outputWidth, size_t outputHeight,
+				    const cudaPreprocessOptions& options=cudaPreprocessOptions() );
+
+#endif
+
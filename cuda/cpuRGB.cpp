@@ -0,0 +1,676 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cpuRGB.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#include <immintrin.h>
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define CPU_NEON
+#include <arm_neon.h>
+#endif
+
+
+// number of pixels of a row that the half-precision conversions stage as float4 at a time
+#define HALF_CHUNK_SIZE 64
+
+
+// conversion that's shared by the bands of rows
+struct rgbConvert
+{
+	const uint8_t* input;
+	uint8_t* output;
+	size_t   width;
+	size_t   inputPitch;
+	size_t   outputPitch;
+	float    scale;
+	bool     swap;		// swap the red and blue channels
+};
+
+
+//-----------------------------------------------------------------------------------
+// 8-bit RGB/BGR to RGBA float4
+//-----------------------------------------------------------------------------------
+
+// unpackRowScalar
+static void unpackRowScalar( const uchar3* in, float4* out, size_t x, size_t width, bool swap )
+{
+	for( ; x < width; x++ )
+	{
+		const uchar3 px = in[x];
+
+		if( swap )
+			out[x] = make_float4(px.z, px.y, px.x, 255.0f);
+		else
+			out[x] = make_float4(px.x, px.y, px.z, 255.0f);
+	}
+}
+
+#ifdef CPU_X86
+// unpackRowSSE41 (4 pixels per iteration)
+TARGET_SSE41 static size_t unpackRowSSE41( const uchar3* in, float4* out, size_t width, bool swap )
+{
+	const __m128i alpha = _mm_setr_epi32(0, 0, 0, 255);
+
+	__m128i mask[4];
+
+	for( int n=0; n < 4; n++ )
+	{
+		const char r = n * 3 + (swap ? 2 : 0);
+		const char g = n * 3 + 1;
+		const char b = n * 3 + (swap ? 0 : 2);
+
+		mask[n] = _mm_setr_epi8(r,-1,-1,-1, g,-1,-1,-1, b,-1,-1,-1, -1,-1,-1,-1);
+	}
+
+	size_t x = 0;
+
+	// the 16-byte load reads past the 4 pixels, so stop early enough to stay in the row
+	for( ; x + 6 <= width; x += 4 )
+	{
+		const __m128i px = _mm_loadu_si128((const __m128i*)(in + x));
+
+		for( int n=0; n < 4; n++ )
+			_mm_storeu_ps((float*)(out + x + n), _mm_cvtepi32_ps(_mm_or_si128(_mm_shuffle_epi8(px, mask[n]), alpha)));
+	}
+
+	return x;
+}
+
+// unpackRowAVX2 (8 pixels per iteration)
+TARGET_AVX2 static size_t unpackRowAVX2( const uchar3* in, float4* out, size_t width, bool swap )
+{
+	const __m256i alpha = _mm256_setr_epi32(0, 0, 0, 255, 0, 0, 0, 255);
+
+	// gather each pair of pixels into 8 bytes, which are then widened to 32-bit
+	const __m128i lo = swap ? _mm_setr_epi8(2,1,0,-1, 5,4,3,-1, 8,7,6,-1, 11,10,9,-1)
+					    : _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const __m128i hi = _mm_srli_si128(lo, 8);
+
+	size_t x = 0;
+
+	// the 16-byte loads read past the 8 pixels, so stop early enough to stay in the row
+	for( ; x + 10 <= width; x += 8 )
+	{
+		const __m128i p0 = _mm_loadu_si128((const __m128i*)(in + x));
+		const __m128i p1 = _mm_loadu_si128((const __m128i*)(in + x + 4));
+
+		const __m128i pairs[4] = { _mm_shuffle_epi8(p0, lo), _mm_shuffle_epi8(p0, hi),
+							  _mm_shuffle_epi8(p1, lo), _mm_shuffle_epi8(p1, hi) };
+
+		for( int n=0; n < 4; n++ )
+			_mm256_storeu_ps((float*)(out + x + n * 2), _mm256_cvtepi32_ps(_mm256_or_si256(_mm256_cvtepu8_epi32(pairs[n]), alpha)));
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// unpackNEON
+static inline float32x4_t unpackNEON( uint16x4_t channel )
+{
+	return vcvtq_f32_u32(vmovl_u16(channel));
+}
+
+// unpackRowNEON (8 pixels per iteration)
+static size_t unpackRowNEON( const uchar3* in, float4* out, size_t width, bool swap )
+{
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const uint8x8x3_t px = vld3_u8((const uint8_t*)(in + x));
+
+		const uint16x8_t r = vmovl_u8(swap ? px.val[2] : px.val[0]);
+		const uint16x8_t g = vmovl_u8(px.val[1]);
+		const uint16x8_t b = vmovl_u8(swap ? px.val[0] : px.val[2]);
+
+		float32x4x4_t lo, hi;
+
+		lo.val[0] = unpackNEON(vget_low_u16(r));
+		lo.val[1] = unpackNEON(vget_low_u16(g));
+		lo.val[2] = unpackNEON(vget_low_u16(b));
+		lo.val[3] = vdupq_n_f32(255.0f);
+
+		hi.val[0] = unpackNEON(vget_high_u16(r));
+		hi.val[1] = unpackNEON(vget_high_u16(g));
+		hi.val[2] = unpackNEON(vget_high_u16(b));
+		hi.val[3] = vdupq_n_f32(255.0f);
+
+		vst4q_f32((float*)(out + x), lo);
+		vst4q_f32((float*)(out + x + 4), hi);
+	}
+
+	return x;
+}
+#endif
+
+// unpackRow
+static void unpackRow( const uchar3* in, float4* out, size_t width, bool swap, uint32_t features )
+{
+	size_t x = 0;
+
+#if defined(CPU_X86)
+	if( features & CPU_FEATURE_AVX2 )
+		x = unpackRowAVX2(in, out, width, swap);
+	else if( features & CPU_FEATURE_SSE41 )
+		x = unpackRowSSE41(in, out, width, swap);
+#elif defined(CPU_NEON)
+	if( features & CPU_FEATURE_NEON )
+		x = unpackRowNEON(in, out, width, swap);
+#endif
+
+	unpackRowScalar(in, out, x, width, swap);
+}
+
+// unpackRows
+static void unpackRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uchar3* in = (const uchar3*)(cvt->input + y * cvt->inputPitch);
+		float4* out = (float4*)(cvt->output + y * cvt->outputPitch);
+
+		unpackRow(in, out, cvt->width, cvt->swap, features);
+	}
+}
+
+// unpackRowsHalf (unpacks a chunk of each row to float4, and then converts it to half)
+static void unpackRowsHalf( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	float4 chunk[HALF_CHUNK_SIZE];
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uchar3* in = (const uchar3*)(cvt->input + y * cvt->inputPitch);
+		half4* out = (half4*)(cvt->output + y * cvt->outputPitch);
+
+		for( size_t x=0; x < cvt->width; x += HALF_CHUNK_SIZE )
+		{
+			const size_t count = (cvt->width - x < HALF_CHUNK_SIZE) ? cvt->width - x : HALF_CHUNK_SIZE;
+
+			unpackRow(in + x, chunk, count, cvt->swap, features);
+			cpuFloatToHalf((const float*)chunk, (uint16_t*)(out + x), count * 4);
+		}
+	}
+}
+
+// launchUnpack
+static bool launchUnpack( uchar3* input, float4* output, size_t width, size_t height, bool swap )
+{
+	if( !input || !output || width == 0 || height == 0 )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(uchar3), width * sizeof(float4), 1.0f, swap };
+	cpuParallelRows(height, 1, unpackRows, &cvt);
+	return true;
+}
+
+static bool launchUnpack( uchar3* input, half4* output, size_t width, size_t height, bool swap )
+{
+	if( !input || !output || width == 0 || height == 0 )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(uchar3), width * sizeof(half4), 1.0f, swap };
+	cpuParallelRows(height, 1, unpackRowsHalf, &cvt);
+	return true;
+}
+
+// cpuRGB8ToRGBA32
+bool cpuRGB8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height )
+{
+	return launchUnpack(input, output, width, height, false);
+}
+
+// cpuBGR8ToRGBA32
+bool cpuBGR8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height )
+{
+	return launchUnpack(input, output, width, height, true);
+}
+
+// cpuRGB8ToRGBA16
+bool cpuRGB8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height )
+{
+	return launchUnpack(input, output, width, height, false);
+}
+
+// cpuBGR8ToRGBA16
+bool cpuBGR8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height )
+{
+	return launchUnpack(input, output, width, height, true);
+}
+
+
+//-----------------------------------------------------------------------------------
+// RGBA float4 to 8-bit RGB/BGR/RGBA/BGRA
+//-----------------------------------------------------------------------------------
+
+static inline uint8_t pack_pixel( float value, float scale )
+{
+	value *= scale;
+
+	if( value < 0.0f )
+		value = 0.0f;
+
+	if( value > 255.0f )
+		value = 255.0f;
+
+	return (uint8_t)value;
+}
+
+// packRowScalar
+template<typename T> static void packRowScalar( const float4* in, T* out, size_t x, size_t width, float scale, bool swap );
+
+template<> void packRowScalar<uchar4>( const float4* in, uchar4* out, size_t x, size_t width, float scale, bool swap )
+{
+	for( ; x < width; x++ )
+	{
+		const float4 px = in[x];
+
+		if( swap )
+			out[x] = make_uchar4(pack_pixel(px.z, scale), pack_pixel(px.y, scale), pack_pixel(px.x, scale), pack_pixel(px.w, scale));
+		else
+			out[x] = make_uchar4(pack_pixel(px.x, scale), pack_pixel(px.y, scale), pack_pixel(px.z, scale), pack_pixel(px.w, scale));
+	}
+}
+
+template<> void packRowScalar<uchar3>( const float4* in, uchar3* out, size_t x, size_t width, float scale, bool swap )
+{
+	for( ; x < width; x++ )
+	{
+		const float4 px = in[x];
+
+		if( swap )
+			out[x] = make_uchar3(pack_pixel(px.z, scale), pack_pixel(px.y, scale), pack_pixel(px.x, scale));
+		else
+			out[x] = make_uchar3(pack_pixel(px.x, scale), pack_pixel(px.y, scale), pack_pixel(px.z, scale));
+	}
+}
+
+#ifdef CPU_X86
+// store 4 packed RGBA pixels, as either uchar4 (16 bytes) or uchar3 (12 bytes)
+TARGET_SSE41 static inline void packStoreSSE( uchar4* out, __m128i px )
+{
+	_mm_storeu_si128((__m128i*)out, px);
+}
+
+TARGET_SSE41 static inline void packStoreSSE( uchar3* out, __m128i px )
+{
+	const __m128i rgb = _mm_shuffle_epi8(px, _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1));
+
+	_mm_storel_epi64((__m128i*)out, rgb);
+
+	const uint32_t tail = _mm_extract_epi32(rgb, 2);
+	memcpy((uint8_t*)out + 8, &tail, sizeof(uint32_t));
+}
+
+// packRowSSE41 (4 pixels per iteration)
+template<typename T> TARGET_SSE41 static size_t packRowSSE41( const float4* in, T* out, size_t width, float scale, bool swap )
+{
+	const __m128 s    = _mm_set1_ps(scale);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 max  = _mm_set1_ps(255.0f);
+
+	const __m128i order = swap ? _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15)
+					       : _mm_setr_epi8(0,1,2,3, 4,5,6,7, 8,9,10,11, 12,13,14,15);
+	size_t x = 0;
+
+	for( ; x + 4 <= width; x += 4 )
+	{
+		__m128i px[4];
+
+		for( int n=0; n < 4; n++ )
+			px[n] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps((const float*)(in + x + n)), s), zero), max));
+
+		// the values are already saturated, so the packing doesn't change them
+		const __m128i rgba = _mm_packus_epi16(_mm_packus_epi32(px[0], px[1]), _mm_packus_epi32(px[2], px[3]));
+		packStoreSSE(out + x, _mm_shuffle_epi8(rgba, order));
+	}
+
+	return x;
+}
+
+// packRowAVX2 (8 pixels per iteration)
+template<typename T> TARGET_AVX2 static size_t packRowAVX2( const float4* in, T* out, size_t width, float scale, bool swap )
+{
+	const __m256 s    = _mm256_set1_ps(scale);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 max  = _mm256_set1_ps(255.0f);
+
+	// the packs operate within each 128-bit lane, which leaves the pixels in the order 0,2,4,6,1,3,5,7
+	const __m256i interleave = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	const __m256i order = swap ? _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15, 2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15)
+					       : _mm256_setr_epi8(0,1,2,3, 4,5,6,7, 8,9,10,11, 12,13,14,15, 0,1,2,3, 4,5,6,7, 8,9,10,11, 12,13,14,15);
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		__m256i px[4];
+
+		for( int n=0; n < 4; n++ )
+			px[n] = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps((const float*)(in + x + n * 2)), s), zero), max));
+
+		__m256i rgba = _mm256_packus_epi16(_mm256_packus_epi32(px[0], px[1]), _mm256_packus_epi32(px[2], px[3]));
+		rgba = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(rgba, interleave), order);
+
+		packStoreSSE(out + x, _mm256_castsi256_si128(rgba));
+		packStoreSSE(out + x + 4, _mm256_extracti128_si256(rgba, 1));
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// packNEON
+static inline uint8x8_t packNEON( float32x4_t lo, float32x4_t hi, float32x4_t s )
+{
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t max  = vdupq_n_f32(255.0f);
+
+	const uint32x4_t l = vcvtq_u32_f32(vminq_f32(vmaxq_f32(vmulq_f32(lo, s), zero), max));
+	const uint32x4_t h = vcvtq_u32_f32(vminq_f32(vmaxq_f32(vmulq_f32(hi, s), zero), max));
+
+	return vmovn_u16(vcombine_u16(vmovn_u32(l), vmovn_u32(h)));
+}
+
+// packStoreNEON
+static inline void packStoreNEON( uchar4* out, uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a )
+{
+	uint8x8x4_t px;
+
+	px.val[0] = r;
+	px.val[1] = g;
+	px.val[2] = b;
+	px.val[3] = a;
+
+	vst4_u8((uint8_t*)out, px);
+}
+
+static inline void packStoreNEON( uchar3* out, uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a )
+{
+	uint8x8x3_t px;
+
+	px.val[0] = r;
+	px.val[1] = g;
+	px.val[2] = b;
+
+	vst3_u8((uint8_t*)out, px);
+}
+
+// packRowNEON (8 pixels per iteration)
+template<typename T> static size_t packRowNEON( const float4* in, T* out, size_t width, float scale, bool swap )
+{
+	const float32x4_t s = vdupq_n_f32(scale);
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const float32x4x4_t lo = vld4q_f32((const float*)(in + x));
+		const float32x4x4_t hi = vld4q_f32((const float*)(in + x + 4));
+
+		const uint8x8_t r = packNEON(lo.val[0], hi.val[0], s);
+		const uint8x8_t g = packNEON(lo.val[1], hi.val[1], s);
+		const uint8x8_t b = packNEON(lo.val[2], hi.val[2], s);
+		const uint8x8_t a = packNEON(lo.val[3], hi.val[3], s);
+
+		if( swap )
+			packStoreNEON(out + x, b, g, r, a);
+		else
+			packStoreNEON(out + x, r, g, b, a);
+	}
+
+	return x;
+}
+#endif
+
+// packRow
+template<typename T> static void packRow( const float4* in, T* out, size_t width, float scale, bool swap, uint32_t features )
+{
+	size_t x = 0;
+
+#if defined(CPU_X86)
+	if( features & CPU_FEATURE_AVX2 )
+		x = packRowAVX2<T>(in, out, width, scale, swap);
+	else if( features & CPU_FEATURE_SSE41 )
+		x = packRowSSE41<T>(in, out, width, scale, swap);
+#elif defined(CPU_NEON)
+	if( features & CPU_FEATURE_NEON )
+		x = packRowNEON<T>(in, out, width, scale, swap);
+#endif
+
+	packRowScalar<T>(in, out, x, width, scale, swap);
+}
+
+// packRows
+template<typename T> static void packRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const float4* in = (const float4*)(cvt->input + y * cvt->inputPitch);
+		T* out = (T*)(cvt->output + y * cvt->outputPitch);
+
+		packRow<T>(in, out, cvt->width, cvt->scale, cvt->swap, features);
+	}
+}
+
+// packRowsHalf (converts a chunk of each row from half to float4, and then packs it)
+template<typename T> static void packRowsHalf( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	float4 chunk[HALF_CHUNK_SIZE];
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const half4* in = (const half4*)(cvt->input + y * cvt->inputPitch);
+		T* out = (T*)(cvt->output + y * cvt->outputPitch);
+
+		for( size_t x=0; x < cvt->width; x += HALF_CHUNK_SIZE )
+		{
+			const size_t count = (cvt->width - x < HALF_CHUNK_SIZE) ? cvt->width - x : HALF_CHUNK_SIZE;
+
+			cpuHalfToFloat((const uint16_t*)(in + x), (float*)chunk, count * 4);
+			packRow<T>(chunk, out + x, count, cvt->scale, cvt->swap, features);
+		}
+	}
+}
+
+// launchPack
+template<typename T> static bool launchPack( float4* input, T* output, size_t width, size_t height, const float2& inputRange, bool swap )
+{
+	if( !input || !output || width == 0 || height == 0 || inputRange.y == 0.0f )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(float4), width * sizeof(T), 255.0f / inputRange.y, swap };
+	cpuParallelRows(height, 1, packRows<T>, &cvt);
+	return true;
+}
+
+template<typename T> static bool launchPack( half4* input, T* output, size_t width, size_t height, const float2& inputRange, bool swap )
+{
+	if( !input || !output || width == 0 || height == 0 || inputRange.y == 0.0f )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(half4), width * sizeof(T), 255.0f / inputRange.y, swap };
+	cpuParallelRows(height, 1, packRowsHalf<T>, &cvt);
+	return true;
+}
+
+// cpuRGBA32ToRGBA8
+bool cpuRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar4>(input, output, width, height, inputRange, false);
+}
+
+// cpuRGBA32ToRGBA8
+bool cpuRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuRGBA32ToRGBA8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA32ToBGRA8
+bool cpuRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar4>(input, output, width, height, inputRange, true);
+}
+
+// cpuRGBA32ToBGRA8
+bool cpuRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuRGBA32ToBGRA8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA32ToRGB8
+bool cpuRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar3>(input, output, width, height, inputRange, false);
+}
+
+// cpuRGBA32ToRGB8
+bool cpuRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height )
+{
+	return cpuRGBA32ToRGB8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA32ToBGR8
+bool cpuRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar3>(input, output, width, height, inputRange, true);
+}
+
+// cpuRGBA32ToBGR8
+bool cpuRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height )
+{
+	return cpuRGBA32ToBGR8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA16ToRGBA8
+bool cpuRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar4>(input, output, width, height, inputRange, false);
+}
+
+// cpuRGBA16ToRGBA8
+bool cpuRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuRGBA16ToRGBA8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA16ToBGRA8
+bool cpuRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar4>(input, output, width, height, inputRange, true);
+}
+
+// cpuRGBA16ToBGRA8
+bool cpuRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuRGBA16ToBGRA8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA16ToRGB8
+bool cpuRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar3>(input, output, width, height, inputRange, false);
+}
+
+// cpuRGBA16ToRGB8
+bool cpuRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height )
+{
+	return cpuRGBA16ToRGB8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+// cpuRGBA16ToBGR8
+bool cpuRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return launchPack<uchar3>(input, output, width, height, inputRange, true);
+}
+
+// cpuRGBA16ToBGR8
+bool cpuRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height )
+{
+	return cpuRGBA16ToBGR8(input, output, width, height, make_float2(0.0f, 255.0f));
+}
+
+
+//-----------------------------------------------------------------------------------
+// RGBA float4 to/from RGBA half4
+//-----------------------------------------------------------------------------------
+
+// floatToHalfRows
+static void floatToHalfRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+		cpuFloatToHalf((const float*)(cvt->input + y * cvt->inputPitch), (uint16_t*)(cvt->output + y * cvt->outputPitch), cvt->width * 4);
+}
+
+// halfToFloatRows
+static void halfToFloatRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const rgbConvert* cvt = (const rgbConvert*)user_data;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+		cpuHalfToFloat((const uint16_t*)(cvt->input + y * cvt->inputPitch), (float*)(cvt->output + y * cvt->outputPitch), cvt->width * 4);
+}
+
+// cpuRGBA32ToRGBA16
+bool cpuRGBA32ToRGBA16( float4* input, half4* output, size_t width, size_t height )
+{
+	if( !input || !output || width == 0 || height == 0 )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(float4), width * sizeof(half4), 1.0f, false };
+	cpuParallelRows(height, 1, floatToHalfRows, &cvt);
+	return true;
+}
+
+// cpuRGBA16ToRGBA32
+bool cpuRGBA16ToRGBA32( half4* input, float4* output, size_t width, size_t height )
+{
+	if( !input || !output || width == 0 || height == 0 )
+		return false;
+
+	rgbConvert cvt = { (const uint8_t*)input, (uint8_t*)output, width, width * sizeof(half4), width * sizeof(float4), 1.0f, false };
+	cpuParallelRows(height, 1, halfToFloatRows, &cvt);
+	return true;
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __CPU_RGB_CONVERT_H__
+#define __CPU_RGB_CONVERT_H__
+
+
+#include "cudaUtility.h"
+#include "cudaFP16.h"
+#include "cpuConvert.h"
+
+
+/**
+ * Host implementations of the conversions from cudaRGB.h, which take CPU pointers.
+ *
+ * Like the host versions of the YUV conversions (see cpuYUV.h), these dispatch to
+ * SSE4.1, AVX2 or NEON paths from cpuGetFeatures() that are bit-exact with the scalar
+ * path, and optionally split the rows of an image across threads with cpuSetThreads().
+ *
+ * When packing floating-point to 8-bit, the pixels are scaled by 255/inputRange.y
+ * (the same as the CUDA kernels), saturated to 0-255, and then truncated.
+ *
+ * The half-precision (`RGBA16`) versions convert to and from float with F16C or NEON
+ * (see cpuFloatToHalf()), and otherwise go through the same paths as the float4 versions,
+ * so their output is the same as converting through a float4 image.
+ *
+ * @ingroup colorspace
+ */
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name 8-bit RGB/BGR to Floating-point RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 8-bit fixed-point RGB image to 32-bit floating-point RGBA image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGB8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height );
+
+/**
+ * Convert 8-bit fixed-point BGR image to 32-bit floating-point RGBA image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuBGR8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Floating-point RGBA to 8-bit RGB/RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point RGB image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point RGB image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point RGBA image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point RGBA image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Floating-point RGBA to 8-bit BGR/BGRA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point BGR image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point BGR image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point BGRA image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 32-bit floating-point RGBA image into 8-bit fixed-point BGRA image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name 8-bit RGB/BGR to Half-precision RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 8-bit fixed-point RGB image to 16-bit half-precision RGBA image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGB8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height );
+
+/**
+ * Convert 8-bit fixed-point BGR image to 16-bit half-precision RGBA image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuBGR8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Half-precision RGBA to 8-bit RGB/RGBA/BGR/BGRA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGB image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGB image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGBA image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGBA image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGR image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGR image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGRA image on the CPU.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGRA image on the CPU,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Single-precision RGBA to/from Half-precision RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 32-bit floating-point RGBA image into 16-bit half-precision RGBA image on the CPU.
+ * The values are rounded to the nearest half, and the range is unchanged.
+ * @ingroup colorspace
+ */
+bool cpuRGBA32ToRGBA16( float4* input, half4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 32-bit floating-point RGBA image on the CPU.
+ * The conversion is exact, and the range is unchanged.
+ * @ingroup colorspace
+ */
+bool cpuRGBA16ToRGBA32( half4* input, float4* output, size_t width, size_t height );
+
+///@}
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cpuResize.h"
+#include "cpuVector.h"
+
+
+// resize that's shared by the bands of rows
+struct resizeJob
+{
+	const uint8_t* input;
+	uint8_t* output;
+	size_t   inputWidth;
+	size_t   outputWidth;
+
+	cpuFilterTaps cols;
+	cpuFilterTaps rows;
+};
+
+
+// cpuBuildFilterTaps (this follows the sampling of the CUDA kernels in cudaResize.cu)
+void cpuBuildFilterTaps( cpuFilterTaps& taps, cudaFilterMode filter, int inputSize, int outputSize, int inputOffset )
+{
+	const float scale = float(inputSize) / float(outputSize);
+
+	taps.index.clear();
+	taps.weight.clear();
+	taps.offset.clear();
+
+	taps.offset.reserve(outputSize + 1);
+
+	for( int x=0; x < outputSize; x++ )
+	{
+		taps.offset.push_back(taps.index.size());
+
+		if( filter == FILTER_LINEAR )
+		{
+			const float sx = fminf(fmaxf((float(x) + 0.5f) * scale - 0.5f, 0.0f), float(inputSize - 1));
+
+			const int x1 = int(sx);
+			const int x2 = (x1 + 1 < inputSize - 1) ? x1 + 1 : inputSize - 1;
+
+			const float x2f = sx - float(x1);
+			const float x1f = 1.0f - x2f;
+
+			taps.index.push_back(inputOffset + x1);
+			taps.weight.push_back(x1f);
+
+			taps.index.push_back(inputOffset + x2);
+			taps.weight.push_back(x2f);
+		}
+		else if( filter == FILTER_AREA )
+		{
+			const float x0f = float(x) * scale;
+			const float x1f = fminf(float(x + 1) * scale, float(inputSize));
+
+			const int begin = int(x0f);
+			const int end   = (int(ceilf(x1f)) < inputSize) ? int(ceilf(x1f)) : inputSize;
+
+			const float norm = 1.0f / (x1f - x0f);
+
+			for( int ix=begin; ix < end; ix++ )
+			{
+				taps.index.push_back(inputOffset + ix);
+				taps.weight.push_back((fminf(float(ix + 1), x1f) - fmaxf(float(ix), x0f)) * norm);
+			}
+		}
+		else
+		{
+			taps.index.push_back(inputOffset + int(float(x) * scale));
+			taps.weight.push_back(1.0f);
+		}
+	}
+
+	taps.offset.push_back(taps.index.size());
+}
+
+
+// resizeRows
+template<typename Ops, typename T> static void resizeRows( size_t rowBegin, size_t rowEnd, const resizeJob* job )
+{
+	const T* input = (const T*)job->input;
+
+	const int*   xIndex  = job->cols.index.data();
+	const float* xWeight = job->cols.weight.data();
+	const int*   xOffset = job->cols.offset.data();
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		T* output = (T*)job->output + y * job->outputWidth;
+
+		const int yBegin = job->rows.offset[y];
+		const int yEnd   = job->rows.offset[y+1];
+
+		for( size_t x=0; x < job->outputWidth; x++ )
+		{
+			typename Ops::vec sum = Ops::zero();
+
+			// filter along each row first, then across the rows
+			for( int ty=yBegin; ty < yEnd; ty++ )
+			{
+				const T* row = input + job->rows.index[ty] * job->inputWidth;
+				typename Ops::vec acc = Ops::zero();
+
+				for( int tx=xOffset[x]; tx < xOffset[x+1]; tx++ )
+					acc = Ops::accum(acc, Ops::load(row + xIndex[tx]), xWeight[tx]);
+
+				sum = Ops::accum(sum, acc, job->rows.weight[ty]);
+			}
+
+			Ops::store(output + x, sum);
+		}
+	}
+}
+
+// resizeBand
+template<typename T> static void resizeBand( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const resizeJob* job = (const resizeJob*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+#if defined(CPU_VECTOR_SSE)
+	if( features & (CPU_FEATURE_SSE41|CPU_FEATURE_AVX2) )
+		return resizeRows<cpuVectorSSE, T>(rowBegin, rowEnd, job);
+#elif defined(CPU_VECTOR_NEON)
+	if( features & CPU_FEATURE_NEON )
+		return resizeRows<cpuVectorNEON, T>(rowBegin, rowEnd, job);
+#endif
+
+	resizeRows<cpuVectorScalar, T>(rowBegin, rowEnd, job);
+}
+
+// launchResize
+template<typename T> static bool launchResize( T* input, size_t inputWidth, size_t inputHeight,
+									  T* output, size_t outputWidth, size_t outputHeight,
+									  cudaFilterMode filter )
+{
+	if( !input || !output || inputWidth == 0 || inputHeight == 0 || outputWidth == 0 || outputHeight == 0 )
+		return false;
+
+	resizeJob job;
+
+	job.input       = (const uint8_t*)input;
+	job.output      = (uint8_t*)output;
+	job.inputWidth  = inputWidth;
+	job.outputWidth = outputWidth;
+
+	cpuBuildFilterTaps(job.cols, filter, inputWidth, outputWidth);
+	cpuBuildFilterTaps(job.rows, filter, inputHeight, outputHeight);
+
+	cpuParallelRows(outputHeight, 1, resizeBand<T>, &job);
+	return true;
+}
+
+
+// cpuResize
+bool cpuResize( float* input, size_t inputWidth, size_t inputHeight,
+			 float* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter )
+{
+	return launchResize<float>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+// cpuResize
+bool cpuResize( float4* input, size_t inputWidth, size_t inputHeight,
+			 float4* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter )
+{
+	return launchResize<float4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+// cpuResize
+bool cpuResize( uchar3* input, size_t inputWidth, size_t inputHeight,
+			 uchar3* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter )
+{
+	return launchResize<uchar3>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+// cpuResize
+bool cpuResize( uchar4* input, size_t inputWidth, size_t inputHeight,
+			 uchar4* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter )
+{
+	return launchResize<uchar4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+// cpuResizeRGBA
+bool cpuResizeRGBA( float4* input, size_t inputWidth, size_t inputHeight,
+			     float4* output, size_t outputWidth, size_t outputHeight,
+			     cudaFilterMode filter )
+{
+	return launchResize<float4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __CPU_RESIZE_H__
+#define __CPU_RESIZE_H__
+
+
+#include "cudaUtility.h"
+#include "cudaFilterMode.h"
+#include "cpuConvert.h"
+
+#include <vector>
+
+
+/**
+ * Host implementations of cudaResize(), which take CPU pointers and can be used
+ * for verifying the results of the GPU on the CPU.  The filtering modes follow the
+ * same semantics as cudaResize() (see cudaResize.h for how each one samples).
+ *
+ * The filtering of each pixel is vectorized across its channels with SSE or NEON
+ * (selected from cpuGetFeatures()), and is bit-exact with the scalar path.  The
+ * rows of the output can optionally be split across threads with cpuSetThreads().
+ *
+ * @ingroup cuda
+ */
+bool cpuResize( float* input,  size_t inputWidth,  size_t inputHeight,
+			 float* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Resize an RGBA float4 image on the CPU.
+ * @see cpuResize()
+ * @ingroup cuda
+ */
+bool cpuResize( float4* input,  size_t inputWidth,  size_t inputHeight,
+			 float4* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Resize an RGB uchar3 image on the CPU.
+ * @see cpuResize()
+ * @ingroup cuda
+ */
+bool cpuResize( uchar3* input,  size_t inputWidth,  size_t inputHeight,
+			 uchar3* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Resize an RGBA uchar4 image on the CPU.
+ * @see cpuResize()
+ * @ingroup cuda
+ */
+bool cpuResize( uchar4* input,  size_t inputWidth,  size_t inputHeight,
+			 uchar4* output, size_t outputWidth, size_t outputHeight,
+			 cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Resize an RGBA float4 image on the CPU (the host version of cudaResizeRGBA()).
+ * @see cpuResize()
+ * @ingroup cuda
+ */
+bool cpuResizeRGBA( float4* input,  size_t inputWidth,  size_t inputHeight,
+			     float4* output, size_t outputWidth, size_t outputHeight,
+			     cudaFilterMode filter=FILTER_POINT );
+
+
+/**
+ * Input pixels (taps) and their weights that each pixel along one axis of the output
+ * is filtered from.  The taps of output pixel `i` are `[offset[i], offset[i+1])`.
+ * @see cpuBuildFilterTaps()
+ * @ingroup cuda
+ */
+struct cpuFilterTaps
+{
+	std::vector<int>   index;	/**< Input pixel of each tap */
+	std::vector<float> weight;	/**< Weight of each tap */
+	std::vector<int>   offset;	/**< First tap of each output pixel (with an extra entry at the end) */
+};
+
+/**
+ * Compute the taps for resizing one axis of an image from `inputSize` to `outputSize`
+ * pixels with the sampling of cudaResize().  The `inputOffset` is added to the input
+ * pixel indices, for filtering from a region of interest.
+ * @ingroup cuda
+ */
+void cpuBuildFilterTaps( cpuFilterTaps& taps, cudaFilterMode filter, int inputSize, int outputSize, int inputOffset=0 );
+
+
+#endif
+
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __CPU_VECTOR_H__
+#define __CPU_VECTOR_H__
+
+
+#include "cudaUtility.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#define CPU_VECTOR_SSE
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#define CPU_VECTOR_NEON
+#include <arm_neon.h>
+#endif
+
+
+/*
+ * 4-lane float vectors that the host filtering code is written against, so that it
+ * can be instantiated for the scalar reference path and for SSE or NEON.  A vector
+ * holds the channels of one pixel:  load() widens a pixel to float (with the unused
+ * channels zeroed), widen() does the same for 4 packed bytes, accum() adds a weighted pixel, and store() narrows the result
+ * back, rounding and saturating 8-bit channels.  The lanes see the same operations
+ * in the same order on every path, so the results are bit-exact as long as the
+ * multiply-adds aren't contracted (build with -ffp-contract=off).
+ */
+
+// cpuVectorRound (round and saturate a value to 8-bit)
+inline uint8_t cpuVectorRound( float value )
+{
+	return (uint8_t)fminf(fmaxf(value + 0.5f, 0.0f), 255.0f);
+}
+
+// cpuVectorScalar (reference implementation)
+struct cpuVectorScalar
+{
+	struct vec { float v[4]; };
+
+	static inline vec zero()						{ vec r = {{0.0f, 0.0f, 0.0f, 0.0f}}; return r; }
+
+	static inline vec widen( uint32_t bytes )		{ vec r = {{float(bytes & 0xFF), float((bytes >> 8) & 0xFF), float((bytes >> 16) & 0xFF), float(bytes >> 24)}}; return r; }
+
+	static inline vec load( const float* px )		{ vec r = {{*px, 0.0f, 0.0f, 0.0f}}; return r; }
+	static inline vec load( const float4* px )		{ vec r = {{px->x, px->y, px->z, px->w}}; return r; }
+	static inline vec load( const uchar3* px )		{ vec r = {{float(px->x), float(px->y), float(px->z), 0.0f}}; return r; }
+	static inline vec load( const uchar4* px )		{ vec r = {{float(px->x), float(px->y), float(px->z), float(px->w)}}; return r; }
+
+	static inline void store( float* px, const vec& a )	{ *px = a.v[0]; }
+	static inline void store( float4* px, const vec& a )	{ *px = make_float4(a.v[0], a.v[1], a.v[2], a.v[3]); }
+	static inline void store( uchar3* px, const vec& a )	{ *px = make_uchar3(cpuVectorRound(a.v[0]), cpuVectorRound(a.v[1]), cpuVectorRound(a.v[2])); }
+	static inline void store( uchar4* px, const vec& a )	{ *px = make_uchar4(cpuVectorRound(a.v[0]), cpuVectorRound(a.v[1]), cpuVectorRound(a.v[2]), cpuVectorRound(a.v[3])); }
+
+	static inline void extract( const vec& a, float* out )	{ memcpy(out, a.v, sizeof(a.v)); }
+
+	static inline vec accum( const vec& acc, const vec& px, float weight )
+	{
+		vec r;
+
+		for( int n=0; n < 4; n++ )
+			r.v[n] = acc.v[n] + px.v[n] * weight;
+
+		return r;
+	}
+};
+
+#ifdef CPU_VECTOR_SSE
+// cpuVectorSSE (only needs SSE2)
+struct cpuVectorSSE
+{
+	typedef __m128 vec;
+
+	static inline vec zero()					{ return _mm_setzero_ps(); }
+
+	static inline vec widen( uint32_t bytes )
+	{
+		const __m128i z = _mm_setzero_si128();
+		return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), z), z));
+	}
+
+	static inline vec load( const float* px )	{ return _mm_set_ss(*px); }
+	static inline vec load( const float4* px )	{ return _mm_loadu_ps((const float*)px); }
+	static inline vec load( const uchar3* px )	{ return widen(px->x | (px->y << 8) | (px->z << 16)); }
+	static inline vec load( const uchar4* px )	{ uint32_t bytes; memcpy(&bytes, px, sizeof(uint32_t)); return widen(bytes); }
+
+	static inline uint32_t narrow( vec a )
+	{
+		a = _mm_min_ps(_mm_max_ps(_mm_add_ps(a, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+		const __m128i i = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_setzero_si128());
+		return _mm_cvtsi128_si32(_mm_packus_epi16(i, i));
+	}
+
+	static inline void store( float* px, vec a )	{ _mm_store_ss(px, a); }
+	static inline void store( float4* px, vec a )	{ _mm_storeu_ps((float*)px, a); }
+	static inline void store( uchar3* px, vec a )	{ const uint32_t bytes = narrow(a); memcpy(px, &bytes, sizeof(uchar3)); }
+	static inline void store( uchar4* px, vec a )	{ const uint32_t bytes = narrow(a); memcpy(px, &bytes, sizeof(uchar4)); }
+
+	static inline void extract( vec a, float* out )	{ _mm_storeu_ps(out, a); }
+
+	static inline vec accum( vec acc, vec px, float weight )
+	{
+		return _mm_add_ps(acc, _mm_mul_ps(px, _mm_set1_ps(weight)));
+	}
+};
+#endif
+
+#ifdef CPU_VECTOR_NEON
+// cpuVectorNEON
+struct cpuVectorNEON
+{
+	typedef float32x4_t vec;
+
+	static inline vec zero()					{ return vdupq_n_f32(0.0f); }
+
+	static inline vec widen( uint32_t bytes )
+	{
+		const uint16x8_t w = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes)));
+		return vcvtq_f32_u32(vmovl_u16(vget_low_u16(w)));
+	}
+
+	static inline vec load( const float* px )	{ return vsetq_lane_f32(*px, vdupq_n_f32(0.0f), 0); }
+	static inline vec load( const float4* px )	{ return vld1q_f32((const float*)px); }
+	static inline vec load( const uchar3* px )	{ return widen(px->x | (px->y << 8) | (px->z << 16)); }
+	static inline vec load( const uchar4* px )	{ uint32_t bytes; memcpy(&bytes, px, sizeof(uint32_t)); return widen(bytes); }
+
+	static inline uint32_t narrow( vec a )
+	{
+		a = vminq_f32(vmaxq_f32(vaddq_f32(a, vdupq_n_f32(0.5f)), vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+		const uint16x4_t i = vmovn_u32(vcvtq_u32_f32(a));
+		return vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(i, i))), 0);
+	}
+
+	static inline void store( float* px, vec a )	{ *px = vgetq_lane_f32(a, 0); }
+	static inline void store( float4* px, vec a )	{ vst1q_f32((float*)px, a); }
+	static inline void store( uchar3* px, vec a )	{ const uint32_t bytes = narrow(a); memcpy(px, &bytes, sizeof(uchar3)); }
+	static inline void store( uchar4* px, vec a )	{ const uint32_t bytes = narrow(a); memcpy(px, &bytes, sizeof(uchar4)); }
+
+	static inline void extract( vec a, float* out )	{ vst1q_f32(out, a); }
+
+	static inline vec accum( vec acc, vec px, float weight )
+	{
+		return vaddq_f32(acc, vmulq_n_f32(px, weight));	// not vmlaq, which may be fused
+	}
+};
+#endif
+
+
+
+#endif
+
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cpuVideoFormat.h"
+
+#include <math.h>
+
+
+// conversion that's shared by the bands of rows
+struct videoConvert
+{
+	const uint8_t*  input;
+	cudaVideoLayout layout;
+	uint8_t*        output;
+};
+
+
+// YUVToRGBAf
+static inline float4 YUVToRGBAf( float luma, float u, float v )
+{
+	u -= 128.0f;
+	v -= 128.0f;
+
+	const float red   = luma + 1.140f * v;
+	const float green = luma - 0.395f * u - 0.581f * v;
+	const float blue  = luma + 2.032f * u;
+
+	return make_float4(fminf(fmaxf(red, 0.0f), 255.0f),
+				    fminf(fmaxf(green, 0.0f), 255.0f),
+				    fminf(fmaxf(blue, 0.0f), 255.0f), 255.0f);
+}
+
+// storeVideoPixel
+template<cudaOutputFormat output>
+static inline void storeVideoPixel( uint8_t* dstRow, size_t x, const float4& px, float luma )
+{
+	if( output == CUDA_OUTPUT_RGBA32 )
+		((float4*)dstRow)[x] = px;
+	else if( output == CUDA_OUTPUT_RGBA8 )
+		((uchar4*)dstRow)[x] = make_uchar4(px.x, px.y, px.z, px.w);
+	else if( output == CUDA_OUTPUT_RGB8 )
+		((uchar3*)dstRow)[x] = make_uchar3(px.x, px.y, px.z);
+	else if( output == CUDA_OUTPUT_BGR8 )
+		((uchar3*)dstRow)[x] = make_uchar3(px.z, px.y, px.x);
+	else if( output == CUDA_OUTPUT_GRAY8 )
+		dstRow[x] = fminf(luma, 255.0f);
+	else if( output == CUDA_OUTPUT_RGBA16 )
+	{
+		const uint16_t h[4] = { cpuFloatToHalf(px.x), cpuFloatToHalf(px.y), cpuFloatToHalf(px.z), cpuFloatToHalf(px.w) };
+		memcpy(dstRow + x * sizeof(half4), h, sizeof(h));
+	}
+}
+
+// videoRows (the same per-pixel steps as the VideoConvert kernel)
+template<cudaVideoFormat format, cudaOutputFormat output>
+static void videoRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const videoConvert* cvt = (const videoConvert*)user_data;
+	const cudaVideoLayout& layout = cvt->layout;
+	const uint8_t* srcImage = cvt->input;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uint8_t* row = srcImage + layout.offset[0] + y * layout.stride[0];
+		uint8_t* dstRow = cvt->output + y * layout.width * cudaOutputFormatSize(output);
+
+		for( size_t x=0; x < layout.width; x++ )
+		{
+			float4 px;
+			float luma;
+
+			if( format == CUDA_VIDEO_GRAY8 )
+			{
+				luma = row[x];
+				px = make_float4(luma, luma, luma, 255.0f);
+			}
+			else if( format == CUDA_VIDEO_RGB || format == CUDA_VIDEO_BGR ||
+				    format == CUDA_VIDEO_RGBX || format == CUDA_VIDEO_BGRX )
+			{
+				const int bpp = (format == CUDA_VIDEO_RGB || format == CUDA_VIDEO_BGR) ? 3 : 4;
+				const uint8_t* p = row + x * bpp;
+
+				if( format == CUDA_VIDEO_BGR || format == CUDA_VIDEO_BGRX )
+					px = make_float4(p[2], p[1], p[0], 255.0f);
+				else
+					px = make_float4(p[0], p[1], p[2], 255.0f);
+
+				luma = 0.299f * px.x + 0.587f * px.y + 0.114f * px.z;
+			}
+			else if( format == CUDA_VIDEO_YUY2 || format == CUDA_VIDEO_UYVY )
+			{
+				const uint8_t* p = row + (x >> 1) * 4;
+
+				if( format == CUDA_VIDEO_YUY2 )
+				{
+					luma = p[(x & 1) * 2];
+					px = YUVToRGBAf(luma, p[1], p[3]);
+				}
+				else
+				{
+					luma = p[(x & 1) * 2 + 1];
+					px = YUVToRGBAf(luma, p[0], p[2]);
+				}
+			}
+			else if( format == CUDA_VIDEO_NV12 || format == CUDA_VIDEO_NV16 )
+			{
+				const size_t cy = (format == CUDA_VIDEO_NV12) ? (y >> 1) : y;
+				const uint8_t* uv = srcImage + layout.offset[1] + cy * layout.stride[1] + (x >> 1) * 2;
+
+				luma = row[x];
+				px = YUVToRGBAf(luma, uv[0], uv[1]);
+			}
+			else if( format == CUDA_VIDEO_I420 || format == CUDA_VIDEO_YV12 )
+			{
+				const size_t c0 = layout.offset[1] + (y >> 1) * layout.stride[1] + (x >> 1);
+				const size_t c1 = layout.offset[2] + (y >> 1) * layout.stride[2] + (x >> 1);
+
+				luma = row[x];
+
+				if( format == CUDA_VIDEO_I420 )
+					px = YUVToRGBAf(luma, srcImage[c0], srcImage[c1]);
+				else
+					px = YUVToRGBAf(luma, srcImage[c1], srcImage[c0]);
+			}
+
+			storeVideoPixel<output>(dstRow, x, px, luma);
+		}
+	}
+}
+
+// launchVideoConvert
+template<cudaVideoFormat format>
+static bool launchVideoConvert( videoConvert* cvt, cudaOutputFormat outputFormat )
+{
+	cpuRowFunction function = NULL;
+
+	switch(outputFormat)
+	{
+		case CUDA_OUTPUT_RGBA32:	function = videoRows<format, CUDA_OUTPUT_RGBA32>; break;
+		case CUDA_OUTPUT_RGBA8:	function = videoRows<format, CUDA_OUTPUT_RGBA8>;  break;
+		case CUDA_OUTPUT_RGB8:	function = videoRows<format, CUDA_OUTPUT_RGB8>;   break;
+		case CUDA_OUTPUT_BGR8:	function = videoRows<format, CUDA_OUTPUT_BGR8>;   break;
+		case CUDA_OUTPUT_GRAY8:	function = videoRows<format, CUDA_OUTPUT_GRAY8>;  break;
+		case CUDA_OUTPUT_RGBA16:	function = videoRows<format, CUDA_OUTPUT_RGBA16>; break;
+		default:
+		{
+			printf(LOG_CPU "cpuVideoConvert() -- unsupported output format (%s)\n", cudaOutputFormatToString(outputFormat));
+			return false;
+		}
+	}
+
+	// 4:2:0 formats share chroma rows between pairs of luma rows
+	cpuParallelRows(cvt->layout.height, 2, function, cvt);
+	return true;
+}
+
+// cpuVideoConvert
+bool cpuVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat format )
+{
+	if( !input || !output || layout.width == 0 || layout.height == 0 )
+		return false;
+
+	videoConvert cvt = { (const uint8_t*)input, layout, (uint8_t*)output };
+
+	switch(layout.format)
+	{
+		case CUDA_VIDEO_NV12:	return launchVideoConvert<CUDA_VIDEO_NV12>(&cvt, format);
+		case CUDA_VIDEO_NV16:	return launchVideoConvert<CUDA_VIDEO_NV16>(&cvt, format);
+		case CUDA_VIDEO_I420:	return launchVideoConvert<CUDA_VIDEO_I420>(&cvt, format);
+		case CUDA_VIDEO_YV12:	return launchVideoConvert<CUDA_VIDEO_YV12>(&cvt, format);
+		case CUDA_VIDEO_YUY2:	return launchVideoConvert<CUDA_VIDEO_YUY2>(&cvt, format);
+		case CUDA_VIDEO_UYVY:	return launchVideoConvert<CUDA_VIDEO_UYVY>(&cvt, format);
+		case CUDA_VIDEO_GRAY8:	return launchVideoConvert<CUDA_VIDEO_GRAY8>(&cvt, format);
+		case CUDA_VIDEO_RGB:	return launchVideoConvert<CUDA_VIDEO_RGB>(&cvt, format);
+		case CUDA_VIDEO_BGR:	return launchVideoConvert<CUDA_VIDEO_BGR>(&cvt, format);
+		case CUDA_VIDEO_RGBX:	return launchVideoConvert<CUDA_VIDEO_RGBX>(&cvt, format);
+		case CUDA_VIDEO_BGRX:	return launchVideoConvert<CUDA_VIDEO_BGRX>(&cvt, format);
+		default:				break;
+	}
+
+	printf(LOG_CPU "cpuVideoConvert() -- unsupported video format (%s)\n", cudaVideoFormatToString(layout.format));
+	return false;
+}
+
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CPU_VIDEO_FORMAT_H__
+#define __CPU_VIDEO_FORMAT_H__
+
+
+#include "cudaVideoFormat.h"
+#include "cpuConvert.h"
+
+
+/**
+ * Convert a raw video frame of any cudaVideoFormat into one of the cudaOutputFormat's on the CPU.
+ * This is the host version of cudaVideoConvert(), which it matches arithmetically (the rows are
+ * split across threads with cpuSetThreads()).
+ *
+ * @param input pointer to the start of the frame in CPU memory
+ * @param layout format and plane layout of the input frame
+ * @param output image of `layout.width * layout.height` pixels in the output format
+ * @param format the pixel format to convert the frame into
+ * @ingroup colorspace
+ */
+bool cpuVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat format );
+
+
+#endif
+
@@ -0,0 +1,1027 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cpuYUV.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#include <immintrin.h>
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define CPU_NEON
+#include <arm_neon.h>
+#endif
+
+
+// scale from the 10-bit NV12 intermediate to 0-255 (matches cudaNV12ToRGBA32)
+#define NV12_FLOAT_SCALE (1.0f / 1024.0f * 255.0f)
+
+
+// conversion that's shared by the bands of rows
+struct yuvConvert
+{
+	const uint8_t* input;
+	size_t   inputPitch;
+	uint8_t* output;
+	size_t   outputPitch;
+	size_t   width;
+	size_t   height;
+	bool     uyvy;		// UYVY instead of YUYV
+	bool     yv12;		// YV12 instead of I420
+};
+
+
+static inline float clampf( float f, float a, float b )
+{
+	return (f < a) ? a : ((f > b) ? b : f);
+}
+
+static inline uint32_t load32( const uint8_t* ptr )
+{
+	uint32_t value;
+	memcpy(&value, ptr, sizeof(uint32_t));
+	return value;
+}
+
+
+//-----------------------------------------------------------------------------------
+// NV12 to RGBA
+//-----------------------------------------------------------------------------------
+
+// nv12PixelScalar
+template<typename T> static inline T nv12PixelScalar( uint8_t luma8, uint8_t cb, uint8_t cr );
+
+template<> inline uchar4 nv12PixelScalar<uchar4>( uint8_t luma8, uint8_t cb, uint8_t cr )
+{
+	const float luma = float(luma8 << 2);
+	const float u    = float(cb << 2) - 512.0f;
+	const float v    = float(cr << 2) - 512.0f;
+
+	const float red   = luma + 1.140f * v;
+	const float green = luma - 0.395f * u - 0.581f * v;
+	const float blue  = luma + 2.032f * u;
+
+	return make_uchar4((uint32_t)clampf(red, 0.0f, 1023.0f) >> 2,
+				    (uint32_t)clampf(green, 0.0f, 1023.0f) >> 2,
+				    (uint32_t)clampf(blue, 0.0f, 1023.0f) >> 2, 255);
+}
+
+template<> inline float4 nv12PixelScalar<float4>( uint8_t luma8, uint8_t cb, uint8_t cr )
+{
+	const float luma = float(luma8 << 2);
+	const float u    = float(cb << 2) - 512.0f;
+	const float v    = float(cr << 2) - 512.0f;
+
+	const float red   = luma + 1.140f * v;
+	const float green = luma - 0.395f * u - 0.581f * v;
+	const float blue  = luma + 2.032f * u;
+
+	const float s = NV12_FLOAT_SCALE;
+	return make_float4(red * s, green * s, blue * s, 1.0f);
+}
+
+// nv12RowScalar
+template<typename T> static void nv12RowScalar( const uint8_t* Y, const uint8_t* uv0, const uint8_t* uv1, T* out, size_t x, size_t width )
+{
+	for( ; x < width; x += 2 )
+	{
+		uint32_t cb = uv0[x];
+		uint32_t cr = uv0[x+1];
+
+		// interpolate chroma vertically on odd rows
+		if( uv1 != NULL )
+		{
+			cb = (cb + uv1[x] + 1) >> 1;
+			cr = (cr + uv1[x+1] + 1) >> 1;
+		}
+
+		out[x] = nv12PixelScalar<T>(Y[x], cb, cr);
+
+		if( x + 1 < width )
+			out[x+1] = nv12PixelScalar<T>(Y[x+1], cb, cr);
+	}
+}
+
+#ifdef CPU_X86
+// nv12ColorSSE
+TARGET_SSE41 static inline void nv12ColorSSE( __m128i yi, __m128i ui, __m128i vi, __m128& r, __m128& g, __m128& b )
+{
+	const __m128 luma = _mm_cvtepi32_ps(_mm_slli_epi32(yi, 2));
+	const __m128 u    = _mm_sub_ps(_mm_cvtepi32_ps(_mm_slli_epi32(ui, 2)), _mm_set1_ps(512.0f));
+	const __m128 v    = _mm_sub_ps(_mm_cvtepi32_ps(_mm_slli_epi32(vi, 2)), _mm_set1_ps(512.0f));
+
+	r = _mm_add_ps(luma, _mm_mul_ps(_mm_set1_ps(1.140f), v));
+	g = _mm_sub_ps(_mm_sub_ps(luma, _mm_mul_ps(_mm_set1_ps(0.395f), u)), _mm_mul_ps(_mm_set1_ps(0.581f), v));
+	b = _mm_add_ps(luma, _mm_mul_ps(_mm_set1_ps(2.032f), u));
+}
+
+// nv12StoreSSE
+TARGET_SSE41 static inline void nv12StoreSSE( uchar4* out, __m128 r, __m128 g, __m128 b )
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 max  = _mm_set1_ps(1023.0f);
+
+	const __m128i ri = _mm_srli_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(r, zero), max)), 2);
+	const __m128i gi = _mm_srli_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(g, zero), max)), 2);
+	const __m128i bi = _mm_srli_epi32(_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(b, zero), max)), 2);
+
+	const __m128i px = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+							  _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_set1_epi32(0xFF000000)));
+
+	_mm_storeu_si128((__m128i*)out, px);
+}
+
+TARGET_SSE41 static inline void nv12StoreSSE( float4* out, __m128 r, __m128 g, __m128 b )
+{
+	const __m128 s = _mm_set1_ps(NV12_FLOAT_SCALE);
+
+	r = _mm_mul_ps(r, s);
+	g = _mm_mul_ps(g, s);
+	b = _mm_mul_ps(b, s);
+
+	__m128 a = _mm_set1_ps(1.0f);
+	_MM_TRANSPOSE4_PS(r, g, b, a);
+
+	_mm_storeu_ps((float*)(out + 0), r);
+	_mm_storeu_ps((float*)(out + 1), g);
+	_mm_storeu_ps((float*)(out + 2), b);
+	_mm_storeu_ps((float*)(out + 3), a);
+}
+
+// nv12RowSSE41 (4 pixels per iteration)
+template<typename T> TARGET_SSE41 static size_t nv12RowSSE41( const uint8_t* Y, const uint8_t* uv0, const uint8_t* uv1, T* out, size_t width )
+{
+	const __m128i uMask = _mm_setr_epi8(0,-1,-1,-1, 0,-1,-1,-1, 2,-1,-1,-1, 2,-1,-1,-1);
+	const __m128i vMask = _mm_setr_epi8(1,-1,-1,-1, 1,-1,-1,-1, 3,-1,-1,-1, 3,-1,-1,-1);
+
+	size_t x = 0;
+
+	for( ; x + 4 <= width; x += 4 )
+	{
+		__m128i c = _mm_cvtsi32_si128(load32(uv0 + x));
+
+		if( uv1 != NULL )
+			c = _mm_avg_epu8(c, _mm_cvtsi32_si128(load32(uv1 + x)));
+
+		const __m128i yi = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(load32(Y + x)));
+
+		__m128 r, g, b;
+		nv12ColorSSE(yi, _mm_shuffle_epi8(c, uMask), _mm_shuffle_epi8(c, vMask), r, g, b);
+		nv12StoreSSE(out + x, r, g, b);
+	}
+
+	return x;
+}
+
+// nv12RowAVX2 (8 pixels per iteration)
+template<typename T> TARGET_AVX2 static size_t nv12RowAVX2( const uint8_t* Y, const uint8_t* uv0, const uint8_t* uv1, T* out, size_t width )
+{
+	const __m128i uMask = _mm_setr_epi8(0,0,2,2,4,4,6,6, -1,-1,-1,-1,-1,-1,-1,-1);
+	const __m128i vMask = _mm_setr_epi8(1,1,3,3,5,5,7,7, -1,-1,-1,-1,-1,-1,-1,-1);
+
+	const __m256 c512 = _mm256_set1_ps(512.0f);
+
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		__m128i c = _mm_loadl_epi64((const __m128i*)(uv0 + x));
+
+		if( uv1 != NULL )
+			c = _mm_avg_epu8(c, _mm_loadl_epi64((const __m128i*)(uv1 + x)));
+
+		const __m256 luma = _mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(Y + x))), 2));
+		const __m256 u    = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(c, uMask)), 2)), c512);
+		const __m256 v    = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(c, vMask)), 2)), c512);
+
+		const __m256 r = _mm256_add_ps(luma, _mm256_mul_ps(_mm256_set1_ps(1.140f), v));
+		const __m256 g = _mm256_sub_ps(_mm256_sub_ps(luma, _mm256_mul_ps(_mm256_set1_ps(0.395f), u)), _mm256_mul_ps(_mm256_set1_ps(0.581f), v));
+		const __m256 b = _mm256_add_ps(luma, _mm256_mul_ps(_mm256_set1_ps(2.032f), u));
+
+		if( sizeof(T) == sizeof(uchar4) )
+		{
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 max  = _mm256_set1_ps(1023.0f);
+
+			const __m256i ri = _mm256_srli_epi32(_mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(r, zero), max)), 2);
+			const __m256i gi = _mm256_srli_epi32(_mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(g, zero), max)), 2);
+			const __m256i bi = _mm256_srli_epi32(_mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(b, zero), max)), 2);
+
+			const __m256i px = _mm256_or_si256(_mm256_or_si256(ri, _mm256_slli_epi32(gi, 8)),
+									     _mm256_or_si256(_mm256_slli_epi32(bi, 16), _mm256_set1_epi32(0xFF000000)));
+
+			_mm256_storeu_si256((__m256i*)(out + x), px);
+		}
+		else
+		{
+			// the float4 layout is stored 4 pixels at a time
+			nv12StoreSSE(out + x, _mm256_castps256_ps128(r), _mm256_castps256_ps128(g), _mm256_castps256_ps128(b));
+			nv12StoreSSE(out + x + 4, _mm256_extractf128_ps(r, 1), _mm256_extractf128_ps(g, 1), _mm256_extractf128_ps(b, 1));
+		}
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// nv12ColorNEON
+static inline void nv12ColorNEON( uint16x4_t yi, uint16x4_t ui, uint16x4_t vi, float32x4_t& r, float32x4_t& g, float32x4_t& b )
+{
+	const float32x4_t c512 = vdupq_n_f32(512.0f);
+
+	const float32x4_t luma = vcvtq_f32_u32(vmovl_u16(yi));
+	const float32x4_t u    = vsubq_f32(vcvtq_f32_u32(vmovl_u16(ui)), c512);
+	const float32x4_t v    = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vi)), c512);
+
+	r = vaddq_f32(luma, vmulq_f32(vdupq_n_f32(1.140f), v));
+	g = vsubq_f32(vsubq_f32(luma, vmulq_f32(vdupq_n_f32(0.395f), u)), vmulq_f32(vdupq_n_f32(0.581f), v));
+	b = vaddq_f32(luma, vmulq_f32(vdupq_n_f32(2.032f), u));
+}
+
+// nv12PackNEON
+static inline uint8x8_t nv12PackNEON( float32x4_t lo, float32x4_t hi )
+{
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t max  = vdupq_n_f32(1023.0f);
+
+	const uint32x4_t l = vshrq_n_u32(vcvtq_u32_f32(vminq_f32(vmaxq_f32(lo, zero), max)), 2);
+	const uint32x4_t h = vshrq_n_u32(vcvtq_u32_f32(vminq_f32(vmaxq_f32(hi, zero), max)), 2);
+
+	return vmovn_u16(vcombine_u16(vmovn_u32(l), vmovn_u32(h)));
+}
+
+// nv12StoreNEON
+static inline void nv12StoreNEON( uchar4* out, float32x4_t r[2], float32x4_t g[2], float32x4_t b[2] )
+{
+	uint8x8x4_t px;
+
+	px.val[0] = nv12PackNEON(r[0], r[1]);
+	px.val[1] = nv12PackNEON(g[0], g[1]);
+	px.val[2] = nv12PackNEON(b[0], b[1]);
+	px.val[3] = vdup_n_u8(255);
+
+	vst4_u8((uint8_t*)out, px);
+}
+
+static inline void nv12StoreNEON( float4* out, float32x4_t r[2], float32x4_t g[2], float32x4_t b[2] )
+{
+	const float32x4_t s = vdupq_n_f32(NV12_FLOAT_SCALE);
+
+	for( int n=0; n < 2; n++ )
+	{
+		float32x4x4_t px;
+
+		px.val[0] = vmulq_f32(r[n], s);
+		px.val[1] = vmulq_f32(g[n], s);
+		px.val[2] = vmulq_f32(b[n], s);
+		px.val[3] = vdupq_n_f32(1.0f);
+
+		vst4q_f32((float*)(out + n * 4), px);
+	}
+}
+
+// nv12RowNEON (8 pixels per iteration)
+template<typename T> static size_t nv12RowNEON( const uint8_t* Y, const uint8_t* uv0, const uint8_t* uv1, T* out, size_t width )
+{
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		uint8x8_t c = vld1_u8(uv0 + x);
+
+		if( uv1 != NULL )
+			c = vrhadd_u8(c, vld1_u8(uv1 + x));
+
+		// deinterleave U/V, and duplicate them for both pixels of each pair
+		const uint8x8x2_t uv = vuzp_u8(c, c);
+
+		const uint16x8_t yi = vshll_n_u8(vld1_u8(Y + x), 2);
+		const uint16x8_t ui = vshll_n_u8(vzip_u8(uv.val[0], uv.val[0]).val[0], 2);
+		const uint16x8_t vi = vshll_n_u8(vzip_u8(uv.val[1], uv.val[1]).val[0], 2);
+
+		float32x4_t r[2], g[2], b[2];
+
+		nv12ColorNEON(vget_low_u16(yi), vget_low_u16(ui), vget_low_u16(vi), r[0], g[0], b[0]);
+		nv12ColorNEON(vget_high_u16(yi), vget_high_u16(ui), vget_high_u16(vi), r[1], g[1], b[1]);
+
+		nv12StoreNEON(out + x, r, g, b);
+	}
+
+	return x;
+}
+#endif
+
+// nv12Rows
+template<typename T> static void nv12Rows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const yuvConvert* cvt = (const yuvConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	const uint8_t* chroma = cvt->input + cvt->inputPitch * cvt->height;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uint8_t* Y   = cvt->input + y * cvt->inputPitch;
+		const uint8_t* uv0 = chroma + (y >> 1) * cvt->inputPitch;
+		const uint8_t* uv1 = NULL;
+
+		if( (y & 1) && (y >> 1) + 1 < (cvt->height >> 1) )
+			uv1 = uv0 + cvt->inputPitch;
+
+		T* out = (T*)(cvt->output + y * cvt->outputPitch);
+		size_t x = 0;
+
+	#if defined(CPU_X86)
+		if( features & CPU_FEATURE_AVX2 )
+			x = nv12RowAVX2<T>(Y, uv0, uv1, out, cvt->width);
+		else if( features & CPU_FEATURE_SSE41 )
+			x = nv12RowSSE41<T>(Y, uv0, uv1, out, cvt->width);
+	#elif defined(CPU_NEON)
+		if( features & CPU_FEATURE_NEON )
+			x = nv12RowNEON<T>(Y, uv0, uv1, out, cvt->width);
+	#endif
+
+		nv12RowScalar<T>(Y, uv0, uv1, out, x, cvt->width);
+	}
+}
+
+// cpuNV12ToRGBA
+bool cpuNV12ToRGBA( uint8_t* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	if( !input || !output || inputPitch == 0 || outputPitch == 0 || width == 0 || height == 0 )
+		return false;
+
+	yuvConvert cvt = { input, inputPitch, (uint8_t*)output, outputPitch, width, height, false, false };
+	cpuParallelRows(height, 1, nv12Rows<uchar4>, &cvt);
+	return true;
+}
+
+// cpuNV12ToRGBA
+bool cpuNV12ToRGBA( uint8_t* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuNV12ToRGBA(input, width * sizeof(uint8_t), output, width * sizeof(uchar4), width, height);
+}
+
+// cpuNV12ToRGBA32
+bool cpuNV12ToRGBA32( uint8_t* input, size_t inputPitch, float4* output, size_t outputPitch, size_t width, size_t height )
+{
+	if( !input || !output || inputPitch == 0 || outputPitch == 0 || width == 0 || height == 0 )
+		return false;
+
+	yuvConvert cvt = { input, inputPitch, (uint8_t*)output, outputPitch, width, height, false, false };
+	cpuParallelRows(height, 1, nv12Rows<float4>, &cvt);
+	return true;
+}
+
+// cpuNV12ToRGBA32
+bool cpuNV12ToRGBA32( uint8_t* input, float4* output, size_t width, size_t height )
+{
+	return cpuNV12ToRGBA32(input, width * sizeof(uint8_t), output, width * sizeof(float4), width, height);
+}
+
+
+//-----------------------------------------------------------------------------------
+// YUYV/UYVY to RGBA
+//-----------------------------------------------------------------------------------
+
+// yuyvPixelScalar
+static inline uchar4 yuyvPixelScalar( float luma, float u, float v )
+{
+	const float red   = luma + 1.4065f * v;
+	const float green = luma - 0.3455f * u - 0.7169f * v;
+	const float blue  = luma + 1.7790f * u;
+
+	return make_uchar4(clampf(red, 0.0f, 255.0f), clampf(green, 0.0f, 255.0f), clampf(blue, 0.0f, 255.0f), 255);
+}
+
+// yuyvRowScalar (one macropixel of two pixels per iteration)
+static void yuyvRowScalar( const uint8_t* in, uchar4* out, size_t x, size_t width, bool uyvy )
+{
+	for( ; x + 2 <= width; x += 2 )
+	{
+		// UYVY [ U0 | Y0 | V0 | Y1 ]
+		// YUYV [ Y0 | U0 | Y1 | V0 ]
+		const uint8_t* px = in + x * 2;
+
+		const float y0 = uyvy ? px[1] : px[0];
+		const float y1 = uyvy ? px[3] : px[2];
+		const float u  = (uyvy ? px[0] : px[1]) - 128.0f;
+		const float v  = (uyvy ? px[2] : px[3]) - 128.0f;
+
+		out[x]   = yuyvPixelScalar(y0, u, v);
+		out[x+1] = yuyvPixelScalar(y1, u, v);
+	}
+}
+
+#ifdef CPU_X86
+// yuyvRowSSE41 (4 pixels per iteration)
+TARGET_SSE41 static size_t yuyvRowSSE41( const uint8_t* in, uchar4* out, size_t width, bool uyvy )
+{
+	const __m128i yMask = uyvy ? _mm_setr_epi8(1,-1,-1,-1, 3,-1,-1,-1, 5,-1,-1,-1, 7,-1,-1,-1)
+						  : _mm_setr_epi8(0,-1,-1,-1, 2,-1,-1,-1, 4,-1,-1,-1, 6,-1,-1,-1);
+	const __m128i uMask = uyvy ? _mm_setr_epi8(0,-1,-1,-1, 0,-1,-1,-1, 4,-1,-1,-1, 4,-1,-1,-1)
+						  : _mm_setr_epi8(1,-1,-1,-1, 1,-1,-1,-1, 5,-1,-1,-1, 5,-1,-1,-1);
+	const __m128i vMask = uyvy ? _mm_setr_epi8(2,-1,-1,-1, 2,-1,-1,-1, 6,-1,-1,-1, 6,-1,-1,-1)
+						  : _mm_setr_epi8(3,-1,-1,-1, 3,-1,-1,-1, 7,-1,-1,-1, 7,-1,-1,-1);
+
+	const __m128 c128 = _mm_set1_ps(128.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 max  = _mm_set1_ps(255.0f);
+
+	size_t x = 0;
+
+	for( ; x + 4 <= width; x += 4 )
+	{
+		const __m128i px = _mm_loadl_epi64((const __m128i*)(in + x * 2));
+
+		const __m128 luma = _mm_cvtepi32_ps(_mm_shuffle_epi8(px, yMask));
+		const __m128 u    = _mm_sub_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, uMask)), c128);
+		const __m128 v    = _mm_sub_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, vMask)), c128);
+
+		const __m128 r = _mm_add_ps(luma, _mm_mul_ps(_mm_set1_ps(1.4065f), v));
+		const __m128 g = _mm_sub_ps(_mm_sub_ps(luma, _mm_mul_ps(_mm_set1_ps(0.3455f), u)), _mm_mul_ps(_mm_set1_ps(0.7169f), v));
+		const __m128 b = _mm_add_ps(luma, _mm_mul_ps(_mm_set1_ps(1.7790f), u));
+
+		const __m128i ri = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(r, zero), max));
+		const __m128i gi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(g, zero), max));
+		const __m128i bi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(b, zero), max));
+
+		const __m128i rgba = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+								    _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_set1_epi32(0xFF000000)));
+
+		_mm_storeu_si128((__m128i*)(out + x), rgba);
+	}
+
+	return x;
+}
+
+// yuyvRowAVX2 (8 pixels per iteration)
+TARGET_AVX2 static size_t yuyvRowAVX2( const uint8_t* in, uchar4* out, size_t width, bool uyvy )
+{
+	const __m128i yMask = uyvy ? _mm_setr_epi8(1,3,5,7,9,11,13,15, -1,-1,-1,-1,-1,-1,-1,-1)
+						  : _mm_setr_epi8(0,2,4,6,8,10,12,14, -1,-1,-1,-1,-1,-1,-1,-1);
+	const __m128i uMask = uyvy ? _mm_setr_epi8(0,0,4,4,8,8,12,12, -1,-1,-1,-1,-1,-1,-1,-1)
+						  : _mm_setr_epi8(1,1,5,5,9,9,13,13, -1,-1,-1,-1,-1,-1,-1,-1);
+	const __m128i vMask = uyvy ? _mm_setr_epi8(2,2,6,6,10,10,14,14, -1,-1,-1,-1,-1,-1,-1,-1)
+						  : _mm_setr_epi8(3,3,7,7,11,11,15,15, -1,-1,-1,-1,-1,-1,-1,-1);
+
+	const __m256 c128 = _mm256_set1_ps(128.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 max  = _mm256_set1_ps(255.0f);
+
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const __m128i px = _mm_loadu_si128((const __m128i*)(in + x * 2));
+
+		const __m256 luma = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(px, yMask)));
+		const __m256 u    = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(px, uMask))), c128);
+		const __m256 v    = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(px, vMask))), c128);
+
+		const __m256 r = _mm256_add_ps(luma, _mm256_mul_ps(_mm256_set1_ps(1.4065f), v));
+		const __m256 g = _mm256_sub_ps(_mm256_sub_ps(luma, _mm256_mul_ps(_mm256_set1_ps(0.3455f), u)), _mm256_mul_ps(_mm256_set1_ps(0.7169f), v));
+		const __m256 b = _mm256_add_ps(luma, _mm256_mul_ps(_mm256_set1_ps(1.7790f), u));
+
+		const __m256i ri = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(r, zero), max));
+		const __m256i gi = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(g, zero), max));
+		const __m256i bi = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(b, zero), max));
+
+		const __m256i rgba = _mm256_or_si256(_mm256_or_si256(ri, _mm256_slli_epi32(gi, 8)),
+									   _mm256_or_si256(_mm256_slli_epi32(bi, 16), _mm256_set1_epi32(0xFF000000)));
+
+		_mm256_storeu_si256((__m256i*)(out + x), rgba);
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// yuyvPackNEON
+static inline uint8x8_t yuyvPackNEON( float32x4_t lo, float32x4_t hi )
+{
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t max  = vdupq_n_f32(255.0f);
+
+	const uint32x4_t l = vcvtq_u32_f32(vminq_f32(vmaxq_f32(lo, zero), max));
+	const uint32x4_t h = vcvtq_u32_f32(vminq_f32(vmaxq_f32(hi, zero), max));
+
+	return vmovn_u16(vcombine_u16(vmovn_u32(l), vmovn_u32(h)));
+}
+
+// yuyvColorNEON (8 pixels that correspond to the u/v lanes)
+static inline void yuyvColorNEON( uint8x8_t y8, uint8x8_t u8, uint8x8_t v8, uint8x8_t& r, uint8x8_t& g, uint8x8_t& b )
+{
+	const float32x4_t c128 = vdupq_n_f32(128.0f);
+
+	const uint16x8_t y16 = vmovl_u8(y8);
+	const uint16x8_t u16 = vmovl_u8(u8);
+	const uint16x8_t v16 = vmovl_u8(v8);
+
+	float32x4_t rf[2], gf[2], bf[2];
+
+	for( int n=0; n < 2; n++ )
+	{
+		const uint16x4_t yh = n ? vget_high_u16(y16) : vget_low_u16(y16);
+		const uint16x4_t uh = n ? vget_high_u16(u16) : vget_low_u16(u16);
+		const uint16x4_t vh = n ? vget_high_u16(v16) : vget_low_u16(v16);
+
+		const float32x4_t luma = vcvtq_f32_u32(vmovl_u16(yh));
+		const float32x4_t u    = vsubq_f32(vcvtq_f32_u32(vmovl_u16(uh)), c128);
+		const float32x4_t v    = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vh)), c128);
+
+		rf[n] = vaddq_f32(luma, vmulq_f32(vdupq_n_f32(1.4065f), v));
+		gf[n] = vsubq_f32(vsubq_f32(luma, vmulq_f32(vdupq_n_f32(0.3455f), u)), vmulq_f32(vdupq_n_f32(0.7169f), v));
+		bf[n] = vaddq_f32(luma, vmulq_f32(vdupq_n_f32(1.7790f), u));
+	}
+
+	r = yuyvPackNEON(rf[0], rf[1]);
+	g = yuyvPackNEON(gf[0], gf[1]);
+	b = yuyvPackNEON(bf[0], bf[1]);
+}
+
+// yuyvRowNEON (16 pixels per iteration)
+static size_t yuyvRowNEON( const uint8_t* in, uchar4* out, size_t width, bool uyvy )
+{
+	size_t x = 0;
+
+	for( ; x + 16 <= width; x += 16 )
+	{
+		const uint8x8x4_t px = vld4_u8(in + x * 2);
+
+		const uint8x8_t y0 = uyvy ? px.val[1] : px.val[0];
+		const uint8x8_t y1 = uyvy ? px.val[3] : px.val[2];
+		const uint8x8_t u  = uyvy ? px.val[0] : px.val[1];
+		const uint8x8_t v  = uyvy ? px.val[2] : px.val[3];
+
+		uint8x8_t r0, g0, b0, r1, g1, b1;
+
+		yuyvColorNEON(y0, u, v, r0, g0, b0);
+		yuyvColorNEON(y1, u, v, r1, g1, b1);
+
+		// interleave the even and odd pixels back together
+		const uint8x8x2_t r = vzip_u8(r0, r1);
+		const uint8x8x2_t g = vzip_u8(g0, g1);
+		const uint8x8x2_t b = vzip_u8(b0, b1);
+
+		uint8x16x4_t rgba;
+
+		rgba.val[0] = vcombine_u8(r.val[0], r.val[1]);
+		rgba.val[1] = vcombine_u8(g.val[0], g.val[1]);
+		rgba.val[2] = vcombine_u8(b.val[0], b.val[1]);
+		rgba.val[3] = vdupq_n_u8(255);
+
+		vst4q_u8((uint8_t*)(out + x), rgba);
+	}
+
+	return x;
+}
+#endif
+
+// yuyvRows
+static void yuyvRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const yuvConvert* cvt = (const yuvConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uint8_t* in = cvt->input + y * cvt->inputPitch;
+		uchar4* out = (uchar4*)(cvt->output + y * cvt->outputPitch);
+		size_t x = 0;
+
+	#if defined(CPU_X86)
+		if( features & CPU_FEATURE_AVX2 )
+			x = yuyvRowAVX2(in, out, cvt->width, cvt->uyvy);
+		else if( features & CPU_FEATURE_SSE41 )
+			x = yuyvRowSSE41(in, out, cvt->width, cvt->uyvy);
+	#elif defined(CPU_NEON)
+		if( features & CPU_FEATURE_NEON )
+			x = yuyvRowNEON(in, out, cvt->width, cvt->uyvy);
+	#endif
+
+		yuyvRowScalar(in, out, x, cvt->width, cvt->uyvy);
+	}
+}
+
+// launchYUYV
+static bool launchYUYV( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height, bool uyvy )
+{
+	if( !input || !inputPitch || !output || !outputPitch || !width || !height )
+		return false;
+
+	yuvConvert cvt = { (const uint8_t*)input, inputPitch, (uint8_t*)output, outputPitch, width, height, uyvy, false };
+	cpuParallelRows(height, 1, yuyvRows, &cvt);
+	return true;
+}
+
+bool cpuUYVYToRGBA( uchar2* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuUYVYToRGBA(input, width * sizeof(uchar2), output, width * sizeof(uchar4), width, height);
+}
+
+bool cpuUYVYToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launchYUYV(input, inputPitch, output, outputPitch, width, height, true);
+}
+
+bool cpuYUYVToRGBA( uchar2* input, uchar4* output, size_t width, size_t height )
+{
+	return cpuYUYVToRGBA(input, width * sizeof(uchar2), output, width * sizeof(uchar4), width, height);
+}
+
+bool cpuYUYVToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launchYUYV(input, inputPitch, output, outputPitch, width, height, false);
+}
+
+
+//-----------------------------------------------------------------------------------
+// YUYV/UYVY to grayscale
+//-----------------------------------------------------------------------------------
+
+// grayRowScalar
+static void grayRowScalar( const uint8_t* in, float* out, size_t x, size_t width, bool uyvy )
+{
+	const size_t offset = uyvy ? 1 : 0;
+
+	for( ; x < width; x++ )
+		out[x] = float(in[x * 2 + offset]) / 255.0f;
+}
+
+#ifdef CPU_X86
+// grayRowSSE41 (4 pixels per iteration)
+TARGET_SSE41 static size_t grayRowSSE41( const uint8_t* in, float* out, size_t width, bool uyvy )
+{
+	const __m128i yMask = uyvy ? _mm_setr_epi8(1,-1,-1,-1, 3,-1,-1,-1, 5,-1,-1,-1, 7,-1,-1,-1)
+						  : _mm_setr_epi8(0,-1,-1,-1, 2,-1,-1,-1, 4,-1,-1,-1, 6,-1,-1,-1);
+
+	const __m128 c255 = _mm_set1_ps(255.0f);
+	size_t x = 0;
+
+	for( ; x + 4 <= width; x += 4 )
+	{
+		const __m128i px = _mm_loadl_epi64((const __m128i*)(in + x * 2));
+		_mm_storeu_ps(out + x, _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, yMask)), c255));
+	}
+
+	return x;
+}
+
+// grayRowAVX2 (8 pixels per iteration)
+TARGET_AVX2 static size_t grayRowAVX2( const uint8_t* in, float* out, size_t width, bool uyvy )
+{
+	const __m128i yMask = uyvy ? _mm_setr_epi8(1,3,5,7,9,11,13,15, -1,-1,-1,-1,-1,-1,-1,-1)
+						  : _mm_setr_epi8(0,2,4,6,8,10,12,14, -1,-1,-1,-1,-1,-1,-1,-1);
+
+	const __m256 c255 = _mm256_set1_ps(255.0f);
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const __m128i px = _mm_loadu_si128((const __m128i*)(in + x * 2));
+		_mm256_storeu_ps(out + x, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_shuffle_epi8(px, yMask))), c255));
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// grayRowNEON (8 pixels per iteration)
+static size_t grayRowNEON( const uint8_t* in, float* out, size_t width, bool uyvy )
+{
+	const float32x4_t c255 = vdupq_n_f32(255.0f);
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const uint8x8x2_t px = vld2_u8(in + x * 2);
+		const uint16x8_t luma = vmovl_u8(uyvy ? px.val[1] : px.val[0]);
+
+		vst1q_f32(out + x,     vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(luma))), c255));
+		vst1q_f32(out + x + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(luma))), c255));
+	}
+
+	return x;
+}
+#endif
+
+// grayRows
+static void grayRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const yuvConvert* cvt = (const yuvConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+	{
+		const uint8_t* in = cvt->input + y * cvt->inputPitch;
+		float* out = (float*)(cvt->output + y * cvt->outputPitch);
+		size_t x = 0;
+
+	#if defined(CPU_X86)
+		if( features & CPU_FEATURE_AVX2 )
+			x = grayRowAVX2(in, out, cvt->width, cvt->uyvy);
+		else if( features & CPU_FEATURE_SSE41 )
+			x = grayRowSSE41(in, out, cvt->width, cvt->uyvy);
+	#elif defined(CPU_NEON)
+		if( features & CPU_FEATURE_NEON )
+			x = grayRowNEON(in, out, cvt->width, cvt->uyvy);
+	#endif
+
+		grayRowScalar(in, out, x, cvt->width, cvt->uyvy);
+	}
+}
+
+// launchGrayYUYV
+static bool launchGrayYUYV( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height, bool uyvy )
+{
+	if( !input || !inputPitch || !output || !outputPitch || !width || !height )
+		return false;
+
+	yuvConvert cvt = { (const uint8_t*)input, inputPitch, (uint8_t*)output, outputPitch, width, height, uyvy, false };
+	cpuParallelRows(height, 1, grayRows, &cvt);
+	return true;
+}
+
+bool cpuUYVYToGray( uchar2* input, float* output, size_t width, size_t height )
+{
+	return cpuUYVYToGray(input, width * sizeof(uchar2), output, width * sizeof(float), width, height);
+}
+
+bool cpuUYVYToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launchGrayYUYV(input, inputPitch, output, outputPitch, width, height, true);
+}
+
+bool cpuYUYVToGray( uchar2* input, float* output, size_t width, size_t height )
+{
+	return cpuYUYVToGray(input, width * sizeof(uchar2), output, width * sizeof(float), width, height);
+}
+
+bool cpuYUYVToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launchGrayYUYV(input, inputPitch, output, outputPitch, width, height, false);
+}
+
+
+//-----------------------------------------------------------------------------------
+// RGBA to I420/YV12
+//-----------------------------------------------------------------------------------
+
+static inline uint8_t rgb_to_y( const uchar4& px )
+{
+	return (uint8_t)(((int)(30 * px.x) + (int)(59 * px.y) + (int)(11 * px.z)) / 100);
+}
+
+static inline uint8_t rgb_to_u( const uchar4& px )
+{
+	return (uint8_t)(((int)(-17 * px.x) - (int)(33 * px.y) + (int)(50 * px.z) + 12800) / 100);
+}
+
+static inline uint8_t rgb_to_v( const uchar4& px )
+{
+	return (uint8_t)(((int)(50 * px.x) - (int)(42 * px.y) - (int)(8 * px.z) + 12800) / 100);
+}
+
+// planarRowScalar
+static void planarRowScalar( const uchar4* in, uint8_t* Y, uint8_t* U, uint8_t* V, size_t x, size_t width )
+{
+	for( size_t n=x; n < width; n++ )
+		Y[n] = rgb_to_y(in[n]);
+
+	// chroma is sampled from the second pixel of each pair (on the second row)
+	if( !U || !V )
+		return;
+
+	for( size_t n=x; n + 1 < width; n += 2 )
+	{
+		U[n/2] = rgb_to_u(in[n+1]);
+		V[n/2] = rgb_to_v(in[n+1]);
+	}
+}
+
+#ifdef CPU_X86
+// planarRowSSE41 (8 pixels per iteration)
+TARGET_SSE41 static size_t planarRowSSE41( const uchar4* in, uint8_t* Y, uint8_t* U, uint8_t* V, size_t width )
+{
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i div  = _mm_set1_epi16(5243);	// (n * 5243) >> 19 == n / 100 for the n <= 25550 that these sums produce
+	const __m128i odd  = _mm_setr_epi8(1,3,5,7, -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const __m128i p0 = _mm_loadu_si128((const __m128i*)(in + x));
+		const __m128i p1 = _mm_loadu_si128((const __m128i*)(in + x + 4));
+
+		const __m128i r = _mm_packus_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+		const __m128i g = _mm_packus_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mask), _mm_and_si128(_mm_srli_epi32(p1, 8), mask));
+		const __m128i b = _mm_packus_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mask), _mm_and_si128(_mm_srli_epi32(p1, 16), mask));
+
+		const __m128i yn = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(30)),
+											  _mm_mullo_epi16(g, _mm_set1_epi16(59))),
+											  _mm_mullo_epi16(b, _mm_set1_epi16(11)));
+
+		const __m128i yv = _mm_srli_epi16(_mm_mulhi_epu16(yn, div), 3);
+		_mm_storel_epi64((__m128i*)(Y + x), _mm_packus_epi16(yv, yv));
+
+		if( !U || !V )
+			continue;
+
+		// the sums stay between 50 and 25550, so they don't wrap in 16 bits
+		const __m128i un = _mm_sub_epi16(_mm_sub_epi16(_mm_add_epi16(_mm_set1_epi16(12800), _mm_mullo_epi16(b, _mm_set1_epi16(50))),
+											  _mm_mullo_epi16(r, _mm_set1_epi16(17))),
+											  _mm_mullo_epi16(g, _mm_set1_epi16(33)));
+
+		const __m128i vn = _mm_sub_epi16(_mm_sub_epi16(_mm_add_epi16(_mm_set1_epi16(12800), _mm_mullo_epi16(r, _mm_set1_epi16(50))),
+											  _mm_mullo_epi16(g, _mm_set1_epi16(42))),
+											  _mm_mullo_epi16(b, _mm_set1_epi16(8)));
+
+		const __m128i uv = _mm_srli_epi16(_mm_mulhi_epu16(un, div), 3);
+		const __m128i vv = _mm_srli_epi16(_mm_mulhi_epu16(vn, div), 3);
+
+		const uint32_t u4 = _mm_cvtsi128_si32(_mm_shuffle_epi8(_mm_packus_epi16(uv, uv), odd));
+		const uint32_t v4 = _mm_cvtsi128_si32(_mm_shuffle_epi8(_mm_packus_epi16(vv, vv), odd));
+
+		memcpy(U + x / 2, &u4, sizeof(uint32_t));
+		memcpy(V + x / 2, &v4, sizeof(uint32_t));
+	}
+
+	return x;
+}
+#endif
+
+#ifdef CPU_NEON
+// divide100NEON
+static inline uint8x8_t divide100NEON( uint16x8_t n )
+{
+	// (n * 5243) >> 19 == n / 100 for the n <= 25550 that these sums produce
+	const uint16x4_t div = vdup_n_u16(5243);
+
+	const uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(n), div), 16);
+	const uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(n), div), 16);
+
+	return vmovn_u16(vshrq_n_u16(vcombine_u16(lo, hi), 3));
+}
+
+// planarRowNEON (8 pixels per iteration)
+static size_t planarRowNEON( const uchar4* in, uint8_t* Y, uint8_t* U, uint8_t* V, size_t width )
+{
+	size_t x = 0;
+
+	for( ; x + 8 <= width; x += 8 )
+	{
+		const uint8x8x4_t px = vld4_u8((const uint8_t*)(in + x));
+
+		const uint8x8_t r = px.val[0];
+		const uint8x8_t g = px.val[1];
+		const uint8x8_t b = px.val[2];
+
+		uint16x8_t yn = vmull_u8(r, vdup_n_u8(30));
+		yn = vmlal_u8(yn, g, vdup_n_u8(59));
+		yn = vmlal_u8(yn, b, vdup_n_u8(11));
+
+		vst1_u8(Y + x, divide100NEON(yn));
+
+		if( !U || !V )
+			continue;
+
+		// the sums stay between 50 and 25550, so they don't wrap in 16 bits
+		uint16x8_t un = vmlal_u8(vdupq_n_u16(12800), b, vdup_n_u8(50));
+		un = vmlsl_u8(un, r, vdup_n_u8(17));
+		un = vmlsl_u8(un, g, vdup_n_u8(33));
+
+		uint16x8_t vn = vmlal_u8(vdupq_n_u16(12800), r, vdup_n_u8(50));
+		vn = vmlsl_u8(vn, g, vdup_n_u8(42));
+		vn = vmlsl_u8(vn, b, vdup_n_u8(8));
+
+		// keep the odd pixels
+		const uint8x8_t u8 = divide100NEON(un);
+		const uint8x8_t v8 = divide100NEON(vn);
+
+		const uint32_t u4 = vget_lane_u32(vreinterpret_u32_u8(vuzp_u8(u8, u8).val[1]), 0);
+		const uint32_t v4 = vget_lane_u32(vreinterpret_u32_u8(vuzp_u8(v8, v8).val[1]), 0);
+
+		memcpy(U + x / 2, &u4, sizeof(uint32_t));
+		memcpy(V + x / 2, &v4, sizeof(uint32_t));
+	}
+
+	return x;
+}
+#endif
+
+// planarRow
+static void planarRow( const uchar4* in, uint8_t* Y, uint8_t* U, uint8_t* V, size_t width, uint32_t features )
+{
+	size_t x = 0;
+
+	// the AVX2 path uses the SSE4.1 kernel (the integer packing doesn't gain from 256-bit lanes)
+#if defined(CPU_X86)
+	if( features & (CPU_FEATURE_AVX2|CPU_FEATURE_SSE41) )
+		x = planarRowSSE41(in, Y, U, V, width);
+#elif defined(CPU_NEON)
+	if( features & CPU_FEATURE_NEON )
+		x = planarRowNEON(in, Y, U, V, width);
+#endif
+
+	planarRowScalar(in, Y, U, V, x, width);
+}
+
+// planarRows
+static void planarRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const yuvConvert* cvt = (const yuvConvert*)user_data;
+	const uint32_t features = cpuGetFeatures();
+
+	const size_t planeSize = cvt->height * cvt->outputPitch;
+	const size_t uvPitch   = cvt->outputPitch / 2;
+
+	uint8_t* planeU = cvt->output + planeSize;
+	uint8_t* planeV = planeU + planeSize / 4;
+
+	if( cvt->yv12 )
+	{
+		uint8_t* swap = planeU;	// in YV12, the V plane comes first
+		planeU = planeV;
+		planeV = swap;
+	}
+
+	// rows are processed in pairs, with the chroma taken from the second row
+	for( size_t y=rowBegin; y < rowEnd; y += 2 )
+	{
+		const uchar4* in0 = (const uchar4*)(cvt->input + y * cvt->inputPitch);
+		uint8_t* Y0 = cvt->output + y * cvt->outputPitch;
+
+		planarRow(in0, Y0, NULL, NULL, cvt->width, features);
+
+		if( y + 1 >= cvt->height )
+			break;
+
+		const uchar4* in1 = (const uchar4*)(cvt->input + (y + 1) * cvt->inputPitch);
+		uint8_t* Y1 = Y0 + cvt->outputPitch;
+
+		planarRow(in1, Y1, planeU + (y / 2) * uvPitch, planeV + (y / 2) * uvPitch, cvt->width, features);
+	}
+}
+
+// launch420
+static bool launch420( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height, bool yv12 )
+{
+	if( !input || !inputPitch || !output || !outputPitch || !width || !height )
+		return false;
+
+	yuvConvert cvt = { (const uint8_t*)input, inputPitch, output, outputPitch, width, height, false, yv12 };
+	cpuParallelRows(height, 2, planarRows, &cvt);
+	return true;
+}
+
+// cpuRGBAToYV12
+bool cpuRGBAToYV12( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launch420(input, inputPitch, output, outputPitch, width, height, true);
+}
+
+// cpuRGBAToYV12
+bool cpuRGBAToYV12( uchar4* input, uint8_t* output, size_t width, size_t height )
+{
+	return cpuRGBAToYV12(input, width * sizeof(uchar4), output, width * sizeof(uint8_t), width, height);
+}
+
+// cpuRGBAToI420
+bool cpuRGBAToI420( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height )
+{
+	return launch420(input, inputPitch, output, outputPitch, width, height, false);
+}
+
+// cpuRGBAToI420
+bool cpuRGBAToI420( uchar4* input, uint8_t* output, size_t width, size_t height )
+{
+	return cpuRGBAToI420(input, width * sizeof(uchar4), output, width * sizeof(uint8_t), width, height);
+}
+
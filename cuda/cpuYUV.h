@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CPU_YUV_CONVERT_H__
+#define __CPU_YUV_CONVERT_H__
+
+
+#include "cudaUtility.h"
+#include "cpuConvert.h"
+
+
+/**
+ * Host implementations of the conversions from cudaYUV.h, which take CPU pointers.
+ *
+ * Each conversion has a scalar reference path, and vectorized paths for SSE4.1,
+ * AVX2 and NEON that are selected at runtime from cpuGetFeatures().  The vectorized
+ * paths perform the same operations in the same order as the scalar path, so their
+ * output is bit-exact with it (this relies on the multiply-adds not being contracted,
+ * which is why the file is built with -ffp-contract=off).  The rows of an image can
+ * optionally be split across threads with cpuSetThreads().
+ *
+ * The arithmetic follows the CUDA kernels, except that cpuNV12ToRGBA() stores the
+ * channels in R,G,B,A byte order with an opaque alpha, and the NV12 hue adjustment
+ * from cudaNV12SetupColorspace() isn't supported.
+ *
+ * @ingroup colorspace
+ */
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name RGBA to YUV 4:2:0 planar (I420 & YV12)
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert an RGBA uchar4 buffer into YUV I420 planar on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGBAToI420( uchar4* input, uint8_t* output, size_t width, size_t height );
+
+/**
+ * Convert an RGBA uchar4 texture into YUV I420 planar on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGBAToI420( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height );
+
+/**
+ * Convert an RGBA uchar4 buffer into YUV YV12 planar on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGBAToYV12( uchar4* input, uint8_t* output, size_t width, size_t height );
+
+/**
+ * Convert an RGBA uchar4 texture into YUV YV12 planar on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuRGBAToYV12( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height );
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name YUV 4:2:2 packed (UYVY & YUYV) to RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert a UYVY 422 packed image into RGBA uchar4 on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuUYVYToRGBA( uchar2* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert a UYVY 422 packed image into RGBA uchar4 on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuUYVYToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height );
+
+/**
+ * Convert a YUYV 422 packed image into RGBA uchar4 on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuYUYVToRGBA( uchar2* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert a YUYV 422 packed image into RGBA uchar4 on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuYUYVToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height );
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name UYUV 4:2:2 packed (UYVY & YUYV) to grayscale
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert a UYVY 422 packed image into a floating-point grayscale image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuUYVYToGray( uchar2* input, float* output, size_t width, size_t height );
+
+/**
+ * Convert a UYVY 422 packed image into a floating-point grayscale image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuUYVYToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height );
+
+/**
+ * Convert a YUYV 422 packed image into a floating-point grayscale image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuYUYVToGray( uchar2* input, float* output, size_t width, size_t height );
+
+/**
+ * Convert a YUYV 422 packed image into a floating-point grayscale image on the CPU.
+ * @ingroup colorspace
+ */
+bool cpuYUYVToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height );
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name YUV NV12 to RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert an NV12 image (semi-planar 4:2:0) to RGBA uchar4 format on the CPU.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+bool cpuNV12ToRGBA( uint8_t* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert an NV12 image (semi-planar 4:2:0) to RGBA uchar4 format on the CPU.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+bool cpuNV12ToRGBA( uint8_t* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height );
+
+/**
+ * Convert an NV12 image (semi-planar 4:2:0) to RGBA float4 format on the CPU.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+bool cpuNV12ToRGBA32( uint8_t* input, float4* output, size_t width, size_t height );
+
+/**
+ * Convert an NV12 image (semi-planar 4:2:0) to RGBA float4 format on the CPU.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+bool cpuNV12ToRGBA32( uint8_t* input, size_t inputPitch, float4* output, size_t outputPitch, size_t width, size_t height );
+
+///@}
+
+#endif
+
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CUDA_FP16_IMAGE_H__
+#define __CUDA_FP16_IMAGE_H__
+
+
+#include "cudaUtility.h"
+
+#ifndef JETSON_UTILS_NO_CUDA
+#include <cuda_fp16.h>
+#endif
+
+
+/**
+ * Half-precision RGBA pixel, which is the element type of FP16 images (the `RGBA16`
+ * conversions).  Pixel intensities from 0 to 255 are stored exactly, since half
+ * floats have 11 bits of precision.  This takes 8 bytes per pixel instead of 16.
+ * @ingroup cuda
+ */
+struct __align__(8) half4
+{
+	__half x;
+	__half y;
+	__half z;
+	__half w;
+};
+
+/**
+ * Half-precision RGB pixel (6 bytes), the 3-channel counterpart to half4.
+ * @ingroup cuda
+ */
+struct half3
+{
+	__half x;
+	__half y;
+	__half z;
+};
+
+
+#ifdef __CUDACC__
+
+// make_half4
+inline __device__ half4 make_half4( float x, float y, float z, float w )
+{
+	half4 h;
+
+	h.x = __float2half_rn(x);
+	h.y = __float2half_rn(y);
+	h.z = __float2half_rn(z);
+	h.w = __float2half_rn(w);
+
+	return h;
+}
+
+// make_half4
+inline __device__ half4 make_half4( const float4& a )
+{
+	return make_half4(a.x, a.y, a.z, a.w);
+}
+
+// make_half3
+inline __device__ half3 make_half3( float x, float y, float z )
+{
+	half3 h;
+
+	h.x = __float2half_rn(x);
+	h.y = __float2half_rn(y);
+	h.z = __float2half_rn(z);
+
+	return h;
+}
+
+// make_float4
+inline __device__ float4 make_float4( const half4& a )
+{
+	return make_float4(__half2float(a.x), __half2float(a.y), __half2float(a.z), __half2float(a.w));
+}
+
+// make_float3
+inline __device__ float3 make_float3( const half3& a )
+{
+	return make_float3(__half2float(a.x), __half2float(a.y), __half2float(a.z));
+}
+
+
+/**
+ * Build an RGBA pixel of either float4 or half4 type, so that kernels can be
+ * templated on the element type of the image they write to.
+ * @ingroup cuda
+ */
+template<typename T> inline __device__ T make_rgba( float x, float y, float z, float w );
+
+template<> inline __device__ float4 make_rgba<float4>( float x, float y, float z, float w )	{ return make_float4(x, y, z, w); }
+template<> inline __device__ half4  make_rgba<half4>( float x, float y, float z, float w )	{ return make_half4(x, y, z, w); }
+
+/**
+ * Load an RGBA pixel of either float4 or half4 type as float4.
+ * @ingroup cuda
+ */
+inline __device__ float4 load_rgba( const float4& a )	{ return a; }
+inline __device__ float4 load_rgba( const half4& a )	{ return make_float4(a); }
+
+#elif defined(JETSON_UTILS_NO_CUDA)
+
+/*
+ * In the host-only build, the half-precision conversions are done with
+ * cpuFloatToHalf() and cpuHalfToFloat() so the host implementations of the
+ * image functions can use the same helpers as the kernels.
+ */
+#include "cpuConvert.h"
+
+// make_half
+inline __half make_half( float x )				{ __half h; h.__x = cpuFloatToHalf(x); return h; }
+
+// make_half4
+inline half4 make_half4( float x, float y, float z, float w )	{ half4 h = { make_half(x), make_half(y), make_half(z), make_half(w) }; return h; }
+inline half4 make_half4( const float4& a )					{ return make_half4(a.x, a.y, a.z, a.w); }
+
+// make_half3
+inline half3 make_half3( float x, float y, float z )			{ half3 h = { make_half(x), make_half(y), make_half(z) }; return h; }
+
+// make_float4
+inline float4 make_float4( const half4& a )	{ return make_float4(cpuHalfToFloat(a.x.__x), cpuHalfToFloat(a.y.__x), cpuHalfToFloat(a.z.__x), cpuHalfToFloat(a.w.__x)); }
+
+// make_float3
+inline float3 make_float3( const half3& a )	{ return make_float3(cpuHalfToFloat(a.x.__x), cpuHalfToFloat(a.y.__x), cpuHalfToFloat(a.z.__x)); }
+
+template<typename T> inline T make_rgba( float x, float y, float z, float w );
+
+template<> inline float4 make_rgba<float4>( float x, float y, float z, float w )	{ return make_float4(x, y, z, w); }
+template<> inline half4  make_rgba<half4>( float x, float y, float z, float w )		{ return make_half4(x, y, z, w); }
+
+inline float4 load_rgba( const float4& a )	{ return a; }
+inline float4 load_rgba( const half4& a )	{ return make_float4(a); }
+
+#endif
+#endif
@@ -35,6 +35,8 @@ cudaFilterMode cudaFilterModeFromStr( const char* str, cudaFilterMode default_va
 		return FILTER_LINEAR;
 	else if( strcasecmp(str, "point") == 0 || strcasecmp(str, "nearest") == 0 )
 		return FILTER_POINT;
+	else if( strcasecmp(str, "area") == 0 || strcasecmp(str, "box") == 0 )
+		return FILTER_AREA;
 
 	return default_value;
 }
@@ -45,6 +47,8 @@ const char* cudaFilterModeToStr( cudaFilterMode filter )
 {
 	if( filter == FILTER_LINEAR )
 		return "linear";
+	else if( filter == FILTER_AREA )
+		return "area";
 
 	return "point";
 }
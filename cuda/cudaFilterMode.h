@@ -35,7 +35,8 @@
 enum cudaFilterMode
 {
 	FILTER_POINT,	 /**< Nearest-neighbor sampling */
-	FILTER_LINEAR	 /**< Bilinear filtering */
+	FILTER_LINEAR,	 /**< Bilinear filtering */
+	FILTER_AREA	 /**< Area averaging (box filter), for downscaling */
 };
 
 /**
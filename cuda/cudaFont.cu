@@ -93,7 +93,7 @@ cudaFont::~cudaFont()
 {
 	if( mRectsCPU != NULL )
 	{
-		CUDA(cudaFreeHost(mRectsCPU));
+		cudaFreeMapped(mRectsCPU);
 		
 		mRectsCPU = NULL; 
 		mRectsGPU = NULL;
@@ -101,7 +101,7 @@ cudaFont::~cudaFont()
 
 	if( mCommandCPU != NULL )
 	{
-		CUDA(cudaFreeHost(mCommandCPU));
+		cudaFreeMapped(mCommandCPU);
 		
 		mCommandCPU = NULL; 
 		mCommandGPU = NULL;
@@ -109,7 +109,7 @@ cudaFont::~cudaFont()
 
 	if( mFontMapCPU != NULL )
 	{
-		CUDA(cudaFreeHost(mFontMapCPU));
+		cudaFreeMapped(mFontMapCPU);
 		
 		mFontMapCPU = NULL; 
 		mFontMapGPU = NULL;
@@ -228,7 +228,7 @@ bool cudaFont::init( const char* filename, float size )
 		// allocate memory for the packed font texture (alpha only)
 		const size_t fontMapSize = mFontMapWidth * mFontMapHeight * sizeof(unsigned char);
 
-		if( !cudaAllocMapped((void**)&mFontMapCPU, (void**)&mFontMapGPU, fontMapSize) )
+		if( !cudaAllocMapped((void**)&mFontMapCPU, (void**)&mFontMapGPU, fontMapSize, CUDA_MEMORY_FONT, false) )
 		{
 			printf(LOG_CUDA "failed to allocate %zu bytes to store %ix%i font map\n", fontMapSize, mFontMapWidth, mFontMapHeight);
 			free(ttf_buffer);
@@ -260,7 +260,7 @@ bool cudaFont::init( const char* filename, float size )
 			printf(LOG_CUDA "fit only %i of %u font glyphs in %ux%u bitmap\n", glyphsPacked, NumGlyphs, mFontMapWidth, mFontMapHeight);
 		#endif
 
-			CUDA(cudaFreeHost(mFontMapCPU));
+			cudaFreeMapped(mFontMapCPU);
 		
 			mFontMapCPU = NULL; 
 			mFontMapGPU = NULL;
@@ -306,11 +306,11 @@ bool cudaFont::init( const char* filename, float size )
 	}
 
 	// allocate memory for GPU command buffer	
-	if( !cudaAllocMapped(&mCommandCPU, &mCommandGPU, sizeof(GlyphCommand) * MaxCommands) )
+	if( !cudaAllocMapped(&mCommandCPU, &mCommandGPU, sizeof(GlyphCommand) * MaxCommands, CUDA_MEMORY_FONT) )
 		return false;
 	
 	// allocate memory for background rect buffers
-	if( !cudaAllocMapped((void**)&mRectsCPU, (void**)&mRectsGPU, sizeof(float4) * MaxCommands) )
+	if( !cudaAllocMapped((void**)&mRectsCPU, (void**)&mRectsGPU, sizeof(float4) * MaxCommands, CUDA_MEMORY_FONT) )
 		return false;
 
 	return true;
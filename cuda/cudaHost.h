@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CUDA_HOST_H__
+#define __CUDA_HOST_H__
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/**
+ * Host-only stand-in for the parts of the CUDA runtime API that jetson-utils uses, which
+ * cudaUtility.h includes instead of `cuda_runtime.h` when the library is built without CUDA
+ * (i.e. with `-DENABLE_CUDA=OFF`, which defines `JETSON_UTILS_NO_CUDA`).
+ *
+ * "Device" memory is regular host memory that's aligned to CUDA_HOST_ALIGNMENT, and the CPU
+ * and GPU pointers of mapped memory are the same, so code written against the CUDA API runs
+ * unmodified.  Copies are done with memcpy(), and the stream and synchronization functions do
+ * nothing because the host implementations of the cuda* image functions are synchronous.
+ *
+ * @ingroup cuda
+ */
+
+
+/**
+ * Alignment of the memory that's returned by cudaMalloc() and cudaHostAlloc() in a
+ * host-only build (this matches the alignment that the CUDA allocator guarantees).
+ * @ingroup cuda
+ */
+#define CUDA_HOST_ALIGNMENT 256
+
+
+// function qualifiers and alignment
+#define __host__
+#define __device__
+#define __global__
+#define __forceinline__	inline __attribute__((always_inline))
+#define __align__(n)	__attribute__((aligned(n)))
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Vector types
+/// @ingroup cuda
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+#define CUDA_HOST_VECTOR2(type, base, align) \
+	struct __align__(align) type { base x; base y; }; \
+	inline type make_##type( base x, base y )	{ type v = { x, y }; return v; }
+
+#define CUDA_HOST_VECTOR3(type, base) \
+	struct type { base x; base y; base z; }; \
+	inline type make_##type( base x, base y, base z )	{ type v = { x, y, z }; return v; }
+
+#define CUDA_HOST_VECTOR4(type, base, align) \
+	struct __align__(align) type { base x; base y; base z; base w; }; \
+	inline type make_##type( base x, base y, base z, base w )	{ type v = { x, y, z, w }; return v; }
+
+CUDA_HOST_VECTOR2(char2, signed char, 2)
+CUDA_HOST_VECTOR3(char3, signed char)
+CUDA_HOST_VECTOR4(char4, signed char, 4)
+
+CUDA_HOST_VECTOR2(uchar2, unsigned char, 2)
+CUDA_HOST_VECTOR3(uchar3, unsigned char)
+CUDA_HOST_VECTOR4(uchar4, unsigned char, 4)
+
+CUDA_HOST_VECTOR2(short2, short, 4)
+CUDA_HOST_VECTOR3(short3, short)
+CUDA_HOST_VECTOR4(short4, short, 8)
+
+CUDA_HOST_VECTOR2(ushort2, unsigned short, 4)
+CUDA_HOST_VECTOR3(ushort3, unsigned short)
+CUDA_HOST_VECTOR4(ushort4, unsigned short, 8)
+
+CUDA_HOST_VECTOR2(int2, int, 8)
+CUDA_HOST_VECTOR3(int3, int)
+CUDA_HOST_VECTOR4(int4, int, 16)
+
+CUDA_HOST_VECTOR2(uint2, unsigned int, 8)
+CUDA_HOST_VECTOR3(uint3, unsigned int)
+CUDA_HOST_VECTOR4(uint4, unsigned int, 16)
+
+CUDA_HOST_VECTOR2(float2, float, 8)
+CUDA_HOST_VECTOR3(float3, float)
+CUDA_HOST_VECTOR4(float4, float, 16)
+
+CUDA_HOST_VECTOR2(double2, double, 16)
+
+#undef CUDA_HOST_VECTOR2
+#undef CUDA_HOST_VECTOR3
+#undef CUDA_HOST_VECTOR4
+
+/**
+ * Kernel launch dimensions (unused by the host implementations, but part of the API).
+ */
+struct dim3
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int z;
+
+	dim3( unsigned int vx=1, unsigned int vy=1, unsigned int vz=1 ) : x(vx), y(vy), z(vz)	{}
+};
+
+/**
+ * Storage of a half-precision float, which the host code only moves around as 16 bits
+ * (use cpuFloatToHalf() and cpuHalfToFloat() from cpuConvert.h to convert them).
+ */
+struct __align__(2) __half
+{
+	unsigned short __x;
+};
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Error handling
+/// @ingroup cuda
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * The subset of the CUDA error codes that the host implementations return
+ * (with the same values as the CUDA runtime).
+ */
+enum cudaError
+{
+	cudaSuccess                      = 0,
+	cudaErrorInvalidValue            = 1,
+	cudaErrorMemoryAllocation        = 2,
+	cudaErrorInitializationError     = 3,
+	cudaErrorInvalidSymbol           = 13,
+	cudaErrorInvalidDevicePointer    = 17,
+	cudaErrorInvalidMemcpyDirection  = 21,
+	cudaErrorNotYetImplemented       = 31,
+	cudaErrorNoDevice                = 100,
+	cudaErrorNotSupported            = 801
+};
+
+typedef enum cudaError cudaError_t;
+
+/**
+ * Return the description of an error code.
+ */
+inline const char* cudaGetErrorString( cudaError_t error )
+{
+	switch(error)
+	{
+		case cudaSuccess:						return "no error";
+		case cudaErrorInvalidValue:				return "invalid argument";
+		case cudaErrorMemoryAllocation:			return "out of memory";
+		case cudaErrorInitializationError:		return "initialization error";
+		case cudaErrorInvalidSymbol:			return "invalid device symbol";
+		case cudaErrorInvalidDevicePointer:		return "invalid device pointer";
+		case cudaErrorInvalidMemcpyDirection:	return "invalid copy direction for memcpy";
+		case cudaErrorNotYetImplemented:		return "function not yet implemented";
+		case cudaErrorNoDevice:					return "no CUDA-capable device is detected";
+		case cudaErrorNotSupported:				return "operation not supported";
+	}
+
+	return "unknown error";
+}
+
+/**
+ * The host implementations return their errors directly, so there's never one pending.
+ */
+inline cudaError_t cudaGetLastError()		{ return cudaSuccess; }
+inline cudaError_t cudaPeekAtLastError()	{ return cudaSuccess; }
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Memory management
+/// @ingroup cuda
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+#define cudaHostAllocDefault		0x00
+#define cudaHostAllocPortable		0x01
+#define cudaHostAllocMapped			0x02
+#define cudaHostAllocWriteCombined	0x04
+
+enum cudaMemcpyKind
+{
+	cudaMemcpyHostToHost     = 0,
+	cudaMemcpyHostToDevice   = 1,
+	cudaMemcpyDeviceToHost   = 2,
+	cudaMemcpyDeviceToDevice = 3,
+	cudaMemcpyDefault        = 4
+};
+
+/**
+ * Allocate memory that's aligned to CUDA_HOST_ALIGNMENT.
+ */
+inline cudaError_t cudaMalloc( void** ptr, size_t size )
+{
+	if( !ptr )
+		return cudaErrorInvalidValue;
+
+	*ptr = NULL;
+
+	if( size == 0 )
+		return cudaSuccess;
+
+	if( posix_memalign(ptr, CUDA_HOST_ALIGNMENT, size) != 0 )
+	{
+		*ptr = NULL;
+		return cudaErrorMemoryAllocation;
+	}
+
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaFree( void* ptr )											{ free(ptr); return cudaSuccess; }
+inline cudaError_t cudaMallocHost( void** ptr, size_t size )						{ return cudaMalloc(ptr, size); }
+inline cudaError_t cudaHostAlloc( void** ptr, size_t size, unsigned int flags )	{ return cudaMalloc(ptr, size); }
+inline cudaError_t cudaFreeHost( void* ptr )										{ free(ptr); return cudaSuccess; }
+
+template<typename T> inline cudaError_t cudaMalloc( T** ptr, size_t size )							{ return cudaMalloc((void**)ptr, size); }
+template<typename T> inline cudaError_t cudaMallocHost( T** ptr, size_t size )						{ return cudaMalloc((void**)ptr, size); }
+template<typename T> inline cudaError_t cudaHostAlloc( T** ptr, size_t size, unsigned int flags )	{ return cudaMalloc((void**)ptr, size); }
+
+/**
+ * The GPU address of mapped memory is the same as the CPU address.
+ */
+inline cudaError_t cudaHostGetDevicePointer( void** gpuPtr, void* cpuPtr, unsigned int flags )
+{
+	if( !gpuPtr || !cpuPtr )
+		return cudaErrorInvalidValue;
+
+	*gpuPtr = cpuPtr;
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaMemcpy( void* dst, const void* src, size_t count, cudaMemcpyKind kind )
+{
+	if( count == 0 )
+		return cudaSuccess;
+
+	if( !dst || !src )
+		return cudaErrorInvalidValue;
+
+	memcpy(dst, src, count);
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaMemcpy2D( void* dst, size_t dstPitch, const void* src, size_t srcPitch, size_t width, size_t height, cudaMemcpyKind kind )
+{
+	if( width > dstPitch || width > srcPitch )
+		return cudaErrorInvalidValue;
+
+	if( width == 0 || height == 0 )
+		return cudaSuccess;
+
+	if( !dst || !src )
+		return cudaErrorInvalidValue;
+
+	for( size_t y=0; y < height; y++ )
+		memcpy((uint8_t*)dst + y * dstPitch, (const uint8_t*)src + y * srcPitch, width);
+
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaMemset( void* ptr, int value, size_t count )
+{
+	if( count == 0 )
+		return cudaSuccess;
+
+	if( !ptr )
+		return cudaErrorInvalidValue;
+
+	memset(ptr, value, count);
+	return cudaSuccess;
+}
+
+///@}
+
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Devices and streams
+/// @ingroup cuda
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+#define cudaDeviceMapHost	0x08
+
+enum cudaDeviceAttr
+{
+	cudaDevAttrPageableMemoryAccess = 88
+};
+
+typedef struct CUstream_st* cudaStream_t;
+
+/**
+ * The host is device 0, and it can access any pageable memory directly.
+ */
+inline cudaError_t cudaGetDevice( int* device )
+{
+	if( !device )
+		return cudaErrorInvalidValue;
+
+	*device = 0;
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaDeviceGetAttribute( int* value, cudaDeviceAttr attr, int device )
+{
+	if( !value || device != 0 )
+		return cudaErrorInvalidValue;
+
+	if( attr != cudaDevAttrPageableMemoryAccess )
+	{
+		*value = 0;
+		return cudaErrorInvalidValue;
+	}
+
+	*value = 1;
+	return cudaSuccess;
+}
+
+inline cudaError_t cudaSetDeviceFlags( unsigned int flags )		{ return cudaSuccess; }
+inline cudaError_t cudaDeviceSynchronize()						{ return cudaSuccess; }
+inline cudaError_t cudaStreamCreate( cudaStream_t* stream )		{ if( stream ) *stream = NULL; return cudaSuccess; }
+inline cudaError_t cudaStreamDestroy( cudaStream_t stream )		{ return cudaSuccess; }
+inline cudaError_t cudaStreamSynchronize( cudaStream_t stream )	{ return cudaSuccess; }
+
+///@}
+
+#endif
+
@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2017, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaMappedMemory.h"
+#include "Mutex.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+
+
+//-----------------------------------------------------------------------------------
+// Size classes
+//
+// Allocations up to 256 bytes use the first class.  Above that, each power of two
+// is split into 8 classes, so a block is never more than 12.5% larger than the
+// request.  Allocations larger than 64MB get their own block and aren't cached.
+//-----------------------------------------------------------------------------------
+#define SIZE_CLASS_MIN_SHIFT  8
+#define SIZE_CLASS_MAX_SHIFT  26
+#define SIZE_CLASS_STEP_SHIFT 3
+#define SIZE_CLASS_STEPS      (1 << SIZE_CLASS_STEP_SHIFT)
+
+#define NUM_SIZE_CLASSES      (1 + (SIZE_CLASS_MAX_SHIFT - SIZE_CLASS_MIN_SHIFT) * SIZE_CLASS_STEPS)
+#define SIZE_CLASS_NONE       -1
+
+#define THREAD_CACHE_DEPTH    2					// blocks of each class kept by each thread
+#define REGISTRY_STRIPES      16				// independently-locked partitions of the registry
+#define DEFAULT_CACHE_LIMIT   (64 * 1024 * 1024)
+
+
+// sizeClassIndex
+static inline int sizeClassIndex( size_t size )
+{
+	if( size <= (size_t(1) << SIZE_CLASS_MIN_SHIFT) )
+		return 0;
+
+	if( size > (size_t(1) << SIZE_CLASS_MAX_SHIFT) )
+		return SIZE_CLASS_NONE;
+
+	// 2^n < size <= 2^(n+1)
+	const int n = 63 - __builtin_clzll((unsigned long long)(size - 1));
+	const size_t step = size_t(1) << (n - SIZE_CLASS_STEP_SHIFT);
+	const size_t k = (size - (size_t(1) << n) + step - 1) / step;	// 1...SIZE_CLASS_STEPS
+
+	return 1 + (n - SIZE_CLASS_MIN_SHIFT) * SIZE_CLASS_STEPS + int(k - 1);
+}
+
+// sizeClassBytes
+static inline size_t sizeClassBytes( int index )
+{
+	if( index <= 0 )
+		return size_t(1) << SIZE_CLASS_MIN_SHIFT;
+
+	const int n = SIZE_CLASS_MIN_SHIFT + (index - 1) / SIZE_CLASS_STEPS;
+	const int k = (index - 1) % SIZE_CLASS_STEPS + 1;
+
+	return (size_t(1) << n) + size_t(k) * (size_t(1) << (n - SIZE_CLASS_STEP_SHIFT));
+}
+
+
+//-----------------------------------------------------------------------------------
+// Backends
+//-----------------------------------------------------------------------------------
+class cudaMappedBackend : public cudaMemoryBackend
+{
+public:
+	virtual bool Alloc( void** cpuPtr, void** gpuPtr, size_t size )
+	{
+		if( CUDA_FAILED(cudaHostAlloc(cpuPtr, size, cudaHostAllocMapped)) )
+			return false;
+
+		if( CUDA_FAILED(cudaHostGetDevicePointer(gpuPtr, *cpuPtr, 0)) )
+		{
+			CUDA(cudaFreeHost(*cpuPtr));
+			return false;
+		}
+
+		return true;
+	}
+
+	virtual void Free( void* cpuPtr )		{ CUDA(cudaFreeHost(cpuPtr)); }
+	virtual const char* GetName() const	{ return "mapped"; }
+};
+
+class cudaHostBackend : public cudaMemoryBackend
+{
+public:
+	virtual bool Alloc( void** cpuPtr, void** gpuPtr, size_t size )
+	{
+		const long pageSize = sysconf(_SC_PAGESIZE);
+
+		if( posix_memalign(cpuPtr, (pageSize > 0) ? pageSize : 4096, size) != 0 )
+		{
+			printf(LOG_CUDA "failed to allocate %zu bytes of host memory\n", size);
+			return false;
+		}
+
+		*gpuPtr = *cpuPtr;
+		return true;
+	}
+
+	virtual void Free( void* cpuPtr )		{ free(cpuPtr); }
+	virtual const char* GetName() const	{ return "host"; }
+};
+
+// Mapped
+cudaMemoryBackend* cudaMemoryBackend::Mapped()
+{
+	static cudaMappedBackend backend;
+	return &backend;
+}
+
+// Host
+cudaMemoryBackend* cudaMemoryBackend::Host()
+{
+	static cudaHostBackend backend;
+	return &backend;
+}
+
+
+//-----------------------------------------------------------------------------------
+// Pool state
+//-----------------------------------------------------------------------------------
+struct cudaMappedBlock
+{
+	void* cpuPtr;
+	void* gpuPtr;
+	size_t size;					// bytes requested
+	size_t capacity;				// bytes allocated from the backend
+	int sizeClass;
+	cudaMemorySubsystem subsystem;
+	cudaMemoryBackend* backend;
+};
+
+struct cudaMemoryCounters
+{
+	cudaMemoryCounters() : bytesInUse(0), bytesPeak(0), bytesReserved(0), numAllocs(0), totalAllocs(0)	{ }
+
+	std::atomic<size_t> bytesInUse;
+	std::atomic<size_t> bytesPeak;
+	std::atomic<size_t> bytesReserved;
+	std::atomic<size_t> numAllocs;
+	std::atomic<size_t> totalAllocs;
+};
+
+struct cudaRegistryStripe
+{
+	Mutex mutex;
+	std::unordered_map<void*, cudaMappedBlock> blocks;
+};
+
+struct cudaMappedPool
+{
+	cudaMappedPool() : backend(cudaMemoryBackend::Mapped()), bytesCached(0), cacheLimit(DEFAULT_CACHE_LIMIT)	{ }
+
+	std::atomic<cudaMemoryBackend*> backend;
+
+	cudaRegistryStripe registry[REGISTRY_STRIPES];	// live blocks, by CPU pointer
+
+	Mutex freeMutex;
+	std::vector<cudaMappedBlock> freeBlocks[NUM_SIZE_CLASSES];	// shared cache of freed blocks
+
+	std::atomic<size_t> bytesCached;		// in the shared cache and every thread cache
+	std::atomic<size_t> cacheLimit;
+
+	cudaMemoryCounters counters[CUDA_MEMORY_NUM_SUBSYSTEMS];
+	cudaMemoryCounters totals;
+};
+
+// the pool is never destroyed, so that the thread caches can
+// still return their blocks to it from threads exiting late
+static cudaMappedPool* pool()
+{
+	static cudaMappedPool* p = new cudaMappedPool();
+	return p;
+}
+
+// registryStripe
+static inline cudaRegistryStripe& registryStripe( cudaMappedPool* p, void* ptr )
+{
+	const uintptr_t addr = (uintptr_t)ptr;
+	return p->registry[((addr >> 12) ^ (addr >> 20)) % REGISTRY_STRIPES];
+}
+
+// releaseBlock
+static void releaseBlock( cudaMappedPool* p, const cudaMappedBlock& block, bool cached )
+{
+	if( cached )
+		p->bytesCached -= block.capacity;
+
+	block.backend->Free(block.cpuPtr);
+}
+
+// trimShared
+static void trimShared( cudaMappedPool* p )
+{
+	std::vector<cudaMappedBlock> blocks;
+
+	p->freeMutex.Lock();
+
+	for( int n=0; n < NUM_SIZE_CLASSES; n++ )
+	{
+		blocks.insert(blocks.end(), p->freeBlocks[n].begin(), p->freeBlocks[n].end());
+		p->freeBlocks[n].clear();
+	}
+
+	p->freeMutex.Unlock();
+
+	for( size_t n=0; n < blocks.size(); n++ )
+		releaseBlock(p, blocks[n], true);
+}
+
+// cacheShared
+static void cacheShared( cudaMappedPool* p, const cudaMappedBlock& block )
+{
+	p->freeMutex.Lock();
+	p->freeBlocks[block.sizeClass].push_back(block);
+	p->freeMutex.Unlock();
+}
+
+
+//-----------------------------------------------------------------------------------
+// Thread caches
+//
+// Each thread keeps a couple of freed blocks of each size class, so the common
+// case of a thread freeing and re-allocating its own buffers doesn't touch the
+// shared cache.  The blocks are handed to the shared cache when the thread exits.
+//-----------------------------------------------------------------------------------
+struct cudaThreadCache
+{
+	cudaThreadCache() : blocks(NULL)	{ }
+
+	~cudaThreadCache()
+	{
+		if( !blocks )
+			return;
+
+		Flush();
+		delete[] blocks;
+	}
+
+	// blocks are only allocated once the thread frees something
+	void Init()
+	{
+		if( blocks != NULL )
+			return;
+
+		blocks = new cudaMappedBlock[NUM_SIZE_CLASSES * THREAD_CACHE_DEPTH];
+		memset(count, 0, sizeof(count));
+	}
+
+	bool Pop( int sizeClass, cudaMappedBlock* block )
+	{
+		if( !blocks || count[sizeClass] == 0 )
+			return false;
+
+		*block = blocks[sizeClass * THREAD_CACHE_DEPTH + (--count[sizeClass])];
+		return true;
+	}
+
+	bool Push( const cudaMappedBlock& block )
+	{
+		Init();
+
+		if( count[block.sizeClass] >= THREAD_CACHE_DEPTH )
+			return false;
+
+		blocks[block.sizeClass * THREAD_CACHE_DEPTH + (count[block.sizeClass]++)] = block;
+		return true;
+	}
+
+	void Flush()
+	{
+		if( !blocks )
+			return;
+
+		cudaMappedPool* p = pool();
+
+		for( int n=0; n < NUM_SIZE_CLASSES; n++ )
+		{
+			while( count[n] > 0 )
+				cacheShared(p, blocks[n * THREAD_CACHE_DEPTH + (--count[n])]);
+		}
+	}
+
+	cudaMappedBlock* blocks;
+	uint8_t count[NUM_SIZE_CLASSES];
+};
+
+static thread_local cudaThreadCache gThreadCache;
+
+
+//-----------------------------------------------------------------------------------
+// Accounting
+//-----------------------------------------------------------------------------------
+static inline void updatePeak( std::atomic<size_t>& peak, size_t value )
+{
+	size_t prev = peak.load();
+
+	while( value > prev && !peak.compare_exchange_weak(prev, value) )
+		;
+}
+
+static inline void countAlloc( cudaMemoryCounters& c, const cudaMappedBlock& block )
+{
+	updatePeak(c.bytesPeak, c.bytesInUse += block.size);
+
+	c.bytesReserved += block.capacity;
+	c.numAllocs++;
+	c.totalAllocs++;
+}
+
+static inline void countFree( cudaMemoryCounters& c, const cudaMappedBlock& block )
+{
+	c.bytesInUse -= block.size;
+	c.bytesReserved -= block.capacity;
+	c.numAllocs--;
+}
+
+static inline cudaMemoryStats loadStats( const cudaMemoryCounters& c )
+{
+	cudaMemoryStats stats;
+
+	stats.bytesInUse    = c.bytesInUse.load();
+	stats.bytesPeak     = c.bytesPeak.load();
+	stats.bytesReserved = c.bytesReserved.load();
+	stats.bytesCached   = 0;
+	stats.numAllocs     = c.numAllocs.load();
+	stats.totalAllocs   = c.totalAllocs.load();
+
+	return stats;
+}
+
+
+//-----------------------------------------------------------------------------------
+// Public API
+//-----------------------------------------------------------------------------------
+
+// cudaAllocMapped
+bool cudaAllocMapped( void** cpuPtr, void** gpuPtr, size_t size, cudaMemorySubsystem subsystem, bool zero )
+{
+	if( !cpuPtr || !gpuPtr || size == 0 )
+		return false;
+
+	if( subsystem < 0 || subsystem >= CUDA_MEMORY_NUM_SUBSYSTEMS )
+		subsystem = CUDA_MEMORY_DEFAULT;
+
+	cudaMappedPool* p = pool();
+	cudaMemoryBackend* backend = p->backend.load();
+
+	cudaMappedBlock block;
+	bool found = false;
+
+	block.sizeClass = sizeClassIndex(size);
+
+	// look for a cached block from the thread, then the shared cache
+	if( block.sizeClass != SIZE_CLASS_NONE )
+	{
+		found = gThreadCache.Pop(block.sizeClass, &block);
+
+		if( !found )
+		{
+			p->freeMutex.Lock();
+
+			std::vector<cudaMappedBlock>& freeBlocks = p->freeBlocks[block.sizeClass];
+
+			if( freeBlocks.size() > 0 )
+			{
+				block = freeBlocks.back();
+				freeBlocks.pop_back();
+				found = true;
+			}
+
+			p->freeMutex.Unlock();
+		}
+
+		if( found )
+		{
+			p->bytesCached -= block.capacity;
+
+			// blocks cached from before the backend was changed aren't reused
+			if( block.backend != backend )
+			{
+				block.backend->Free(block.cpuPtr);
+				found = false;
+			}
+		}
+	}
+
+	// allocate a new block from the backend
+	if( !found )
+	{
+		block.capacity = (block.sizeClass != SIZE_CLASS_NONE) ? sizeClassBytes(block.sizeClass) : size;
+		block.backend  = backend;
+
+		if( !backend->Alloc(&block.cpuPtr, &block.gpuPtr, block.capacity) )
+		{
+			// release the cached blocks and try again before giving up
+			if( p->bytesCached.load() == 0 )
+				return false;
+
+			gThreadCache.Flush();
+			trimShared(p);
+
+			if( !backend->Alloc(&block.cpuPtr, &block.gpuPtr, block.capacity) )
+				return false;
+		}
+	}
+
+	block.size = size;
+	block.subsystem = subsystem;
+
+	if( zero )
+		memset(block.cpuPtr, 0, size);
+
+	cudaRegistryStripe& stripe = registryStripe(p, block.cpuPtr);
+
+	stripe.mutex.Lock();
+	stripe.blocks[block.cpuPtr] = block;
+	stripe.mutex.Unlock();
+
+	countAlloc(p->counters[subsystem], block);
+	countAlloc(p->totals, block);
+
+	*cpuPtr = block.cpuPtr;
+	*gpuPtr = block.gpuPtr;
+
+	//printf(LOG_CUDA "cudaAllocMapped %zu bytes, CPU %p GPU %p\n", size, *cpuPtr, *gpuPtr);
+	return true;
+}
+
+
+// cudaFreeMapped
+bool cudaFreeMapped( void* ptr )
+{
+	if( !ptr )
+		return true;
+
+	cudaMappedPool* p = pool();
+	cudaRegistryStripe& stripe = registryStripe(p, ptr);
+
+	cudaMappedBlock block;
+	bool found = false;
+
+	stripe.mutex.Lock();
+
+	std::unordered_map<void*, cudaMappedBlock>::iterator iter = stripe.blocks.find(ptr);
+
+	if( iter != stripe.blocks.end() )
+	{
+		block = iter->second;
+		stripe.blocks.erase(iter);
+		found = true;
+	}
+
+	stripe.mutex.Unlock();
+
+	// memory that didn't come from cudaAllocMapped()
+	if( !found )
+		return CUDA_SUCCESS(cudaFreeHost(ptr));
+
+	countFree(p->counters[block.subsystem], block);
+	countFree(p->totals, block);
+
+	// keep the block for reuse if there's room in the cache
+	if( block.sizeClass != SIZE_CLASS_NONE && (p->bytesCached += block.capacity) <= p->cacheLimit.load() )
+	{
+		if( !gThreadCache.Push(block) )
+			cacheShared(p, block);
+
+		return true;
+	}
+
+	releaseBlock(p, block, block.sizeClass != SIZE_CLASS_NONE);
+	return true;
+}
+
+
+// cudaMemorySubsystemToStr
+const char* cudaMemorySubsystemToStr( cudaMemorySubsystem subsystem )
+{
+	switch(subsystem)
+	{
+		case CUDA_MEMORY_DEFAULT:	 return "default";
+		case CUDA_MEMORY_CAMERA:	 return "camera";
+		case CUDA_MEMORY_CODEC:		 return "codec";
+		case CUDA_MEMORY_IMAGE:		 return "image";
+		case CUDA_MEMORY_FONT:		 return "font";
+		case CUDA_MEMORY_POINTCLOUD: return "pointcloud";
+		case CUDA_MEMORY_PYTHON:	 return "python";
+		case CUDA_MEMORY_PIPELINE:	 return "pipeline";
+		default:					 return "unknown";
+	}
+}
+
+
+// cudaMappedMemoryStats
+cudaMemoryStats cudaMappedMemoryStats( cudaMemorySubsystem subsystem )
+{
+	if( subsystem < 0 || subsystem >= CUDA_MEMORY_NUM_SUBSYSTEMS )
+	{
+		cudaMemoryStats stats;
+		memset(&stats, 0, sizeof(stats));
+		return stats;
+	}
+
+	return loadStats(pool()->counters[subsystem]);
+}
+
+
+// cudaMappedMemoryStats
+cudaMemoryStats cudaMappedMemoryStats()
+{
+	cudaMappedPool* p = pool();
+	cudaMemoryStats stats = loadStats(p->totals);
+
+	stats.bytesCached = p->bytesCached.load();
+	return stats;
+}
+
+
+// cudaMappedMemoryPrint
+void cudaMappedMemoryPrint()
+{
+	const cudaMemoryStats totals = cudaMappedMemoryStats();
+
+	printf(LOG_CUDA "mapped memory (%s backend, %zu KB cached)\n", cudaMappedMemoryGetBackend()->GetName(), totals.bytesCached / 1024);
+	printf(LOG_CUDA "   subsystem   allocs    in-use KB    peak KB    reserved KB\n");
+
+	for( int n=0; n < CUDA_MEMORY_NUM_SUBSYSTEMS; n++ )
+	{
+		const cudaMemoryStats stats = cudaMappedMemoryStats((cudaMemorySubsystem)n);
+
+		if( stats.totalAllocs == 0 )
+			continue;
+
+		printf(LOG_CUDA "   %-10s  %6zu  %11zu  %9zu  %13zu\n", cudaMemorySubsystemToStr((cudaMemorySubsystem)n),
+			  stats.numAllocs, stats.bytesInUse / 1024, stats.bytesPeak / 1024, stats.bytesReserved / 1024);
+	}
+
+	printf(LOG_CUDA "   %-10s  %6zu  %11zu  %9zu  %13zu\n", "total", totals.numAllocs,
+		  totals.bytesInUse / 1024, totals.bytesPeak / 1024, totals.bytesReserved / 1024);
+}
+
+
+// cudaMappedMemoryTrim
+void cudaMappedMemoryTrim()
+{
+	gThreadCache.Flush();
+	trimShared(pool());
+}
+
+
+// cudaMappedMemoryGetCacheLimit
+size_t cudaMappedMemoryGetCacheLimit()
+{
+	return pool()->cacheLimit.load();
+}
+
+
+// cudaMappedMemorySetCacheLimit
+void cudaMappedMemorySetCacheLimit( size_t bytes )
+{
+	pool()->cacheLimit = bytes;
+
+	if( pool()->bytesCached.load() > bytes )
+		cudaMappedMemoryTrim();
+}
+
+
+// cudaMappedMemoryGetBackend
+cudaMemoryBackend* cudaMappedMemoryGetBackend()
+{
+	return pool()->backend.load();
+}
+
+
+// cudaMappedMemorySetBackend
+void cudaMappedMemorySetBackend( cudaMemoryBackend* backend )
+{
+	if( !backend )
+		backend = cudaMemoryBackend::Mapped();
+
+	if( pool()->backend.exchange(backend) != backend )
+		cudaMappedMemoryTrim();
+}
+
@@ -27,36 +27,136 @@
 #include "cudaUtility.h"
 
 
+/**
+ * Subsystems that mapped memory allocations are accounted to.
+ * Pass one of these to cudaAllocMapped() to tag the allocation,
+ * then query the usage with cudaMappedMemoryStats().
+ * @ingroup cuda
+ */
+enum cudaMemorySubsystem
+{
+	CUDA_MEMORY_DEFAULT = 0,		/**< Untagged allocations (the default) */
+	CUDA_MEMORY_CAMERA,			/**< Camera capture ringbuffers (gstCamera, gstPipeline) */
+	CUDA_MEMORY_CODEC,			/**< Encoder and decoder buffers (gstEncoder, gstDecoder) */
+	CUDA_MEMORY_IMAGE,			/**< Images loaded with loadImage() */
+	CUDA_MEMORY_FONT,			/**< cudaFont atlas and command buffers */
+	CUDA_MEMORY_POINTCLOUD,		/**< cudaPointCloud vertex buffers */
+	CUDA_MEMORY_PYTHON,			/**< Allocations from the Python bindings (cudaAllocMapped, cudaFromNumpy) */
+	CUDA_MEMORY_PIPELINE,		/**< Frames that are recycled between the stages of a Pipeline */
+	CUDA_MEMORY_NUM_SUBSYSTEMS	/**< Number of subsystems (not a valid subsystem) */
+};
+
+/**
+ * Stringize function to convert cudaMemorySubsystem enum to text
+ * @ingroup cuda
+ */
+const char* cudaMemorySubsystemToStr( cudaMemorySubsystem subsystem );
+
+
+/**
+ * Mapped memory usage, as returned by cudaMappedMemoryStats().
+ * @ingroup cuda
+ */
+struct cudaMemoryStats
+{
+	size_t bytesInUse;		/**< Bytes requested by the live allocations */
+	size_t bytesPeak;		/**< High-water mark of bytesInUse */
+	size_t bytesReserved;	/**< Bytes held by the live allocations, after rounding up to their size class */
+	size_t bytesCached;		/**< Bytes of freed blocks kept in the pool for reuse (only reported in the totals) */
+	size_t numAllocs;		/**< Number of live allocations */
+	size_t totalAllocs;		/**< Number of allocations made since startup */
+};
+
+
+/**
+ * Backend that the mapped memory pool gets its blocks from.
+ *
+ * The default backend is cudaMemoryBackend::Mapped(), which uses cudaHostAlloc().
+ * cudaMemoryBackend::Host() uses regular aligned host memory (with equal CPU and
+ * GPU pointers), so code using cudaAllocMapped() can be exercised without a GPU.
+ * Other backends can be implemented and selected with cudaMappedMemorySetBackend().
+ *
+ * @ingroup cuda
+ */
+class cudaMemoryBackend
+{
+public:
+	/**
+	 * Destructor
+	 */
+	virtual ~cudaMemoryBackend()		{ }
+
+	/**
+	 * Allocate a block of memory.  It doesn't need to be zeroed.
+	 * @returns `true` if the allocation succeeded, `false` otherwise.
+	 */
+	virtual bool Alloc( void** cpuPtr, void** gpuPtr, size_t size ) = 0;
+
+	/**
+	 * Release a block that was returned by Alloc().
+	 */
+	virtual void Free( void* cpuPtr ) = 0;
+
+	/**
+	 * Return the name of the backend (for logging).
+	 */
+	virtual const char* GetName() const = 0;
+
+	/**
+	 * CUDA mapped memory from cudaHostAlloc(cudaHostAllocMapped).
+	 */
+	static cudaMemoryBackend* Mapped();
+
+	/**
+	 * Host memory from posix_memalign(), aligned to the page size.
+	 * The CPU and GPU pointers that it returns are equal.
+	 */
+	static cudaMemoryBackend* Host();
+};
+
+
 /**
  * Allocate ZeroCopy mapped memory, shared between CUDA and CPU.
  *
+ * Allocations are rounded up to a size class and served from a pool,
+ * so that freeing a buffer with cudaFreeMapped() and allocating it again
+ * (i.e. when a camera or decoder changes resolution) reuses the block
+ * instead of going back to cudaHostAlloc().  Each block is still its own
+ * cudaHostAlloc() allocation, and allocations larger than 64MB bypass the pool.
+ *
  * @note although two pointers are returned, one for CPU and GPU,
  *       they both resolve to the same physical memory.
  *
+ * @note when the library is built without CUDA, this is regular host
+ *       memory aligned to CUDA_HOST_ALIGNMENT, and the pointers are equal.
+ *
+ * @note memory from cudaAllocMapped() must be released with cudaFreeMapped().
+ *       Releasing it with cudaFreeHost() isn't supported, because the block
+ *       would stay registered, and be counted as in use by cudaMappedMemoryStats().
+ *
  * @param[out] cpuPtr Returned CPU pointer to the shared memory.
  * @param[out] gpuPtr Returned GPU pointer to the shared memory.
  * @param[in] size Size (in bytes) of the shared memory to allocate.
+ * @param[in] subsystem The subsystem that the allocation is accounted to.
+ * @param[in] zero If `true` (the default), the memory is cleared to zero.
+ *                 Buffers that get completely overwritten can skip it.
  *
  * @returns `true` if the allocation succeeded, `false` otherwise.
  * @ingroup cuda
  */
-inline bool cudaAllocMapped( void** cpuPtr, void** gpuPtr, size_t size )
-{
-	if( !cpuPtr || !gpuPtr || size == 0 )
-		return false;
-
-	//CUDA(cudaSetDeviceFlags(cudaDeviceMapHost));
+bool cudaAllocMapped( void** cpuPtr, void** gpuPtr, size_t size, cudaMemorySubsystem subsystem=CUDA_MEMORY_DEFAULT, bool zero=true );
 
-	if( CUDA_FAILED(cudaHostAlloc(cpuPtr, size, cudaHostAllocMapped)) )
-		return false;
-
-	if( CUDA_FAILED(cudaHostGetDevicePointer(gpuPtr, *cpuPtr, 0)) )
-		return false;
 
-	memset(*cpuPtr, 0, size);
-	//printf(LOG_CUDA "cudaAllocMapped %zu bytes, CPU %p GPU %p\n", size, *cpuPtr, *gpuPtr);
-	return true;
-}
+/**
+ * Release memory that was allocated with cudaAllocMapped(), returning it to the pool.
+ * `ptr` is the CPU pointer (or the single pointer from the overload of cudaAllocMapped()).
+ * Pointers that didn't come from cudaAllocMapped() are released with cudaFreeHost().
+ * It's safe to pass NULL, which is ignored.
+ *
+ * @returns `true` if the memory was released, `false` otherwise.
+ * @ingroup cuda
+ */
+bool cudaFreeMapped( void* ptr );
 
 
 /**
@@ -68,11 +168,13 @@ inline bool cudaAllocMapped( void** cpuPtr, void** gpuPtr, size_t size )
  *
  * @param[out] ptr Returned pointer to the shared CPU/GPU memory.
  * @param[in] size Size (in bytes) of the shared memory to allocate.
+ * @param[in] subsystem The subsystem that the allocation is accounted to.
+ * @param[in] zero If `true` (the default), the memory is cleared to zero.
  *
  * @returns `true` if the allocation succeeded, `false` otherwise.
  * @ingroup cuda
  */
-inline bool cudaAllocMapped( void** ptr, size_t size )
+inline bool cudaAllocMapped( void** ptr, size_t size, cudaMemorySubsystem subsystem=CUDA_MEMORY_DEFAULT, bool zero=true )
 {
 	void* cpuPtr = NULL;
 	void* gpuPtr = NULL;
@@ -80,12 +182,13 @@ inline bool cudaAllocMapped( void** ptr, size_t size )
 	if( !ptr || size == 0 )
 		return false;
 
-	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size) )
+	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, subsystem, zero) )
 		return false;
 
 	if( cpuPtr != gpuPtr )
 	{
 		printf(LOG_CUDA "cudaAllocMapped() - addresses of CPU and GPU pointers don't match\n");
+		cudaFreeMapped(cpuPtr);
 		return false;
 	}
 
@@ -94,4 +197,60 @@ inline bool cudaAllocMapped( void** ptr, size_t size )
 }
 
 
+/**
+ * Return the mapped memory usage of one subsystem.
+ * @ingroup cuda
+ */
+cudaMemoryStats cudaMappedMemoryStats( cudaMemorySubsystem subsystem );
+
+/**
+ * Return the mapped memory usage totalled across every subsystem.
+ * @ingroup cuda
+ */
+cudaMemoryStats cudaMappedMemoryStats();
+
+/**
+ * Print the mapped memory usage of each subsystem to stdout.
+ * @ingroup cuda
+ */
+void cudaMappedMemoryPrint();
+
+
+/**
+ * Release the freed blocks that the pool is holding back to the backend.
+ * This covers the shared pool and the calling thread's cache
+ * (other threads release their caches when they exit).
+ * @ingroup cuda
+ */
+void cudaMappedMemoryTrim();
+
+/**
+ * Return the maximum number of bytes that the pool keeps cached for reuse.
+ * @ingroup cuda
+ */
+size_t cudaMappedMemoryGetCacheLimit();
+
+/**
+ * Set the maximum number of bytes that the pool keeps cached for reuse.
+ * The default is 64MB.  Setting it to 0 releases every block as soon as it's freed.
+ * @ingroup cuda
+ */
+void cudaMappedMemorySetCacheLimit( size_t bytes );
+
+
+/**
+ * Return the backend that new blocks are allocated from.
+ * @ingroup cuda
+ */
+cudaMemoryBackend* cudaMappedMemoryGetBackend();
+
+/**
+ * Set the backend that new blocks are allocated from.  Passing NULL restores
+ * the default (cudaMemoryBackend::Mapped).  Live blocks are released to the
+ * backend they came from, so it has to outlive them.
+ * @ingroup cuda
+ */
+void cudaMappedMemorySetBackend( cudaMemoryBackend* backend );
+
+
 #endif
@@ -23,7 +23,11 @@
 #ifndef HELPER_MATH_H
 #define HELPER_MATH_H
 
+#ifdef JETSON_UTILS_NO_CUDA
+#include "cudaHost.h"
+#else
 #include "cuda_runtime.h"
+#endif
 
 typedef unsigned int uint;
 typedef unsigned short ushort;
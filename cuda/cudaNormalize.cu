@@ -34,19 +34,20 @@ __global__ void gpuNormalize( T* input, T* output, int width, int height, float
 	if( x >= width || y >= height )
 		return;
 
-	const T px = input[ y * width + x ];
+	const float4 px = load_rgba(input[ y * width + x ]);
 
-	output[y*width+x] = make_float4(px.x * scaling_factor,
+	output[y*width+x] = make_rgba<T>(px.x * scaling_factor,
 							  px.y * scaling_factor,
 							  px.z * scaling_factor,
 							  px.w * scaling_factor);
 }
 
 
-// cudaNormalizeRGBA
-cudaError_t cudaNormalizeRGBA( float4* input, const float2& input_range,
-						 float4* output, const float2& output_range,
-						 size_t  width,  size_t height )
+// launchNormalize
+template <typename T>
+static cudaError_t launchNormalize( T* input, const float2& input_range,
+						  T* output, const float2& output_range,
+						  size_t  width,  size_t height )
 {
 	if( !input || !output )
 		return cudaErrorInvalidDevicePointer;
@@ -60,12 +61,30 @@ cudaError_t cudaNormalizeRGBA( float4* input, const float2& input_range,
 	const dim3 blockDim(8, 8);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y));
 
-	gpuNormalize<float4><<<gridDim, blockDim>>>(input, output, width, height, multiplier);
+	gpuNormalize<T><<<gridDim, blockDim>>>(input, output, width, height, multiplier);
 
 	return CUDA(cudaGetLastError());
 }
 
 
+// cudaNormalizeRGBA
+cudaError_t cudaNormalizeRGBA( float4* input, const float2& input_range,
+						 float4* output, const float2& output_range,
+						 size_t  width,  size_t height )
+{
+	return launchNormalize(input, input_range, output, output_range, width, height);
+}
+
+
+// cudaNormalizeRGBA
+cudaError_t cudaNormalizeRGBA( half4* input, const float2& input_range,
+						 half4* output, const float2& output_range,
+						 size_t  width,  size_t height )
+{
+	return launchNormalize(input, input_range, output, output_range, width, height);
+}
+
+
 
 
 
@@ -25,6 +25,7 @@
 
 
 #include "cudaUtility.h"
+#include "cudaFP16.h"
 
 
 /**
@@ -38,5 +39,16 @@ cudaError_t cudaNormalizeRGBA( float4* input,  const float2& input_range,
 						 float4* output, const float2& output_range,
 						 size_t  width,  size_t height );
 
+/**
+ * Rebase the pixel intensities of a half-precision image between two scales.
+ * The scaling is done in single-precision, and the result is rounded to half.
+ * @param input_range the range of pixel values of the input image (e.g. `[0,1]`)
+ * @param output_range the desired range of pixel values of the output image (e.g. `[0,255]`)
+ * @ingroup cuda
+ */
+cudaError_t cudaNormalizeRGBA( half4* input,  const float2& input_range,
+						 half4* output, const float2& output_range,
+						 size_t  width,  size_t height );
+
 #endif
 
@@ -22,6 +22,7 @@
 
 #include "cudaPointCloud.h"
 #include "cudaMappedMemory.h"
+#include "ThreadPool.h"
 
 #include "glUtility.h"
 #include "glBuffer.h"
@@ -29,6 +30,9 @@
 
 #include "mat33.h"
 
+#include <string>
+#include <vector>
+
 
 // constructor
 cudaPointCloud::cudaPointCloud()
@@ -79,7 +83,7 @@ void cudaPointCloud::Free()
 
 	if( mPointsCPU != NULL )
 	{
-		CUDA(cudaFreeHost(mPointsCPU));
+		cudaFreeMapped(mPointsCPU);
 
 		mPointsCPU = NULL;
 		mPointsGPU = NULL;
@@ -123,7 +127,7 @@ bool cudaPointCloud::Reserve( uint32_t maxPoints )
 	const size_t maxSize = maxPoints * sizeof(Vertex);
 
 	// allocate new memory
-	if( !cudaAllocMapped((void**)&mPointsCPU, (void**)&mPointsGPU, maxSize) )
+	if( !cudaAllocMapped((void**)&mPointsCPU, (void**)&mPointsGPU, maxSize, CUDA_MEMORY_POINTCLOUD) )
 	{
 		printf(LOG_CUDA "failed to allocate %zu bytes for point cloud\n", maxSize);
 		return false;
@@ -355,26 +359,60 @@ bool cudaPointCloud::Save( const char* filename )
 	// wait for the GPU to finish any processing
 	CUDA(cudaDeviceSynchronize());
 
-	// write out points to the PCD file
-	for( size_t n=0; n < mNumPoints; n++ )
-	{
-		Vertex* point = GetData(n);
+	// format the points in parallel, a window of batches at a time so the text stays bounded
+	ThreadPool* pool = ThreadPool::GetShared();
 
-		// output XYZ coordinates
-		fprintf(file, "%f %f %f", point->pos.x, point->pos.y, point->pos.z);
+	const size_t batchSize  = 8192;
+	const size_t numBatches = (mNumPoints + batchSize - 1) / batchSize;
+	const size_t windowSize = (pool->GetNumThreads() + 1) * 4;
 
-		// output RGB color
-		if( mHasRGB )
-		{
-			// pack the color into 24 bits
-			const uint32_t rgb_packed = (uint32_t(point->color.x) << 16 |
-	      					         uint32_t(point->color.y) << 8 | 
-							         uint32_t(point->color.z));
-		
-			fprintf(file, " %u", rgb_packed);
-		}
+	std::vector<std::string> text(windowSize);
+
+	for( size_t window=0; window < numBatches; window += windowSize )
+	{
+		const size_t count = (window + windowSize < numBatches) ? windowSize : numBatches - window;
 
-		fprintf(file, "\n");
+		pool->ParallelFor(count, 1, [&](size_t begin, size_t end)
+		{
+			for( size_t batch=begin; batch < end; batch++ )
+			{
+				const size_t first = (window + batch) * batchSize;
+				const size_t last  = (first + batchSize < mNumPoints) ? first + batchSize : mNumPoints;
+
+				std::string& str = text[batch];
+				str.clear();
+
+				char line[256];	// enough for the longest %f of three floats
+
+				for( size_t n=first; n < last; n++ )
+				{
+					Vertex* point = GetData(n);
+					int length = 0;
+
+					// output XYZ coordinates and the RGB color
+					if( mHasRGB )
+					{
+						// pack the color into 24 bits
+						const uint32_t rgb_packed = (uint32_t(point->color.x) << 16 |
+												     uint32_t(point->color.y) << 8 | 
+												     uint32_t(point->color.z));
+
+						length = snprintf(line, sizeof(line), "%f %f %f %u\n", point->pos.x, point->pos.y, point->pos.z, rgb_packed);
+					}
+					else
+					{
+						length = snprintf(line, sizeof(line), "%f %f %f\n", point->pos.x, point->pos.y, point->pos.z);
+					}
+
+					if( length > 0 )
+						str.append(line, length);
+				}
+			}
+		});
+
+		// write out the batches in order
+		for( size_t batch=0; batch < count; batch++ )
+			fwrite(text[batch].data(), 1, text[batch].size(), file);
 	}
 		
 	fclose(file);
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaPreprocess.h"
+
+
+// parameters that are passed to the kernels
+struct preprocessParams
+{
+	int2   offset;		// top-left of the ROI
+	int2   size;		// dimensions of the ROI
+	float2 scale;		// ROI size / tensor size
+	float3 mean;
+	float3 invStdDev;
+	float  pixelScale;
+	bool   bgr;
+	bool   chw;
+};
+
+
+// preprocessLoad (RGBA8)
+inline __device__ float4 preprocessLoad( uchar4* input, int x, int y, int width, int height )
+{
+	const uchar4 px = input[y * width + x];
+	return make_float4(px.x, px.y, px.z, 0.0f);
+}
+
+// preprocessLoad (NV12, returns the Y/U/V samples)
+inline __device__ float4 preprocessLoad( uint8_t* input, int x, int y, int width, int height )
+{
+	const uint8_t* uv = input + width * height + (y >> 1) * width + (x & ~1);
+	return make_float4(input[y * width + x], uv[0], uv[1], 0.0f);
+}
+
+// preprocessStore
+inline __device__ void preprocessStore( float* output, int index, float value )	{ output[index] = value; }
+inline __device__ void preprocessStore( __half* output, int index, float value )	{ output[index] = __float2half_rn(value); }
+
+// preprocessAccum
+inline __device__ float4 preprocessAccum( const float4& acc, const float4& px, float weight )
+{
+	return make_float4(acc.x + px.x * weight, acc.y + px.y * weight, acc.z + px.z * weight, acc.w + px.w * weight);
+}
+
+
+// preprocessSample (filters the ROI with the sampling of cudaResize)
+template<cudaFilterMode filter, typename T>
+inline __device__ float4 preprocessSample( T* input, int x, int y, int width, int height, const preprocessParams& params )
+{
+	const float4 zero = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	if( filter == FILTER_POINT )
+	{
+		const int dx = float(x) * params.scale.x;
+		const int dy = float(y) * params.scale.y;
+
+		return preprocessAccum(zero, preprocessAccum(zero, preprocessLoad(input, params.offset.x + dx, params.offset.y + dy, width, height), 1.0f), 1.0f);
+	}
+	else if( filter == FILTER_LINEAR )
+	{
+		const float sx = fminf(fmaxf((float(x) + 0.5f) * params.scale.x - 0.5f, 0.0f), float(params.size.x - 1));
+		const float sy = fminf(fmaxf((float(y) + 0.5f) * params.scale.y - 0.5f, 0.0f), float(params.size.y - 1));
+
+		const int x1 = int(sx);
+		const int y1 = int(sy);
+
+		const int x2 = min(x1 + 1, params.size.x - 1);
+		const int y2 = min(y1 + 1, params.size.y - 1);
+
+		const float x2f = sx - float(x1);
+		const float y2f = sy - float(y1);
+
+		const float x1f = 1.0f - x2f;
+		const float y1f = 1.0f - y2f;
+
+		const int ox = params.offset.x;
+		const int oy = params.offset.y;
+
+		const float4 row1 = preprocessAccum(preprocessAccum(zero, preprocessLoad(input, ox + x1, oy + y1, width, height), x1f), preprocessLoad(input, ox + x2, oy + y1, width, height), x2f);
+		const float4 row2 = preprocessAccum(preprocessAccum(zero, preprocessLoad(input, ox + x1, oy + y2, width, height), x1f), preprocessLoad(input, ox + x2, oy + y2, width, height), x2f);
+
+		return preprocessAccum(preprocessAccum(zero, row1, y1f), row2, y2f);
+	}
+	else // FILTER_AREA
+	{
+		const float x0f = float(x) * params.scale.x;
+		const float y0f = float(y) * params.scale.y;
+
+		const float x1f = fminf(float(x + 1) * params.scale.x, float(params.size.x));
+		const float y1f = fminf(float(y + 1) * params.scale.y, float(params.size.y));
+
+		const int xEnd = min(int(ceilf(x1f)), params.size.x);
+		const int yEnd = min(int(ceilf(y1f)), params.size.y);
+
+		const float xNorm = 1.0f / (x1f - x0f);
+		const float yNorm = 1.0f / (y1f - y0f);
+
+		float4 sum = zero;
+
+		for( int iy=int(y0f); iy < yEnd; iy++ )
+		{
+			const float wy = (fminf(float(iy + 1), y1f) - fmaxf(float(iy), y0f)) * yNorm;
+			float4 row = zero;
+
+			for( int ix=int(x0f); ix < xEnd; ix++ )
+			{
+				const float wx = (fminf(float(ix + 1), x1f) - fmaxf(float(ix), x0f)) * xNorm;
+				row = preprocessAccum(row, preprocessLoad(input, params.offset.x + ix, params.offset.y + iy, width, height), wx);
+			}
+
+			sum = preprocessAccum(sum, row, wy);
+		}
+
+		return sum;
+	}
+}
+
+
+// gpuPreprocess
+template<cudaFilterMode filter, typename T, typename S>
+__global__ void gpuPreprocess( T* input, int iWidth, int iHeight, S* output, int oWidth, int oHeight, preprocessParams params )
+{
+	const int x = blockIdx.x * blockDim.x + threadIdx.x;
+	const int y = blockIdx.y * blockDim.y + threadIdx.y;
+
+	if( x >= oWidth || y >= oHeight )
+		return;
+
+	const float4 px = preprocessSample<filter>(input, x, y, iWidth, iHeight, params);
+
+	float3 rgb = make_float3(px.x, px.y, px.z);
+
+	// NV12 is filtered as Y/U/V, and converted afterwards
+	if( sizeof(T) == sizeof(uint8_t) )
+	{
+		const float u = px.y - 128.0f;
+		const float v = px.z - 128.0f;
+
+		rgb.x = fminf(fmaxf(px.x + 1.140f * v, 0.0f), 255.0f);
+		rgb.y = fminf(fmaxf(px.x - 0.395f * u - 0.581f * v, 0.0f), 255.0f);
+		rgb.z = fminf(fmaxf(px.x + 2.032f * u, 0.0f), 255.0f);
+	}
+
+	const float r = (rgb.x * params.pixelScale - params.mean.x) * params.invStdDev.x;
+	const float g = (rgb.y * params.pixelScale - params.mean.y) * params.invStdDev.y;
+	const float b = (rgb.z * params.pixelScale - params.mean.z) * params.invStdDev.z;
+
+	const int pixel  = y * oWidth + x;
+	const int stride = params.chw ? oWidth * oHeight : 1;
+	const int index  = params.chw ? pixel : pixel * 3;
+
+	preprocessStore(output, index, params.bgr ? b : r);
+	preprocessStore(output, index + stride, g);
+	preprocessStore(output, index + stride * 2, params.bgr ? r : b);
+}
+
+
+// launchPreprocess
+template<typename T, typename S>
+static cudaError_t launchPreprocess( T* input, size_t inputWidth, size_t inputHeight,
+							  S* output, size_t outputWidth, size_t outputHeight,
+							  const cudaPreprocessOptions& options, cudaStream_t stream )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( inputWidth == 0 || outputWidth == 0 || inputHeight == 0 || outputHeight == 0 )
+		return cudaErrorInvalidValue;
+
+	int4 roi = options.roi;
+
+	if( roi.x == 0 && roi.y == 0 && roi.z == 0 && roi.w == 0 )
+		roi = make_int4(0, 0, inputWidth, inputHeight);
+
+	if( roi.x < 0 || roi.y < 0 || roi.z > (int)inputWidth || roi.w > (int)inputHeight || roi.x >= roi.z || roi.y >= roi.w )
+		return cudaErrorInvalidValue;
+
+	if( options.stdDev.x == 0.0f || options.stdDev.y == 0.0f || options.stdDev.z == 0.0f )
+		return cudaErrorInvalidValue;
+
+	preprocessParams params;
+
+	params.offset     = make_int2(roi.x, roi.y);
+	params.size       = make_int2(roi.z - roi.x, roi.w - roi.y);
+	params.scale      = make_float2(float(params.size.x) / float(outputWidth), float(params.size.y) / float(outputHeight));
+	params.mean       = options.mean;
+	params.invStdDev  = make_float3(1.0f / options.stdDev.x, 1.0f / options.stdDev.y, 1.0f / options.stdDev.z);
+	params.pixelScale = options.scale;
+	params.bgr        = (options.order == CHANNEL_ORDER_BGR);
+	params.chw        = (options.format == FORMAT_CHW);
+
+	// launch kernel
+	const dim3 blockDim(8, 8);
+	const dim3 gridDim(iDivUp(outputWidth,blockDim.x), iDivUp(outputHeight,blockDim.y));
+
+	#define preprocessKernel(filterMode) gpuPreprocess<filterMode, T, S><<<gridDim, blockDim, 0, stream>>>( \
+									input, inputWidth, inputHeight, output, outputWidth, outputHeight, params)
+
+	if( options.filter == FILTER_LINEAR )
+		preprocessKernel(FILTER_LINEAR);
+	else if( options.filter == FILTER_AREA )
+		preprocessKernel(FILTER_AREA);
+	else
+		preprocessKernel(FILTER_POINT);
+
+	return CUDA(cudaGetLastError());
+}
+
+
+// cudaPreprocess
+cudaError_t cudaPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+					   float* output, size_t outputWidth, size_t outputHeight,
+					   const cudaPreprocessOptions& options, cudaStream_t stream )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options, stream);
+}
+
+// cudaPreprocess
+cudaError_t cudaPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+					   __half* output, size_t outputWidth, size_t outputHeight,
+					   const cudaPreprocessOptions& options, cudaStream_t stream )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options, stream);
+}
+
+// cudaPreprocessNV12
+cudaError_t cudaPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+					       float* output, size_t outputWidth, size_t outputHeight,
+					       const cudaPreprocessOptions& options, cudaStream_t stream )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options, stream);
+}
+
+// cudaPreprocessNV12
+cudaError_t cudaPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+					       __half* output, size_t outputWidth, size_t outputHeight,
+					       const cudaPreprocessOptions& options, cudaStream_t stream )
+{
+	return launchPreprocess(input, inputWidth, inputHeight, output, outputWidth, outputHeight, options, stream);
+}
+
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __CUDA_PREPROCESS_H__
+#define __CUDA_PREPROCESS_H__
+
+
+#include "cudaUtility.h"
+#include "cudaFilterMode.h"
+#include "cudaFP16.h"
+
+
+/**
+ * Order of the color channels in a preprocessed tensor.
+ * @ingroup cuda
+ */
+enum cudaChannelOrder
+{
+	CHANNEL_ORDER_RGB,	/**< Red, green, blue (default) */
+	CHANNEL_ORDER_BGR	/**< Blue, green, red */
+};
+
+
+/**
+ * Options for cudaPreprocess(), which are applied in the following order:
+ *
+ *   1. the region of interest is resized to the tensor dimensions with the filter
+ *   2. NV12 images are converted to RGB (after filtering), and saturated to 0-255
+ *   3. each channel is normalized as `(value * scale - mean) / stdDev`
+ *   4. the channels are written in the channel order with the tensor layout
+ *
+ * The defaults produce an RGB tensor with values between `[0,1]` in planar (CHW) layout.
+ * @ingroup cuda
+ */
+struct cudaPreprocessOptions
+{
+	int4   roi;				/**< Region of the input to use (left, top, right, bottom), or all zeros for the entire image */
+	cudaFilterMode filter;		/**< Filtering mode used for the resize (default FILTER_LINEAR) */
+	cudaDataFormat format;		/**< Layout of the tensor, FORMAT_CHW for planar (default) or FORMAT_HWC for packed */
+	cudaChannelOrder order;		/**< Order of the color channels in the tensor (default CHANNEL_ORDER_RGB) */
+	float  scale;				/**< Multiplier that's applied to the 0-255 pixel values (default 1/255) */
+	float3 mean;				/**< Mean that's subtracted from each channel after scaling, in RGB order (default 0) */
+	float3 stdDev;				/**< Standard deviation that each channel is divided by, in RGB order (default 1) */
+
+	/**
+	 * Constructor, sets the default options.
+	 */
+	cudaPreprocessOptions() : roi(make_int4(0,0,0,0)), filter(FILTER_LINEAR), format(FORMAT_CHW), order(CHANNEL_ORDER_RGB),
+						 scale(1.0f / 255.0f), mean(make_float3(0,0,0)), stdDev(make_float3(1,1,1)) {}
+};
+
+
+/**
+ * Prepare an RGBA8 image as a 3-channel float tensor for inference in a single pass on the GPU,
+ * fusing the crop, resize, normalization and layout change (the alpha channel is dropped).
+ * @param input RGBA8 image in CUDA memory
+ * @param output tensor of `outputWidth * outputHeight * 3` floats in CUDA memory
+ * @ingroup cuda
+ */
+cudaError_t cudaPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+					   float* output, size_t outputWidth, size_t outputHeight,
+					   const cudaPreprocessOptions& options=cudaPreprocessOptions(),
+					   cudaStream_t stream=NULL );
+
+/**
+ * Prepare an RGBA8 image as a 3-channel half-precision tensor for inference in a single pass on the GPU.
+ * @see the float version of cudaPreprocess() for uchar4 images
+ * @ingroup cuda
+ */
+cudaError_t cudaPreprocess( uchar4* input, size_t inputWidth, size_t inputHeight,
+					   __half* output, size_t outputWidth, size_t outputHeight,
+					   const cudaPreprocessOptions& options=cudaPreprocessOptions(),
+					   cudaStream_t stream=NULL );
+
+/**
+ * Prepare an NV12 image as a 3-channel float tensor for inference in a single pass on the GPU,
+ * fusing the crop, resize, colorspace conversion, normalization and layout change.  The Y/U/V
+ * samples are filtered first, and then converted with the coefficients of the NV12 kernels in cudaYUV.h.
+ * @param input NV12 image in CUDA memory (8-bit Y plane followed by the interleaved U/V plane)
+ * @param output tensor of `outputWidth * outputHeight * 3` floats in CUDA memory
+ * @ingroup cuda
+ */
+cudaError_t cudaPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+					       float* output, size_t outputWidth, size_t outputHeight,
+					       const cudaPreprocessOptions& options=cudaPreprocessOptions(),
+					       cudaStream_t stream=NULL );
+
+/**
+ * Prepare an NV12 image as a 3-channel half-precision tensor for inference in a single pass on the GPU.
+ * @see the float version of cudaPreprocessNV12()
+ * @ingroup cuda
+ */
+cudaError_t cudaPreprocessNV12( uint8_t* input, size_t inputWidth, size_t inputHeight,
+					       __half* output, size_t outputWidth, size_t outputHeight,
+					       const cudaPreprocessOptions& options=cudaPreprocessOptions(),
+					       cudaStream_t stream=NULL );
+
+#endif
+
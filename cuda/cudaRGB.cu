@@ -19,13 +19,12 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  */
-
 #include "cudaRGB.h"
 
 //-------------------------------------------------------------------------------------------------------------------------
-template<bool isBGR>
+template<bool isBGR, typename T>
 __global__ void RGBToRGBAf(uchar3* srcImage,
-                           float4* dstImage,
+                           T* dstImage,
                            int width, int height)
 {
 	const int x = (blockIdx.x * blockDim.x) + threadIdx.x;
@@ -45,12 +44,13 @@ __global__ void RGBToRGBAf(uchar3* srcImage,
 	const uchar3 px = srcImage[pixel];
 	
 	if( isBGR )
-		dstImage[pixel] = make_float4(px.z * s, px.y * s, px.x * s, 255.0f * s);
+		dstImage[pixel] = make_rgba<T>(px.z * s, px.y * s, px.x * s, 255.0f * s);
 	else
-		dstImage[pixel] = make_float4(px.x * s, px.y * s, px.z * s, 255.0f * s);
+		dstImage[pixel] = make_rgba<T>(px.x * s, px.y * s, px.z * s, 255.0f * s);
 }
 
-cudaError_t cudaBGR8ToRGBA32( uchar3* srcDev, float4* destDev, size_t width, size_t height )
+template<bool isBGR, typename T>
+static cudaError_t launchRGBToRGBA( uchar3* srcDev, T* destDev, size_t width, size_t height )
 {
 	if( !srcDev || !destDev )
 		return cudaErrorInvalidDevicePointer;
@@ -58,27 +58,34 @@ cudaError_t cudaBGR8ToRGBA32( uchar3* srcDev, float4* destDev, size_t width, siz
 	const dim3 blockDim(8,8,1);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
 
-	RGBToRGBAf<true><<<gridDim, blockDim>>>( srcDev, destDev, width, height );
+	RGBToRGBAf<isBGR, T><<<gridDim, blockDim>>>( srcDev, destDev, width, height );
 	
 	return CUDA(cudaGetLastError());
 }
 
+cudaError_t cudaBGR8ToRGBA32( uchar3* srcDev, float4* destDev, size_t width, size_t height )
+{
+	return launchRGBToRGBA<true>(srcDev, destDev, width, height);
+}
+
 cudaError_t cudaRGB8ToRGBA32( uchar3* srcDev, float4* destDev, size_t width, size_t height )
 {
-	if( !srcDev || !destDev )
-		return cudaErrorInvalidDevicePointer;
+	return launchRGBToRGBA<false>(srcDev, destDev, width, height);
+}
 
-	const dim3 blockDim(8,8,1);
-	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
+cudaError_t cudaBGR8ToRGBA16( uchar3* srcDev, half4* destDev, size_t width, size_t height )
+{
+	return launchRGBToRGBA<true>(srcDev, destDev, width, height);
+}
 
-	RGBToRGBAf<false><<<gridDim, blockDim>>>( srcDev, destDev, width, height );
-	
-	return CUDA(cudaGetLastError());
+cudaError_t cudaRGB8ToRGBA16( uchar3* srcDev, half4* destDev, size_t width, size_t height )
+{
+	return launchRGBToRGBA<false>(srcDev, destDev, width, height);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------
-template<bool isBGRA>
-__global__ void RGBAToRGBA8(float4* srcImage,
+template<bool isBGRA, typename T>
+__global__ void RGBAToRGBA8(T* srcImage,
                             uchar4* dstImage,
                             int width, int height,
 					   float scaling_factor)
@@ -94,7 +101,7 @@ __global__ void RGBAToRGBA8(float4* srcImage,
 	if( y >= height )
 		return;
 
-	const float4 px = srcImage[pixel];
+	const float4 px = load_rgba(srcImage[pixel]);
 
 	if( isBGRA )
 	{
@@ -112,7 +119,8 @@ __global__ void RGBAToRGBA8(float4* srcImage,
 	}
 }
 
-cudaError_t cudaRGBA32ToRGBA8( float4* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
+template<bool isBGRA, typename T>
+static cudaError_t launchRGBAToRGBA8( T* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
 {
 	if( !srcDev || !destDev )
 		return cudaErrorInvalidDevicePointer;
@@ -125,11 +133,16 @@ cudaError_t cudaRGBA32ToRGBA8( float4* srcDev, uchar4* destDev, size_t width, si
 	const dim3 blockDim(8,8,1);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
 
-	RGBAToRGBA8<false><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
+	RGBAToRGBA8<isBGRA, T><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
 	
 	return CUDA(cudaGetLastError());
 }
 
+cudaError_t cudaRGBA32ToRGBA8( float4* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGBA8<false>(srcDev, destDev, width, height, inputRange);
+}
+
 cudaError_t cudaRGBA32ToRGBA8( float4* srcDev, uchar4* destDev, size_t width, size_t height )
 {
 	return cudaRGBA32ToRGBA8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
@@ -137,31 +150,38 @@ cudaError_t cudaRGBA32ToRGBA8( float4* srcDev, uchar4* destDev, size_t width, si
 
 cudaError_t cudaRGBA32ToBGRA8( float4* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
 {
-	if( !srcDev || !destDev )
-		return cudaErrorInvalidDevicePointer;
+	return launchRGBAToRGBA8<true>(srcDev, destDev, width, height, inputRange);
+}
 
-	if( width == 0 || height == 0 )
-		return cudaErrorInvalidValue;
+cudaError_t cudaRGBA32ToBGRA8( float4* srcDev, uchar4* destDev, size_t width, size_t height )
+{
+	return cudaRGBA32ToBGRA8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+}
 
-	const float multiplier = 255.0f / inputRange.y;
+cudaError_t cudaRGBA16ToRGBA8( half4* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGBA8<false>(srcDev, destDev, width, height, inputRange);
+}
 
-	const dim3 blockDim(8,8,1);
-	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
+cudaError_t cudaRGBA16ToRGBA8( half4* srcDev, uchar4* destDev, size_t width, size_t height )
+{
+	return cudaRGBA16ToRGBA8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+}
 
-	RGBAToRGBA8<true><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
-	
-	return CUDA(cudaGetLastError());
+cudaError_t cudaRGBA16ToBGRA8( half4* srcDev, uchar4* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGBA8<true>(srcDev, destDev, width, height, inputRange);
 }
 
-cudaError_t cudaRGBA32ToBGRA8( float4* srcDev, uchar4* destDev, size_t width, size_t height )
+cudaError_t cudaRGBA16ToBGRA8( half4* srcDev, uchar4* destDev, size_t width, size_t height )
 {
-	return cudaRGBA32ToBGRA8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+	return cudaRGBA16ToBGRA8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
 }
 
 
 //-------------------------------------------------------------------------------------------------------------------------
-template<bool isBGR>
-__global__ void RGBAToRGB8(float4* srcImage,
+template<bool isBGR, typename T>
+__global__ void RGBAToRGB8(T* srcImage,
                            uchar3* dstImage,
                            int width, int height,
 					  float scaling_factor)
@@ -177,7 +197,7 @@ __global__ void RGBAToRGB8(float4* srcImage,
 	if( y >= height )
 		return;
 
-	const float4 px = srcImage[pixel];
+	const float4 px = load_rgba(srcImage[pixel]);
 
 	if( isBGR )
 	{
@@ -193,7 +213,8 @@ __global__ void RGBAToRGB8(float4* srcImage,
 	}
 }
 
-cudaError_t cudaRGBA32ToRGB8( float4* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
+template<bool isBGR, typename T>
+static cudaError_t launchRGBAToRGB8( T* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
 {
 	if( !srcDev || !destDev )
 		return cudaErrorInvalidDevicePointer;
@@ -206,17 +227,72 @@ cudaError_t cudaRGBA32ToRGB8( float4* srcDev, uchar3* destDev, size_t width, siz
 	const dim3 blockDim(8,8,1);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
 
-	RGBAToRGB8<false><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
+	RGBAToRGB8<isBGR, T><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
 	
 	return CUDA(cudaGetLastError());
 }
 
+cudaError_t cudaRGBA32ToRGB8( float4* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGB8<false>(srcDev, destDev, width, height, inputRange);
+}
+
 cudaError_t cudaRGBA32ToRGB8( float4* srcDev, uchar3* destDev, size_t width, size_t height )
 {
 	return cudaRGBA32ToRGB8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
 }
 
 cudaError_t cudaRGBA32ToBGR8( float4* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGB8<true>(srcDev, destDev, width, height, inputRange);
+}
+
+cudaError_t cudaRGBA32ToBGR8( float4* srcDev, uchar3* destDev, size_t width, size_t height )
+{
+	return cudaRGBA32ToBGR8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+}
+
+cudaError_t cudaRGBA16ToRGB8( half4* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGB8<false>(srcDev, destDev, width, height, inputRange);
+}
+
+cudaError_t cudaRGBA16ToRGB8( half4* srcDev, uchar3* destDev, size_t width, size_t height )
+{
+	return cudaRGBA16ToRGB8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+}
+
+cudaError_t cudaRGBA16ToBGR8( half4* srcDev, uchar3* destDev, size_t width, size_t height, const float2& inputRange )
+{
+	return launchRGBAToRGB8<true>(srcDev, destDev, width, height, inputRange);
+}
+
+cudaError_t cudaRGBA16ToBGR8( half4* srcDev, uchar3* destDev, size_t width, size_t height )
+{
+	return cudaRGBA16ToBGR8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------------
+template<typename T_in, typename T_out>
+__global__ void RGBAToRGBA(T_in* srcImage,
+                           T_out* dstImage,
+                           int width, int height)
+{
+	const int x = (blockIdx.x * blockDim.x) + threadIdx.x;
+	const int y = (blockIdx.y * blockDim.y) + threadIdx.y;
+	
+	if( x >= width || y >= height )
+		return;
+
+	const int pixel = y * width + x;
+	const float4 px = load_rgba(srcImage[pixel]);
+
+	dstImage[pixel] = make_rgba<T_out>(px.x, px.y, px.z, px.w);
+}
+
+template<typename T_in, typename T_out>
+static cudaError_t launchRGBAToRGBA( T_in* srcDev, T_out* destDev, size_t width, size_t height )
 {
 	if( !srcDev || !destDev )
 		return cudaErrorInvalidDevicePointer;
@@ -224,19 +300,22 @@ cudaError_t cudaRGBA32ToBGR8( float4* srcDev, uchar3* destDev, size_t width, siz
 	if( width == 0 || height == 0 )
 		return cudaErrorInvalidValue;
 
-	const float multiplier = 255.0f / inputRange.y;
-
 	const dim3 blockDim(8,8,1);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height,blockDim.y), 1);
 
-	RGBAToRGB8<true><<<gridDim, blockDim>>>( srcDev, destDev, width, height, multiplier );
+	RGBAToRGBA<T_in, T_out><<<gridDim, blockDim>>>( srcDev, destDev, width, height );
 	
 	return CUDA(cudaGetLastError());
 }
 
-cudaError_t cudaRGBA32ToBGR8( float4* srcDev, uchar3* destDev, size_t width, size_t height )
+cudaError_t cudaRGBA32ToRGBA16( float4* srcDev, half4* destDev, size_t width, size_t height )
 {
-	return cudaRGBA32ToBGR8(srcDev, destDev, width, height, make_float2(0.0f, 255.0f));
+	return launchRGBAToRGBA(srcDev, destDev, width, height);
+}
+
+cudaError_t cudaRGBA16ToRGBA32( half4* srcDev, float4* destDev, size_t width, size_t height )
+{
+	return launchRGBAToRGBA(srcDev, destDev, width, height);
 }
 
 
@@ -25,6 +25,7 @@
 
 
 #include "cudaUtility.h"
+#include "cudaFP16.h"
 
 
 
@@ -123,5 +124,114 @@ cudaError_t cudaRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size
 
 ///@}
 
+//////////////////////////////////////////////////////////////////////////////////
+/// @name 8-bit RGB/BGR to Half-precision RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+	
+/**
+ * Convert 8-bit fixed-point RGB image to 16-bit half-precision RGBA image
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGB8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height );
+
+/**
+ * Convert 8-bit fixed-point BGR image to 16-bit half-precision RGBA image
+ * @ingroup colorspace
+ */
+cudaError_t cudaBGR8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Half-precision RGBA to 8-bit RGB/RGBA/BGR/BGRA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGB image.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGB image,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGBA image.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point RGBA image,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGR image.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGR image,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGRA image.
+ * Assumes 0.0-255.0f input range, output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 8-bit fixed-point BGRA image,
+ * with the floating-point input range specified by the user.  Output range is 0-255.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange );
+
+///@}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @name Single-precision RGBA to/from Half-precision RGBA
+/// @ingroup colorspace
+//////////////////////////////////////////////////////////////////////////////////
+
+///@{
+
+/**
+ * Convert 32-bit floating-point RGBA image into 16-bit half-precision RGBA image.
+ * The values are rounded to the nearest half, and the range is unchanged.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA32ToRGBA16( float4* input, half4* output, size_t width, size_t height );
+
+/**
+ * Convert 16-bit half-precision RGBA image into 32-bit floating-point RGBA image.
+ * The conversion is exact, and the range is unchanged.
+ * @ingroup colorspace
+ */
+cudaError_t cudaRGBA16ToRGBA32( half4* input, float4* output, size_t width, size_t height );
+
+///@}
+
 #endif
 
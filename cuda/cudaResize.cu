@@ -24,7 +24,32 @@
 
 
 
-// gpuResample
+// resizeLoad (widen a pixel to float4 for filtering)
+inline __device__ float4 resizeLoad( const float& px )  { return make_float4(px, 0.0f, 0.0f, 0.0f); }
+inline __device__ float4 resizeLoad( const float4& px ) { return px; }
+inline __device__ float4 resizeLoad( const uchar3& px ) { return make_float4(px.x, px.y, px.z, 0.0f); }
+inline __device__ float4 resizeLoad( const uchar4& px ) { return make_float4(px.x, px.y, px.z, px.w); }
+
+// resizeRound (round and saturate a filtered value to 8-bit)
+inline __device__ unsigned char resizeRound( float value )
+{
+	return (unsigned char)fminf(fmaxf(value + 0.5f, 0.0f), 255.0f);
+}
+
+// resizeStore (narrow a filtered float4 back to the pixel type)
+inline __device__ void resizeStore( float& px, const float4& v )  { px = v.x; }
+inline __device__ void resizeStore( float4& px, const float4& v ) { px = v; }
+inline __device__ void resizeStore( uchar3& px, const float4& v ) { px = make_uchar3(resizeRound(v.x), resizeRound(v.y), resizeRound(v.z)); }
+inline __device__ void resizeStore( uchar4& px, const float4& v ) { px = make_uchar4(resizeRound(v.x), resizeRound(v.y), resizeRound(v.z), resizeRound(v.w)); }
+
+// resizeAccum (acc + px * weight, on each channel)
+inline __device__ float4 resizeAccum( const float4& acc, const float4& px, float weight )
+{
+	return make_float4(acc.x + px.x * weight, acc.y + px.y * weight, acc.z + px.z * weight, acc.w + px.w * weight);
+}
+
+
+// gpuResize (FILTER_POINT)
 template <typename T>
 __global__ void gpuResize( float2 scale, T* input, int iWidth, T* output, int oWidth, int oHeight )
 {
@@ -43,32 +68,93 @@ __global__ void gpuResize( float2 scale, T* input, int iWidth, T* output, int oW
 }
 
 
-// cudaResize
-cudaError_t cudaResize( float* input, size_t inputWidth, size_t inputHeight,
-				        float* output, size_t outputWidth, size_t outputHeight )
+// gpuResizeLinear (FILTER_LINEAR)
+template <typename T>
+__global__ void gpuResizeLinear( float2 scale, T* input, int iWidth, int iHeight, T* output, int oWidth, int oHeight )
 {
-	if( !input || !output )
-		return cudaErrorInvalidDevicePointer;
+	const int x = blockIdx.x * blockDim.x + threadIdx.x;
+	const int y = blockIdx.y * blockDim.y + threadIdx.y;
 
-	if( inputWidth == 0 || outputWidth == 0 || inputHeight == 0 || outputHeight == 0 )
-		return cudaErrorInvalidValue;
+	if( x >= oWidth || y >= oHeight )
+		return;
 
-	const float2 scale = make_float2( float(inputWidth) / float(outputWidth),
-							          float(inputHeight) / float(outputHeight) );
+	// sample from the center of the output pixel
+	const float sx = fminf(fmaxf((float(x) + 0.5f) * scale.x - 0.5f, 0.0f), float(iWidth - 1));
+	const float sy = fminf(fmaxf((float(y) + 0.5f) * scale.y - 0.5f, 0.0f), float(iHeight - 1));
 
-	// launch kernel
-	const dim3 blockDim(8, 8);
-	const dim3 gridDim(iDivUp(outputWidth,blockDim.x), iDivUp(outputHeight,blockDim.y));
+	const int x1 = int(sx);
+	const int y1 = int(sy);
 
-	gpuResize<float><<<gridDim, blockDim>>>(scale, input, inputWidth, output, outputWidth, outputHeight);
+	const int x2 = min(x1 + 1, iWidth - 1);	// bounds check
+	const int y2 = min(y1 + 1, iHeight - 1);
 
-	return CUDA(cudaGetLastError());
+	const float x2f = sx - float(x1);
+	const float y2f = sy - float(y1);
+
+	const float x1f = 1.0f - x2f;
+	const float y1f = 1.0f - y2f;
+
+	const float4 zero = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+	const float4 row1 = resizeAccum(resizeAccum(zero, resizeLoad(input[y1 * iWidth + x1]), x1f), resizeLoad(input[y1 * iWidth + x2]), x2f);
+	const float4 row2 = resizeAccum(resizeAccum(zero, resizeLoad(input[y2 * iWidth + x1]), x1f), resizeLoad(input[y2 * iWidth + x2]), x2f);
+
+	resizeStore(output[y * oWidth + x], resizeAccum(resizeAccum(zero, row1, y1f), row2, y2f));
 }
 
 
-// cudaResizeRGBA
-cudaError_t cudaResizeRGBA( float4* input,  size_t inputWidth, size_t inputHeight,
-				            float4* output, size_t outputWidth, size_t outputHeight )
+// gpuResizeArea (FILTER_AREA)
+template <typename T>
+__global__ void gpuResizeArea( float2 scale, T* input, int iWidth, int iHeight, T* output, int oWidth, int oHeight )
+{
+	const int x = blockIdx.x * blockDim.x + threadIdx.x;
+	const int y = blockIdx.y * blockDim.y + threadIdx.y;
+
+	if( x >= oWidth || y >= oHeight )
+		return;
+
+	// footprint of the output pixel in the input image
+	const float x0f = float(x) * scale.x;
+	const float y0f = float(y) * scale.y;
+
+	const float x1f = fminf(float(x + 1) * scale.x, float(iWidth));
+	const float y1f = fminf(float(y + 1) * scale.y, float(iHeight));
+
+	const int xBegin = int(x0f);
+	const int yBegin = int(y0f);
+
+	const int xEnd = min(int(ceilf(x1f)), iWidth);
+	const int yEnd = min(int(ceilf(y1f)), iHeight);
+
+	const float xNorm = 1.0f / (x1f - x0f);
+	const float yNorm = 1.0f / (y1f - y0f);
+
+	const float4 zero = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+	float4 sum = zero;
+
+	for( int iy=yBegin; iy < yEnd; iy++ )
+	{
+		const float wy = (fminf(float(iy + 1), y1f) - fmaxf(float(iy), y0f)) * yNorm;
+		float4 row = zero;
+
+		for( int ix=xBegin; ix < xEnd; ix++ )
+		{
+			const float wx = (fminf(float(ix + 1), x1f) - fmaxf(float(ix), x0f)) * xNorm;
+			row = resizeAccum(row, resizeLoad(input[iy * iWidth + ix]), wx);
+		}
+
+		sum = resizeAccum(sum, row, wy);
+	}
+
+	resizeStore(output[y * oWidth + x], sum);
+}
+
+
+// launchResize
+template <typename T>
+static cudaError_t launchResize( T* input, size_t inputWidth, size_t inputHeight,
+						   T* output, size_t outputWidth, size_t outputHeight,
+						   cudaFilterMode filter )
 {
 	if( !input || !output )
 		return cudaErrorInvalidDevicePointer;
@@ -83,12 +169,55 @@ cudaError_t cudaResizeRGBA( float4* input,  size_t inputWidth, size_t inputHeigh
 	const dim3 blockDim(8, 8);
 	const dim3 gridDim(iDivUp(outputWidth,blockDim.x), iDivUp(outputHeight,blockDim.y));
 
-	gpuResize<float4><<<gridDim, blockDim>>>(scale, input, inputWidth, output, outputWidth, outputHeight);
+	if( filter == FILTER_LINEAR )
+		gpuResizeLinear<T><<<gridDim, blockDim>>>(scale, input, inputWidth, inputHeight, output, outputWidth, outputHeight);
+	else if( filter == FILTER_AREA )
+		gpuResizeArea<T><<<gridDim, blockDim>>>(scale, input, inputWidth, inputHeight, output, outputWidth, outputHeight);
+	else
+		gpuResize<T><<<gridDim, blockDim>>>(scale, input, inputWidth, output, outputWidth, outputHeight);
 
 	return CUDA(cudaGetLastError());
 }
 
 
+// cudaResize
+cudaError_t cudaResize( float* input, size_t inputWidth, size_t inputHeight,
+				    float* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter )
+{
+	return launchResize<float>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
 
+// cudaResize
+cudaError_t cudaResize( float4* input, size_t inputWidth, size_t inputHeight,
+				    float4* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter )
+{
+	return launchResize<float4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
 
+// cudaResize
+cudaError_t cudaResize( uchar3* input, size_t inputWidth, size_t inputHeight,
+				    uchar3* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter )
+{
+	return launchResize<uchar3>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+// cudaResize
+cudaError_t cudaResize( uchar4* input, size_t inputWidth, size_t inputHeight,
+				    uchar4* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter )
+{
+	return launchResize<uchar4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
+
+
+// cudaResizeRGBA
+cudaError_t cudaResizeRGBA( float4* input,  size_t inputWidth, size_t inputHeight,
+				            float4* output, size_t outputWidth, size_t outputHeight,
+				            cudaFilterMode filter )
+{
+	return launchResize<float4>(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter);
+}
 
@@ -25,23 +25,69 @@
 
 
 #include "cudaUtility.h"
+#include "cudaFilterMode.h"
 
 
+/*
+ * The filtering modes of cudaResize() sample the input image as follows:
+ *
+ *   - FILTER_POINT selects the input pixel at `int(x * scale)`, where the
+ *     scale is the input size divided by the output size.
+ *
+ *   - FILTER_LINEAR interpolates between the 4 pixels surrounding the center
+ *     of the output pixel, `(x + 0.5) * scale - 0.5`, clamped to the edges.
+ *
+ *   - FILTER_AREA averages the input pixels that are covered by the output
+ *     pixel's footprint `[x * scale, (x+1) * scale)`, weighted by their
+ *     fractional coverage.  This avoids the aliasing of the other modes when
+ *     downscaling.  When upscaling, it reduces to point sampling with blending
+ *     along the pixel boundaries.
+ *
+ * The samples are weighted along each row first, and then the rows are weighted
+ * together.  8-bit outputs are rounded to the nearest value and saturated.
+ * cpuResize() is a host implementation with the same semantics (see cpuResize.h).
+ */
+
 
 /**
  * Function for increasing or decreasing the size of an image on the GPU.
  * @ingroup cuda
  */
 cudaError_t cudaResize( float* input,  size_t inputWidth,  size_t inputHeight,
-				    float* output, size_t outputWidth, size_t outputHeight );
+				    float* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Function for increasing or decreasing the size of an RGBA float4 image on the GPU.
+ * @ingroup cuda
+ */
+cudaError_t cudaResize( float4* input,  size_t inputWidth,  size_t inputHeight,
+				    float4* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter=FILTER_POINT );
 
+/**
+ * Function for increasing or decreasing the size of an RGB uchar3 image on the GPU.
+ * @ingroup cuda
+ */
+cudaError_t cudaResize( uchar3* input,  size_t inputWidth,  size_t inputHeight,
+				    uchar3* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter=FILTER_POINT );
+
+/**
+ * Function for increasing or decreasing the size of an RGBA uchar4 image on the GPU.
+ * @ingroup cuda
+ */
+cudaError_t cudaResize( uchar4* input,  size_t inputWidth,  size_t inputHeight,
+				    uchar4* output, size_t outputWidth, size_t outputHeight,
+				    cudaFilterMode filter=FILTER_POINT );
 
 /**
  * Function for increasing or decreasing the size of an image on the GPU.
  * @ingroup cuda
  */
 cudaError_t cudaResizeRGBA( float4* input,  size_t inputWidth,  size_t inputHeight,
-				        float4* output, size_t outputWidth, size_t outputHeight );
+				        float4* output, size_t outputWidth, size_t outputHeight,
+				        cudaFilterMode filter=FILTER_POINT );
 
 
 
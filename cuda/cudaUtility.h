@@ -24,8 +24,13 @@
 #define __CUDA_UTILITY_H_
 
 
+#ifdef JETSON_UTILS_NO_CUDA
+#include "cudaHost.h"
+#else
 #include <cuda_runtime.h>
 #include <cuda.h>
+#endif
+
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cudaVideoFormat.h"
+
+
+// cudaVideoFormatToString
+const char* cudaVideoFormatToString( cudaVideoFormat format )
+{
+	switch(format)
+	{
+		case CUDA_VIDEO_NV12:	return "CUDA_VIDEO_NV12";
+		case CUDA_VIDEO_NV16:	return "CUDA_VIDEO_NV16";
+		case CUDA_VIDEO_I420:	return "CUDA_VIDEO_I420";
+		case CUDA_VIDEO_YV12:	return "CUDA_VIDEO_YV12";
+		case CUDA_VIDEO_YUY2:	return "CUDA_VIDEO_YUY2";
+		case CUDA_VIDEO_UYVY:	return "CUDA_VIDEO_UYVY";
+		case CUDA_VIDEO_GRAY8:	return "CUDA_VIDEO_GRAY8";
+		case CUDA_VIDEO_RGB:	return "CUDA_VIDEO_RGB";
+		case CUDA_VIDEO_BGR:	return "CUDA_VIDEO_BGR";
+		case CUDA_VIDEO_RGBX:	return "CUDA_VIDEO_RGBX";
+		case CUDA_VIDEO_BGRX:	return "CUDA_VIDEO_BGRX";
+		default:				break;
+	}
+
+	return "UNKNOWN";
+}
+
+
+// cudaVideoFormatDepth
+uint32_t cudaVideoFormatDepth( cudaVideoFormat format )
+{
+	switch(format)
+	{
+		case CUDA_VIDEO_NV12:
+		case CUDA_VIDEO_I420:
+		case CUDA_VIDEO_YV12:	return 12;
+		case CUDA_VIDEO_NV16:
+		case CUDA_VIDEO_YUY2:
+		case CUDA_VIDEO_UYVY:	return 16;
+		case CUDA_VIDEO_GRAY8:	return 8;
+		case CUDA_VIDEO_RGB:
+		case CUDA_VIDEO_BGR:	return 24;
+		case CUDA_VIDEO_RGBX:
+		case CUDA_VIDEO_BGRX:	return 32;
+		default:				break;
+	}
+
+	return 0;
+}
+
+
+// cudaOutputFormatToString
+const char* cudaOutputFormatToString( cudaOutputFormat format )
+{
+	switch(format)
+	{
+		case CUDA_OUTPUT_RGBA32:	return "CUDA_OUTPUT_RGBA32";
+		case CUDA_OUTPUT_RGBA8:	return "CUDA_OUTPUT_RGBA8";
+		case CUDA_OUTPUT_RGB8:	return "CUDA_OUTPUT_RGB8";
+		case CUDA_OUTPUT_BGR8:	return "CUDA_OUTPUT_BGR8";
+		case CUDA_OUTPUT_GRAY8:	return "CUDA_OUTPUT_GRAY8";
+		case CUDA_OUTPUT_RGBA16:	return "CUDA_OUTPUT_RGBA16";
+		default:				break;
+	}
+
+	return "UNKNOWN";
+}
+
+
+// cudaOutputFormatSize
+size_t cudaOutputFormatSize( cudaOutputFormat format )
+{
+	switch(format)
+	{
+		case CUDA_OUTPUT_RGBA32:	return sizeof(float4);
+		case CUDA_OUTPUT_RGBA8:	return sizeof(uchar4);
+		case CUDA_OUTPUT_RGB8:
+		case CUDA_OUTPUT_BGR8:	return sizeof(uchar3);
+		case CUDA_OUTPUT_GRAY8:	return sizeof(uint8_t);
+		case CUDA_OUTPUT_RGBA16:	return sizeof(half4);
+		default:				break;
+	}
+
+	return 0;
+}
+
+
+// cudaVideoLayoutPacked
+bool cudaVideoLayoutPacked( cudaVideoLayout* layout, cudaVideoFormat format, uint32_t width, uint32_t height )
+{
+	if( !layout || format == CUDA_VIDEO_UNKNOWN )
+		return false;
+
+	memset(layout, 0, sizeof(cudaVideoLayout));
+
+	layout->format = format;
+	layout->width  = width;
+	layout->height = height;
+	layout->planes = 1;
+
+	const size_t lumaSize = width * height;
+
+	switch(format)
+	{
+		case CUDA_VIDEO_NV12:
+		case CUDA_VIDEO_NV16:
+		{
+			layout->planes    = 2;
+			layout->stride[0] = width;
+			layout->stride[1] = width;
+			layout->offset[1] = lumaSize;
+			layout->size      = lumaSize + ((format == CUDA_VIDEO_NV12) ? lumaSize / 2 : lumaSize);
+			break;
+		}
+		case CUDA_VIDEO_I420:
+		case CUDA_VIDEO_YV12:
+		{
+			layout->planes    = 3;
+			layout->stride[0] = width;
+			layout->stride[1] = width / 2;
+			layout->stride[2] = width / 2;
+			layout->offset[1] = lumaSize;
+			layout->offset[2] = lumaSize + lumaSize / 4;
+			layout->size      = lumaSize + lumaSize / 2;
+			break;
+		}
+		default:
+		{
+			layout->stride[0] = width * cudaVideoFormatDepth(format) / 8;
+			layout->size      = layout->stride[0] * height;
+			break;
+		}
+	}
+
+	return true;
+}
+
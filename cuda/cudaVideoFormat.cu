@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cudaVideoFormat.h"
+
+
+//-------------------------------------------------------------------------------------------------------------------------
+inline __device__ float4 YUVToRGBAf( float luma, float u, float v )
+{
+	u -= 128.0f;
+	v -= 128.0f;
+
+	const float red   = luma + 1.140f * v;
+	const float green = luma - 0.395f * u - 0.581f * v;
+	const float blue  = luma + 2.032f * u;
+
+	return make_float4(fminf(fmaxf(red, 0.0f), 255.0f),
+				    fminf(fmaxf(green, 0.0f), 255.0f),
+				    fminf(fmaxf(blue, 0.0f), 255.0f), 255.0f);
+}
+
+template<cudaOutputFormat output>
+inline __device__ void storeVideoPixel( void* dstImage, int index, const float4& px, float luma )
+{
+	if( output == CUDA_OUTPUT_RGBA32 )
+		((float4*)dstImage)[index] = px;
+	else if( output == CUDA_OUTPUT_RGBA8 )
+		((uchar4*)dstImage)[index] = make_uchar4(px.x, px.y, px.z, px.w);
+	else if( output == CUDA_OUTPUT_RGB8 )
+		((uchar3*)dstImage)[index] = make_uchar3(px.x, px.y, px.z);
+	else if( output == CUDA_OUTPUT_BGR8 )
+		((uchar3*)dstImage)[index] = make_uchar3(px.z, px.y, px.x);
+	else if( output == CUDA_OUTPUT_GRAY8 )
+		((uint8_t*)dstImage)[index] = fminf(luma, 255.0f);
+	else if( output == CUDA_OUTPUT_RGBA16 )
+		((half4*)dstImage)[index] = make_half4(px);
+}
+
+template<cudaVideoFormat format, cudaOutputFormat output>
+__global__ void VideoConvert( const uint8_t* srcImage, cudaVideoLayout layout, void* dstImage )
+{
+	const int x = (blockIdx.x * blockDim.x) + threadIdx.x;
+	const int y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+	if( x >= (int)layout.width || y >= (int)layout.height )
+		return;
+
+	const uint8_t* row = srcImage + layout.offset[0] + y * layout.stride[0];
+
+	// for YUV formats the luma is used directly, so the RGB conversion
+	// gets compiled out of the kernels that only output grayscale
+	float4 px;
+	float luma;
+
+	if( format == CUDA_VIDEO_GRAY8 )
+	{
+		luma = row[x];
+		px = make_float4(luma, luma, luma, 255.0f);
+	}
+	else if( format == CUDA_VIDEO_RGB || format == CUDA_VIDEO_BGR ||
+		    format == CUDA_VIDEO_RGBX || format == CUDA_VIDEO_BGRX )
+	{
+		const int bpp = (format == CUDA_VIDEO_RGB || format == CUDA_VIDEO_BGR) ? 3 : 4;
+		const uint8_t* p = row + x * bpp;
+
+		if( format == CUDA_VIDEO_BGR || format == CUDA_VIDEO_BGRX )
+			px = make_float4(p[2], p[1], p[0], 255.0f);
+		else
+			px = make_float4(p[0], p[1], p[2], 255.0f);
+
+		luma = 0.299f * px.x + 0.587f * px.y + 0.114f * px.z;
+	}
+	else if( format == CUDA_VIDEO_YUY2 || format == CUDA_VIDEO_UYVY )
+	{
+		// each 4-byte macropixel holds two luma samples that share U and V
+		const uint8_t* p = row + (x >> 1) * 4;
+
+		if( format == CUDA_VIDEO_YUY2 )
+		{
+			luma = p[(x & 1) * 2];
+			px = YUVToRGBAf(luma, p[1], p[3]);
+		}
+		else
+		{
+			luma = p[(x & 1) * 2 + 1];
+			px = YUVToRGBAf(luma, p[0], p[2]);
+		}
+	}
+	else if( format == CUDA_VIDEO_NV12 || format == CUDA_VIDEO_NV16 )
+	{
+		// NV16 has full vertical chroma resolution, NV12 has half
+		const int cy = (format == CUDA_VIDEO_NV12) ? (y >> 1) : y;
+		const uint8_t* uv = srcImage + layout.offset[1] + cy * layout.stride[1] + (x >> 1) * 2;
+
+		luma = row[x];
+		px = YUVToRGBAf(luma, uv[0], uv[1]);
+	}
+	else if( format == CUDA_VIDEO_I420 || format == CUDA_VIDEO_YV12 )
+	{
+		// I420 stores the U plane first, YV12 stores the V plane first
+		const size_t c0 = layout.offset[1] + (y >> 1) * layout.stride[1] + (x >> 1);
+		const size_t c1 = layout.offset[2] + (y >> 1) * layout.stride[2] + (x >> 1);
+
+		luma = row[x];
+
+		if( format == CUDA_VIDEO_I420 )
+			px = YUVToRGBAf(luma, srcImage[c0], srcImage[c1]);
+		else
+			px = YUVToRGBAf(luma, srcImage[c1], srcImage[c0]);
+	}
+
+	storeVideoPixel<output>(dstImage, y * layout.width + x, px, luma);
+}
+
+template<cudaVideoFormat format>
+static cudaError_t launchVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat outputFormat )
+{
+	const dim3 blockDim(8,8,1);
+	const dim3 gridDim(iDivUp(layout.width,blockDim.x), iDivUp(layout.height,blockDim.y), 1);
+
+	switch(outputFormat)
+	{
+		case CUDA_OUTPUT_RGBA32:	VideoConvert<format, CUDA_OUTPUT_RGBA32><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		case CUDA_OUTPUT_RGBA8:	VideoConvert<format, CUDA_OUTPUT_RGBA8><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		case CUDA_OUTPUT_RGB8:	VideoConvert<format, CUDA_OUTPUT_RGB8><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		case CUDA_OUTPUT_BGR8:	VideoConvert<format, CUDA_OUTPUT_BGR8><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		case CUDA_OUTPUT_GRAY8:	VideoConvert<format, CUDA_OUTPUT_GRAY8><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		case CUDA_OUTPUT_RGBA16:	VideoConvert<format, CUDA_OUTPUT_RGBA16><<<gridDim, blockDim>>>((uint8_t*)input, layout, output); break;
+		default:
+		{
+			printf(LOG_CUDA "cudaVideoConvert() -- unsupported output format (%s)\n", cudaOutputFormatToString(outputFormat));
+			return cudaErrorInvalidValue;
+		}
+	}
+
+	return CUDA(cudaGetLastError());
+}
+
+// cudaVideoConvert
+cudaError_t cudaVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat format )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( layout.width == 0 || layout.height == 0 )
+		return cudaErrorInvalidValue;
+
+	switch(layout.format)
+	{
+		case CUDA_VIDEO_NV12:	return launchVideoConvert<CUDA_VIDEO_NV12>(input, layout, output, format);
+		case CUDA_VIDEO_NV16:	return launchVideoConvert<CUDA_VIDEO_NV16>(input, layout, output, format);
+		case CUDA_VIDEO_I420:	return launchVideoConvert<CUDA_VIDEO_I420>(input, layout, output, format);
+		case CUDA_VIDEO_YV12:	return launchVideoConvert<CUDA_VIDEO_YV12>(input, layout, output, format);
+		case CUDA_VIDEO_YUY2:	return launchVideoConvert<CUDA_VIDEO_YUY2>(input, layout, output, format);
+		case CUDA_VIDEO_UYVY:	return launchVideoConvert<CUDA_VIDEO_UYVY>(input, layout, output, format);
+		case CUDA_VIDEO_GRAY8:	return launchVideoConvert<CUDA_VIDEO_GRAY8>(input, layout, output, format);
+		case CUDA_VIDEO_RGB:	return launchVideoConvert<CUDA_VIDEO_RGB>(input, layout, output, format);
+		case CUDA_VIDEO_BGR:	return launchVideoConvert<CUDA_VIDEO_BGR>(input, layout, output, format);
+		case CUDA_VIDEO_RGBX:	return launchVideoConvert<CUDA_VIDEO_RGBX>(input, layout, output, format);
+		case CUDA_VIDEO_BGRX:	return launchVideoConvert<CUDA_VIDEO_BGRX>(input, layout, output, format);
+		default:				break;
+	}
+
+	printf(LOG_CUDA "cudaVideoConvert() -- unsupported video format (%s)\n", cudaVideoFormatToString(layout.format));
+	return cudaErrorInvalidValue;
+}
+
+// cudaVideoToRGBA32
+cudaError_t cudaVideoToRGBA32( void* input, const cudaVideoLayout& layout, float4* output )
+{
+	return cudaVideoConvert(input, layout, output, CUDA_OUTPUT_RGBA32);
+}
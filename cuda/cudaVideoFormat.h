@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CUDA_VIDEO_FORMAT_H__
+#define __CUDA_VIDEO_FORMAT_H__
+
+
+#include "cudaUtility.h"
+#include "cudaFP16.h"
+
+
+/**
+ * Enumeration of the raw video formats that cudaVideoToRGBA32() can convert from.
+ * @ingroup colorspace
+ */
+enum cudaVideoFormat
+{
+	CUDA_VIDEO_UNKNOWN = 0,	/**< Unsupported or unknown format */
+	CUDA_VIDEO_NV12,		/**< YUV 4:2:0, Y plane followed by interleaved UV plane */
+	CUDA_VIDEO_NV16,		/**< YUV 4:2:2, Y plane followed by interleaved UV plane */
+	CUDA_VIDEO_I420,		/**< YUV 4:2:0, separate Y, U and V planes */
+	CUDA_VIDEO_YV12,		/**< YUV 4:2:0, separate Y, V and U planes */
+	CUDA_VIDEO_YUY2,		/**< YUV 4:2:2 packed as Y0 U Y1 V */
+	CUDA_VIDEO_UYVY,		/**< YUV 4:2:2 packed as U Y0 V Y1 */
+	CUDA_VIDEO_GRAY8,		/**< 8-bit grayscale */
+	CUDA_VIDEO_RGB,			/**< 24-bit RGB */
+	CUDA_VIDEO_BGR,			/**< 24-bit BGR */
+	CUDA_VIDEO_RGBX,		/**< 32-bit RGB with an unused (or alpha) 4th byte */
+	CUDA_VIDEO_BGRX			/**< 32-bit BGR with an unused (or alpha) 4th byte */
+};
+
+/**
+ * Stringize function to convert cudaVideoFormat enum to text
+ * @ingroup colorspace
+ */
+const char* cudaVideoFormatToString( cudaVideoFormat format );
+
+/**
+ * Return the average number of bits per pixel of a format
+ * (i.e. 12 for NV12, 16 for YUY2, 24 for RGB), or 0 if it's unknown.
+ * @ingroup colorspace
+ */
+uint32_t cudaVideoFormatDepth( cudaVideoFormat format );
+
+
+/**
+ * Memory layout of a raw video frame, as it was negotiated by the producer.
+ * Each plane starts at an offset from the beginning of the frame, and its rows
+ * are `stride` bytes apart (which may include padding past the visible width).
+ * @ingroup colorspace
+ */
+struct cudaVideoLayout
+{
+	cudaVideoFormat format;		/**< Pixel format of the frame */
+	uint32_t width;				/**< Width of the frame, in pixels */
+	uint32_t height;			/**< Height of the frame, in pixels */
+	uint32_t planes;			/**< Number of planes that are used by the format */
+	size_t   offset[3];			/**< Offset of each plane from the start of the frame, in bytes */
+	size_t   stride[3];			/**< Row pitch of each plane, in bytes */
+	size_t   size;				/**< Total size of the frame, in bytes */
+};
+
+/**
+ * Fill out the layout of a tightly-packed frame (where the rows aren't padded).
+ * @returns `false` if the format is CUDA_VIDEO_UNKNOWN, otherwise `true`.
+ * @ingroup colorspace
+ */
+bool cudaVideoLayoutPacked( cudaVideoLayout* layout, cudaVideoFormat format, uint32_t width, uint32_t height );
+
+
+/**
+ * Pixel formats that cudaVideoConvert() can convert a raw video frame into.
+ * @ingroup colorspace
+ */
+enum cudaOutputFormat
+{
+	CUDA_OUTPUT_RGBA32 = 0,	/**< float4 RGBA, with pixel intensities ranging from 0.0 to 255.0 */
+	CUDA_OUTPUT_RGBA8,		/**< uchar4 RGBA, with an opaque alpha channel */
+	CUDA_OUTPUT_RGB8,		/**< uchar3 RGB */
+	CUDA_OUTPUT_BGR8,		/**< uchar3 BGR */
+	CUDA_OUTPUT_GRAY8,		/**< 8-bit grayscale (the luma of YUV formats) */
+	CUDA_OUTPUT_RGBA16,		/**< half4 RGBA, with pixel intensities ranging from 0.0 to 255.0 */
+	CUDA_OUTPUT_FORMATS		/**< Number of output formats */
+};
+
+/**
+ * Stringize function to convert cudaOutputFormat enum to text
+ * @ingroup colorspace
+ */
+const char* cudaOutputFormatToString( cudaOutputFormat format );
+
+/**
+ * Return the size of one pixel of an output format in bytes
+ * (i.e. 16 for CUDA_OUTPUT_RGBA32, 3 for CUDA_OUTPUT_RGB8), or 0 if it's unknown.
+ * @ingroup colorspace
+ */
+size_t cudaOutputFormatSize( cudaOutputFormat format );
+
+
+/**
+ * Convert a raw video frame of any cudaVideoFormat into a float4 RGBA image,
+ * with pixel intensities ranging from 0.0 to 255.0.  The planes are read using
+ * the offsets and strides from the layout, so padded rows are handled directly.
+ * Chroma is sampled from the nearest site (without interpolation).
+ *
+ * @param input pointer to the start of the frame in GPU address space
+ * @param layout format and plane layout of the input frame
+ * @param output float4 RGBA image of `layout.width * layout.height` pixels
+ * @ingroup colorspace
+ */
+cudaError_t cudaVideoToRGBA32( void* input, const cudaVideoLayout& layout, float4* output );
+
+/**
+ * Convert a raw video frame of any cudaVideoFormat directly into one of the
+ * cudaOutputFormat's, without going through a float4 intermediate image.
+ *
+ * The 8-bit formats have the same values as converting to float4 with
+ * cudaVideoToRGBA32() and then truncating to 8 bits (like cudaRGBA32ToRGBA8()),
+ * except that CUDA_OUTPUT_GRAY8 takes the luma plane of YUV formats as-is,
+ * and weighs RGB formats by 0.299R + 0.587G + 0.114B.
+ * CUDA_OUTPUT_RGBA16 has the float4 values rounded to half-precision.
+ *
+ * @param input pointer to the start of the frame in GPU address space
+ * @param layout format and plane layout of the input frame
+ * @param output image of `layout.width * layout.height` pixels in the output format
+ * @param format the pixel format to convert the frame into
+ * @ingroup colorspace
+ */
+cudaError_t cudaVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat format );
+
+
+#endif
+
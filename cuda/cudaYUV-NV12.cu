@@ -271,8 +271,9 @@ cudaError_t cudaNV12ToRGBA( uint8_t* srcDev, uchar4* destDev, size_t width, size
 
 //-------------------------------------------------------------------------------------------------------------------------
 
+template<typename T>
 __global__ void NV12ToRGBAf(uint32_t* srcImage,  size_t nSourcePitch,
-                           float4* dstImage,     size_t nDestPitch,
+                           T* dstImage,          size_t nDestPitch,
                            uint32_t width,       uint32_t height)
 {
     int x, y;
@@ -351,20 +352,21 @@ __global__ void NV12ToRGBAf(uint32_t* srcImage,  size_t nSourcePitch,
 
 	const float s = 1.0f / 1024.0f * 255.0f;
 
-	dstImage[y * width + x]     = make_float4(red[0] * s, green[0] * s, blue[0] * s, 1.0f);
-	dstImage[y * width + x + 1] = make_float4(red[1] * s, green[1] * s, blue[1] * s, 1.0f);
+	dstImage[y * width + x]     = make_rgba<T>(red[0] * s, green[0] * s, blue[0] * s, 1.0f);
+	dstImage[y * width + x + 1] = make_rgba<T>(red[1] * s, green[1] * s, blue[1] * s, 1.0f);
 #else
 	//printf("cuda thread %i %i  %i %i \n", x, y, width, height);
 		
-	dstImage[y * width + x]     = make_float4(1.0f, 0.0f, 0.0f, 1.0f);
-	dstImage[y * width + x + 1] = make_float4(1.0f, 0.0f, 0.0f, 1.0f);
+	dstImage[y * width + x]     = make_rgba<T>(1.0f, 0.0f, 0.0f, 1.0f);
+	dstImage[y * width + x + 1] = make_rgba<T>(1.0f, 0.0f, 0.0f, 1.0f);
 #endif
 }
 
 
 
-// cudaNV12ToRGBA
-cudaError_t cudaNV12ToRGBA32( uint8_t* srcDev, size_t srcPitch, float4* destDev, size_t destPitch, size_t width, size_t height )
+// launchNV12ToRGBA
+template<typename T>
+static cudaError_t launchNV12ToRGBA( uint8_t* srcDev, size_t srcPitch, T* destDev, size_t destPitch, size_t width, size_t height )
 {
 	if( !srcDev || !destDev )
 		return cudaErrorInvalidDevicePointer;
@@ -379,16 +381,33 @@ cudaError_t cudaNV12ToRGBA32( uint8_t* srcDev, size_t srcPitch, float4* destDev,
 	//const dim3 gridDim((width+(2*blockDim.x-1))/(2*blockDim.x), (height+(blockDim.y-1))/blockDim.y, 1);
 	const dim3 gridDim(iDivUp(width,blockDim.x), iDivUp(height, blockDim.y), 1);
 
-	NV12ToRGBAf<<<gridDim, blockDim>>>( (uint32_t*)srcDev, srcPitch, destDev, destPitch, width, height );
+	NV12ToRGBAf<T><<<gridDim, blockDim>>>( (uint32_t*)srcDev, srcPitch, destDev, destPitch, width, height );
 	
 	return CUDA(cudaGetLastError());
 }
 
+// cudaNV12ToRGBA32
+cudaError_t cudaNV12ToRGBA32( uint8_t* srcDev, size_t srcPitch, float4* destDev, size_t destPitch, size_t width, size_t height )
+{
+	return launchNV12ToRGBA(srcDev, srcPitch, destDev, destPitch, width, height);
+}
+
 cudaError_t cudaNV12ToRGBA32( uint8_t* srcDev, float4* destDev, size_t width, size_t height )
 {
 	return cudaNV12ToRGBA32(srcDev, width * sizeof(uint8_t), destDev, width * sizeof(float4), width, height);
 }
 
+// cudaNV12ToRGBA16
+cudaError_t cudaNV12ToRGBA16( uint8_t* srcDev, size_t srcPitch, half4* destDev, size_t destPitch, size_t width, size_t height )
+{
+	return launchNV12ToRGBA(srcDev, srcPitch, destDev, destPitch, width, height);
+}
+
+cudaError_t cudaNV12ToRGBA16( uint8_t* srcDev, half4* destDev, size_t width, size_t height )
+{
+	return cudaNV12ToRGBA16(srcDev, width * sizeof(uint8_t), destDev, width * sizeof(half4), width, height);
+}
+
 
 // cudaNV12SetupColorspace
 cudaError_t cudaNV12SetupColorspace( float hue )
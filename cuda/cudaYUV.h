@@ -25,6 +25,7 @@
 
 
 #include "cudaUtility.h"
+#include "cudaFP16.h"
 
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -164,6 +165,20 @@ cudaError_t cudaNV12ToRGBA32( uint8_t* input, float4* output, size_t width, size
  */
 cudaError_t cudaNV12ToRGBA32( uint8_t* input, size_t inputPitch, float4* output, size_t outputPitch, size_t width, size_t height );
 
+/**
+ * Convert an NV12 texture (semi-planar 4:2:0) to RGBA half4 format.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+cudaError_t cudaNV12ToRGBA16( uint8_t* input, half4* output, size_t width, size_t height );
+
+/**
+ * Convert an NV12 texture (semi-planar 4:2:0) to RGBA half4 format.
+ * NV12 = 8-bit Y plane followed by an interleaved U/V plane with 2x2 subsampling.
+ * @ingroup colorspace
+ */
+cudaError_t cudaNV12ToRGBA16( uint8_t* input, size_t inputPitch, half4* output, size_t outputPitch, size_t width, size_t height );
+
 /**
  * Setup NV12 color conversion constants.
  * cudaNV12SetupColorspace() isn't necessary for the user to call, it will be
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaColormap.h"
+#include "cudaFilterMode.cuh"
+
+#include "cudaHostKernel.h"
+
+
+// launchColormapPalette
+template<cudaFilterMode filter>
+static void launchColormapPalette( float4* palette, float* input, int input_width, int input_height,
+						     float4* output, int output_width, int output_height, 
+						     float multiplier, float min_value )
+{
+	cudaHostLaunch(output_width, output_height, [=]( int x, int y )
+	{
+		const float pixel = cudaFilterPixel<filter>(input, x, y, input_width, input_height, output_width, output_height);
+		const float value = fmaxf(fminf((pixel - min_value) * multiplier, 255.0f), 0.0f);
+
+		output[y * output_width + x] = palette[(int)value];
+	});
+}
+
+
+// launchColormapFlow
+template<cudaFilterMode filter, cudaDataFormat format>
+static void launchColormapFlow( float2* input, int input_width, int input_height,
+						  float4* output, int output_width, int output_height, 
+						  float max_value )
+{
+	cudaHostLaunch(output_width, output_height, [=]( int x, int y )
+	{
+		const float2 pixel = cudaFilterPixel<filter, format>(input, x, y, input_width, input_height, output_width, output_height);
+		const float2 value = pixel / max_value;
+
+		const float3 color = make_float3(1.0f + value.x,
+								   1.0f - 0.5 * (value.x + value.y),
+								   1.0f + value.y) * 255.0f;
+
+		output[y * output_width + x] = make_float4(clamp(color, 0.0f, 255.0f), 255.0f);
+	});
+}
+
+
+// launchColormapNone
+template<cudaFilterMode filter, cudaDataFormat format, typename T>
+static void launchColormapNone( T* input, int input_width, int input_height,
+						  T* output, int output_width, int output_height )
+{
+	cudaHostLaunch(output_width, output_height, [=]( int x, int y )
+	{
+		output[y * output_width + x] = cudaFilterPixel<filter, format>(input, x, y, input_width, input_height, output_width, output_height);
+	});
+}
+
+
+// cudaColormap
+cudaError_t cudaColormap( float* input, size_t input_width, size_t input_height,
+					 float* output, size_t output_width, size_t output_height,
+					 const float2& input_range, cudaColormapType colormap, 
+					 cudaFilterMode filter, cudaDataFormat format, cudaStream_t stream )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( input_width == 0 || output_width == 0 || input_height == 0 || output_height == 0 )
+		return cudaErrorInvalidValue;
+
+	if( colormap > COLORMAP_NONE )
+		return cudaErrorNotYetImplemented;
+
+	if( input_width == output_width && input_height == output_height )
+		filter = FILTER_POINT;
+	else if( filter == FILTER_AREA )
+		filter = FILTER_LINEAR;	// the colormaps don't implement area averaging
+
+	// palettized colormaps
+	if( colormap <= COLORMAP_VIRIDIS )
+	{
+		// get the pointer to the colormap
+		float4* palette = cudaColormapPalette(colormap);
+
+		if( !palette )
+			return cudaErrorMemoryAllocation;
+	 
+		// calculate the multiplier to map from input_range -> [0,255]
+		const float multiplier = 255.0f / (input_range.y - input_range.x);
+
+		#define colormapKernel(filterMode) launchColormapPalette<filterMode>( \
+										palette, input, input_width, input_height, \
+										(float4*)output, output_width, output_height, \
+										multiplier, input_range.x);
+
+		if( filter == FILTER_POINT )
+			colormapKernel(FILTER_POINT)
+		else if( filter == FILTER_LINEAR )
+			colormapKernel(FILTER_LINEAR)
+	}
+	else if( colormap == COLORMAP_FLOW ) // parametric flow field
+	{
+		// get the maximum absolute value
+		const float max_value = fmaxf(fabs(input_range.x), fabs(input_range.y));
+
+		#define flowKernel(filterMode, layout) launchColormapFlow<filterMode, layout>( \
+										 (float2*)input, input_width, input_height, \
+										 (float4*)output, output_width, output_height, \
+										 max_value);
+
+		if( filter == FILTER_POINT )
+		{
+			if( format == FORMAT_CHW )
+				flowKernel(FILTER_POINT, FORMAT_CHW)
+			else if( format == FORMAT_HWC )
+				flowKernel(FILTER_POINT, FORMAT_HWC)
+		}
+		else if( filter == FILTER_LINEAR )
+		{
+			if( format == FORMAT_CHW )
+				flowKernel(FILTER_LINEAR, FORMAT_CHW)
+			else if( format == FORMAT_HWC )
+				flowKernel(FILTER_LINEAR, FORMAT_HWC)
+		}
+	}
+	else if( colormap == COLORMAP_NONE )
+	{
+		#define noneKernel(filterMode, layout) launchColormapNone<filterMode, layout>( \
+										 input, input_width, input_height, \
+										 output, output_width, output_height);
+
+		if( filter == FILTER_POINT )
+		{
+			if( format == FORMAT_CHW )
+				noneKernel(FILTER_POINT, FORMAT_CHW)
+			else if( format == FORMAT_HWC )
+				noneKernel(FILTER_POINT, FORMAT_HWC)
+		}
+		else if( filter == FILTER_LINEAR )
+		{
+			if( format == FORMAT_CHW )
+				noneKernel(FILTER_LINEAR, FORMAT_CHW)
+			else if( format == FORMAT_HWC )
+				noneKernel(FILTER_LINEAR, FORMAT_HWC)
+		}
+	}
+
+	return cudaSuccess;
+}
+
+
+// cudaColormap
+cudaError_t cudaColormap( float* input, float* output, size_t width, size_t height,
+					 const float2& input_range, cudaColormapType colormap,
+					 cudaDataFormat format, cudaStream_t stream)
+{
+	return cudaColormap(input, width, height, output, width, height,
+					input_range, colormap, FILTER_POINT, format, stream);
+}
+
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaCrop.h"
+
+#include "cudaHostKernel.h"
+
+
+// launchCrop
+template <typename T>
+static cudaError_t launchCrop( T* input, T* output, const int4& roi, 
+					      size_t inputWidth, size_t inputHeight )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( inputWidth == 0 || inputHeight == 0 )
+		return cudaErrorInvalidValue;
+
+	// get the ROI/output dimensions
+	const int outputWidth = roi.z - roi.x;
+	const int outputHeight = roi.w - roi.y;
+
+	// validate the requested ROI
+	if( outputWidth <= 0 || outputHeight <= 0 )
+		return cudaErrorInvalidValue;
+
+	if( outputWidth > inputWidth || outputHeight > inputHeight )
+		return cudaErrorInvalidValue;
+
+	if( roi.x < 0 || roi.y < 0 || roi.z < 0 || roi.w < 0 )
+		return cudaErrorInvalidValue;
+
+	// the rows of the ROI are contiguous, so they're copied whole
+	for( int y=0; y < outputHeight; y++ )
+		memcpy(output + y * outputWidth, input + (y + roi.y) * inputWidth + roi.x, outputWidth * sizeof(T));
+
+	return cudaSuccess;
+}
+
+
+// cudaCrop
+cudaError_t cudaCrop( float* input, float* output, const int4& roi, 
+				  size_t inputWidth, size_t inputHeight )
+{
+	return launchCrop(input, output, roi, inputWidth, inputHeight);
+}
+
+
+// cudaCropRGBA
+cudaError_t cudaCropRGBA( float4* input, float4* output, const int4& roi, 
+					 size_t inputWidth, size_t inputHeight )
+{
+	return launchCrop(input, output, roi, inputWidth, inputHeight);
+}
+
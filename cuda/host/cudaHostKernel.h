@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CUDA_HOST_KERNEL_H__
+#define __CUDA_HOST_KERNEL_H__
+
+
+#include "cudaUtility.h"
+#include "cpuConvert.h"
+
+
+/*
+ * Helpers for the host implementations of the cuda* image functions in the
+ * host-only build.  A "host kernel" is a functor that's called as kernel(x, y)
+ * for every pixel of the grid, so the bodies of the CUDA kernels carry over
+ * unchanged, and the rows are split across threads with cpuParallelRows().
+ */
+
+
+// grid of pixels that a host kernel is run over
+template<typename Kernel>
+struct cudaHostGrid
+{
+	const Kernel* kernel;
+	size_t width;
+};
+
+// cudaHostRows
+template<typename Kernel>
+static void cudaHostRows( size_t rowBegin, size_t rowEnd, void* user_data )
+{
+	const cudaHostGrid<Kernel>* grid = (const cudaHostGrid<Kernel>*)user_data;
+
+	for( size_t y=rowBegin; y < rowEnd; y++ )
+		for( size_t x=0; x < grid->width; x++ )
+			(*grid->kernel)(x, y);
+}
+
+// cudaHostLaunch
+template<typename Kernel>
+inline void cudaHostLaunch( size_t width, size_t height, const Kernel& kernel )
+{
+	cudaHostGrid<Kernel> grid = { &kernel, width };
+	cpuParallelRows(height, 1, cudaHostRows<Kernel>, &grid);
+}
+
+// cudaHostResult (the cpu* functions validate their arguments and return false on error)
+inline cudaError_t cudaHostResult( bool result )
+{
+	return result ? cudaSuccess : cudaErrorInvalidValue;
+}
+
+
+#endif
+
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaNormalize.h"
+
+#include "cudaHostKernel.h"
+
+
+// launchNormalize
+template <typename T>
+static cudaError_t launchNormalize( T* input, const float2& input_range,
+						  T* output, const float2& output_range,
+						  size_t  width,  size_t height )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( width == 0 || height == 0  )
+		return cudaErrorInvalidValue;
+
+	const float multiplier = output_range.y / input_range.y;
+
+	cudaHostLaunch(width, height, [=]( int x, int y )
+	{
+		const float4 px = load_rgba(input[y * width + x]);
+
+		output[y * width + x] = make_rgba<T>(px.x * multiplier,
+									  px.y * multiplier,
+									  px.z * multiplier,
+									  px.w * multiplier);
+	});
+
+	return cudaSuccess;
+}
+
+
+// cudaNormalizeRGBA
+cudaError_t cudaNormalizeRGBA( float4* input, const float2& input_range,
+						 float4* output, const float2& output_range,
+						 size_t  width,  size_t height )
+{
+	return launchNormalize(input, input_range, output, output_range, width, height);
+}
+
+
+// cudaNormalizeRGBA
+cudaError_t cudaNormalizeRGBA( half4* input, const float2& input_range,
+						 half4* output, const float2& output_range,
+						 size_t  width,  size_t height )
+{
+	return launchNormalize(input, input_range, output, output_range, width, height);
+}
+
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaOverlay.h"
+
+#include "cudaHostKernel.h"
+
+
+// cudaRectFill
+cudaError_t cudaRectFill( float4* input, float4* output, uint32_t width, uint32_t height, float4* rects, int numRects, const float4& color )
+{
+	if( !input || !output || width == 0 || height == 0 || !rects || numRects == 0 )
+		return cudaErrorInvalidValue;
+
+	const float alpha = color.w / 255.0f;
+	const float ialph = 1.0f - alpha;
+
+	cudaHostLaunch(width, height, [=]( int x, int y )
+	{
+		float4 px_out = input[y * width + x];
+
+		const float fx = x;
+		const float fy = y;
+
+		for( int nr=0; nr < numRects; nr++ )
+		{
+			const float4 r = rects[nr];
+
+			if( fy >= r.y && fy <= r.w && fx >= r.x && fx <= r.z )
+			{
+				px_out.x = alpha * color.x + ialph * px_out.x;
+				px_out.y = alpha * color.y + ialph * px_out.y;
+				px_out.z = alpha * color.z + ialph * px_out.z;
+			}
+		}
+
+		output[y * width + x] = px_out;
+	});
+
+	return cudaSuccess;
+}
+
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaRGB.h"
+#include "cpuRGB.h"
+
+#include "cudaHostKernel.h"
+
+
+// cudaRGB8ToRGBA32
+cudaError_t cudaRGB8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGB8ToRGBA32(input, output, width, height));
+}
+
+// cudaBGR8ToRGBA32
+cudaError_t cudaBGR8ToRGBA32( uchar3* input, float4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuBGR8ToRGBA32(input, output, width, height));
+}
+
+// cudaRGBA32ToRGB8
+cudaError_t cudaRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA32ToRGB8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA32ToRGB8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA32ToRGB8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA32ToRGBA8
+cudaError_t cudaRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA32ToRGBA8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA32ToRGBA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA32ToRGBA8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA32ToBGR8
+cudaError_t cudaRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA32ToBGR8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA32ToBGR8( float4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA32ToBGR8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA32ToBGRA8
+cudaError_t cudaRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA32ToBGRA8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA32ToBGRA8( float4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA32ToBGRA8(input, output, width, height, inputRange));
+}
+
+// cudaRGB8ToRGBA16
+cudaError_t cudaRGB8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGB8ToRGBA16(input, output, width, height));
+}
+
+// cudaBGR8ToRGBA16
+cudaError_t cudaBGR8ToRGBA16( uchar3* input, half4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuBGR8ToRGBA16(input, output, width, height));
+}
+
+// cudaRGBA16ToRGB8
+cudaError_t cudaRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA16ToRGB8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA16ToRGB8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA16ToRGB8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA16ToRGBA8
+cudaError_t cudaRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA16ToRGBA8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA16ToRGBA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA16ToRGBA8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA16ToBGR8
+cudaError_t cudaRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA16ToBGR8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA16ToBGR8( half4* input, uchar3* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA16ToBGR8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA16ToBGRA8
+cudaError_t cudaRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA16ToBGRA8(input, output, width, height));
+}
+
+cudaError_t cudaRGBA16ToBGRA8( half4* input, uchar4* output, size_t width, size_t height, const float2& inputRange )
+{
+	return cudaHostResult(cpuRGBA16ToBGRA8(input, output, width, height, inputRange));
+}
+
+// cudaRGBA32ToRGBA16
+cudaError_t cudaRGBA32ToRGBA16( float4* input, half4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA32ToRGBA16(input, output, width, height));
+}
+
+// cudaRGBA16ToRGBA32
+cudaError_t cudaRGBA16ToRGBA32( half4* input, float4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBA16ToRGBA32(input, output, width, height));
+}
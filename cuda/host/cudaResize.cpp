@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaResize.h"
+#include "cpuResize.h"
+
+#include "cudaHostKernel.h"
+
+
+// cudaResize
+cudaError_t cudaResize( float* input, size_t inputWidth, size_t inputHeight,
+				    float* output, size_t outputWidth, size_t outputHeight, cudaFilterMode filter )
+{
+	return cudaHostResult(cpuResize(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter));
+}
+
+cudaError_t cudaResize( float4* input, size_t inputWidth, size_t inputHeight,
+				    float4* output, size_t outputWidth, size_t outputHeight, cudaFilterMode filter )
+{
+	return cudaHostResult(cpuResize(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter));
+}
+
+cudaError_t cudaResize( uchar3* input, size_t inputWidth, size_t inputHeight,
+				    uchar3* output, size_t outputWidth, size_t outputHeight, cudaFilterMode filter )
+{
+	return cudaHostResult(cpuResize(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter));
+}
+
+cudaError_t cudaResize( uchar4* input, size_t inputWidth, size_t inputHeight,
+				    uchar4* output, size_t outputWidth, size_t outputHeight, cudaFilterMode filter )
+{
+	return cudaHostResult(cpuResize(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter));
+}
+
+// cudaResizeRGBA
+cudaError_t cudaResizeRGBA( float4* input, size_t inputWidth, size_t inputHeight,
+				        float4* output, size_t outputWidth, size_t outputHeight, cudaFilterMode filter )
+{
+	return cudaHostResult(cpuResizeRGBA(input, inputWidth, inputHeight, output, outputWidth, outputHeight, filter));
+}
+
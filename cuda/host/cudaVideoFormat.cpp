@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaVideoFormat.h"
+#include "cpuVideoFormat.h"
+
+#include "cudaHostKernel.h"
+
+
+// cudaVideoConvert
+cudaError_t cudaVideoConvert( void* input, const cudaVideoLayout& layout, void* output, cudaOutputFormat format )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	return cudaHostResult(cpuVideoConvert(input, layout, output, format));
+}
+
+// cudaVideoToRGBA32
+cudaError_t cudaVideoToRGBA32( void* input, const cudaVideoLayout& layout, float4* output )
+{
+	return cudaVideoConvert(input, layout, output, CUDA_OUTPUT_RGBA32);
+}
+
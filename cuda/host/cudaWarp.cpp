@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaWarp.h"
+#include "mat33.h"
+
+#include "cudaHostKernel.h"
+
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------------
+// perspective & affine
+//-----------------------------------------------------------------------------------
+
+// setup the transformation for the host kernel
+inline static void invertTransform( float3 mat[3], const float transform[3][3], bool transform_inverted )
+{
+	// invert the matrix if it isn't already
+	if( !transform_inverted )
+	{
+		float inv[3][3];
+
+		mat33_inverse(inv, transform);
+
+		for( uint32_t i=0; i < 3; i++ )
+			mat[i] = make_float3(inv[i][0], inv[i][1], inv[i][2]);
+	}
+	else
+	{
+		for( uint32_t i=0; i < 3; i++ )
+			mat[i] = make_float3(transform[i][0], transform[i][1], transform[i][2]);
+	}
+}
+
+// launchPerspectiveWarp
+template<typename T>
+static cudaError_t launchPerspectiveWarp( T* input, T* output, uint32_t width, uint32_t height,
+								  const float transform[3][3], bool transform_inverted )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( width == 0 || height == 0 )
+		return cudaErrorInvalidValue;
+
+	// setup the transform
+	float3 mat[3];
+	invertTransform(mat, transform, transform_inverted);
+
+	const float3 m0 = mat[0];
+	const float3 m1 = mat[1];
+
+	cudaHostLaunch(width, height, [=]( int x, int y )
+	{
+		const int u = m0.x * x + m0.y * y + m0.z;
+		const int v = m1.x * x + m1.y * y + m1.z;
+
+		T px;
+
+		px.x = 0; px.y = 255;
+		px.z = 0; px.w = 255;
+
+		if( u < (int)width && v < (int)height && u >= 0 && v >= 0 )
+			px = input[v * width + u];
+
+		output[y * width + x] = px;
+	});
+
+	return cudaSuccess;
+}
+
+// cudaWarpPerspective
+cudaError_t cudaWarpPerspective( uchar4* input, uchar4* output, uint32_t width, uint32_t height,
+						   const float transform[3][3], bool transform_inverted )
+{
+	return launchPerspectiveWarp(input, output, width, height, transform, transform_inverted);
+}
+
+// cudaWarpPerspective
+cudaError_t cudaWarpPerspective( float4* input, float4* output, uint32_t width, uint32_t height,
+						   const float transform[3][3], bool transform_inverted )
+{
+	return launchPerspectiveWarp(input, output, width, height, transform, transform_inverted);
+}
+
+// convert the affine transform to 3x3
+inline static void affineTransform( float psp_transform[3][3], const float transform[2][3] )
+{
+	for( uint32_t i=0; i < 2; i++ )
+		for( uint32_t j=0; j < 3; j++ )
+			psp_transform[i][j] = transform[i][j];
+
+	psp_transform[2][0] = 0;
+	psp_transform[2][1] = 0;
+	psp_transform[2][2] = 1;
+}
+
+// cudaWarpAffine
+cudaError_t cudaWarpAffine( float4* input, float4* output, uint32_t width, uint32_t height,
+					   const float transform[2][3], bool transform_inverted )
+{
+	float psp_transform[3][3];
+	affineTransform(psp_transform, transform);
+
+	return CUDA(cudaWarpPerspective(input, output, width, height, psp_transform, transform_inverted));
+}
+
+// cudaWarpAffine
+cudaError_t cudaWarpAffine( uchar4* input, uchar4* output, uint32_t width, uint32_t height,
+					   const float transform[2][3], bool transform_inverted )
+{
+	float psp_transform[3][3];
+	affineTransform(psp_transform, transform);
+
+	return CUDA(cudaWarpPerspective(input, output, width, height, psp_transform, transform_inverted));
+}
+
+
+//-----------------------------------------------------------------------------------
+// fisheye
+//-----------------------------------------------------------------------------------
+
+// launchFisheye
+template<typename T>
+static cudaError_t launchFisheye( T* input, T* output, uint32_t width, uint32_t height, float focus )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( width == 0 || height == 0 )
+		return cudaErrorInvalidValue;
+
+	const float fWidth  = width;
+	const float fHeight = height;
+
+	cudaHostLaunch(width, height, [=]( int x, int y )
+	{
+		// convert to cartesian coordinates
+		const float cx = ((x / fWidth) - 0.5f)  * 2.0f;	
+		const float cy = (0.5f - (y / fHeight)) * 2.0f;
+
+		const float theta = atan2f(cy, cx);
+		const float r     = atanf(sqrtf(cx*cx+cy*cy) * focus);
+
+		const float tx = r * cosf(theta);
+		const float ty = r * sinf(theta);
+
+		// convert back out of cartesian coordinates
+		float u = (tx * 0.5f + 0.5f) * fWidth;
+		float v = (0.5f - (ty * 0.5f)) * fHeight;
+
+		if( u < 0.0f ) u = 0.0f;
+		if( v < 0.0f ) v = 0.0f;
+
+		if( u > fWidth  - 1.0f ) u = fWidth - 1.0f;
+		if( v > fHeight - 1.0f ) v = fHeight - 1.0f;
+
+		output[y * width + x] = input[(int)v * width + (int)u];
+	});
+
+	return cudaSuccess;
+}
+
+// cudaWarpFisheye
+cudaError_t cudaWarpFisheye( uchar4* input, uchar4* output, uint32_t width, uint32_t height, float focus )
+{
+	return launchFisheye(input, output, width, height, focus);
+}
+
+// cudaWarpFisheye
+cudaError_t cudaWarpFisheye( float4* input, float4* output, uint32_t width, uint32_t height, float focus )
+{
+	return launchFisheye(input, output, width, height, focus);
+}
+
+
+//-----------------------------------------------------------------------------------
+// intrinsic (lens distortion)
+//-----------------------------------------------------------------------------------
+
+// launchIntrinsicWarp
+template<typename T>
+static cudaError_t launchIntrinsicWarp( T* input, T* output, uint32_t width, uint32_t height,
+								const float2& focalLength, const float2& principalPoint, const float4& distortion )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( width == 0 || height == 0 )
+		return cudaErrorInvalidValue;
+
+	const float2 f  = focalLength;
+	const float2 c  = principalPoint;
+
+	const float k1 = distortion.x;
+	const float k2 = distortion.y;
+	const float p1 = distortion.z;
+	const float p2 = distortion.w;
+
+	cudaHostLaunch(width, height, [=]( int x_out, int y_out )
+	{
+		const float u = x_out;
+		const float v = y_out;
+
+		const float _fx = 1.0f / f.x;
+		const float _fy = 1.0f / f.y;
+
+		const float y      = (v - c.y)*_fy;
+		const float y2     = y*y;
+		const float _2p1y  = 2.0*p1*y;
+		const float _3p1y2 = 3.0*p1*y2;
+		const float p2y2   = p2*y2;
+
+		const float x  = (u - c.x)*_fx;
+		const float x2 = x*x;
+		const float r2 = x2 + y2;
+		const float d  = 1.0 + (k1 + k2*r2)*r2;
+		const float _u = f.x*(x*(d + _2p1y) + p2y2 + (3.0*p2)*x2) + c.x;
+		const float _v = f.y*(y*(d + (2.0*p2)*x) + _3p1y2 + p1*x2) + c.y;
+
+		const int x_in = _u;
+		const int y_in = _v;
+
+		// like the kernel, output pixels that map outside the image are left as-is
+		if( x_in >= (int)width || y_in >= (int)height || x_in < 0 || y_in < 0 )
+			return;
+
+		output[y_out * width + x_out] = input[y_in * width + x_in];
+	});
+
+	return cudaSuccess;
+}
+
+// cudaWarpIntrinsic
+cudaError_t cudaWarpIntrinsic( uchar4* input, uchar4* output, uint32_t width, uint32_t height,
+						 const float2& focalLength, const float2& principalPoint, const float4& distortion )
+{
+	return launchIntrinsicWarp(input, output, width, height, focalLength, principalPoint, distortion);
+}
+
+// cudaWarpIntrinsic
+cudaError_t cudaWarpIntrinsic( float4* input, float4* output, uint32_t width, uint32_t height,
+						 const float2& focalLength, const float2& principalPoint, const float4& distortion )
+{
+	return launchIntrinsicWarp(input, output, width, height, focalLength, principalPoint, distortion);
+}
+
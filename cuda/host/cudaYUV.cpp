@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "cudaYUV.h"
+#include "cpuYUV.h"
+#include "cpuRGB.h"
+
+#include "cudaHostKernel.h"
+
+
+//-----------------------------------------------------------------------------------
+// RGBA to YUV 4:2:0 planar (I420 & YV12)
+//-----------------------------------------------------------------------------------
+
+// cudaRGBAToI420
+cudaError_t cudaRGBAToI420( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBAToI420(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaRGBAToI420( uchar4* input, uint8_t* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBAToI420(input, output, width, height));
+}
+
+// cudaRGBAToYV12
+cudaError_t cudaRGBAToYV12( uchar4* input, size_t inputPitch, uint8_t* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBAToYV12(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaRGBAToYV12( uchar4* input, uint8_t* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuRGBAToYV12(input, output, width, height));
+}
+
+
+//-----------------------------------------------------------------------------------
+// YUV 4:2:2 packed (UYVY & YUYV)
+//-----------------------------------------------------------------------------------
+
+// cudaUYVYToRGBA
+cudaError_t cudaUYVYToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuUYVYToRGBA(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaUYVYToRGBA( uchar2* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuUYVYToRGBA(input, output, width, height));
+}
+
+// cudaYUYVToRGBA
+cudaError_t cudaYUYVToRGBA( uchar2* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuYUYVToRGBA(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaYUYVToRGBA( uchar2* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuYUYVToRGBA(input, output, width, height));
+}
+
+// cudaUYVYToGray
+cudaError_t cudaUYVYToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuUYVYToGray(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaUYVYToGray( uchar2* input, float* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuUYVYToGray(input, output, width, height));
+}
+
+// cudaYUYVToGray
+cudaError_t cudaYUYVToGray( uchar2* input, size_t inputPitch, float* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuYUYVToGray(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaYUYVToGray( uchar2* input, float* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuYUYVToGray(input, output, width, height));
+}
+
+
+//-----------------------------------------------------------------------------------
+// YUV NV12
+//-----------------------------------------------------------------------------------
+
+// cudaNV12ToRGBA
+cudaError_t cudaNV12ToRGBA( uint8_t* input, size_t inputPitch, uchar4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuNV12ToRGBA(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaNV12ToRGBA( uint8_t* input, uchar4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuNV12ToRGBA(input, output, width, height));
+}
+
+// cudaNV12ToRGBA32
+cudaError_t cudaNV12ToRGBA32( uint8_t* input, size_t inputPitch, float4* output, size_t outputPitch, size_t width, size_t height )
+{
+	return cudaHostResult(cpuNV12ToRGBA32(input, inputPitch, output, outputPitch, width, height));
+}
+
+cudaError_t cudaNV12ToRGBA32( uint8_t* input, float4* output, size_t width, size_t height )
+{
+	return cudaHostResult(cpuNV12ToRGBA32(input, output, width, height));
+}
+
+// cudaNV12ToRGBA16
+cudaError_t cudaNV12ToRGBA16( uint8_t* input, size_t inputPitch, half4* output, size_t outputPitch, size_t width, size_t height )
+{
+	if( !input || !output )
+		return cudaErrorInvalidDevicePointer;
+
+	if( inputPitch == 0 || outputPitch == 0 || width == 0 || height == 0 )
+		return cudaErrorInvalidValue;
+
+	// the chroma is interpolated between rows, so the whole frame is converted
+	// to float4 first and then packed to half (like the kernel, the output is packed)
+	float4* rgba = NULL;
+
+	if( CUDA_FAILED(cudaMalloc(&rgba, width * height * sizeof(float4))) )
+		return cudaErrorMemoryAllocation;
+
+	const bool result = cpuNV12ToRGBA32(input, inputPitch, rgba, width * sizeof(float4), width, height) &&
+					cpuRGBA32ToRGBA16(rgba, output, width, height);
+
+	cudaFree(rgba);
+	return cudaHostResult(result);
+}
+
+cudaError_t cudaNV12ToRGBA16( uint8_t* input, half4* output, size_t width, size_t height )
+{
+	return cudaNV12ToRGBA16(input, width * sizeof(uint8_t), output, width * sizeof(half4), width, height);
+}
+
+// cudaNV12SetupColorspace (the kernels don't apply the hue matrix either, so there's nothing to setup)
+cudaError_t cudaNV12SetupColorspace( float hue )
+{
+	return cudaSuccess;
+}
+
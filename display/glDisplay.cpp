@@ -436,7 +436,7 @@ void glDisplay::EndRender()
 
 
 // allocTexture
-glTexture* glDisplay::allocTexture( uint32_t width, uint32_t height )
+glTexture* glDisplay::allocTexture( uint32_t width, uint32_t height, uint32_t format )
 {
 	if( width == 0 || height == 0 )
 		return NULL;
@@ -447,11 +447,11 @@ glTexture* glDisplay::allocTexture( uint32_t width, uint32_t height )
 	{
 		glTexture* tex = mTextures[n];
 
-		if( tex->GetWidth() == width && tex->GetHeight() == height )
+		if( tex->GetWidth() == width && tex->GetHeight() == height && tex->GetFormat() == format )
 			return tex;
 	}
 
-	glTexture* tex = glTexture::Create(width, height, GL_RGBA32F_ARB);
+	glTexture* tex = glTexture::Create(width, height, format);
 
 	if( !tex )
 	{
@@ -476,12 +476,26 @@ void glDisplay::Render( glTexture* texture, float x, float y )
 
 // Render
 void glDisplay::Render( float* img, uint32_t width, uint32_t height, float x, float y, bool normalize )
+{
+	renderImage(img, width, height, GL_RGBA32F_ARB, x, y, normalize);
+}
+
+
+// Render
+void glDisplay::Render( half4* img, uint32_t width, uint32_t height, float x, float y, bool normalize )
+{
+	renderImage(img, width, height, GL_RGBA16F_ARB, x, y, normalize);
+}
+
+
+// renderImage
+void glDisplay::renderImage( void* img, uint32_t width, uint32_t height, uint32_t format, float x, float y, bool normalize )
 {
 	if( !img || width == 0 || height == 0 )
 		return;
 	
 	// obtain the OpenGL texture to use
-	glTexture* interopTex = allocTexture(width, height);
+	glTexture* interopTex = allocTexture(width, height, format);
 
 	if( !interopTex )
 		return;
@@ -508,9 +522,19 @@ void glDisplay::Render( float* img, uint32_t width, uint32_t height, float x, fl
 		}
 
 		// rescale image pixel intensities for display
-		CUDA(cudaNormalizeRGBA((float4*)img, make_float2(0.0f, 255.0f), 
-						   (float4*)mNormalizedCUDA, make_float2(0.0f, 1.0f), 
- 						   width, height));
+		// (the buffer is sized for float4, so it fits half4 images too)
+		if( format == GL_RGBA16F_ARB )
+		{
+			CUDA(cudaNormalizeRGBA((half4*)img, make_float2(0.0f, 255.0f), 
+							   (half4*)mNormalizedCUDA, make_float2(0.0f, 1.0f), 
+ 							   width, height));
+		}
+		else
+		{
+			CUDA(cudaNormalizeRGBA((float4*)img, make_float2(0.0f, 255.0f), 
+							   (float4*)mNormalizedCUDA, make_float2(0.0f, 1.0f), 
+ 							   width, height));
+		}
 	}
 
 	// map from CUDA to openGL using GL interop
@@ -537,6 +561,15 @@ void glDisplay::RenderOnce( float* img, uint32_t width, uint32_t height, float x
 }
 
 
+// RenderOnce
+void glDisplay::RenderOnce( half4* img, uint32_t width, uint32_t height, float x, float y, bool normalize )
+{
+	BeginRender();
+	Render(img, width, height, x, y, normalize);
+	EndRender();
+}
+
+
 // RenderLine
 void glDisplay::RenderLine( float x1, float y1, float x2, float y2, float r, float g, float b, float a, float thickness )
 {
@@ -27,6 +27,7 @@
 #include "glTexture.h"
 #include "glEvents.h"
 #include "glWidget.h"
+#include "cudaFP16.h"
 
 #include <time.h>
 #include <vector>
@@ -83,6 +84,13 @@ public:
 	 */
 	void Render( float* image, uint32_t width, uint32_t height, float x=0.0f, float y=30.0f, bool normalize=true );
 
+	/**
+	 * Render a CUDA half4 image using OpenGL interop
+	 * This is the same as the float4 version of Render(), except that the image is displayed
+	 * from a half-precision texture, so it takes half of the memory bandwidth to upload.
+	 */
+	void Render( half4* image, uint32_t width, uint32_t height, float x=0.0f, float y=30.0f, bool normalize=true );
+
 	/**
 	 * Begin the frame, render one CUDA float4 image using OpenGL interop, and end the frame.
 	 * Note that this function is only useful if you are rendering a single texture per frame.
@@ -92,6 +100,12 @@ public:
 	 */
 	void RenderOnce( float* image, uint32_t width, uint32_t height, float x=5.0f, float y=30.0f, bool normalize=true );
 
+	/**
+	 * Begin the frame, render one CUDA half4 image using OpenGL interop, and end the frame.
+	 * @see the float4 version of RenderOnce()
+	 */
+	void RenderOnce( half4* image, uint32_t width, uint32_t height, float x=5.0f, float y=30.0f, bool normalize=true );
+
 	/**
 	 * Render a line in screen coordinates with the specified color
 	 * @note the RGBA color values are expected to be in the range of [0-1]
@@ -439,7 +453,8 @@ protected:
 	bool initWindow( int width, int height );
 	bool initGL();
 
-	glTexture* allocTexture( uint32_t width, uint32_t height );	
+	glTexture* allocTexture( uint32_t width, uint32_t height, uint32_t format=GL_RGBA32F_ARB );	
+	void renderImage( void* image, uint32_t width, uint32_t height, uint32_t format, float x, float y, bool normalize );
 
 	void activateViewport();
 
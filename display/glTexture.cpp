@@ -131,7 +131,7 @@ inline uint32_t glTextureType( uint32_t format )
 		case GL_LUMINANCE16F_ARB:
 		case GL_LUMINANCE_ALPHA16F_ARB:
 		case GL_RGB16F_ARB:
-		case GL_RGBA16F_ARB:			return GL_FLOAT;
+		case GL_RGBA16F_ARB:			return GL_HALF_FLOAT;
 
 		case GL_LUMINANCE32F_ARB:
 		case GL_LUMINANCE_ALPHA32F_ARB:
@@ -154,7 +154,8 @@ inline uint glTextureTypeSize( uint32_t format )
 		case GL_BYTE:					return 1;
 
 		case GL_UNSIGNED_SHORT:
-		case GL_SHORT:					return 2;
+		case GL_SHORT:
+		case GL_HALF_FLOAT:				return 2;
 
 		case GL_UNSIGNED_INT:
 		case GL_INT:
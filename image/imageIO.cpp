@@ -23,6 +23,7 @@
 #include "imageIO.h"
 #include "cudaMappedMemory.h"
 #include "filesystem.h"
+#include "cpuRGB.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
@@ -36,64 +37,16 @@
 #define LOG_IMAGE "[image] "
 
 
-// limit_pixel
-static inline unsigned char limit_pixel( float pixel, float max_pixel )
+// saveImageIO (internal)
+static bool saveImageIO( const char* filename, unsigned char* img, float* hdr, int width, int height, int quality )
 {
-	if( pixel < 0 )
-		pixel = 0;
-
-	if( pixel > max_pixel )
-		pixel = max_pixel;
-
-	return (unsigned char)pixel;
-}
-
+	const size_t stride = width * sizeof(unsigned char) * 4;
 
-// saveImageRGBA
-bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, float max_pixel, int quality )
-{
-	// validate parameters
-	if( !filename || !cpu || width <= 0 || height <= 0 )
-	{
-		printf(LOG_IMAGE "saveImageRGBA() - invalid parameter\n");
-		return false;
-	}
-	
 	if( quality < 1 )
 		quality = 1;
 
 	if( quality > 100 )
 		quality = 100;
-	
-	// allocate memory for the uint8 image
-	const size_t stride = width * sizeof(unsigned char) * 4;
-	const size_t size   = stride * height;
-	unsigned char* img  = (unsigned char*)malloc(size);
-
-	if( !img )
-	{
-		printf(LOG_IMAGE "failed to allocate %zu bytes to save %ix%i image '%s'\n", size, width, height, filename);
-		return false;
-	}
-
-	// convert image from float to uint8
-	const float scale = 255.0f / max_pixel;
-
-	for( int y=0; y < height; y++ )
-	{
-		const size_t yOffset = y * stride;
-
-		for( int x=0; x < width; x++ )
-		{
-			const size_t offset = yOffset + x * sizeof(unsigned char) * 4;
-			const float4 pixel  = cpu[y * width + x];
-
-			img[offset + 0] = limit_pixel(pixel.x * scale, max_pixel);
-			img[offset + 1] = limit_pixel(pixel.y * scale, max_pixel);
-			img[offset + 2] = limit_pixel(pixel.z * scale, max_pixel);
-			img[offset + 3] = limit_pixel(pixel.w * scale, max_pixel);
-		}
-	}
 
 	// determine the file extension
 	const std::string ext = fileExtension(filename);
@@ -102,7 +55,6 @@ bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, fl
 	if( ext.size() == 0 )
 	{
 		printf(LOG_IMAGE "invalid filename or extension, '%s'\n", filename);
-		free(img);
 		return false;
 	}
 
@@ -139,14 +91,12 @@ bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, fl
 	}
 	else if( strcasecmp(extension, "hdr") == 0 )
 	{
-		save_result = stbi_write_hdr(filename, width, height, 4, (float*)cpu);
+		save_result = stbi_write_hdr(filename, width, height, 4, hdr);
 	}
 	else
 	{
 		printf(LOG_IMAGE "invalid extension format '.%s' saving image '%s'\n", extension, filename);
 		printf(LOG_IMAGE "valid extensions are:  JPG/JPEG, PNG, TGA, BMP, and HDR.\n");
-
-		free(img);
 		return false;
 	}
 
@@ -154,12 +104,97 @@ bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, fl
 	if( !save_result )
 	{
 		printf(LOG_IMAGE "failed to save %ix%i image to '%s'\n", width, height, filename);
+		return false;
+	}
+
+	return true;
+}
+
+
+// saveImageRGBA
+bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, float max_pixel, int quality )
+{
+	// validate parameters
+	if( !filename || !cpu || width <= 0 || height <= 0 )
+	{
+		printf(LOG_IMAGE "saveImageRGBA() - invalid parameter\n");
+		return false;
+	}
+	
+	// allocate memory for the uint8 image
+	const size_t size  = width * height * sizeof(unsigned char) * 4;
+	unsigned char* img = (unsigned char*)malloc(size);
+
+	if( !img )
+	{
+		printf(LOG_IMAGE "failed to allocate %zu bytes to save %ix%i image '%s'\n", size, width, height, filename);
+		return false;
+	}
+
+	// convert image from float to uint8
+	if( !cpuRGBA32ToRGBA8(cpu, (uchar4*)img, width, height, make_float2(0.0f, max_pixel)) )
+	{
+		printf(LOG_IMAGE "failed to convert %ix%i image '%s' to uint8\n", width, height, filename);
 		free(img);
 		return false;
 	}
 
+	const bool result = saveImageIO(filename, img, (float*)cpu, width, height, quality);
+
 	free(img);
-	return true;
+	return result;
+}
+
+
+// saveImageRGBA
+bool saveImageRGBA( const char* filename, half4* cpu, int width, int height, float max_pixel, int quality )
+{
+	// validate parameters
+	if( !filename || !cpu || width <= 0 || height <= 0 )
+	{
+		printf(LOG_IMAGE "saveImageRGBA() - invalid parameter\n");
+		return false;
+	}
+	
+	// allocate memory for the uint8 image
+	const size_t size  = width * height * sizeof(unsigned char) * 4;
+	unsigned char* img = (unsigned char*)malloc(size);
+
+	if( !img )
+	{
+		printf(LOG_IMAGE "failed to allocate %zu bytes to save %ix%i image '%s'\n", size, width, height, filename);
+		return false;
+	}
+
+	// convert image from half to uint8
+	if( !cpuRGBA16ToRGBA8(cpu, (uchar4*)img, width, height, make_float2(0.0f, max_pixel)) )
+	{
+		printf(LOG_IMAGE "failed to convert %ix%i image '%s' to uint8\n", width, height, filename);
+		free(img);
+		return false;
+	}
+
+	// HDR files are written from floating-point, so only they need the image in float4
+	float4* hdr = NULL;
+
+	if( strcasecmp(fileExtension(filename).c_str(), "hdr") == 0 )
+	{
+		hdr = (float4*)malloc(width * height * sizeof(float4));
+
+		if( !hdr || !cpuRGBA16ToRGBA32(cpu, hdr, width, height) )
+		{
+			printf(LOG_IMAGE "failed to convert %ix%i image '%s' to float\n", width, height, filename);
+			free(hdr);
+			free(img);
+			return false;
+		}
+	}
+
+	const bool result = saveImageIO(filename, img, (float*)hdr, width, height, quality);
+
+	free(hdr);
+	free(img);
+	return result;
 }
 
 
@@ -249,6 +284,47 @@ static unsigned char* loadImageIO( const char* filename, int* width, int* height
 }
 
 
+// loadRowRGBA (internal)
+static void loadRowRGBA( const unsigned char* img, int imgChannels, int imgWidth, int y, const float4& mean, float4* row )
+{
+	const size_t yOffset = y * imgWidth * imgChannels * sizeof(unsigned char);
+
+	for( int x=0; x < imgWidth; x++ )
+	{
+		#define GET_PIXEL(channel)	    float(img[offset + channel])
+		#define SET_PIXEL_FLOAT4(r,g,b,a) row[x] = make_float4(r,g,b,a)
+
+		const size_t offset = yOffset + x * imgChannels * sizeof(unsigned char);
+				
+		switch(imgChannels)
+		{
+			case 1:	
+			{
+				const float grey = GET_PIXEL(0);
+				SET_PIXEL_FLOAT4(grey - mean.x, grey - mean.y, grey - mean.z, 255.0f - mean.w); 
+				break;
+			}
+			case 2:	
+			{
+				const float grey = GET_PIXEL(0);
+				SET_PIXEL_FLOAT4(grey - mean.x, grey - mean.y, grey - mean.z, GET_PIXEL(1) - mean.w);
+				break;
+			}
+			case 3:
+			{
+				SET_PIXEL_FLOAT4(GET_PIXEL(0) - mean.x, GET_PIXEL(1) - mean.y, GET_PIXEL(2) - mean.z, 255.0f - mean.w);
+				break;
+			}
+			case 4:
+			{
+				SET_PIXEL_FLOAT4(GET_PIXEL(0) - mean.x, GET_PIXEL(1) - mean.y, GET_PIXEL(2) - mean.z, GET_PIXEL(3) - mean.w);
+				break;
+			}
+		}
+	}
+}
+
+
 // loadImageRGBA
 bool loadImageRGBA( const char* filename, float4** cpu, float4** gpu, int* width, int* height, const float4& mean )
 {
@@ -273,7 +349,7 @@ bool loadImageRGBA( const char* filename, float4** cpu, float4** gpu, int* width
 	// allocate CUDA buffer for the image
 	const size_t imgSize = imgWidth * imgHeight * sizeof(float) * 4;
 
-	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize) )
+	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize, CUDA_MEMORY_IMAGE, false) )
 	{
 		printf(LOG_CUDA "failed to allocate %zu bytes for image '%s'\n", imgSize, filename);
 		return false;
@@ -284,54 +360,75 @@ bool loadImageRGBA( const char* filename, float4** cpu, float4** gpu, int* width
 	float4* cpuPtr = *cpu;
 	
 	for( int y=0; y < imgHeight; y++ )
-	{
-		const size_t yOffset = y * imgWidth * imgChannels * sizeof(unsigned char);
+		loadRowRGBA(img, imgChannels, imgWidth, y, mean, cpuPtr + y * imgWidth);
+	
+	*width  = imgWidth;
+	*height = imgHeight;
+	
+	free(img);
+	return true;
+}
 
-		for( int x=0; x < imgWidth; x++ )
-		{
-			#define GET_PIXEL(channel)	    float(img[offset + channel])
-			#define SET_PIXEL_FLOAT4(r,g,b,a) cpuPtr[y*imgWidth+x] = make_float4(r,g,b,a)
 
-			const size_t offset = yOffset + x * imgChannels * sizeof(unsigned char);
-					
-			switch(imgChannels)
-			{
-				case 1:	
-				{
-					const float grey = GET_PIXEL(0);
-					SET_PIXEL_FLOAT4(grey - mean.x, grey - mean.y, grey - mean.z, 255.0f - mean.w); 
-					break;
-				}
-				case 2:	
-				{
-					const float grey = GET_PIXEL(0);
-					SET_PIXEL_FLOAT4(grey - mean.x, grey - mean.y, grey - mean.z, GET_PIXEL(1) - mean.w);
-					break;
-				}
-				case 3:
-				{
-					SET_PIXEL_FLOAT4(GET_PIXEL(0) - mean.x, GET_PIXEL(1) - mean.y, GET_PIXEL(2) - mean.z, 255.0f - mean.w);
-					break;
-				}
-				case 4:
-				{
-					SET_PIXEL_FLOAT4(GET_PIXEL(0) - mean.x, GET_PIXEL(1) - mean.y, GET_PIXEL(2) - mean.z, GET_PIXEL(3) - mean.w);
-					break;
-				}
-			}
-		}
+// loadImageRGBA
+bool loadImageRGBA( const char* filename, float4** ptr, int* width, int* height, const float4& mean )
+{
+	return loadImageRGBA(filename, ptr, ptr, width, height, mean);
+}
+
+
+// loadImageRGBA
+bool loadImageRGBA( const char* filename, half4** cpu, half4** gpu, int* width, int* height, const float4& mean )
+{
+	// validate parameters
+	if( !filename || !cpu || !gpu || !width || !height )
+	{
+		printf(LOG_IMAGE "loadImageRGBA() - invalid parameter(s)\n");
+		return false;
 	}
+
+	// attempt to load the data from disk
+	int imgWidth = *width;
+	int imgHeight = *height;
+	int imgChannels = 0;
+
+	unsigned char* img = loadImageIO(filename, &imgWidth, &imgHeight, &imgChannels);
 	
+	if( !img )
+		return false;
+
+	// allocate CUDA buffer for the image, and a row of float4 to convert through
+	const size_t imgSize = imgWidth * imgHeight * sizeof(half4);
+	float4* row = (float4*)malloc(imgWidth * sizeof(float4));
+
+	if( !row || !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize, CUDA_MEMORY_IMAGE, false) )
+	{
+		printf(LOG_CUDA "failed to allocate %zu bytes for image '%s'\n", imgSize, filename);
+		free(row);
+		free(img);
+		return false;
+	}
+
+	// convert uint8 image to half4, a row at a time
+	half4* cpuPtr = *cpu;
+
+	for( int y=0; y < imgHeight; y++ )
+	{
+		loadRowRGBA(img, imgChannels, imgWidth, y, mean, row);
+		cpuFloatToHalf((const float*)row, (uint16_t*)(cpuPtr + y * imgWidth), imgWidth * 4);
+	}
+
 	*width  = imgWidth;
 	*height = imgHeight;
-	
+
+	free(row);
 	free(img);
 	return true;
 }
 
 
 // loadImageRGBA
-bool loadImageRGBA( const char* filename, float4** ptr, int* width, int* height, const float4& mean )
+bool loadImageRGBA( const char* filename, half4** ptr, int* width, int* height, const float4& mean )
 {
 	return loadImageRGBA(filename, ptr, ptr, width, height, mean);
 }
@@ -361,7 +458,7 @@ bool loadImageRGB( const char* filename, float3** cpu, float3** gpu, int* width,
 	// allocate CUDA buffer for the image
 	const size_t imgSize = imgWidth * imgHeight * sizeof(float) * 3;
 
-	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize) )
+	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize, CUDA_MEMORY_IMAGE, false) )
 	{
 		printf(LOG_CUDA "failed to allocate %zu bytes for image '%s'\n", imgSize, filename);
 		return false;
@@ -437,7 +534,7 @@ bool loadImageBGR( const char* filename, float3** cpu, float3** gpu, int* width,
 	// allocate CUDA buffer for the image
 	const size_t imgSize = imgWidth * imgHeight * sizeof(float) * 3;
 
-	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize) )
+	if( !cudaAllocMapped((void**)cpu, (void**)gpu, imgSize, CUDA_MEMORY_IMAGE, false) )
 	{
 		printf(LOG_CUDA "failed to allocate %zu bytes for image '%s'\n", imgSize, filename);
 		return false;
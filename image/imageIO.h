@@ -25,6 +25,7 @@
 
 
 #include "cudaUtility.h"
+#include "cudaFP16.h"
 
 
 /**
@@ -125,6 +126,31 @@ bool loadImageRGBA( const char* filename, float4** ptr, int* width, int* height,
 bool saveImageRGBA( const char* filename, float4* cpu, int width, int height, float max_pixel=255.0f, int quality=100 );
 
 
+/**
+ * Load a color image from disk into CUDA memory with alpha, in half4 RGBA format with pixel values 0-255.
+ * This is the same as the float4 version of loadImageRGBA(), except that the image takes half of the memory.
+ * The pixels are converted to half-precision (after the mean pixel subtraction) with cpuFloatToHalf().
+ * @ingroup image
+ */
+bool loadImageRGBA( const char* filename, half4** cpu, half4** gpu, int* width, int* height, const float4& mean_pixel=make_float4(0,0,0,0) );
+
+
+/**
+ * Load a color image from disk into shared CPU/GPU memory with alpha, in half4 RGBA format with pixel values 0-255.
+ * This is the same as the float4 version of loadImageRGBA(), except that the image takes half of the memory.
+ * @ingroup image
+ */
+bool loadImageRGBA( const char* filename, half4** ptr, int* width, int* height, const float4& mean_pixel=make_float4(0,0,0,0) );
+
+
+/**
+ * Save a half4 RGBA image to disk.
+ * This is the same as the float4 version of saveImageRGBA(), and supports the same file formats.
+ * @ingroup image
+ */
+bool saveImageRGBA( const char* filename, half4* cpu, int width, int height, float max_pixel=255.0f, int quality=100 );
+
+
 /**
  * Load a color image from disk into CUDA memory, in float3 RGB format with pixel values 0-255.
  *
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "latencyHistogram.h"
+
+#include <string.h>
+
+
+// constructor
+latencyHistogram::latencyHistogram()
+{
+	Reset();
+}
+
+
+// bucketIndex
+uint32_t latencyHistogram::bucketIndex( uint64_t value )
+{
+	if( value < SubBuckets )
+		return value;
+
+	// the top 4 bits below the leading one select the sub-bucket
+	const uint32_t exponent = 63 - __builtin_clzll(value);
+	const uint32_t sub = (value >> (exponent - 4)) - SubBuckets;
+
+	return (exponent - 3) * SubBuckets + sub;
+}
+
+
+// bucketUpper
+uint64_t latencyHistogram::bucketUpper( uint32_t index )
+{
+	if( index < SubBuckets )
+		return index;
+
+	const uint32_t exponent = index / SubBuckets + 3;
+	const uint64_t lower = (uint64_t)(SubBuckets + index % SubBuckets) << (exponent - 4);
+
+	return lower + (1ULL << (exponent - 4)) - 1;
+}
+
+
+// Add
+void latencyHistogram::Add( uint64_t nanoseconds )
+{
+	mMutex.Lock();
+
+	mBuckets[bucketIndex(nanoseconds)]++;
+	mSum += nanoseconds;
+	mCount++;
+
+	if( nanoseconds < mMin )
+		mMin = nanoseconds;
+
+	if( nanoseconds > mMax )
+		mMax = nanoseconds;
+
+	mMutex.Unlock();
+}
+
+
+// Add
+void latencyHistogram::Add( const timespec& start, const timespec& end )
+{
+	if( timeCmp(start, end) > 0 )
+		return;
+
+	const timespec diff = timeDiff(start, end);
+	Add((uint64_t)diff.tv_sec * 1000000000ULL + diff.tv_nsec);
+}
+
+
+// Reset
+void latencyHistogram::Reset()
+{
+	mMutex.Lock();
+
+	memset(mBuckets, 0, sizeof(mBuckets));
+
+	mCount = 0;
+	mMin   = UINT64_MAX;
+	mMax   = 0;
+	mSum   = 0.0;
+
+	mMutex.Unlock();
+}
+
+
+// GetCount
+uint64_t latencyHistogram::GetCount()
+{
+	mMutex.Lock();
+	const uint64_t count = mCount;
+	mMutex.Unlock();
+	return count;
+}
+
+
+// GetMin
+uint64_t latencyHistogram::GetMin()
+{
+	mMutex.Lock();
+	const uint64_t value = (mCount > 0) ? mMin : 0;
+	mMutex.Unlock();
+	return value;
+}
+
+
+// GetMax
+uint64_t latencyHistogram::GetMax()
+{
+	mMutex.Lock();
+	const uint64_t value = mMax;
+	mMutex.Unlock();
+	return value;
+}
+
+
+// GetMean
+double latencyHistogram::GetMean()
+{
+	mMutex.Lock();
+	const double mean = (mCount > 0) ? mSum / mCount : 0.0;
+	mMutex.Unlock();
+	return mean;
+}
+
+
+// GetPercentile
+uint64_t latencyHistogram::GetPercentile( double percentile )
+{
+	mMutex.Lock();
+
+	if( mCount == 0 )
+	{
+		mMutex.Unlock();
+		return 0;
+	}
+
+	if( percentile < 0.0 )
+		percentile = 0.0;
+	else if( percentile > 100.0 )
+		percentile = 100.0;
+
+	// the rank of the sample that the percentile falls on (1-based)
+	uint64_t rank = (uint64_t)(percentile * 0.01 * mCount + 0.5);
+
+	if( rank < 1 )
+		rank = 1;
+	else if( rank > mCount )
+		rank = mCount;
+
+	uint64_t value = mMax;
+	uint64_t total = 0;
+
+	for( uint32_t n=0; n < NumBuckets; n++ )
+	{
+		total += mBuckets[n];
+
+		if( total >= rank )
+		{
+			value = bucketUpper(n);
+			break;
+		}
+	}
+
+	// the bucket bounds can overshoot the actual samples
+	if( value > mMax )
+		value = mMax;
+	else if( value < mMin )
+		value = mMin;
+
+	mMutex.Unlock();
+	return value;
+}
+
+
+// Print
+void latencyHistogram::Print( const char* name )
+{
+	printf("%s latency:  count=%llu  min=%.3fms  mean=%.3fms  p50=%.3fms  p99=%.3fms  p999=%.3fms  max=%.3fms\n",
+		  (name != NULL) ? name : "", (unsigned long long)GetCount(), GetMin() * 0.000001, GetMean() * 0.000001,
+		  GetP50() * 0.000001, GetP99() * 0.000001, GetP999() * 0.000001, GetMax() * 0.000001);
+}
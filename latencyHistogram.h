@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __LATENCY_HISTOGRAM_H__
+#define __LATENCY_HISTOGRAM_H__
+
+#include "timespec.h"
+#include "Mutex.h"
+
+
+/**
+ * Thread-safe histogram of latency measurements, for querying percentiles at runtime.
+ *
+ * Samples are stored in nanoseconds, in buckets that are spaced logarithmically
+ * with 16 linear sub-buckets per power of two.  This keeps the memory fixed
+ * regardless of the number of samples, while percentiles are accurate to
+ * within ~6% across the whole range from nanoseconds to hours.
+ *
+ * @ingroup time
+ */
+class latencyHistogram
+{
+public:
+	/**
+	 * Constructor
+	 */
+	latencyHistogram();
+
+	/**
+	 * Add a sample, in nanoseconds.
+	 */
+	void Add( uint64_t nanoseconds );
+
+	/**
+	 * Add a sample that's the difference between two timestamps.
+	 * If end is before start, the sample is ignored.
+	 */
+	void Add( const timespec& start, const timespec& end );
+
+	/**
+	 * Remove all of the samples.
+	 */
+	void Reset();
+
+	/**
+	 * Get the number of samples.
+	 */
+	uint64_t GetCount();
+
+	/**
+	 * Get the smallest sample, in nanoseconds.
+	 */
+	uint64_t GetMin();
+
+	/**
+	 * Get the largest sample, in nanoseconds.
+	 */
+	uint64_t GetMax();
+
+	/**
+	 * Get the mean of the samples, in nanoseconds.
+	 */
+	double GetMean();
+
+	/**
+	 * Get the value (in nanoseconds) that the given percentage of samples are at or below.
+	 * @param percentile the percentile to query, between 0.0 and 100.0 (i.e. 99.9 for p999)
+	 * @returns the upper bound of the bucket that the percentile falls in, or 0 if there are no samples.
+	 */
+	uint64_t GetPercentile( double percentile );
+
+	/**
+	 * Get the median latency, in nanoseconds.
+	 */
+	inline uint64_t GetP50()				{ return GetPercentile(50.0); }
+
+	/**
+	 * Get the 99th percentile latency, in nanoseconds.
+	 */
+	inline uint64_t GetP99()				{ return GetPercentile(99.0); }
+
+	/**
+	 * Get the 99.9th percentile latency, in nanoseconds.
+	 */
+	inline uint64_t GetP999()				{ return GetPercentile(99.9); }
+
+	/**
+	 * Print the count, min, mean, p50/p99/p999 and max (in milliseconds).
+	 */
+	void Print( const char* name=NULL );
+
+protected:
+	static uint32_t bucketIndex( uint64_t value );
+	static uint64_t bucketUpper( uint32_t index );
+
+	static const uint32_t SubBuckets = 16;
+	static const uint32_t NumBuckets = (64 - 3) * SubBuckets;
+
+	uint64_t mBuckets[NumBuckets];
+	uint64_t mCount;
+	uint64_t mMin;
+	uint64_t mMax;
+	double   mSum;
+
+	Mutex mMutex;
+};
+
+
+#endif
+
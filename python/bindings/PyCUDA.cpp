@@ -118,9 +118,9 @@ void PyCUDA_FreeMapped( PyObject* capsule )
 		return;
 	}
 
-	if( CUDA_FAILED(cudaFreeHost(ptr)) )
+	if( !cudaFreeMapped(ptr) )
 	{
-		printf(LOG_PY_UTILS "failed to free CUDA mapped memory with cudaFreeHost()\n");
+		printf(LOG_PY_UTILS "failed to free CUDA mapped memory with cudaFreeMapped()\n");
 		return;
 	}
 }
@@ -140,7 +140,7 @@ PyObject* PyCUDA_RegisterMappedMemory( void* cpuPtr, void* gpuPtr, bool freeOnDe
 		PyErr_SetString(PyExc_Exception, LOG_PY_UTILS "RegisterMappedMemory() pointers don't match");
 		
 		if( freeOnDelete )
-			CUDA(cudaFreeHost(cpuPtr));
+			cudaFreeMapped(cpuPtr);
 
 		return NULL;
 	}
@@ -153,7 +153,7 @@ PyObject* PyCUDA_RegisterMappedMemory( void* cpuPtr, void* gpuPtr, bool freeOnDe
 		PyErr_SetString(PyExc_Exception, LOG_PY_UTILS "RegisterMappedMemory() failed to create PyCapsule container");
 		
 		if( freeOnDelete )
-			CUDA(cudaFreeHost(cpuPtr));
+			cudaFreeMapped(cpuPtr);
 
 		return NULL;
 	}
@@ -183,7 +183,7 @@ PyObject* PyCUDA_AllocMapped( PyObject* self, PyObject* args )
 	void* cpuPtr = NULL;
 	void* gpuPtr = NULL;
 
-	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size) )
+	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, CUDA_MEMORY_PYTHON) )
 	{
 		PyErr_SetString(PyExc_Exception, LOG_PY_UTILS "cudaAllocMapped() failed");
 		return NULL;
@@ -148,7 +148,7 @@ PyObject* PyNumPy_ToCUDA( PyObject* self, PyObject* args )
 	void* cpuPtr = NULL;
 	void* gpuPtr = NULL;
 
-	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size) )
+	if( !cudaAllocMapped(&cpuPtr, &gpuPtr, size, CUDA_MEMORY_PYTHON, false) )
 	{
 		PyErr_SetString(PyExc_Exception, LOG_PY_UTILS "cudaAllocMapped() failed");
 		Py_DECREF(array);
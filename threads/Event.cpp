@@ -19,61 +19,120 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  */
- 
+
 #include "Event.h"
+
 #include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include <vector>
+
+
+// the time remaining until a deadline on the monotonic clock (returns false if it has passed)
+static bool eventRemaining( const timespec& deadline, timespec* remaining )
+{
+	const timespec now = timestampMonotonic();
+
+	if( timeCmp(now, deadline) >= 0 )
+		return false;
+
+	timeDiff(now, deadline, remaining);
+	return true;
+}
+
+
+// poll the eventfd's until one is readable, the timeout occurs (NULL for no timeout), or a signal interrupts it
+static void eventPoll( pollfd* fds, size_t count, const timespec* timeout )
+{
+	if( ppoll(fds, count, timeout, NULL) < 0 && errno != EINTR )
+		printf("Event -- ppoll() failed (error %i: %s)\n", errno, strerror(errno));
+}
 
 
 // constructor
 Event::Event( bool autoReset )
 {
 	mAutoReset = autoReset;
-	mQuery     = false;
-	
-	pthread_cond_init(&mID, NULL);
+	mFD        = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if( mFD < 0 )
+		printf("Event -- failed to create eventfd (error %i: %s)\n", errno, strerror(errno));
 }
 
 
 // destructor
 Event::~Event()
 {
-	pthread_cond_destroy(&mID);
+	if( mFD >= 0 )
+		close(mFD);
 }
 
 
 // Query
 bool Event::Query()
 {
-	bool r = false;
-	mQueryMutex.Lock();
-	r = mQuery;
-	mQueryMutex.Unlock();
-	return r;
+	pollfd fd;
+
+	fd.fd      = mFD;
+	fd.events  = POLLIN;
+	fd.revents = 0;
+
+	return (poll(&fd, 1, 0) > 0) && (fd.revents & POLLIN);
 }
 
 
 // Wake
 void Event::Wake()
 {
-	mQueryMutex.Lock();
-	mQuery = true;
-	pthread_cond_signal(&mID);
-	mQueryMutex.Unlock();
+	// the counter only overflows after 2^64 wakes, so failing with EAGAIN isn't a concern
+	const uint64_t value = 1;
+
+	if( write(mFD, &value, sizeof(value)) != sizeof(value) && errno != EAGAIN )
+		printf("Event -- failed to write eventfd (error %i: %s)\n", errno, strerror(errno));
+}
+
+
+// Reset
+void Event::Reset()
+{
+	uint64_t value = 0;
+
+	// reading the eventfd zeroes the counter, and fails with EAGAIN if it was already zero
+	if( read(mFD, &value, sizeof(value)) != sizeof(value) && errno != EAGAIN )
+		printf("Event -- failed to read eventfd (error %i: %s)\n", errno, strerror(errno));
+}
+
+
+// tryWait
+bool Event::tryWait()
+{
+	if( !mAutoReset )
+		return Query();
+
+	// only one of the threads that were woken will read a non-zero counter
+	uint64_t value = 0;
+	return (read(mFD, &value, sizeof(value)) == sizeof(value));
 }
 
 
 // Wait
 bool Event::Wait()
 {
-	mQueryMutex.Lock();
+	pollfd fd;
 
-	while(!mQuery)
-		pthread_cond_wait(&mID, mQueryMutex.GetID());
+	fd.fd     = mFD;
+	fd.events = POLLIN;
 
-	if( mAutoReset )
-		mQuery = false;
+	while( !tryWait() )
+	{
+		fd.revents = 0;
+		eventPoll(&fd, 1, NULL);
+	}
 
-	mQueryMutex.Unlock();
 	return true;
 }
 
@@ -81,25 +140,115 @@ bool Event::Wait()
 // Wait
 bool Event::Wait( const timespec& timeout )
 {
-	mQueryMutex.Lock();
+	const timespec deadline = timeAdd(timestampMonotonic(), timeout);
+
+	pollfd fd;
 
-	const timespec abs_time = timeAdd( timestamp(), timeout );
+	fd.fd     = mFD;
+	fd.events = POLLIN;
 
-	while(!mQuery)
+	while( !tryWait() )
 	{
-		const int ret = pthread_cond_timedwait(&mID, mQueryMutex.GetID(), &abs_time);
-		
-		if( ret == ETIMEDOUT )
-		{
-			mQueryMutex.Unlock();
+		timespec remaining;
+
+		if( !eventRemaining(deadline, &remaining) )
 			return false;
-		}
+
+		fd.revents = 0;
+		eventPoll(&fd, 1, &remaining);
 	}
-	
-	if( mAutoReset )
-		mQuery = false;
 
-	mQueryMutex.Unlock();
 	return true;
 }
 
+
+// WaitAny
+int Event::WaitAny( Event** events, size_t count, uint64_t timeout )
+{
+	if( !events || count == 0 )
+		return -1;
+
+	const timespec deadline = (timeout != UINT64_MAX) ? timeAdd(timestampMonotonic(), timeNew(timeout * 1000 * 1000)) : timeZero();
+	std::vector<pollfd> fds(count);
+
+	for( size_t n=0; n < count; n++ )
+	{
+		fds[n].fd     = events[n]->mFD;
+		fds[n].events = POLLIN;
+	}
+
+	while(true)
+	{
+		for( size_t n=0; n < count; n++ )
+		{
+			if( events[n]->tryWait() )
+				return n;
+		}
+
+		timespec remaining;
+
+		if( timeout != UINT64_MAX && !eventRemaining(deadline, &remaining) )
+			return -1;
+
+		for( size_t n=0; n < count; n++ )
+			fds[n].revents = 0;
+
+		eventPoll(fds.data(), count, (timeout != UINT64_MAX) ? &remaining : NULL);
+	}
+}
+
+
+// WaitAll
+bool Event::WaitAll( Event** events, size_t count, uint64_t timeout )
+{
+	if( !events || count == 0 )
+		return false;
+
+	const timespec deadline = (timeout != UINT64_MAX) ? timeAdd(timestampMonotonic(), timeNew(timeout * 1000 * 1000)) : timeZero();
+
+	std::vector<bool> raised(count, false);
+	std::vector<pollfd> fds;
+
+	while(true)
+	{
+		// take the events that have been raised, and poll the ones that haven't
+		fds.clear();
+
+		for( size_t n=0; n < count; n++ )
+		{
+			if( !raised[n] )
+				raised[n] = events[n]->tryWait();
+
+			if( !raised[n] )
+			{
+				pollfd fd;
+
+				fd.fd      = events[n]->mFD;
+				fd.events  = POLLIN;
+				fd.revents = 0;
+
+				fds.push_back(fd);
+			}
+		}
+
+		if( fds.size() == 0 )
+			return true;
+
+		timespec remaining;
+
+		if( timeout != UINT64_MAX && !eventRemaining(deadline, &remaining) )
+			break;
+
+		eventPoll(fds.data(), fds.size(), (timeout != UINT64_MAX) ? &remaining : NULL);
+	}
+
+	// give back the auto-reset events that were taken
+	for( size_t n=0; n < count; n++ )
+	{
+		if( raised[n] && events[n]->mAutoReset )
+			events[n]->Wake();
+	}
+
+	return false;
+}
+
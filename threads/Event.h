@@ -19,15 +19,24 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  */
- 
+
 #ifndef __MULTITHREAD_EVENT_H_
 #define __MULTITHREAD_EVENT_H_
 
 #include "Mutex.h"
 #include "timespec.h"
 
+#include <stddef.h>
+
+
 /**
  * Event object for signalling other threads.
+ *
+ * The event is backed by an eventfd, which is readable while the event is raised, so it can
+ * be waited on with poll/select/epoll alongside sockets and devices (see GetFD()).  Several
+ * events can be waited on together with WaitAny() and WaitAll().  Timeouts are measured
+ * with the monotonic clock, so they aren't affected by changes to the system time.
+ *
  * @ingroup threads
  */
 class Event
@@ -46,13 +55,14 @@ public:
 
 	/**
 	 * Raise the event.  Any threads waiting on this event will be woken up.
+	 * For auto-reset events, only one of the waiting threads will return from its wait.
 	 */
 	void Wake();
 
 	/**
 	 * Reset the event status to un-raised.
 	 */
-	inline void Reset()							{ mQueryMutex.Lock(); mQuery = false; mQueryMutex.Unlock(); }
+	void Reset();
 
 	/**
 	 * Query the status of this event.
@@ -91,16 +101,31 @@ public:
 	inline bool WaitUs( uint64_t timeout )		{ return (timeout == UINT64_MAX) ? Wait() : Wait(timeNew(timeout*1000)); }
 	
 	/**
-	 * Get the Event object
+	 * Wait until any of the events are raised, or the timeout (in milliseconds) occurs.
+	 * If the event that was raised is auto-reset, it gets reset for this thread.
+	 * @returns the index of the event that was raised, or -1 if the timeout occurred.
 	 */
-	inline pthread_cond_t* GetID()			{ return &mID; }
+	static int WaitAny( Event** events, size_t count, uint64_t timeout=UINT64_MAX );
 
-protected:
+	/**
+	 * Wait until every one of the events has been raised, or the timeout (in milliseconds) occurs.
+	 * The auto-reset events are reset as they're raised, and if the timeout occurs,
+	 * the ones that were already reset get raised again so the signals aren't lost.
+	 * @returns true if every event was raised, or false if the timeout occurred.
+	 */
+	static bool WaitAll( Event** events, size_t count, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Get the file descriptor of the eventfd, which is readable (POLLIN/EPOLLIN) while the event is raised.
+	 * Don't read from it directly -- once it's reported readable, call Wait(0) to take the event
+	 * (which also resets it if it's auto-reset), or Query() to check it.
+	 */
+	inline int GetFD() const					{ return mFD; }
 
-	pthread_cond_t mID;
+protected:
+	bool tryWait();
 
-	Mutex mQueryMutex;
-	bool  mQuery;
+	int   mFD;
 	bool  mAutoReset;
 };
 
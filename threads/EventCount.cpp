@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "EventCount.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+// futexWait
+static inline int futexWait( std::atomic<uint32_t>* addr, uint32_t value, const timespec* timeout )
+{
+	return syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT_PRIVATE, value, timeout, NULL, 0);
+}
+
+// futexWake
+static inline int futexWake( std::atomic<uint32_t>* addr, int count )
+{
+	return syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+
+// constructor
+EventCount::EventCount( uint32_t spinCount ) : mEpoch(0), mWaiters(0)
+{
+	mSpinCount = spinCount;
+}
+
+
+// Notify
+void EventCount::Notify()
+{
+	// the increment and the load are ordered against the waiter's
+	// increment of mWaiters and its load of mEpoch in WaitNs()
+	mEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+	if( mWaiters.load(std::memory_order_seq_cst) > 0 )
+		futexWake(&mEpoch, INT_MAX);
+}
+
+
+// WaitNs
+bool EventCount::WaitNs( uint32_t snapshot, uint64_t timeout )
+{
+	for( uint32_t n=0; n < mSpinCount; n++ )
+	{
+		if( mEpoch.load(std::memory_order_acquire) != snapshot )
+			return true;
+
+		cpuRelax();
+	}
+
+	if( timeout == 0 )
+		return false;
+
+	timespec ts;
+
+	ts.tv_sec  = timeout / 1000000000ULL;
+	ts.tv_nsec = timeout % 1000000000ULL;
+
+	mWaiters.fetch_add(1, std::memory_order_seq_cst);
+
+	// the futex only sleeps if mEpoch still equals the snapshot, so a Notify() that
+	// happens between the check above and the system call can't be missed
+	if( mEpoch.load(std::memory_order_seq_cst) == snapshot )
+		futexWait(&mEpoch, snapshot, (timeout == UINT64_MAX) ? NULL : &ts);
+
+	mWaiters.fetch_sub(1, std::memory_order_seq_cst);
+
+	return (mEpoch.load(std::memory_order_acquire) != snapshot);
+}
+
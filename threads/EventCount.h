@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_EVENT_COUNT_H_
+#define __MULTITHREAD_EVENT_COUNT_H_
+
+#include <stdint.h>
+#include <atomic>
+
+
+/**
+ * Hint to the processor that the thread is busy-waiting.
+ * @ingroup threads
+ */
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile("yield" ::: "memory");
+#endif
+}
+
+
+/**
+ * Lock-free condition for waiting on lock-free data structures, like SPSCQueue and MPMCQueue.
+ *
+ * A waiting thread takes a snapshot with Prepare(), checks its condition (i.e. tries to pop
+ * from a queue), and if it isn't met, calls Wait() with the snapshot.  The thread that changes
+ * the condition calls Notify() afterwards.  Wait() spins briefly, then sleeps on a futex.
+ * Notify() doesn't make a system call unless a thread is actually sleeping, and neither
+ * side takes a lock, so a waiter can't hold up the notifying thread (or vice versa).
+ *
+ * @ingroup threads
+ */
+class EventCount
+{
+public:
+	/**
+	 * Constructor
+	 * @param spinCount the number of times that Wait() checks for a notification before sleeping.
+	 */
+	EventCount( uint32_t spinCount=DefaultSpinCount );
+
+	/**
+	 * Take a snapshot of the state before checking the condition.
+	 */
+	inline uint32_t Prepare() const				{ return mEpoch.load(std::memory_order_acquire); }
+
+	/**
+	 * Wake every thread that's waiting.  Call this after changing the condition.
+	 */
+	void Notify();
+
+	/**
+	 * Wait until Notify() is called after the snapshot was taken (it may return right away).
+	 * @returns true if a notification was received, or false if the wait was interrupted.
+	 */
+	inline bool Wait( uint32_t snapshot )			{ return WaitNs(snapshot, UINT64_MAX); }
+
+	/**
+	 * Wait for a specified number of milliseconds until Notify() is called after the snapshot was taken.
+	 * @returns true if a notification was received, or false if the timeout expired.
+	 */
+	inline bool Wait( uint32_t snapshot, uint64_t timeout )	{ return WaitNs(snapshot, (timeout == UINT64_MAX) ? UINT64_MAX : timeout * 1000 * 1000); }
+
+	/**
+	 * Wait for a specified number of nanoseconds until Notify() is called after the snapshot was taken.
+	 * @returns true if a notification was received, or false if the timeout expired.
+	 */
+	bool WaitNs( uint32_t snapshot, uint64_t timeout );
+
+	/**
+	 * The default number of times to spin before sleeping.
+	 */
+	static const uint32_t DefaultSpinCount = 256;
+
+protected:
+	std::atomic<uint32_t> mEpoch;		// incremented by each Notify(), and the futex word
+	std::atomic<uint32_t> mWaiters;		// number of threads that are sleeping (or about to)
+
+	uint32_t mSpinCount;
+};
+
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "LockStats.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+
+std::atomic<bool> LockStats::mEnabled(false);
+
+// the registry uses a static pthread mutex, so it can be used from static initializers
+static pthread_mutex_t gRegistryMutex = PTHREAD_MUTEX_INITIALIZER;
+static LockStats*      gRegistry = NULL;
+
+
+// constructor
+LockStats::LockStats( const char* name ) : mAcquired(0), mContended(0), mWaitTime(0), mMaxHoldTime(0)
+{
+	strncpy(mName, name, sizeof(mName) - 1);
+	mName[sizeof(mName) - 1] = '\0';
+
+	mNext = NULL;
+}
+
+
+// Register
+LockStats* LockStats::Register( const char* name )
+{
+	if( !name || name[0] == '\0' )
+		return NULL;
+
+	pthread_mutex_lock(&gRegistryMutex);
+
+	LockStats* stats = gRegistry;
+
+	while( stats != NULL && strncmp(stats->mName, name, sizeof(stats->mName) - 1) != 0 )
+		stats = stats->mNext;
+
+	if( !stats )
+	{
+		stats = new LockStats(name);
+		stats->mNext = gRegistry;
+		gRegistry = stats;
+	}
+
+	pthread_mutex_unlock(&gRegistryMutex);
+	return stats;
+}
+
+
+// Enable
+void LockStats::Enable( bool enable )
+{
+	mEnabled = enable;
+}
+
+
+// Print
+void LockStats::Print()
+{
+	printf("lock statistics (%s)\n", IsEnabled() ? "enabled" : "disabled");
+	printf("   %-32s  %10s  %10s  %8s  %12s  %14s\n", "lock", "acquired", "contended", "percent", "wait (ms)", "max hold (us)");
+
+	pthread_mutex_lock(&gRegistryMutex);
+
+	for( LockStats* stats = gRegistry; stats != NULL; stats = stats->mNext )
+	{
+		const uint64_t acquired  = stats->GetAcquired();
+		const uint64_t contended = stats->GetContended();
+
+		if( acquired == 0 )
+			continue;
+
+		printf("   %-32s  %10llu  %10llu  %7.2f%%  %12.3f  %14.1f\n", stats->mName,
+			  (unsigned long long)acquired, (unsigned long long)contended,
+			  double(contended) * 100.0 / acquired,
+			  stats->GetWaitTime() * 0.000001, stats->GetMaxHoldTime() * 0.001);
+	}
+
+	pthread_mutex_unlock(&gRegistryMutex);
+}
+
+
+// Reset
+void LockStats::Reset()
+{
+	pthread_mutex_lock(&gRegistryMutex);
+
+	for( LockStats* stats = gRegistry; stats != NULL; stats = stats->mNext )
+	{
+		stats->mAcquired    = 0;
+		stats->mContended   = 0;
+		stats->mWaitTime    = 0;
+		stats->mMaxHoldTime = 0;
+	}
+
+	pthread_mutex_unlock(&gRegistryMutex);
+}
+
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_LOCK_STATS_H_
+#define __MULTITHREAD_LOCK_STATS_H_
+
+#include <stdint.h>
+#include <time.h>
+#include <atomic>
+
+
+/**
+ * Contention statistics that are shared by every lock with the same name.
+ *
+ * Locks are instrumented when they're given a name (see Mutex, RWMutex, and SpinLock)
+ * and the statistics are enabled with LockStats::Enable().  Otherwise, locking
+ * only costs one extra branch.  Print() dumps the statistics of every named lock.
+ *
+ * @ingroup threads
+ */
+class LockStats
+{
+public:
+	/**
+	 * Get the statistics for the locks with this name, creating them the first time.
+	 * Returns NULL if the name is NULL or empty.  The statistics are never freed.
+	 */
+	static LockStats* Register( const char* name );
+
+	/**
+	 * Enable or disable collecting statistics (disabled by default).
+	 */
+	static void Enable( bool enable=true );
+
+	/**
+	 * Return true if the statistics are being collected.
+	 */
+	static inline bool IsEnabled()						{ return mEnabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * Print the statistics of every named lock that has been acquired.
+	 */
+	static void Print();
+
+	/**
+	 * Reset the statistics of every named lock.
+	 */
+	static void Reset();
+
+	/**
+	 * Get the name of the locks.
+	 */
+	inline const char* GetName() const					{ return mName; }
+
+	/**
+	 * Get the number of times the locks were acquired.
+	 */
+	inline uint64_t GetAcquired() const					{ return mAcquired.load(); }
+
+	/**
+	 * Get the number of times the locks were already held when a thread tried to acquire them.
+	 */
+	inline uint64_t GetContended() const				{ return mContended.load(); }
+
+	/**
+	 * Get the total time that threads spent waiting for the locks (in nanoseconds).
+	 */
+	inline uint64_t GetWaitTime() const					{ return mWaitTime.load(); }
+
+	/**
+	 * Get the longest time that one of the locks was held exclusively (in nanoseconds).
+	 */
+	inline uint64_t GetMaxHoldTime() const				{ return mMaxHoldTime.load(); }
+
+	/**
+	 * Record that a lock was acquired, after `waitTime` nanoseconds if it was contended.
+	 */
+	inline void Acquired( bool contended, uint64_t waitTime=0 )
+	{
+		mAcquired.fetch_add(1, std::memory_order_relaxed);
+
+		if( contended )
+		{
+			mContended.fetch_add(1, std::memory_order_relaxed);
+			mWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Record that a lock was released after being held for `holdTime` nanoseconds.
+	 */
+	inline void Released( uint64_t holdTime )
+	{
+		uint64_t max = mMaxHoldTime.load(std::memory_order_relaxed);
+
+		while( holdTime > max && !mMaxHoldTime.compare_exchange_weak(max, holdTime, std::memory_order_relaxed) );
+	}
+
+	/**
+	 * Get the time from the monotonic clock (in nanoseconds) for measuring waits and holds.
+	 */
+	static inline uint64_t Now()						{ timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return uint64_t(t.tv_sec) * 1000000000ULL + t.tv_nsec; }
+
+protected:
+	LockStats( const char* name );
+
+	char mName[64];
+
+	std::atomic<uint64_t> mAcquired;
+	std::atomic<uint64_t> mContended;
+	std::atomic<uint64_t> mWaitTime;
+	std::atomic<uint64_t> mMaxHoldTime;
+
+	LockStats* mNext;	// the registry is a linked list, because the locks are only registered once
+
+	static std::atomic<bool> mEnabled;
+};
+
+#endif
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_MPMC_QUEUE_H_
+#define __MULTITHREAD_MPMC_QUEUE_H_
+
+#include "SPSCQueue.h"
+
+
+/**
+ * Bounded lock-free queue that any number of threads can push to and pop from.
+ *
+ * Each cell of the ring has a sequence number that tells producers when the cell
+ * is free and consumers when it's been filled, so threads only contend on a single
+ * compare-and-swap of the head or tail index.  Push() and Pop() wait with an
+ * EventCount like SPSCQueue does.  The capacity is rounded up to a power of two.
+ *
+ * @ingroup threads
+ */
+template<typename T>
+class MPMCQueue
+{
+public:
+	/**
+	 * Constructor
+	 * @param capacity the maximum number of values in the queue (rounded up to a power of two)
+	 */
+	MPMCQueue( uint32_t capacity );
+
+	/**
+	 * Destructor
+	 */
+	~MPMCQueue();
+
+	/**
+	 * Add a value to the back of the queue, if there's room.
+	 * @returns true if the value was queued, false if the queue was full.
+	 */
+	bool TryPush( const T& value );
+
+	/**
+	 * Remove the value at the front of the queue, if there is one.
+	 * @returns true if a value was retrieved, false if the queue was empty.
+	 */
+	bool TryPop( T* value );
+
+	/**
+	 * Add a value to the back of the queue, waiting up to `timeout` milliseconds
+	 * for room if it's full (UINT64_MAX waits indefinitely).
+	 * @returns true if the value was queued, false on timeout.
+	 */
+	bool Push( const T& value, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Remove the value at the front of the queue, waiting up to `timeout` milliseconds
+	 * for one if it's empty (UINT64_MAX waits indefinitely).
+	 * @returns true if a value was retrieved, false on timeout.
+	 */
+	bool Pop( T* value, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Get the number of values in the queue (this is approximate while other threads are active).
+	 */
+	uint32_t GetSize() const;
+
+	/**
+	 * Get the maximum number of values in the queue.
+	 */
+	inline uint32_t GetCapacity() const	{ return mMask + 1; }
+
+protected:
+	struct Cell
+	{
+		std::atomic<uint32_t> sequence;
+		T value;
+	};
+
+	static const uint32_t CacheLineSize = 64;	// keeps mTail and mHead on separate cache lines
+
+	Cell*    mCells;
+	uint32_t mMask;
+
+	char mPad0[CacheLineSize];
+	std::atomic<uint32_t> mTail;	// next position to push to
+	char mPad1[CacheLineSize];
+	std::atomic<uint32_t> mHead;	// next position to pop from
+	char mPad2[CacheLineSize];
+
+	EventCount mNotEmpty;
+	EventCount mNotFull;
+};
+
+
+// constructor
+template<typename T>
+MPMCQueue<T>::MPMCQueue( uint32_t capacity ) : mTail(0), mHead(0)
+{
+	capacity = queueCapacity(capacity);
+
+	mCells = new Cell[capacity];
+	mMask  = capacity - 1;
+
+	for( uint32_t n=0; n < capacity; n++ )
+		mCells[n].sequence.store(n, std::memory_order_relaxed);
+}
+
+
+// destructor
+template<typename T>
+MPMCQueue<T>::~MPMCQueue()
+{
+	delete[] mCells;
+}
+
+
+// TryPush
+template<typename T>
+bool MPMCQueue<T>::TryPush( const T& value )
+{
+	uint32_t pos = mTail.load(std::memory_order_relaxed);
+	Cell* cell = NULL;
+
+	while(true)
+	{
+		cell = &mCells[pos & mMask];
+
+		const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const int32_t  diff = (int32_t)(sequence - pos);
+
+		if( diff == 0 )
+		{
+			// the cell is free, try to claim it
+			if( mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+				break;
+		}
+		else if( diff < 0 )
+		{
+			return false;	// the cell still holds a value from the previous lap, so the queue is full
+		}
+		else
+		{
+			pos = mTail.load(std::memory_order_relaxed);	// another producer claimed it
+		}
+	}
+
+	cell->value = value;
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	mNotEmpty.Notify();
+
+	return true;
+}
+
+
+// TryPop
+template<typename T>
+bool MPMCQueue<T>::TryPop( T* value )
+{
+	uint32_t pos = mHead.load(std::memory_order_relaxed);
+	Cell* cell = NULL;
+
+	while(true)
+	{
+		cell = &mCells[pos & mMask];
+
+		const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const int32_t  diff = (int32_t)(sequence - (pos + 1));
+
+		if( diff == 0 )
+		{
+			// the cell has been filled, try to claim it
+			if( mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+				break;
+		}
+		else if( diff < 0 )
+		{
+			return false;	// the cell hasn't been filled yet, so the queue is empty
+		}
+		else
+		{
+			pos = mHead.load(std::memory_order_relaxed);	// another consumer claimed it
+		}
+	}
+
+	*value = cell->value;
+	cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+	mNotFull.Notify();
+
+	return true;
+}
+
+
+// Push
+template<typename T>
+bool MPMCQueue<T>::Push( const T& value, uint64_t timeout )
+{
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mNotFull.Prepare();
+
+		if( TryPush(value) )
+			return true;
+
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return false;
+
+		mNotFull.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// Pop
+template<typename T>
+bool MPMCQueue<T>::Pop( T* value, uint64_t timeout )
+{
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mNotEmpty.Prepare();
+
+		if( TryPop(value) )
+			return true;
+
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return false;
+
+		mNotEmpty.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// GetSize
+template<typename T>
+uint32_t MPMCQueue<T>::GetSize() const
+{
+	const uint32_t head = mHead.load(std::memory_order_acquire);
+	const uint32_t tail = mTail.load(std::memory_order_acquire);
+
+	return ((int32_t)(tail - head) > 0) ? (tail - head) : 0;
+}
+
+
+#endif
@@ -24,8 +24,11 @@
 
 
 // constructor
-Mutex::Mutex()
+Mutex::Mutex( const char* name )
 {
+	mStats     = LockStats::Register(name);
+	mHoldStart = 0;
+
 	pthread_mutex_init(&mID, NULL);
 }
 
@@ -35,3 +38,29 @@ Mutex::~Mutex()
 {
 	pthread_mutex_destroy(&mID);
 }
+
+
+// lockProfiled
+void Mutex::lockProfiled()
+{
+	if( pthread_mutex_trylock(&mID) == 0 )
+	{
+		mStats->Acquired(false);
+	}
+	else
+	{
+		const uint64_t start = LockStats::Now();
+		pthread_mutex_lock(&mID);
+		mStats->Acquired(true, LockStats::Now() - start);
+	}
+
+	mHoldStart = LockStats::Now();
+}
+
+
+// unlockProfiled
+void Mutex::unlockProfiled()
+{
+	mStats->Released(LockStats::Now() - mHoldStart);
+	mHoldStart = 0;
+}
@@ -25,11 +25,18 @@
 
 #include <pthread.h>
 
+#include "LockStats.h"
+
 
 /**
  * A lightweight mutual exclusion lock.  It is very fast to check if the mutex is available,
  * lock it, and release it.  However, if the mutex is unavailable when you attempt to
  * lock it, execution of the thread will stop until it becomes available.
+ *
+ * If the mutex is given a name, it records contention statistics while LockStats::Enable()
+ * is on (the statistics are shared by every lock with that name).  These can be printed
+ * with LockStats::Print() to find which locks threads are waiting on.
+ *
  * @ingroup threads
  */
 class Mutex
@@ -37,8 +44,9 @@ class Mutex
 public:
 	/**
 	 * Constructor
+	 * @param name Optional name of the lock, which enables collecting contention statistics for it.
 	 */
-	Mutex();
+	Mutex( const char* name=NULL );
 
 	/**
 	 * Destructor
@@ -49,18 +57,30 @@ public:
 	 * If the lock is free, aquire it.  Otherwise, return without waiting for it to become available.
 	 * @result True if the lock was aquired, false if not.
 	 */
-	inline bool AttemptLock()					{ return (pthread_mutex_trylock(&mID) == 0); }
+	inline bool AttemptLock()
+	{
+		if( pthread_mutex_trylock(&mID) != 0 )
+			return false;
+
+		if( mStats != NULL && LockStats::IsEnabled() )
+		{
+			mStats->Acquired(false);
+			mHoldStart = LockStats::Now();
+		}
+
+		return true;
+	}
 	
 	/**
 	 * Aquire the lock, whenever it becomes available.  This could mean just a few instructions
 	 * if the lock is already free, or to block the thread if it isn't.
 	 */
-	inline void Lock()							{ pthread_mutex_lock(&mID); }
+	inline void Lock()							{ if( mStats != NULL && LockStats::IsEnabled() ) lockProfiled(); else pthread_mutex_lock(&mID); }
 
 	/**
 	 * Release the lock
 	 */
-	inline void Unlock()						{ pthread_mutex_unlock(&mID); }		
+	inline void Unlock()						{ if( mHoldStart != 0 ) unlockProfiled(); pthread_mutex_unlock(&mID); }
 
 	/**
 	 * Wait for the lock, then release it immediately.  Use this in situations where you are waiting for
@@ -69,12 +89,24 @@ public:
 	inline void Sync()							{ Lock(); Unlock(); }
 
 	/**
-	 * Get the mutex object
+	 * Get the contention statistics of the lock, or NULL if it doesn't have a name.
+	 */
+	inline LockStats* GetStats() const			{ return mStats; }
+
+	/**
+	 * Get the mutex object.  If a condition variable waits with it, the time
+	 * spent waiting is counted as part of the hold time in the statistics.
 	 */
 	pthread_mutex_t* GetID() 					{ return &mID; }
 
 protected:
+	void lockProfiled();
+	void unlockProfiled();
+
 	pthread_mutex_t mID;
+
+	LockStats* mStats;
+	uint64_t   mHoldStart;	// when the lock was acquired (only set while collecting statistics)
 };
 
 #endif
\ No newline at end of file
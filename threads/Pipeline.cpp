@@ -0,0 +1,851 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "Pipeline.h"
+#include "Thread.h"
+
+#include "cudaMappedMemory.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+// the current time from the monotonic clock, in nanoseconds
+static inline uint64_t pipelineTime()
+{
+	const timespec t = timestampMonotonic();
+	return uint64_t(t.tv_sec) * 1000000000ULL + t.tv_nsec;
+}
+
+// the nanoseconds between a timespec from timestampMonotonic() and a pipelineTime()
+static inline uint64_t pipelineElapsed( const timespec& start, uint64_t end )
+{
+	const uint64_t begin = uint64_t(start.tv_sec) * 1000000000ULL + start.tv_nsec;
+	return (end > begin) ? end - begin : 0;
+}
+
+
+// PipelineQueuePolicyToString
+const char* PipelineQueuePolicyToString( PipelineQueuePolicy policy )
+{
+	switch(policy)
+	{
+		case PIPELINE_QUEUE_BLOCK:			return "block";
+		case PIPELINE_QUEUE_DROP_OLDEST:	return "drop-oldest";
+		case PIPELINE_QUEUE_DROP_NEWEST:	return "drop-newest";
+	}
+
+	return "unknown";
+}
+
+
+//-----------------------------------------------------------------------------------
+// PipelineWorker (a thread dedicated to a stage)
+//-----------------------------------------------------------------------------------
+class PipelineWorker : public Thread
+{
+public:
+	PipelineWorker( PipelineStage* stage ) : mStage(stage)	{ }
+
+	virtual void Run()		{ mStage->loop(); }
+
+	PipelineStage* mStage;
+};
+
+
+//-----------------------------------------------------------------------------------
+// PipelineFrame
+//-----------------------------------------------------------------------------------
+
+// constructor
+PipelineFrame::PipelineFrame( PipelineStage* owner ) : mRefCount(0)
+{
+	cpu       = NULL;
+	cuda      = NULL;
+	size      = 0;
+	width     = 0;
+	height    = 0;
+	sequence  = 0;
+	created   = timeZero();
+	user_data = NULL;
+
+	mOwner        = owner;
+	mCallback     = NULL;
+	mCallbackData = NULL;
+	mAllocCPU     = NULL;
+	mAllocCUDA    = NULL;
+	mAllocSize    = 0;
+}
+
+
+// Release
+void PipelineFrame::Release()
+{
+	if( mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+		mOwner->recycle(this);
+}
+
+
+// SetReleaseCallback
+void PipelineFrame::SetReleaseCallback( PipelineReleaseCallback callback, void* data )
+{
+	mCallback     = callback;
+	mCallbackData = data;
+}
+
+
+// CopyMetadata
+void PipelineFrame::CopyMetadata( const PipelineFrame* frame )
+{
+	if( !frame )
+		return;
+
+	width    = frame->width;
+	height   = frame->height;
+	sequence = frame->sequence;
+	created  = frame->created;
+}
+
+
+//-----------------------------------------------------------------------------------
+// PipelineStage
+//-----------------------------------------------------------------------------------
+
+// constructor
+PipelineStage::PipelineStage( const char* name, const PipelineStageOptions& options ) 
+	: mQueue(options.queueSize), mFree(options.frames)
+{
+	init(name, options);
+}
+
+
+// constructor
+PipelineStage::PipelineStage( const char* name, const Function& function, const PipelineStageOptions& options ) 
+	: mFunction(function), mQueue(options.queueSize), mFree(options.frames)
+{
+	init(name, options);
+}
+
+
+// init
+void PipelineStage::init( const char* name, const PipelineStageOptions& options )
+{
+	mName      = (name != NULL) ? name : "stage";
+	mOptions   = options;
+	mNumInputs = 0;
+	mStartTime = 0;
+
+	mDepth     = 0;
+	mMaxDepth  = 0;
+	mActive    = 0;
+	mProcessed = 0;
+	mDropped   = 0;
+	mSequence  = 0;
+	mStopping  = false;
+
+	mOutstanding = 0;
+	mTasks       = 0;
+
+	if( mOptions.queueSize == 0 )
+		mOptions.queueSize = 1;
+
+	if( mOptions.concurrency == 0 )
+		mOptions.concurrency = 1;
+
+	// allocate the frames that get recycled back to this stage
+	for( uint32_t n=0; n < mOptions.frames; n++ )
+	{
+		PipelineFrame* frame = new PipelineFrame(this);
+
+		if( mOptions.frameSize > 0 )
+		{
+			if( !cudaAllocMapped(&frame->mAllocCPU, &frame->mAllocCUDA, mOptions.frameSize, CUDA_MEMORY_PIPELINE, false) )
+			{
+				printf("Pipeline -- stage '%s' failed to allocate frame %u of %u (%zu bytes)\n", mName.c_str(), n, mOptions.frames, mOptions.frameSize);
+				delete frame;
+				break;
+			}
+
+			frame->mAllocSize = mOptions.frameSize;
+		}
+
+		frame->cpu  = frame->mAllocCPU;
+		frame->cuda = frame->mAllocCUDA;
+		frame->size = frame->mAllocSize;
+
+		mFrames.push_back(frame);
+		mFree.TryPush(frame);
+	}
+}
+
+
+// destructor
+PipelineStage::~PipelineStage()
+{
+	const uint32_t outstanding = mOutstanding.load();
+
+	if( outstanding > 0 )
+	{
+		// something still has a reference to them, so freeing them isn't safe
+		printf("Pipeline -- stage '%s' deleted with %u frames still in use (leaking %zu frames)\n", mName.c_str(), outstanding, mFrames.size());
+		return;
+	}
+
+	for( size_t n=0; n < mFrames.size(); n++ )
+	{
+		if( mFrames[n]->mAllocCPU != NULL )
+			cudaFreeMapped(mFrames[n]->mAllocCPU);
+
+		delete mFrames[n];
+	}
+}
+
+
+// Process
+PipelineFrame* PipelineStage::Process( PipelineFrame* input )
+{
+	if( !mFunction )
+		return input;
+
+	return mFunction(input);
+}
+
+
+// AcquireFrame
+PipelineFrame* PipelineStage::AcquireFrame( const PipelineFrame* metadata, uint64_t timeout )
+{
+	if( mFrames.size() == 0 )
+	{
+		printf("Pipeline -- stage '%s' doesn't have any frames to acquire (set PipelineStageOptions::frames)\n", mName.c_str());
+		return NULL;
+	}
+
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mFreeEvent.Prepare();
+		PipelineFrame* frame = NULL;
+
+		if( mFree.TryPop(&frame) )
+		{
+			mOutstanding++;
+			frame->mRefCount = 1;
+
+			if( metadata != NULL )
+			{
+				frame->CopyMetadata(metadata);
+			}
+			else
+			{
+				frame->sequence = mSequence++;
+				frame->created  = timestampMonotonic();
+			}
+
+			return frame;
+		}
+
+		if( mStopping || timeout == 0 )
+			return NULL;
+
+		// wait for a frame to be recycled
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return NULL;
+
+		mFreeEvent.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// recycle
+void PipelineStage::recycle( PipelineFrame* frame )
+{
+	PipelineReleaseCallback callback = frame->mCallback;
+	void* callbackData = frame->mCallbackData;
+
+	// the callback sees the memory the frame was pointing to, before it's restored to the frame's own
+	if( callback != NULL )
+		callback(frame, callbackData);
+
+	frame->cpu       = frame->mAllocCPU;
+	frame->cuda      = frame->mAllocCUDA;
+	frame->size      = frame->mAllocSize;
+	frame->user_data = NULL;
+
+	frame->mCallback     = NULL;
+	frame->mCallbackData = NULL;
+
+	mFree.TryPush(frame);
+	mFreeEvent.Notify();
+
+	// this has to be the last access to the stage, which can be deleted once nothing is outstanding
+	mOutstanding--;
+}
+
+
+// GetThroughput
+double PipelineStage::GetThroughput() const
+{
+	if( mStartTime == 0 )
+		return 0.0;
+
+	const uint64_t elapsed = pipelineTime() - mStartTime;
+
+	if( elapsed == 0 )
+		return 0.0;
+
+	return double(mProcessed.load()) * 1000000000.0 / elapsed;
+}
+
+
+// reserve (a place in the input queue, which is bounded by the queueSize option rather than the ring's capacity)
+bool PipelineStage::reserve()
+{
+	uint32_t depth = mDepth.load();
+
+	while( depth < mOptions.queueSize )
+	{
+		if( mDepth.compare_exchange_weak(depth, depth + 1) )
+		{
+			uint32_t max = mMaxDepth.load(std::memory_order_relaxed);
+			while( depth + 1 > max && !mMaxDepth.compare_exchange_weak(max, depth + 1, std::memory_order_relaxed) );
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// push
+bool PipelineStage::push( PipelineFrame* frame )
+{
+	QueueEntry entry;
+
+	entry.frame    = frame;
+	entry.enqueued = pipelineTime();
+
+	while(true)
+	{
+		const uint32_t snapshot = mSpaceEvent.Prepare();
+
+		if( !mStopping && reserve() )
+		{
+			// the ring's capacity is at least queueSize, so this only fails while a pop is finishing
+			while( !mQueue.TryPush(entry) )
+				cpuRelax();
+
+			mInputEvent.Notify();
+
+			if( mOptions.threads == 0 )
+				schedule();
+
+			return true;
+		}
+
+		if( mStopping || mOptions.policy == PIPELINE_QUEUE_DROP_NEWEST )
+		{
+			mDropped++;
+			frame->Release();
+			return false;
+		}
+
+		if( mOptions.policy == PIPELINE_QUEUE_DROP_OLDEST )
+		{
+			QueueEntry oldest;
+
+			if( pop(&oldest) )
+			{
+				mDropped++;
+				oldest.frame->Release();
+			}
+
+			continue;
+		}
+
+		// PIPELINE_QUEUE_BLOCK waits for the stage to take a frame from the queue
+		mSpaceEvent.Wait(snapshot);
+	}
+}
+
+
+// pop
+bool PipelineStage::pop( QueueEntry* entry )
+{
+	if( !mQueue.TryPop(entry) )
+		return false;
+
+	mDepth--;
+	mSpaceEvent.Notify();
+	return true;
+}
+
+
+// run
+void PipelineStage::run( PipelineFrame* input, uint64_t enqueued )
+{
+	const uint64_t begin = pipelineTime();
+
+	if( input != NULL )
+		mQueueLatency.Add(begin - enqueued);
+
+	PipelineFrame* output = Process(input);
+
+	const uint64_t end = pipelineTime();
+
+	if( input != NULL || output != NULL )
+	{
+		mProcessed++;
+		mProcessLatency.Add(end - begin);
+		mFrameLatency.Add(pipelineElapsed((input != NULL) ? input->created : output->created, end));
+	}
+
+	if( input != NULL && input != output )
+		input->Release();
+
+	if( !output )
+		return;
+
+	// each output gets its own reference to the frame
+	const size_t numOutputs = mOutputs.size();
+
+	if( numOutputs == 0 )
+	{
+		output->Release();
+		return;
+	}
+
+	if( numOutputs > 1 )
+		output->mRefCount.fetch_add(numOutputs - 1, std::memory_order_relaxed);
+
+	for( size_t n=0; n < numOutputs; n++ )
+		mOutputs[n]->push(output);
+}
+
+
+// loop (for the dedicated threads)
+void PipelineStage::loop()
+{
+	while( !mStopping )
+	{
+		if( mNumInputs == 0 )
+		{
+			run(NULL, 0);
+			continue;
+		}
+
+		const uint32_t snapshot = mInputEvent.Prepare();
+		QueueEntry entry;
+
+		if( pop(&entry) )
+		{
+			run(entry.frame, entry.enqueued);
+			continue;
+		}
+
+		if( mStopping )
+			break;
+
+		mInputEvent.Wait(snapshot);
+	}
+}
+
+
+// schedule (a pool task to drain the queue, if there's room for another one)
+void PipelineStage::schedule()
+{
+	uint32_t active = mActive.load();
+
+	while( active < mOptions.concurrency )
+	{
+		if( mActive.compare_exchange_weak(active, active + 1) )
+		{
+			mTasks++;
+
+			ThreadPool* pool = (mOptions.pool != NULL) ? mOptions.pool : ThreadPool::GetShared();
+			pool->Enqueue([this]() { drain(); });
+			return;
+		}
+	}
+}
+
+
+// drain (a pool task that processes frames until the queue is empty)
+void PipelineStage::drain()
+{
+	while(true)
+	{
+		QueueEntry entry;
+
+		while( !mStopping && pop(&entry) )
+			run(entry.frame, entry.enqueued);
+
+		mActive--;
+
+		// a frame that was queued after the queue looked empty may not have
+		// scheduled a task if this one was still active, so check it again
+		if( mStopping || mDepth.load() == 0 )
+			break;
+
+		uint32_t active = mActive.load();
+		bool resumed = false;
+
+		while( active < mOptions.concurrency && !resumed )
+			resumed = mActive.compare_exchange_weak(active, active + 1);
+
+		if( !resumed )
+			break;
+	}
+
+	// this has to be the last access to the stage, which can be deleted once there are no tasks
+	mTasks--;
+}
+
+
+// start
+void PipelineStage::start()
+{
+	mStopping  = false;
+	mStartTime = pipelineTime();
+
+	// sources always get their own thread, because they block waiting for frames
+	uint32_t numThreads = mOptions.threads;
+
+	if( numThreads == 0 && mNumInputs == 0 )
+		numThreads = 1;
+
+	// a pool task can't wait for room in a blocking queue downstream, because the task that
+	// drains it may be queued behind this one in the same pool, so these get their own threads too
+	for( size_t n=0; n < mOutputs.size() && numThreads == 0; n++ )
+	{
+		if( mOutputs[n]->mOptions.policy == PIPELINE_QUEUE_BLOCK )
+		{
+			printf("Pipeline -- stage '%s' outputs to a blocking queue, so it gets dedicated threads instead of running on a pool\n", mName.c_str());
+
+			numThreads = mOptions.concurrency;
+			mOptions.threads = numThreads;
+		}
+	}
+
+	for( uint32_t n=0; n < numThreads; n++ )
+	{
+		PipelineWorker* worker = new PipelineWorker(this);
+
+		if( !worker->StartThread() )
+		{
+			printf("Pipeline -- stage '%s' failed to start thread %u of %u\n", mName.c_str(), n, numThreads);
+			delete worker;
+			break;
+		}
+
+		mWorkers.push_back(worker);
+	}
+}
+
+
+// stop
+void PipelineStage::stop()
+{
+	mStopping = true;
+
+	mInputEvent.Notify();
+	mSpaceEvent.Notify();
+	mFreeEvent.Notify();
+
+	for( size_t n=0; n < mWorkers.size(); n++ )
+		pthread_join(*mWorkers[n]->GetThreadID(), NULL);
+
+	for( size_t n=0; n < mWorkers.size(); n++ )
+		delete mWorkers[n];
+
+	mWorkers.clear();
+
+	// wait for the pool tasks to finish (they exit soon after seeing mStopping)
+	while( mTasks.load() > 0 )
+		sleepMs(1);
+}
+
+
+// flush (release the frames left in the queue)
+void PipelineStage::flush()
+{
+	QueueEntry entry;
+
+	while( pop(&entry) )
+	{
+		mDropped++;
+		entry.frame->Release();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------
+// Pipeline
+//-----------------------------------------------------------------------------------
+
+// constructor
+Pipeline::Pipeline()
+{
+	mRunning = false;
+}
+
+
+// destructor
+Pipeline::~Pipeline()
+{
+	Stop();
+
+	for( size_t n=0; n < mStages.size(); n++ )
+		delete mStages[n];
+}
+
+
+// AddStage
+PipelineStage* Pipeline::AddStage( PipelineStage* stage )
+{
+	if( !stage || mRunning || hasStage(stage) )
+		return NULL;
+
+	mStages.push_back(stage);
+	return stage;
+}
+
+
+// AddStage
+PipelineStage* Pipeline::AddStage( const char* name, const PipelineStage::Function& function, const PipelineStageOptions& options )
+{
+	if( mRunning )
+		return NULL;
+
+	return AddStage(new PipelineStage(name, function, options));
+}
+
+
+// hasStage
+bool Pipeline::hasStage( PipelineStage* stage ) const
+{
+	for( size_t n=0; n < mStages.size(); n++ )
+	{
+		if( mStages[n] == stage )
+			return true;
+	}
+
+	return false;
+}
+
+
+// reaches (if there's a path of connections from one stage to the other)
+bool Pipeline::reaches( PipelineStage* from, PipelineStage* to ) const
+{
+	if( from == to )
+		return true;
+
+	for( size_t n=0; n < from->mOutputs.size(); n++ )
+	{
+		if( reaches(from->mOutputs[n], to) )
+			return true;
+	}
+
+	return false;
+}
+
+
+// Connect
+bool Pipeline::Connect( PipelineStage* from, PipelineStage* to )
+{
+	if( mRunning || !hasStage(from) || !hasStage(to) )
+		return false;
+
+	if( reaches(to, from) )
+	{
+		printf("Pipeline -- connecting '%s' to '%s' would form a cycle\n", from->GetName(), to->GetName());
+		return false;
+	}
+
+	for( size_t n=0; n < from->mOutputs.size(); n++ )
+	{
+		if( from->mOutputs[n] == to )
+			return true;
+	}
+
+	from->mOutputs.push_back(to);
+	to->mNumInputs++;
+
+	return true;
+}
+
+
+// sortStages (in topological order, so every stage comes after the ones that feed it)
+void Pipeline::sortStages( std::vector<PipelineStage*>* order ) const
+{
+	std::vector<uint32_t> inputs(mStages.size());
+
+	for( size_t n=0; n < mStages.size(); n++ )
+		inputs[n] = mStages[n]->mNumInputs;
+
+	order->clear();
+
+	while( order->size() < mStages.size() )
+	{
+		for( size_t n=0; n < mStages.size(); n++ )
+		{
+			if( inputs[n] != 0 )
+				continue;
+
+			inputs[n] = UINT32_MAX;		// so it isn't visited again
+			order->push_back(mStages[n]);
+
+			for( size_t i=0; i < mStages[n]->mOutputs.size(); i++ )
+			{
+				for( size_t j=0; j < mStages.size(); j++ )
+				{
+					if( mStages[j] == mStages[n]->mOutputs[i] )
+						inputs[j]--;
+				}
+			}
+		}
+	}
+}
+
+
+// FindStage
+PipelineStage* Pipeline::FindStage( const char* name ) const
+{
+	if( !name )
+		return NULL;
+
+	for( size_t n=0; n < mStages.size(); n++ )
+	{
+		if( strcmp(mStages[n]->GetName(), name) == 0 )
+			return mStages[n];
+	}
+
+	return NULL;
+}
+
+
+// Start
+bool Pipeline::Start()
+{
+	if( mRunning )
+		return true;
+
+	if( mStages.size() == 0 )
+	{
+		printf("Pipeline -- can't start a pipeline without any stages\n");
+		return false;
+	}
+
+	// the stages downstream are started first, so they're ready when frames arrive
+	std::vector<PipelineStage*> order;
+	sortStages(&order);
+
+	for( size_t n=order.size(); n > 0; n-- )
+		order[n-1]->start();
+
+	mRunning = true;
+	return true;
+}
+
+
+// isIdle (if no frames are queued or being processed)
+bool Pipeline::isIdle() const
+{
+	for( size_t n=0; n < mStages.size(); n++ )
+	{
+		// frames that haven't been recycled are still queued, being processed, or held by a stage
+		if( mStages[n]->mDepth.load() > 0 || mStages[n]->mActive.load() > 0 || mStages[n]->mOutstanding.load() > 0 )
+			return false;
+	}
+
+	return true;
+}
+
+
+// Stop
+void Pipeline::Stop( uint64_t drainTimeout )
+{
+	if( !mRunning )
+		return;
+
+	// stop the sources, so no new frames enter the pipeline
+	for( size_t n=0; n < mStages.size(); n++ )
+	{
+		if( mStages[n]->IsSource() )
+			mStages[n]->stop();
+	}
+
+	// let the frames in flight make it through the rest of the stages
+	const timespec start = timestampMonotonic();
+
+	while( !isIdle() )
+	{
+		uint64_t remaining = 0;
+
+		if( drainTimeout == 0 || !queueTimeout(start, drainTimeout, &remaining) )
+		{
+			printf("Pipeline -- frames were still in flight after %llu ms, dropping them\n", (unsigned long long)drainTimeout);
+			break;
+		}
+
+		sleepMs(1);
+	}
+
+	// stop the rest from upstream to downstream, so nothing gets queued to a stage after it stopped
+	std::vector<PipelineStage*> order;
+	sortStages(&order);
+
+	for( size_t n=0; n < order.size(); n++ )
+	{
+		if( !order[n]->IsSource() )
+			order[n]->stop();
+	}
+
+	for( size_t n=0; n < mStages.size(); n++ )
+		mStages[n]->flush();
+
+	mRunning = false;
+}
+
+
+// PrintStats
+void Pipeline::PrintStats()
+{
+	printf("pipeline statistics (%zu stages, %s)\n", mStages.size(), mRunning ? "running" : "stopped");
+	printf("   %-16s  %10s  %8s  %8s  %11s  %19s  %19s  %19s\n", "stage", "processed", "dropped", "fps", "queue (max)",
+		  "process p50/p99 ms", "queued p50/p99 ms", "latency p50/p99 ms");
+
+	for( size_t n=0; n < mStages.size(); n++ )
+	{
+		PipelineStage* stage = mStages[n];
+
+		printf("   %-16s  %10llu  %8llu  %8.1f  %5u (%3u)  %9.3f %9.3f  %9.3f %9.3f  %9.3f %9.3f\n", stage->GetName(),
+			  (unsigned long long)stage->GetProcessed(), (unsigned long long)stage->GetDropped(), stage->GetThroughput(),
+			  stage->GetQueueDepth(), stage->GetMaxQueueDepth(),
+			  stage->GetProcessLatency()->GetP50() * 0.000001, stage->GetProcessLatency()->GetP99() * 0.000001,
+			  stage->GetQueueLatency()->GetP50() * 0.000001, stage->GetQueueLatency()->GetP99() * 0.000001,
+			  stage->GetFrameLatency()->GetP50() * 0.000001, stage->GetFrameLatency()->GetP99() * 0.000001);
+	}
+}
+
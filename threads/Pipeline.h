@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_PIPELINE_H_
+#define __MULTITHREAD_PIPELINE_H_
+
+#include "EventCount.h"
+#include "MPMCQueue.h"
+#include "ThreadPool.h"
+
+#include "latencyHistogram.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+
+
+// forward declarations
+class Pipeline;
+class PipelineStage;
+class PipelineWorker;
+
+
+/**
+ * Enumeration of policies for what a stage's input queue does while it's full.
+ * @see PipelineStageOptions
+ * @ingroup threads
+ */
+enum PipelineQueuePolicy
+{
+	PIPELINE_QUEUE_BLOCK,		/**< Never drop frames, the upstream stage waits until there's room (default) */
+	PIPELINE_QUEUE_DROP_OLDEST,	/**< Drop the oldest queued frame to make room for the new one */
+	PIPELINE_QUEUE_DROP_NEWEST	/**< Drop the new frame, keeping the ones that are already queued */
+};
+
+/**
+ * Convert a PipelineQueuePolicy enum to a string.
+ * @ingroup threads
+ */
+const char* PipelineQueuePolicyToString( PipelineQueuePolicy policy );
+
+
+class PipelineFrame;
+
+/**
+ * Function pointer typedef that gets called when a frame is recycled back to the
+ * stage that it came from, so that memory the frame was pointing to (for example,
+ * a zero-copy buffer held from a camera) can be handed back.
+ * @ingroup threads
+ */
+typedef void (*PipelineReleaseCallback)( PipelineFrame* frame, void* user_data );
+
+
+/**
+ * A frame that's passed between the stages of a Pipeline.
+ *
+ * Frames are owned by the stage that allocated them with PipelineStage::AcquireFrame(),
+ * and they're reference counted so that they can be sent to several stages at once.
+ * When the last reference is released, the frame is recycled back to that stage.
+ *
+ * The pipeline takes care of the references for frames that are returned from
+ * PipelineStage::Process().  A stage that hangs on to a frame after Process() returns
+ * (i.e. for an asynchronous encode) should Retain() it, and Release() it when done.
+ *
+ * @ingroup threads
+ */
+class PipelineFrame
+{
+public:
+	void*    cpu;		/**< Pointer to the frame in CPU address space */
+	void*    cuda;		/**< Pointer to the frame in GPU address space */
+	size_t   size;		/**< Size of the frame in bytes */
+	uint32_t width;		/**< Width of the image (optional) */
+	uint32_t height;	/**< Height of the image (optional) */
+	uint64_t sequence;	/**< Sequence number, assigned by the stage that acquired the frame */
+	timespec created;	/**< Time that the frame was acquired, from timestampMonotonic() */
+	void*    user_data;	/**< Data that the stages can attach to the frame (reset when the frame is recycled) */
+
+	/**
+	 * Add a reference to the frame.
+	 */
+	inline void Retain()							{ mRefCount.fetch_add(1, std::memory_order_relaxed); }
+
+	/**
+	 * Release a reference to the frame, and recycle it if it was the last one.
+	 */
+	void Release();
+
+	/**
+	 * Set a function that gets called when the frame is recycled.  After the function
+	 * returns, the cpu, cuda, and size are restored to the frame's own memory.
+	 */
+	void SetReleaseCallback( PipelineReleaseCallback callback, void* user_data=NULL );
+
+	/**
+	 * Copy the dimensions, sequence number, and creation time from another frame.
+	 */
+	void CopyMetadata( const PipelineFrame* frame );
+
+	/**
+	 * Get the stage that the frame gets recycled back to.
+	 */
+	inline PipelineStage* GetOwner() const			{ return mOwner; }
+
+protected:
+	friend class PipelineStage;
+
+	PipelineFrame( PipelineStage* owner );
+
+	std::atomic<uint32_t> mRefCount;
+	PipelineStage*        mOwner;
+
+	PipelineReleaseCallback mCallback;
+	void*                   mCallbackData;
+
+	void*  mAllocCPU;	// the memory that was allocated for the frame
+	void*  mAllocCUDA;
+	size_t mAllocSize;
+};
+
+
+/**
+ * Options for creating a PipelineStage.
+ * @ingroup threads
+ */
+struct PipelineStageOptions
+{
+	uint32_t    threads;		/**< Number of threads dedicated to the stage, or 0 to run it on a ThreadPool if none of its outputs use PIPELINE_QUEUE_BLOCK (default 1) */
+	uint32_t    concurrency;	/**< When running on a ThreadPool, the most frames processed at once (default 1, which keeps them in order) */
+	ThreadPool* pool;			/**< The ThreadPool to run on when threads is 0 (default NULL, which is ThreadPool::GetShared()) */
+	uint32_t    queueSize;		/**< Number of frames that the input queue holds, rounded up to a power of two (default 4) */
+	PipelineQueuePolicy policy;	/**< What the input queue does while it's full (default PIPELINE_QUEUE_BLOCK) */
+	uint32_t    frames;			/**< Number of frames the stage allocates for AcquireFrame() (default 0) */
+	size_t      frameSize;		/**< Size of each frame in bytes, or 0 for frames that point to memory from elsewhere (default 0) */
+
+	/**
+	 * Constructor, sets the default options.
+	 */
+	PipelineStageOptions() : threads(1), concurrency(1), pool(NULL), queueSize(4), policy(PIPELINE_QUEUE_BLOCK), frames(0), frameSize(0) {}
+};
+
+
+/**
+ * One stage of a Pipeline, which processes the frames in its input queue and
+ * passes the results to the stages that it's connected to.
+ *
+ * Subclasses override Process(), or a function can be given to the constructor instead.
+ * A stage with no inputs is a source -- it runs on its own thread, calling Process(NULL)
+ * in a loop, and it should block until it has a frame (i.e. while capturing from a camera).
+ * Frames for the source to fill are allocated with AcquireFrame(), and they're recycled
+ * back once every stage downstream is done with them, so the number of frames in flight
+ * is bounded by the options.frames that the source was created with.
+ *
+ * Per-stage metrics are collected for throughput, queue depth, dropped frames, the time
+ * spent in Process(), the time frames waited in the input queue, and the latency from
+ * when a frame was acquired up to when this stage finished with it.
+ *
+ * @ingroup threads
+ */
+class PipelineStage
+{
+public:
+	/**
+	 * Function typedef for processing a frame.  It returns the frame to pass downstream
+	 * (which can be the input, a new frame from AcquireFrame(), or NULL to pass nothing).
+	 * The input is NULL for sources.
+	 */
+	typedef std::function<PipelineFrame*(PipelineFrame* input)> Function;
+
+	/**
+	 * Create a stage that's implemented by a subclass overriding Process().
+	 */
+	PipelineStage( const char* name, const PipelineStageOptions& options=PipelineStageOptions() );
+
+	/**
+	 * Create a stage that calls a function to process the frames.
+	 */
+	PipelineStage( const char* name, const Function& function, const PipelineStageOptions& options=PipelineStageOptions() );
+
+	/**
+	 * Destructor.  Frames that are still in use elsewhere when the stage is deleted are leaked rather than freed.
+	 */
+	virtual ~PipelineStage();
+
+	/**
+	 * Process a frame, returning the frame to pass downstream (or NULL for nothing).
+	 * The pipeline releases the input after this returns, unless it's returned to be passed on.
+	 * The default implementation calls the function that the stage was created with.
+	 */
+	virtual PipelineFrame* Process( PipelineFrame* input );
+
+	/**
+	 * Get a free frame from the stage, waiting up to `timeout` milliseconds for one to be recycled.
+	 * If `metadata` isn't NULL, the new frame's dimensions, sequence number, and creation time
+	 * are copied from it, otherwise the frame gets the next sequence number and the current time.
+	 * @returns the frame (with one reference), or NULL if the timeout occurred or the pipeline is stopping.
+	 */
+	PipelineFrame* AcquireFrame( const PipelineFrame* metadata=NULL, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Get the name of the stage.
+	 */
+	inline const char* GetName() const				{ return mName.c_str(); }
+
+	/**
+	 * Get the options that the stage was created with.
+	 */
+	inline const PipelineStageOptions& GetOptions() const	{ return mOptions; }
+
+	/**
+	 * Return true if the stage doesn't have any inputs.
+	 */
+	inline bool IsSource() const					{ return mNumInputs == 0; }
+
+	/**
+	 * Return true if the pipeline is stopping (sources can check this to stop blocking).
+	 */
+	inline bool IsStopping() const					{ return mStopping.load(std::memory_order_relaxed); }
+
+	/**
+	 * Get the number of frames that were processed (for sources, the number that were produced).
+	 */
+	inline uint64_t GetProcessed() const			{ return mProcessed.load(); }
+
+	/**
+	 * Get the number of frames that were dropped from the input queue.
+	 */
+	inline uint64_t GetDropped() const				{ return mDropped.load(); }
+
+	/**
+	 * Get the number of frames in the input queue.
+	 */
+	inline uint32_t GetQueueDepth() const			{ return mDepth.load(); }
+
+	/**
+	 * Get the highest number of frames that were in the input queue.
+	 */
+	inline uint32_t GetMaxQueueDepth() const		{ return mMaxDepth.load(); }
+
+	/**
+	 * Get the number of frames that were processed per second since the pipeline was started.
+	 */
+	double GetThroughput() const;
+
+	/**
+	 * Get the histogram of the time spent in Process().
+	 */
+	inline latencyHistogram* GetProcessLatency()	{ return &mProcessLatency; }
+
+	/**
+	 * Get the histogram of the time that frames waited in the input queue.
+	 */
+	inline latencyHistogram* GetQueueLatency()		{ return &mQueueLatency; }
+
+	/**
+	 * Get the histogram of the time from when frames were acquired until this stage was done with them.
+	 * For the last stage of a pipeline, this is the end-to-end latency.
+	 */
+	inline latencyHistogram* GetFrameLatency()		{ return &mFrameLatency; }
+
+protected:
+	friend class Pipeline;
+	friend class PipelineFrame;
+	friend class PipelineWorker;
+
+	// a frame in the input queue, and when it was queued
+	struct QueueEntry
+	{
+		PipelineFrame* frame;
+		uint64_t       enqueued;
+	};
+
+	void init( const char* name, const PipelineStageOptions& options );
+	void start();
+	void stop();
+	void flush();
+
+	bool push( PipelineFrame* frame );
+	bool pop( QueueEntry* entry );
+	bool reserve();
+
+	void run( PipelineFrame* input, uint64_t enqueued );
+	void loop();
+	void drain();
+	void schedule();
+
+	void recycle( PipelineFrame* frame );
+
+	std::string          mName;
+	Function             mFunction;
+	PipelineStageOptions mOptions;
+
+	std::vector<PipelineStage*>  mOutputs;
+	std::vector<PipelineWorker*> mWorkers;
+	uint32_t                     mNumInputs;
+
+	MPMCQueue<QueueEntry> mQueue;
+	EventCount            mInputEvent;	// notified when a frame is queued, or the pipeline is stopping
+	EventCount            mSpaceEvent;	// notified when a frame leaves the queue, or the pipeline is stopping
+
+	std::vector<PipelineFrame*> mFrames;
+	MPMCQueue<PipelineFrame*>   mFree;
+	EventCount                  mFreeEvent;	// notified when a frame is recycled, or the pipeline is stopping
+
+	std::atomic<uint32_t> mDepth;		// frames in the queue (including ones being pushed)
+	std::atomic<uint32_t> mMaxDepth;
+	std::atomic<uint32_t> mActive;		// pool tasks that are scheduled or processing frames
+	std::atomic<uint32_t> mTasks;		// pool tasks that haven't returned yet
+	std::atomic<uint32_t> mOutstanding;	// frames that were acquired and haven't been recycled
+	std::atomic<uint64_t> mProcessed;
+	std::atomic<uint64_t> mDropped;
+	std::atomic<uint64_t> mSequence;
+	std::atomic<bool>     mStopping;
+
+	uint64_t mStartTime;
+
+	latencyHistogram mProcessLatency;
+	latencyHistogram mQueueLatency;
+	latencyHistogram mFrameLatency;
+};
+
+
+/**
+ * A graph of stages that frames flow through, with the stages running concurrently.
+ *
+ * Instead of capturing, processing, encoding, and displaying each frame in one serial loop,
+ * each of those steps becomes a stage, and the stages overlap with each other so the
+ * throughput is limited by the slowest stage instead of the sum of them.  Stages are
+ * connected by bounded queues, and a stage can feed several others (fan-out, where they
+ * share the same frame), or be fed by several (fan-in, where the frames are merged in the
+ * order they arrive).  For example:
+ *
+ * @code
+ * Pipeline pipeline;
+ *
+ * PipelineStageOptions captureOptions;
+ * captureOptions.frames    = 4;
+ * captureOptions.frameSize = width * height * sizeof(uchar4);
+ *
+ * PipelineStage* capture = pipeline.AddStage("capture", [&](PipelineFrame*) -> PipelineFrame*
+ * {
+ *     PipelineFrame* frame = capture->AcquireFrame();
+ *     ... capture into frame->cuda, return NULL on failure (after frame->Release()) ...
+ *     return frame;
+ * }, captureOptions);
+ *
+ * PipelineStage* process = pipeline.AddStage("process", [&](PipelineFrame* frame) { ... return frame; });
+ * PipelineStage* display = pipeline.AddStage("display", [&](PipelineFrame* frame) { ... return (PipelineFrame*)NULL; });
+ *
+ * pipeline.Connect(capture, process);
+ * pipeline.Connect(process, display);
+ * pipeline.Start();
+ * @endcode
+ *
+ * Stages that need a particular thread (for example, rendering with OpenGL) can be
+ * left out of the graph, and fed by a stage that hands frames to that thread instead.
+ *
+ * @ingroup threads
+ */
+class Pipeline
+{
+public:
+	/**
+	 * Create an empty pipeline.
+	 */
+	Pipeline();
+
+	/**
+	 * Destructor.  Stops the pipeline and deletes the stages.
+	 */
+	~Pipeline();
+
+	/**
+	 * Add a stage to the pipeline, which takes ownership of it.
+	 * @returns the stage, or NULL if the pipeline is running.
+	 */
+	PipelineStage* AddStage( PipelineStage* stage );
+
+	/**
+	 * Add a stage that calls a function to process the frames.
+	 * @returns the stage, or NULL if the pipeline is running.
+	 */
+	PipelineStage* AddStage( const char* name, const PipelineStage::Function& function, const PipelineStageOptions& options=PipelineStageOptions() );
+
+	/**
+	 * Connect the output of one stage to the input of another.
+	 * Both stages should have been added to the pipeline, and the connection can't form a cycle.
+	 */
+	bool Connect( PipelineStage* from, PipelineStage* to );
+
+	/**
+	 * Start running the stages.
+	 */
+	bool Start();
+
+	/**
+	 * Stop running the stages.  The sources are stopped first, and then the frames that are
+	 * already in flight are given up to `drainTimeout` milliseconds to finish (0 drops them).
+	 */
+	void Stop( uint64_t drainTimeout=DefaultDrainTimeout );
+
+	/**
+	 * Return true if the pipeline is running.
+	 */
+	inline bool IsRunning() const					{ return mRunning; }
+
+	/**
+	 * Get the number of stages.
+	 */
+	inline uint32_t GetNumStages() const			{ return mStages.size(); }
+
+	/**
+	 * Get a stage by its index, in the order that they were added.
+	 */
+	inline PipelineStage* GetStage( uint32_t index ) const	{ return mStages[index]; }
+
+	/**
+	 * Find a stage by its name, or return NULL if there isn't one.
+	 */
+	PipelineStage* FindStage( const char* name ) const;
+
+	/**
+	 * Print the throughput, queue depth, drops, and latencies of each stage.
+	 */
+	void PrintStats();
+
+	/**
+	 * The default time in milliseconds that Stop() waits for frames in flight to finish.
+	 */
+	static const uint64_t DefaultDrainTimeout = 1000;
+
+protected:
+	bool hasStage( PipelineStage* stage ) const;
+	bool reaches( PipelineStage* from, PipelineStage* to ) const;
+	bool isIdle() const;
+	void sortStages( std::vector<PipelineStage*>* order ) const;
+
+	std::vector<PipelineStage*> mStages;
+	bool mRunning;
+};
+
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "RWMutex.h"
+
+
+// constructor
+RWMutex::RWMutex( const char* name )
+{
+	mStats     = LockStats::Register(name);
+	mHoldStart = 0;
+
+	pthread_rwlockattr_t attr;
+	pthread_rwlockattr_init(&attr);
+
+#ifdef __GLIBC__
+	// glibc prefers readers by default, which lets them starve the writers
+	pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+
+	pthread_rwlock_init(&mID, &attr);
+	pthread_rwlockattr_destroy(&attr);
+}
+
+
+// destructor
+RWMutex::~RWMutex()
+{
+	pthread_rwlock_destroy(&mID);
+}
+
+
+// lockProfiled
+void RWMutex::lockProfiled()
+{
+	if( pthread_rwlock_trywrlock(&mID) == 0 )
+	{
+		mStats->Acquired(false);
+	}
+	else
+	{
+		const uint64_t start = LockStats::Now();
+		pthread_rwlock_wrlock(&mID);
+		mStats->Acquired(true, LockStats::Now() - start);
+	}
+
+	mHoldStart = LockStats::Now();
+}
+
+
+// lockSharedProfiled
+void RWMutex::lockSharedProfiled()
+{
+	if( pthread_rwlock_tryrdlock(&mID) == 0 )
+	{
+		mStats->Acquired(false);
+		return;
+	}
+
+	const uint64_t start = LockStats::Now();
+	pthread_rwlock_rdlock(&mID);
+	mStats->Acquired(true, LockStats::Now() - start);
+}
+
+
+// unlockProfiled
+void RWMutex::unlockProfiled()
+{
+	mStats->Released(LockStats::Now() - mHoldStart);
+	mHoldStart = 0;
+}
+
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_RW_MUTEX_H_
+#define __MULTITHREAD_RW_MUTEX_H_
+
+#include <pthread.h>
+
+#include "LockStats.h"
+
+
+/**
+ * A reader/writer lock, which can be held by many readers at once, or by one writer.
+ * The exclusive (writer) side has the same interface as Mutex, and the shared (reader)
+ * side has the same functions with a `Shared` suffix.  Waiting writers take priority
+ * over new readers, so a steady stream of readers can't starve the writers.
+ *
+ * Like Mutex, if the lock is given a name it records contention statistics
+ * while LockStats::Enable() is on.  The hold time is only measured for writers.
+ *
+ * @ingroup threads
+ */
+class RWMutex
+{
+public:
+	/**
+	 * Constructor
+	 * @param name Optional name of the lock, which enables collecting contention statistics for it.
+	 */
+	RWMutex( const char* name=NULL );
+
+	/**
+	 * Destructor
+	 */
+	~RWMutex();
+
+	/**
+	 * If the lock is free, aquire it exclusively.  Otherwise, return without waiting for it to become available.
+	 * @result True if the lock was aquired, false if not.
+	 */
+	inline bool AttemptLock()
+	{
+		if( pthread_rwlock_trywrlock(&mID) != 0 )
+			return false;
+
+		if( mStats != NULL && LockStats::IsEnabled() )
+		{
+			mStats->Acquired(false);
+			mHoldStart = LockStats::Now();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Aquire the lock exclusively, once the readers and any other writer have released it.
+	 */
+	inline void Lock()							{ if( mStats != NULL && LockStats::IsEnabled() ) lockProfiled(); else pthread_rwlock_wrlock(&mID); }
+
+	/**
+	 * Release the exclusive lock.
+	 */
+	inline void Unlock()						{ if( mHoldStart != 0 ) unlockProfiled(); pthread_rwlock_unlock(&mID); }
+
+	/**
+	 * Wait for the exclusive lock, then release it immediately.
+	 */
+	inline void Sync()							{ Lock(); Unlock(); }
+
+	/**
+	 * If no writer holds or is waiting for the lock, aquire it shared.  Otherwise, return without waiting.
+	 * @result True if the lock was aquired, false if not.
+	 */
+	inline bool AttemptLockShared()
+	{
+		if( pthread_rwlock_tryrdlock(&mID) != 0 )
+			return false;
+
+		if( mStats != NULL && LockStats::IsEnabled() )
+			mStats->Acquired(false);
+
+		return true;
+	}
+
+	/**
+	 * Aquire the lock shared with other readers, once there are no writers holding or waiting for it.
+	 */
+	inline void LockShared()					{ if( mStats != NULL && LockStats::IsEnabled() ) lockSharedProfiled(); else pthread_rwlock_rdlock(&mID); }
+
+	/**
+	 * Release the shared lock.
+	 */
+	inline void UnlockShared()					{ pthread_rwlock_unlock(&mID); }
+
+	/**
+	 * Get the contention statistics of the lock, or NULL if it doesn't have a name.
+	 */
+	inline LockStats* GetStats() const			{ return mStats; }
+
+	/**
+	 * Get the rwlock object
+	 */
+	pthread_rwlock_t* GetID() 					{ return &mID; }
+
+protected:
+	void lockProfiled();
+	void lockSharedProfiled();
+	void unlockProfiled();
+
+	pthread_rwlock_t mID;
+
+	LockStats* mStats;
+	uint64_t   mHoldStart;	// when the writer acquired the lock (only set while collecting statistics)
+};
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_SPSC_QUEUE_H_
+#define __MULTITHREAD_SPSC_QUEUE_H_
+
+#include "EventCount.h"
+#include "timespec.h"
+
+
+/**
+ * Bounded lock-free queue with a single producer thread and a single consumer thread.
+ *
+ * TryPush() and TryPop() never block or take a lock, and each thread only writes its
+ * own index.  Push() and Pop() wait for room or for a value with an EventCount,
+ * spinning briefly before sleeping.  The capacity is rounded up to a power of two.
+ *
+ * Only one thread may push and only one thread may pop at a time.  When there are
+ * more producers or consumers, use MPMCQueue instead.
+ *
+ * @ingroup threads
+ */
+template<typename T>
+class SPSCQueue
+{
+public:
+	/**
+	 * Constructor
+	 * @param capacity the maximum number of values in the queue (rounded up to a power of two)
+	 */
+	SPSCQueue( uint32_t capacity );
+
+	/**
+	 * Destructor
+	 */
+	~SPSCQueue();
+
+	/**
+	 * Add a value to the back of the queue, if there's room.
+	 * @returns true if the value was queued, false if the queue was full.
+	 */
+	bool TryPush( const T& value );
+
+	/**
+	 * Remove the value at the front of the queue, if there is one.
+	 * @returns true if a value was retrieved, false if the queue was empty.
+	 */
+	bool TryPop( T* value );
+
+	/**
+	 * Add a value to the back of the queue, waiting up to `timeout` milliseconds
+	 * for room if it's full (UINT64_MAX waits indefinitely).
+	 * @returns true if the value was queued, false on timeout.
+	 */
+	bool Push( const T& value, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Remove the value at the front of the queue, waiting up to `timeout` milliseconds
+	 * for one if it's empty (UINT64_MAX waits indefinitely).
+	 * @returns true if a value was retrieved, false on timeout.
+	 */
+	bool Pop( T* value, uint64_t timeout=UINT64_MAX );
+
+	/**
+	 * Get the number of values in the queue (this is approximate while the other thread is active).
+	 */
+	uint32_t GetSize() const;
+
+	/**
+	 * Get the maximum number of values in the queue.
+	 */
+	inline uint32_t GetCapacity() const	{ return mMask + 1; }
+
+protected:
+	/**
+	 * Size of a cache line, used to keep the indices that are written
+	 * by different threads from sharing a line (false sharing).
+	 */
+	static const uint32_t CacheLineSize = 64;
+
+	T*       mBuffer;
+	uint32_t mMask;
+
+	char mPad0[CacheLineSize];
+
+	std::atomic<uint32_t> mTail;	// written by the producer
+	uint32_t mHeadCached;			// producer's copy of mHead
+
+	char mPad1[CacheLineSize];
+
+	std::atomic<uint32_t> mHead;	// written by the consumer
+	uint32_t mTailCached;			// consumer's copy of mTail
+
+	char mPad2[CacheLineSize];
+
+	EventCount mNotEmpty;
+	EventCount mNotFull;
+};
+
+
+// queueCapacity (rounds up to a power of two)
+inline uint32_t queueCapacity( uint32_t capacity )
+{
+	uint32_t n = 2;
+
+	while( n < capacity && n < (1U << 31) )
+		n <<= 1;
+
+	return n;
+}
+
+// queueTimeout (returns the nanoseconds remaining of a timeout in milliseconds, from a start time on the monotonic clock)
+inline bool queueTimeout( const timespec& start, uint64_t timeout, uint64_t* remaining )
+{
+	if( timeout == UINT64_MAX )
+	{
+		*remaining = UINT64_MAX;
+		return true;
+	}
+
+	const timespec elapsed = timeDiff(start, timestampMonotonic());
+	const uint64_t elapsedNs = elapsed.tv_sec * 1000000000ULL + elapsed.tv_nsec;
+	const uint64_t timeoutNs = timeout * 1000000ULL;
+
+	if( elapsedNs >= timeoutNs )
+		return false;
+
+	*remaining = timeoutNs - elapsedNs;
+	return true;
+}
+
+
+// constructor
+template<typename T>
+SPSCQueue<T>::SPSCQueue( uint32_t capacity ) : mTail(0), mHead(0)
+{
+	capacity = queueCapacity(capacity);
+
+	mBuffer     = new T[capacity];
+	mMask       = capacity - 1;
+	mHeadCached = 0;
+	mTailCached = 0;
+}
+
+
+// destructor
+template<typename T>
+SPSCQueue<T>::~SPSCQueue()
+{
+	delete[] mBuffer;
+}
+
+
+// TryPush
+template<typename T>
+bool SPSCQueue<T>::TryPush( const T& value )
+{
+	const uint32_t tail = mTail.load(std::memory_order_relaxed);
+
+	if( tail - mHeadCached > mMask )
+	{
+		mHeadCached = mHead.load(std::memory_order_acquire);
+
+		if( tail - mHeadCached > mMask )
+			return false;
+	}
+
+	mBuffer[tail & mMask] = value;
+	mTail.store(tail + 1, std::memory_order_release);
+	mNotEmpty.Notify();
+
+	return true;
+}
+
+
+// TryPop
+template<typename T>
+bool SPSCQueue<T>::TryPop( T* value )
+{
+	const uint32_t head = mHead.load(std::memory_order_relaxed);
+
+	if( head == mTailCached )
+	{
+		mTailCached = mTail.load(std::memory_order_acquire);
+
+		if( head == mTailCached )
+			return false;
+	}
+
+	*value = mBuffer[head & mMask];
+	mHead.store(head + 1, std::memory_order_release);
+	mNotFull.Notify();
+
+	return true;
+}
+
+
+// Push
+template<typename T>
+bool SPSCQueue<T>::Push( const T& value, uint64_t timeout )
+{
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mNotFull.Prepare();
+
+		if( TryPush(value) )
+			return true;
+
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return false;
+
+		mNotFull.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// Pop
+template<typename T>
+bool SPSCQueue<T>::Pop( T* value, uint64_t timeout )
+{
+	const timespec start = timestampMonotonic();
+
+	while(true)
+	{
+		const uint32_t snapshot = mNotEmpty.Prepare();
+
+		if( TryPop(value) )
+			return true;
+
+		uint64_t remaining = 0;
+
+		if( !queueTimeout(start, timeout, &remaining) )
+			return false;
+
+		mNotEmpty.WaitNs(snapshot, remaining);
+	}
+}
+
+
+// GetSize
+template<typename T>
+uint32_t SPSCQueue<T>::GetSize() const
+{
+	const uint32_t head = mHead.load(std::memory_order_acquire);
+	const uint32_t tail = mTail.load(std::memory_order_acquire);
+
+	return tail - head;
+}
+
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "SpinLock.h"
+
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+// constructor
+SpinLock::SpinLock( const char* name, uint32_t maxSpinCount ) : mState(UNLOCKED), mSpinCount(0)
+{
+	mMaxSpinCount = maxSpinCount;
+	mStats        = LockStats::Register(name);
+	mHoldStart    = 0;
+}
+
+
+// lockSlow
+void SpinLock::lockSlow()
+{
+	// spin for a while longer than it took recently (like glibc's adaptive mutexes)
+	const uint32_t average = mSpinCount.load(std::memory_order_relaxed);
+	const uint32_t limit   = (average * 2 + 10 < mMaxSpinCount) ? average * 2 + 10 : mMaxSpinCount;
+
+	uint32_t spins = 0;
+
+	for( ; spins < limit; spins++ )
+	{
+		// only try to take the lock once it looks free, so the cache line isn't bounced around
+		uint32_t unlocked = UNLOCKED;
+
+		if( mState.load(std::memory_order_relaxed) == UNLOCKED &&
+		    mState.compare_exchange_weak(unlocked, LOCKED, std::memory_order_acquire) )
+		{
+			mSpinCount.store(int32_t(average) + (int32_t(spins) - int32_t(average)) / 8, std::memory_order_relaxed);
+			return;
+		}
+
+		cpuRelax();
+	}
+
+	mSpinCount.store(int32_t(average) + (int32_t(limit) - int32_t(average)) / 8, std::memory_order_relaxed);
+
+	// sleep until the lock is released, marking it contended so Unlock() wakes a thread
+	while( mState.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED )
+		syscall(SYS_futex, (uint32_t*)&mState, FUTEX_WAIT_PRIVATE, CONTENDED, NULL, NULL, 0);
+}
+
+
+// wake
+void SpinLock::wake()
+{
+	syscall(SYS_futex, (uint32_t*)&mState, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+
+// lockProfiled
+void SpinLock::lockProfiled()
+{
+	uint32_t unlocked = UNLOCKED;
+
+	if( mState.compare_exchange_strong(unlocked, LOCKED, std::memory_order_acquire) )
+	{
+		mStats->Acquired(false);
+	}
+	else
+	{
+		const uint64_t start = LockStats::Now();
+		lockSlow();
+		mStats->Acquired(true, LockStats::Now() - start);
+	}
+
+	mHoldStart = LockStats::Now();
+}
+
+
+// unlockProfiled
+void SpinLock::unlockProfiled()
+{
+	mStats->Released(LockStats::Now() - mHoldStart);
+	mHoldStart = 0;
+}
+
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_SPIN_LOCK_H_
+#define __MULTITHREAD_SPIN_LOCK_H_
+
+#include "EventCount.h"
+#include "LockStats.h"
+
+
+/**
+ * An adaptive spin lock with the same interface as Mutex, for protecting short critical sections.
+ *
+ * When the lock is held, a thread first spins on it, and if it still isn't free, the thread sleeps
+ * on a futex until it's released (so unlike a pure spin lock, a preempted holder doesn't burn the
+ * waiters' CPU time).  How long threads spin adapts to how long it took to get the lock recently.
+ *
+ * Like Mutex, if the lock is given a name it records contention statistics
+ * while LockStats::Enable() is on.
+ *
+ * @ingroup threads
+ */
+class SpinLock
+{
+public:
+	/**
+	 * Constructor
+	 * @param name Optional name of the lock, which enables collecting contention statistics for it.
+	 * @param maxSpinCount The most times to spin on the lock before sleeping.
+	 */
+	SpinLock( const char* name=NULL, uint32_t maxSpinCount=DefaultSpinCount );
+
+	/**
+	 * If the lock is free, aquire it.  Otherwise, return without waiting for it to become available.
+	 * @result True if the lock was aquired, false if not.
+	 */
+	inline bool AttemptLock()
+	{
+		uint32_t unlocked = UNLOCKED;
+
+		if( !mState.compare_exchange_strong(unlocked, LOCKED, std::memory_order_acquire) )
+			return false;
+
+		if( mStats != NULL && LockStats::IsEnabled() )
+		{
+			mStats->Acquired(false);
+			mHoldStart = LockStats::Now();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Aquire the lock, spinning and then sleeping if it isn't free.
+	 */
+	inline void Lock()
+	{
+		if( mStats != NULL && LockStats::IsEnabled() )
+			return lockProfiled();
+
+		uint32_t unlocked = UNLOCKED;
+
+		if( !mState.compare_exchange_strong(unlocked, LOCKED, std::memory_order_acquire) )
+			lockSlow();
+	}
+
+	/**
+	 * Release the lock, and wake a thread that's sleeping on it.
+	 */
+	inline void Unlock()
+	{
+		if( mHoldStart != 0 )
+			unlockProfiled();
+
+		if( mState.exchange(UNLOCKED, std::memory_order_release) == CONTENDED )
+			wake();
+	}
+
+	/**
+	 * Wait for the lock, then release it immediately.
+	 */
+	inline void Sync()							{ Lock(); Unlock(); }
+
+	/**
+	 * Get the contention statistics of the lock, or NULL if it doesn't have a name.
+	 */
+	inline LockStats* GetStats() const			{ return mStats; }
+
+	/**
+	 * The default limit on spinning before sleeping.
+	 */
+	static const uint32_t DefaultSpinCount = 100;
+
+protected:
+	void lockSlow();
+	void lockProfiled();
+	void unlockProfiled();
+	void wake();
+
+	// mState is UNLOCKED, LOCKED, or CONTENDED when threads may be sleeping on it
+	static const uint32_t UNLOCKED  = 0;
+	static const uint32_t LOCKED    = 1;
+	static const uint32_t CONTENDED = 2;
+
+	std::atomic<uint32_t> mState;
+	std::atomic<uint32_t> mSpinCount;	// running average of the spins it took to get the lock
+
+	uint32_t   mMaxSpinCount;
+	LockStats* mStats;
+	uint64_t   mHoldStart;	// when the lock was acquired (only set while collecting statistics)
+};
+
+#endif
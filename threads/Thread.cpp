@@ -266,6 +266,44 @@ bool Thread::SetAffinity( unsigned int cpuID, pthread_t* thread_ptr )
 }
 
 
+// LockAffinityMask
+bool Thread::LockAffinityMask( uint64_t mask )
+{
+	return Thread::SetAffinityMask( mask, GetThreadID() );
+}
+
+
+// SetAffinityMask
+bool Thread::SetAffinityMask( uint64_t mask, pthread_t* thread_ptr )
+{
+	pthread_t thread;
+	cpu_set_t cpu_set;
+
+	CPU_ZERO(&cpu_set);
+
+	for( unsigned int cpuID=0; cpuID < 64; cpuID++ )
+	{
+		if( mask & (1ULL << cpuID) )
+			CPU_SET(cpuID, &cpu_set);
+	}
+
+	if( !thread_ptr )
+		thread = pthread_self();
+	else
+		thread = *thread_ptr;
+
+	const int result_set_cpu = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpu_set);
+
+	if( result_set_cpu != 0 )
+	{
+		printf("pthread_setaffinity_np() failed (error=%i)\n", result_set_cpu);
+		return false;
+	}
+
+	return true;
+}
+
+
 // GetCPU
 int Thread::GetCPU()
 {
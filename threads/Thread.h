@@ -24,6 +24,7 @@
 #define __MULTITHREAD_H_
 
 #include <pthread.h>
+#include <stdint.h>
 
 
 /**
@@ -137,6 +138,19 @@ public:
 	 */
 	static bool SetAffinity( unsigned int cpu, pthread_t* thread=NULL );
 
+	/**
+	 * Lock this thread to a set of CPU cores.
+	 * @param mask Bit N of the mask selects CPU core N.
+	 */
+	bool LockAffinityMask( uint64_t mask );
+
+	/**
+	 * Lock the specified thread's affinity to a set of CPU cores.
+	 * @param mask Bit N of the mask selects CPU core N.
+	 * @param thread The thread, or if NULL, the currently running thread.
+	 */
+	static bool SetAffinityMask( uint64_t mask, pthread_t* thread=NULL );
+
 	/**
 	 * Look up which CPU core the thread is running on.
 	 */
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#include "ThreadPool.h"
+#include "Thread.h"
+#include "Mutex.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <deque>
+
+
+// a worker thread and its deque of tasks
+class ThreadPoolWorker : public Thread
+{
+public:
+	ThreadPoolWorker( ThreadPool* pool, uint32_t index ) : mPool(pool), mIndex(index)	{ }
+
+	virtual void Run()		{ mPool->workerLoop(mIndex); }
+
+	ThreadPool* mPool;
+	uint32_t    mIndex;
+
+	Mutex mMutex;
+	std::deque<ThreadPool::Task> mTasks;	// the owner pops from the back, thieves from the front
+};
+
+
+// the pool and worker index of the calling thread (if it's a worker)
+static thread_local const ThreadPool* gWorkerPool  = NULL;
+static thread_local uint32_t          gWorkerIndex = 0;
+
+
+// constructor
+ThreadPool::ThreadPool( const ThreadPoolOptions& options ) : mPending(0), mNextWorker(0), mStolen(0), mStopping(false), mNumStarted(0)
+{
+	mOptions = options;
+
+	if( mOptions.threads == 0 )
+	{
+		const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		mOptions.threads = (cpus > 0) ? cpus : 1;
+	}
+
+	if( mOptions.realtime )
+		Thread::InitRealtime();
+
+	for( uint32_t n=0; n < mOptions.threads; n++ )
+		mWorkers.push_back(new ThreadPoolWorker(this, n));
+
+	// the workers are created before any of them start, so they can steal from each other
+	for( uint32_t n=0; n < mWorkers.size(); n++ )
+	{
+		if( !mWorkers[n]->StartThread() )
+		{
+			printf("ThreadPool -- failed to start worker thread %u of %u\n", n, mOptions.threads);
+
+			// the remaining workers never ran, so they can be removed
+			for( uint32_t m=n; m < mWorkers.size(); m++ )
+				delete mWorkers[m];
+
+			mWorkers.resize(n);
+			break;
+		}
+	}
+
+	if( mWorkers.size() == 0 )
+		printf("ThreadPool -- no worker threads were started, tasks will be run by the caller\n");
+
+	// let the workers that were started look at the other deques
+	mNumStarted = mWorkers.size();
+	mWorkEvent.Notify();
+}
+
+
+// destructor
+ThreadPool::~ThreadPool()
+{
+	Wait();
+
+	mStopping = true;
+	mWorkEvent.Notify();
+
+	// every worker has to exit before any are deleted, because they steal from each other
+	for( size_t n=0; n < mWorkers.size(); n++ )
+		pthread_join(*mWorkers[n]->GetThreadID(), NULL);
+
+	for( size_t n=0; n < mWorkers.size(); n++ )
+		delete mWorkers[n];
+}
+
+
+// GetShared
+ThreadPool* ThreadPool::GetShared()
+{
+	// never deleted, so the workers are still around for static destructors
+	static ThreadPool* pool = new ThreadPool();
+	return pool;
+}
+
+
+// GetWorkerIndex
+int ThreadPool::GetWorkerIndex() const
+{
+	return (gWorkerPool == this) ? (int)gWorkerIndex : -1;
+}
+
+
+// Enqueue
+void ThreadPool::Enqueue( const Task& task )
+{
+	if( !task )
+		return;
+
+	if( mWorkers.size() == 0 )
+	{
+		task();
+		return;
+	}
+
+	const int self = GetWorkerIndex();
+	const uint32_t worker = (self >= 0) ? self : (mNextWorker++ % mWorkers.size());
+
+	mPending++;
+
+	mWorkers[worker]->mMutex.Lock();
+	mWorkers[worker]->mTasks.push_back(task);
+	mWorkers[worker]->mMutex.Unlock();
+
+	mWorkEvent.Notify();
+}
+
+
+// pop
+bool ThreadPool::pop( uint32_t worker, Task* task )
+{
+	ThreadPoolWorker* w = mWorkers[worker];
+	bool found = false;
+
+	w->mMutex.Lock();
+
+	if( !w->mTasks.empty() )
+	{
+		*task = w->mTasks.back();
+		w->mTasks.pop_back();
+		found = true;
+	}
+
+	w->mMutex.Unlock();
+	return found;
+}
+
+
+// steal
+bool ThreadPool::steal( uint32_t worker, Task* task )
+{
+	const uint32_t numWorkers = mNumStarted;
+
+	for( uint32_t n=1; n < numWorkers; n++ )
+	{
+		ThreadPoolWorker* victim = mWorkers[(worker + n) % numWorkers];
+		bool found = false;
+
+		// don't wait on a deque that's busy, try the next one instead
+		if( !victim->mMutex.AttemptLock() )
+			continue;
+
+		if( !victim->mTasks.empty() )
+		{
+			*task = victim->mTasks.front();
+			victim->mTasks.pop_front();
+			found = true;
+		}
+
+		victim->mMutex.Unlock();
+
+		if( found )
+		{
+			mStolen++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// workerLoop
+void ThreadPool::workerLoop( uint32_t worker )
+{
+	gWorkerPool  = this;
+	gWorkerIndex = worker;
+
+	if( mOptions.affinity != 0 )
+		Thread::SetAffinityMask(mOptions.affinity);
+
+	if( mOptions.priority != 0 )
+		Thread::SetPriority(mOptions.priority);
+
+	// wait until the constructor knows which workers were started
+	while(true)
+	{
+		const uint32_t snapshot = mWorkEvent.Prepare();
+
+		if( mNumStarted != 0 )
+			break;
+
+		mWorkEvent.Wait(snapshot);
+	}
+
+	while(true)
+	{
+		// take the snapshot before looking for a task, so a submission can't be missed
+		const uint32_t snapshot = mWorkEvent.Prepare();
+		Task task;
+
+		if( pop(worker, &task) || steal(worker, &task) )
+		{
+			task();
+
+			if( --mPending == 0 )
+				mIdleEvent.Notify();
+
+			continue;
+		}
+
+		if( mStopping )
+			break;
+
+		mWorkEvent.Wait(snapshot);
+	}
+}
+
+
+// Wait
+void ThreadPool::Wait()
+{
+	while(true)
+	{
+		const uint32_t snapshot = mIdleEvent.Prepare();
+
+		if( mPending == 0 )
+			return;
+
+		mIdleEvent.Wait(snapshot);
+	}
+}
+
+
+// chunks of a ParallelFor() that are shared between the caller and the workers
+struct ThreadPoolJob
+{
+	const ThreadPool::RangeFunction* function;	// only called while chunks remain, so the caller's copy stays valid
+
+	size_t count;
+	size_t grain;
+	size_t numChunks;
+
+	std::atomic<size_t> nextChunk;
+	std::atomic<size_t> doneChunks;
+
+	EventCount doneEvent;
+
+	// process chunks until there are none left
+	void Run()
+	{
+		while(true)
+		{
+			const size_t chunk = nextChunk++;
+
+			if( chunk >= numChunks )
+				return;
+
+			const size_t begin = chunk * grain;
+			const size_t end   = (begin + grain < count) ? begin + grain : count;
+
+			(*function)(begin, end);
+
+			if( ++doneChunks == numChunks )
+				doneEvent.Notify();
+		}
+	}
+};
+
+
+// ParallelFor
+void ThreadPool::ParallelFor( size_t count, size_t grain, const RangeFunction& function )
+{
+	if( count == 0 || !function )
+		return;
+
+	if( grain == 0 )
+		grain = 1;
+
+	const size_t numChunks = (count + grain - 1) / grain;
+
+	if( numChunks == 1 || mWorkers.size() == 0 )
+	{
+		function(0, count);
+		return;
+	}
+
+	// the job is shared, because workers can pick up a helper task after the caller returns
+	std::shared_ptr<ThreadPoolJob> job = std::make_shared<ThreadPoolJob>();
+
+	job->function   = &function;
+	job->count      = count;
+	job->grain      = grain;
+	job->numChunks  = numChunks;
+	job->nextChunk  = 0;
+	job->doneChunks = 0;
+
+	const size_t numHelpers = (numChunks - 1 < mWorkers.size()) ? numChunks - 1 : mWorkers.size();
+
+	for( size_t n=0; n < numHelpers; n++ )
+		Enqueue([job]() { job->Run(); });
+
+	job->Run();
+
+	// wait for the chunks that the workers are still processing
+	while(true)
+	{
+		const uint32_t snapshot = job->doneEvent.Prepare();
+
+		if( job->doneChunks == numChunks )
+			break;
+
+		job->doneEvent.Wait(snapshot);
+	}
+}
+
+
+// ParallelTiles
+void ThreadPool::ParallelTiles( uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight, const TileFunction& function )
+{
+	if( width == 0 || height == 0 || !function )
+		return;
+
+	if( tileWidth == 0 || tileWidth > width )
+		tileWidth = width;
+
+	if( tileHeight == 0 || tileHeight > height )
+		tileHeight = height;
+
+	const uint32_t tilesX = (width + tileWidth - 1) / tileWidth;
+	const uint32_t tilesY = (height + tileHeight - 1) / tileHeight;
+
+	ParallelFor(size_t(tilesX) * tilesY, 1, [&](size_t begin, size_t end)
+	{
+		for( size_t n=begin; n < end; n++ )
+		{
+			const uint32_t x = (n % tilesX) * tileWidth;
+			const uint32_t y = (n / tilesX) * tileHeight;
+
+			function(x, y, (x + tileWidth < width) ? tileWidth : width - x,
+					     (y + tileHeight < height) ? tileHeight : height - y);
+		}
+	});
+}
+
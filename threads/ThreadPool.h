@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+ 
+#ifndef __MULTITHREAD_POOL_H_
+#define __MULTITHREAD_POOL_H_
+
+#include "EventCount.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include <future>
+#include <functional>
+
+
+/**
+ * Options for creating a ThreadPool.
+ * @ingroup threads
+ */
+struct ThreadPoolOptions
+{
+	uint32_t threads;	/**< Number of worker threads (default 0, which is one per online CPU core) */
+	uint64_t affinity;	/**< Mask of the CPU cores that the workers can run on, where bit N selects core N (default 0, any core) */
+	int      priority;	/**< SCHED_FIFO priority of the workers for Thread::SetPriority(), or 0 to keep the default scheduling (default 0) */
+	bool     realtime;	/**< Call Thread::InitRealtime() before starting the workers (default false) */
+
+	/**
+	 * Constructor, sets the default options.
+	 */
+	ThreadPoolOptions() : threads(0), affinity(0), priority(0), realtime(false) {}
+};
+
+
+// internal worker thread
+class ThreadPoolWorker;
+
+
+/**
+ * Work-stealing pool of worker threads for running tasks in parallel.
+ *
+ * Each worker has its own deque of tasks.  Tasks that a worker submits go on its own
+ * deque, which it runs newest-first, and tasks submitted from other threads are spread
+ * across the workers.  An idle worker steals the oldest task from another worker's deque,
+ * and when there's nothing left to steal, it sleeps on an EventCount.
+ *
+ * ParallelFor() and ParallelTiles() split a range or an image into chunks that the calling
+ * thread works on together with the pool, so they can be nested inside of other tasks.
+ * GetShared() returns the pool that the library's CPU-side operations run on.
+ *
+ * @ingroup threads
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * Function typedef for a task.
+	 */
+	typedef std::function<void()> Task;
+
+	/**
+	 * Function typedef for processing the part of a range from `begin` up to (but not including) `end`.
+	 */
+	typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+	/**
+	 * Function typedef for processing a tile of an image.
+	 */
+	typedef std::function<void(uint32_t x, uint32_t y, uint32_t width, uint32_t height)> TileFunction;
+
+	/**
+	 * Create the pool and start the worker threads.
+	 */
+	ThreadPool( const ThreadPoolOptions& options=ThreadPoolOptions() );
+
+	/**
+	 * Destructor.  Waits for the tasks that were submitted to finish, then stops the workers.
+	 */
+	~ThreadPool();
+
+	/**
+	 * Submit a task to be run by the pool.
+	 * If none of the worker threads could be started, the task is run by the caller instead.
+	 */
+	void Enqueue( const Task& task );
+
+	/**
+	 * Submit a task to be run by the pool, returning a future for its result.
+	 * Waiting on the future from inside another task can deadlock if every worker
+	 * is doing the same, so tasks should use ParallelFor() to wait on their own work.
+	 */
+	template<typename F>
+	std::future<typename std::result_of<F()>::type> Submit( F function );
+
+	/**
+	 * Process the range [0, count) in chunks of `grain` items, and return once every chunk is done.
+	 * The calling thread processes chunks too, so this is safe to call from inside a task.
+	 */
+	void ParallelFor( size_t count, size_t grain, const RangeFunction& function );
+
+	/**
+	 * Process a width x height image in tiles, and return once every tile is done.
+	 * To process bands of rows, make the tiles as wide as the image.
+	 */
+	void ParallelTiles( uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight, const TileFunction& function );
+
+	/**
+	 * Wait until every task that was submitted has finished.
+	 * This shouldn't be called from inside of a task.
+	 */
+	void Wait();
+
+	/**
+	 * Get the number of worker threads.
+	 */
+	inline uint32_t GetNumThreads() const		{ return mWorkers.size(); }
+
+	/**
+	 * Get the number of tasks that were stolen by idle workers from another worker.
+	 */
+	inline uint64_t GetNumStolen() const		{ return mStolen.load(); }
+
+	/**
+	 * Get the index of the calling thread in this pool, or -1 if it isn't one of its workers.
+	 */
+	int GetWorkerIndex() const;
+
+	/**
+	 * Get the shared pool, which is created with the default options the first time it's used.
+	 */
+	static ThreadPool* GetShared();
+
+protected:
+	friend class ThreadPoolWorker;
+
+	bool pop( uint32_t worker, Task* task );
+	bool steal( uint32_t worker, Task* task );
+	void workerLoop( uint32_t worker );
+
+	std::vector<ThreadPoolWorker*> mWorkers;
+	ThreadPoolOptions mOptions;
+
+	std::atomic<size_t>   mPending;		// tasks that were submitted and haven't finished
+	std::atomic<uint32_t> mNextWorker;	// round-robin cursor for tasks from outside the pool
+	std::atomic<uint64_t> mStolen;
+	std::atomic<bool>     mStopping;
+	std::atomic<uint32_t> mNumStarted;	// set once the workers that failed to start are removed
+
+	EventCount mWorkEvent;		// notified when a task is submitted
+	EventCount mIdleEvent;		// notified when mPending reaches zero
+};
+
+
+// Submit
+template<typename F>
+std::future<typename std::result_of<F()>::type> ThreadPool::Submit( F function )
+{
+	typedef typename std::result_of<F()>::type R;
+
+	std::shared_ptr< std::packaged_task<R()> > task = std::make_shared< std::packaged_task<R()> >(function);
+	std::future<R> future = task->get_future();
+
+	Enqueue([task]() { (*task)(); });
+	return future;
+}
+
+
+#endif
@@ -41,6 +41,20 @@ inline void timestamp( timespec* timestampOut )					{ if(!timestampOut) return;
  */
 inline timespec timestamp()									{ timespec t; timestamp(&t); return t; }
 
+/**
+ * Retrieve a timestamp from the monotonic clock, which isn't affected by changes
+ * to the system time (i.e. from NTP).  Use it for measuring intervals and timeouts.
+ * @ingroup time
+ */
+inline void timestampMonotonic( timespec* timestampOut )			{ if(!timestampOut) return; timestampOut->tv_sec=0; timestampOut->tv_nsec=0; clock_gettime(CLOCK_MONOTONIC, timestampOut); } 
+
+/**
+ * Retrieve a timestamp from the monotonic clock, which isn't affected by changes
+ * to the system time (i.e. from NTP).  Use it for measuring intervals and timeouts.
+ * @ingroup time
+ */
+inline timespec timestampMonotonic()							{ timespec t; timestampMonotonic(&t); return t; }
+
 /**
  * Return a blank timespec that's been zero'd.
  * @ingroup time